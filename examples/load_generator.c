@@ -0,0 +1,945 @@
+/*
+================================================================================
+FILE: load_generator.c
+PURPOSE: Measure the API server's capacity and latency under a request mix
+DESCRIPTION:
+    - Drives POST /api/allocate, POST /api/deallocate, GET /api/stats and
+      GET /api/blocks over N connections (one thread each) with a chosen
+      mix, and reports throughput and latency percentiles per operation
+    - CLOSED LOOP (default): every connection sends its next request as
+      soon as the last answer arrived. Finds the throughput the server
+      can sustain with N clients in flight
+    - OPEN LOOP (--rate R): requests are DUE at a fixed rate whether or
+      not the server keeps up. Latency is measured from when a request
+      was due, not from when it could finally be sent: a server that
+      stalls for 1 s then gets charged for every request that had to
+      wait, instead of for the single slow one ("coordinated omission")
+    - Latencies go into HDR histograms (log-linear buckets, 3 significant
+      digits from 1 us up to minutes), merged across threads; --hdr FILE
+      writes the full percentile spectrum in HdrHistogram's text format
+    - Keep-alive by default (one TCP connection per thread); --close
+      opens a new connection for every request, as a simple client would
+    - Build and run (next to ./build/memory_visualizer --server 8080):
+      gcc -O2 -pthread -o build/load_generator examples/load_generator.c -lm
+      ./build/load_generator                           → 8 connections, 10 s
+      ./build/load_generator --connections 32 --duration 30
+      ./build/load_generator --rate 20000 --hdr open.hgrm
+      ./build/load_generator --mix allocate=50,deallocate=50 --size 1-512
+================================================================================
+*/
+
+#include <stdio.h>          // printf, fprintf, snprintf, fopen
+#include <stdlib.h>         // malloc, realloc, free, atoi, strtol
+#include <string.h>         // memset, memcpy, strcmp, strstr, strncmp
+#include <stdint.h>         // uint64_t, uint32_t
+#include <math.h>           // sqrt
+#include <unistd.h>         // read, close
+#include <errno.h>          // errno, EINTR
+#include <time.h>           // clock_gettime, clock_nanosleep, nanosleep
+#include <signal.h>         // signal, SIGPIPE
+#include <pthread.h>        // pthread_create, pthread_join
+#include <netdb.h>          // getaddrinfo
+#include <sys/socket.h>     // socket, connect, send
+#include <netinet/in.h>     // IPPROTO_TCP
+#include <netinet/tcp.h>    // TCP_NODELAY
+
+// macOS has no MSG_NOSIGNAL; SIGPIPE is ignored in main() instead
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+
+#define MAX_CONNECTIONS 1024
+
+// Processes one connection keeps allocated at most (a deallocate needs
+// one of its own PIDs; an allocate with this many live frees one instead)
+#define DEFAULT_MAX_LIVE 256
+
+// HDR histogram in microseconds: values below 2048 us are exact, above
+// that every bucket is 1/1024 of its power of two wide (3 digits)
+#define HDR_SUB_BITS  11
+#define HDR_SUB_COUNT (1 << HDR_SUB_BITS)               // 2048
+#define HDR_HALF      (HDR_SUB_COUNT / 2)               // 1024
+#define HDR_MAX_LOG2  28                                // 2^28 us ≈ 268 s
+#define HDR_BUCKETS   ((HDR_MAX_LOG2 - HDR_SUB_BITS + 2) * HDR_HALF)
+
+
+typedef enum {
+    OP_ALLOCATE = 0,
+    OP_DEALLOCATE,
+    OP_STATS,
+    OP_BLOCKS,
+    OP_COUNT
+} Operation;
+
+static const char *opNames[OP_COUNT] = { "allocate", "deallocate", "stats", "blocks" };
+
+
+/*
+================================================================================
+STRUCTURE: Histogram
+================================================================================
+PURPOSE: Counts of latencies per log-linear bucket, plus exact extremes
+         and sums for the mean and standard deviation
+
+index(v) for v < 2048: v itself. Above: the power of two 2^(b+10) ≤ v
+gives the bucket b, the top 11 bits of v the place in it, so each of
+the 1024 slots of bucket b is 2^b us wide:
+
+    v = 3000 us  → b = 1, top bits 1500 → index 2048 + (1500 - 1024) = 2524
+                   holds 3000..3001 us
+*/
+
+typedef struct {
+    uint32_t counts[HDR_BUCKETS];
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    double   sum;
+    double   sumSquares;
+} Histogram;
+
+static int hdrIndex(uint64_t value) {
+    if (value >= (1ULL << HDR_MAX_LOG2)) {
+        value = (1ULL << HDR_MAX_LOG2) - 1;
+    }
+    int bucket = 63 - __builtin_clzll(value | (HDR_SUB_COUNT - 1)) - (HDR_SUB_BITS - 1);
+    int sub = (int)(value >> bucket);
+    return bucket == 0 ? sub : (bucket + 1) * HDR_HALF + (sub - HDR_HALF);
+}
+
+// The highest value that lands in 'index' (what a percentile reports)
+static uint64_t hdrHighest(int index) {
+    if (index < HDR_SUB_COUNT) {
+        return (uint64_t)index;
+    }
+    int bucket = index / HDR_HALF - 1;
+    uint64_t sub = (uint64_t)(index % HDR_HALF + HDR_HALF);
+    return ((sub + 1) << bucket) - 1;
+}
+
+static void hdrRecord(Histogram *h, uint64_t value) {
+    h->counts[hdrIndex(value)]++;
+    if (h->total == 0 || value < h->min) {
+        h->min = value;
+    }
+    if (value > h->max) {
+        h->max = value;
+    }
+    h->total++;
+    h->sum += (double)value;
+    h->sumSquares += (double)value * (double)value;
+}
+
+static void hdrMerge(Histogram *into, const Histogram *from) {
+    if (from->total == 0) {
+        return;
+    }
+    for (int i = 0; i < HDR_BUCKETS; i++) {
+        into->counts[i] += from->counts[i];
+    }
+    if (into->total == 0 || from->min < into->min) {
+        into->min = from->min;
+    }
+    if (from->max > into->max) {
+        into->max = from->max;
+    }
+    into->total += from->total;
+    into->sum += from->sum;
+    into->sumSquares += from->sumSquares;
+}
+
+// The value at 'percentile' (0..100); 100 is the exact maximum
+static uint64_t hdrPercentile(const Histogram *h, double percentile) {
+    if (h->total == 0) {
+        return 0;
+    }
+    if (percentile >= 100.0) {
+        return h->max;
+    }
+    uint64_t wanted = (uint64_t)(percentile / 100.0 * (double)h->total + 0.5);
+    if (wanted == 0) {
+        wanted = 1;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < HDR_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen >= wanted) {
+            uint64_t value = hdrHighest(i);
+            return value < h->max ? value : h->max;
+        }
+    }
+    return h->max;
+}
+
+
+/*
+================================================================================
+STRUCTURE: Options / Worker
+================================================================================
+*/
+
+typedef struct {
+    const char *host;
+    const char *port;
+    int         connections;
+    double      rate;               // Requests per second in all; 0 = closed loop
+    double      duration;           // Seconds measured
+    double      warmup;             // Seconds run first, not measured
+    int         weights[OP_COUNT];
+    int         minSize;            // KB
+    int         maxSize;
+    const char *algorithm;
+    int         keepAlive;
+    int         maxLive;
+    const char *hdrPath;            // NULL: no percentile file
+} Options;
+
+typedef struct {
+    const Options *options;
+    int            index;
+    uint64_t       random;
+
+    int            fd;              // -1 while not connected
+    char          *buffer;          // Response bytes
+    size_t         capacity;
+    size_t         filled;
+
+    int           *live;            // PIDs this connection allocated
+    int            liveCount;
+
+    Histogram      latency[OP_COUNT];   // From due time (open loop) or send time
+    Histogram      service;             // From the actual send, all operations
+    uint64_t       ok[OP_COUNT];
+    uint64_t       rejected[OP_COUNT];  // 4xx: no room, no such process
+    uint64_t       errors;              // Connection lost, 5xx, unparsable
+    uint64_t       late;                // Open loop: sent after their due time
+    uint64_t       lastAnswer;          // us; the run can outlast --duration
+} Worker;
+
+static struct timespec startTime;
+
+
+/*
+--------------------------------------------------------------------------------
+HELPERS: nowUs / sleepUntilUs / nextRandom
+--------------------------------------------------------------------------------
+*/
+
+// Microseconds since the run started (CLOCK_MONOTONIC)
+static uint64_t nowUs(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t us = (int64_t)(now.tv_sec - startTime.tv_sec) * 1000000LL +
+                 (now.tv_nsec - startTime.tv_nsec) / 1000;
+    return (uint64_t)us;
+}
+
+static void sleepUntilUs(uint64_t due) {
+#ifdef TIMER_ABSTIME
+    struct timespec wake = startTime;
+    wake.tv_sec += (time_t)(due / 1000000ULL);
+    wake.tv_nsec += (long)(due % 1000000ULL) * 1000L;
+    if (wake.tv_nsec >= 1000000000L) {
+        wake.tv_sec++;
+        wake.tv_nsec -= 1000000000L;
+    }
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL) == EINTR) {
+    }
+#else
+    // No clock_nanosleep (macOS): sleep the remaining time, look again
+    uint64_t now;
+    while ((now = nowUs()) < due) {
+        uint64_t left = due - now;
+        struct timespec pause = { (time_t)(left / 1000000ULL), (long)(left % 1000000ULL) * 1000L };
+        nanosleep(&pause, NULL);
+    }
+#endif
+}
+
+// xorshift64*: cheap, per thread, good enough to pick operations
+static uint64_t nextRandom(Worker *w) {
+    w->random ^= w->random >> 12;
+    w->random ^= w->random << 25;
+    w->random ^= w->random >> 27;
+    return w->random * 2685821657736338717ULL;
+}
+
+
+/*
+================================================================================
+FUNCTION: connectServer
+================================================================================
+*/
+
+static int connectServer(const Options *options) {
+
+    struct addrinfo hints;
+    struct addrinfo *found;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(options->host, options->port, &hints, &found) != 0) {
+        return -1;
+    }
+    int fd = -1;
+    for (struct addrinfo *a = found; a != NULL && fd < 0; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd >= 0 && connect(fd, a->ai_addr, a->ai_addrlen) < 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(found);
+    if (fd >= 0) {
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+    return fd;
+}
+
+
+/*
+================================================================================
+FUNCTION: exchange
+================================================================================
+PURPOSE: One HTTP request and its whole response on the worker's
+         connection (connecting first if there is none)
+
+ALGORITHM:
+1. Send the request in one send()
+2. Read until the blank line after the headers, take Content-Length
+3. Read until the body is complete; a "Connection: close" answer (or
+   --close) closes our side too
+
+RETURNS: The status code (body in w->buffer, NUL-terminated at
+         w->buffer + *bodyStart), or -1 on a connection error
+*/
+
+static int exchange(Worker *w, const char *request, int length, size_t *bodyStart) {
+
+    if (w->fd < 0) {
+        w->fd = connectServer(w->options);
+        if (w->fd < 0) {
+            return -1;
+        }
+    }
+
+    // STEP 1: Send
+    for (int sent = 0; sent < length; ) {
+        ssize_t n = send(w->fd, request + sent, length - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            close(w->fd);
+            w->fd = -1;
+            return -1;
+        }
+        sent += (int)n;
+    }
+
+    // STEP 2 + 3: Headers, then the body they announce
+    w->filled = 0;
+    size_t headerEnd = 0;
+    size_t total = 0;
+    while (headerEnd == 0 || w->filled < total) {
+        if (w->filled + 4096 + 1 > w->capacity) {
+            size_t capacity = w->capacity * 2;
+            char *grown = (char*)realloc(w->buffer, capacity);
+            if (grown == NULL) {
+                break;
+            }
+            w->buffer = grown;
+            w->capacity = capacity;
+        }
+        ssize_t n = read(w->fd, w->buffer + w->filled, w->capacity - w->filled - 1);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        w->filled += (size_t)n;
+        w->buffer[w->filled] = '\0';
+        if (headerEnd == 0) {
+            char *blank = strstr(w->buffer, "\r\n\r\n");
+            if (blank == NULL) {
+                continue;
+            }
+            headerEnd = (size_t)(blank - w->buffer) + 4;
+            const char *field = strstr(w->buffer, "Content-Length:");
+            long bodyLength = field != NULL && field < blank ? strtol(field + 15, NULL, 10) : 0;
+            total = headerEnd + (size_t)(bodyLength > 0 ? bodyLength : 0);
+        }
+    }
+    if (headerEnd == 0 || w->filled < total) {
+        close(w->fd);
+        w->fd = -1;
+        return -1;
+    }
+    w->buffer[total] = '\0';
+
+    int status = 0;
+    if (sscanf(w->buffer, "HTTP/1.%*d %d", &status) != 1) {
+        status = -1;
+    }
+    const char *connection = strstr(w->buffer, "Connection: close");
+    if (!w->options->keepAlive || (connection != NULL && connection < w->buffer + headerEnd)) {
+        close(w->fd);
+        w->fd = -1;
+    }
+    *bodyStart = headerEnd;
+    return status;
+}
+
+
+/*
+================================================================================
+FUNCTION: runOne
+================================================================================
+PURPOSE: Pick the next operation from the mix, perform it, classify the
+         answer
+
+A deallocate needs a PID this connection allocated; with none live it
+becomes an allocate, and an allocate with --max-live PIDs live becomes a
+deallocate, so the heap neither runs empty of work nor fills up with
+one connection's leftovers.
+
+RETURNS: The operation performed, its outcome in *status (HTTP status,
+         -1 = connection error)
+*/
+
+static Operation pickOperation(Worker *w) {
+    const Options *o = w->options;
+    int sum = 0;
+    for (int i = 0; i < OP_COUNT; i++) {
+        sum += o->weights[i];
+    }
+    int roll = (int)(nextRandom(w) % (uint64_t)sum);
+    Operation op = OP_ALLOCATE;
+    for (int i = 0; i < OP_COUNT; i++) {
+        if (roll < o->weights[i]) {
+            op = (Operation)i;
+            break;
+        }
+        roll -= o->weights[i];
+    }
+    if (op == OP_DEALLOCATE && w->liveCount == 0) {
+        op = OP_ALLOCATE;
+    } else if (op == OP_ALLOCATE && w->liveCount == o->maxLive) {
+        op = OP_DEALLOCATE;
+    }
+    return op;
+}
+
+static Operation runOne(Worker *w, int *status) {
+
+    const Options *o = w->options;
+    Operation op = pickOperation(w);
+    const char *connection = o->keepAlive ? "keep-alive" : "close";
+    char request[512];
+    char body[128];
+    int length;
+    int slot = 0;
+
+    switch (op) {
+    case OP_ALLOCATE: {
+        int size = o->minSize + (int)(nextRandom(w) % (uint64_t)(o->maxSize - o->minSize + 1));
+        int bodyLength = snprintf(body, sizeof(body), "{\"size\":%d,\"algorithm\":\"%s\"}",
+                                  size, o->algorithm);
+        length = snprintf(request, sizeof(request),
+            "POST /api/allocate HTTP/1.1\r\nHost: %s\r\nConnection: %s\r\n"
+            "Content-Type: application/json\r\nContent-Length: %d\r\n\r\n%s",
+            o->host, connection, bodyLength, body);
+        break;
+    }
+    case OP_DEALLOCATE: {
+        slot = (int)(nextRandom(w) % (uint64_t)w->liveCount);
+        int bodyLength = snprintf(body, sizeof(body), "{\"processId\":%d}", w->live[slot]);
+        length = snprintf(request, sizeof(request),
+            "POST /api/deallocate HTTP/1.1\r\nHost: %s\r\nConnection: %s\r\n"
+            "Content-Type: application/json\r\nContent-Length: %d\r\n\r\n%s",
+            o->host, connection, bodyLength, body);
+        break;
+    }
+    default:
+        length = snprintf(request, sizeof(request),
+            "GET /api/%s HTTP/1.1\r\nHost: %s\r\nConnection: %s\r\n\r\n",
+            op == OP_STATS ? "stats" : "blocks", o->host, connection);
+        break;
+    }
+
+    size_t bodyStart = 0;
+    *status = exchange(w, request, length, &bodyStart);
+
+    // Keep track of our processes
+    if (op == OP_ALLOCATE && *status == 200) {
+        const char *pid = strstr(w->buffer + bodyStart, "\"processId\":\"P");
+        if (pid != NULL && w->liveCount < o->maxLive) {
+            w->live[w->liveCount++] = atoi(pid + 14);
+        }
+    } else if (op == OP_DEALLOCATE && *status >= 0) {
+        // Freed or gone (reset by someone else): either way not ours now
+        w->live[slot] = w->live[--w->liveCount];
+    }
+    return op;
+}
+
+
+/*
+================================================================================
+FUNCTION: workerThread
+================================================================================
+ALGORITHM:
+CLOSED LOOP: send, wait for the answer, send the next one.
+             latency = answer - send
+OPEN LOOP:   request k of this connection is due at
+             warm-up start + k / (rate / connections), staggered between
+             connections. Sleep until it is due (if early), send it.
+             latency = answer - DUE time: when the server falls behind,
+             the backlog it caused is part of every later latency, as a
+             real client arriving on schedule would see it
+*/
+
+static void* workerThread(void *arg) {
+
+    Worker *w = (Worker*)arg;
+    const Options *o = w->options;
+    uint64_t measureFrom = (uint64_t)(o->warmup * 1e6);
+    uint64_t end = measureFrom + (uint64_t)(o->duration * 1e6);
+    double interval = o->rate > 0 ? 1e6 * o->connections / o->rate : 0;
+    double due = interval * w->index / o->connections;
+
+    while (1) {
+        uint64_t sendAt;
+        uint64_t from;
+        int late = 0;
+        if (interval > 0) {
+            if ((uint64_t)due >= end) {
+                break;
+            }
+            uint64_t now = nowUs();
+            if (now < (uint64_t)due) {
+                sleepUntilUs((uint64_t)due);
+                now = nowUs();
+            } else if (now > (uint64_t)due + 1000) {
+                late = 1;
+            }
+            sendAt = now;
+            from = (uint64_t)due;
+            due += interval;
+        } else {
+            sendAt = nowUs();
+            if (sendAt >= end) {
+                break;
+            }
+            from = sendAt;
+        }
+
+        int status;
+        Operation op = runOne(w, &status);
+        uint64_t answered = nowUs();
+
+        if (from < measureFrom) {
+            continue;       // Warm-up
+        }
+        w->late += late;
+        w->lastAnswer = answered;
+        if (status >= 200 && status < 300) {
+            w->ok[op]++;
+        } else if (status >= 400 && status < 500) {
+            w->rejected[op]++;
+        } else {
+            w->errors++;
+            if (status < 0 && o->keepAlive) {
+                struct timespec pause = { 0, 10 * 1000000L };   // Server gone? Do not spin
+                nanosleep(&pause, NULL);
+            }
+            continue;
+        }
+        hdrRecord(&w->latency[op], answered - from);
+        hdrRecord(&w->service, answered - sendAt);
+    }
+    return NULL;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: releaseLive
+--------------------------------------------------------------------------------
+PURPOSE: Free what the run left allocated (not measured), so the next
+         run starts from the same heap
+*/
+
+static void releaseLive(Worker *w) {
+    char request[256];
+    char body[64];
+    size_t bodyStart;
+    while (w->liveCount > 0) {
+        int bodyLength = snprintf(body, sizeof(body), "{\"processId\":%d}",
+                                  w->live[--w->liveCount]);
+        int length = snprintf(request, sizeof(request),
+            "POST /api/deallocate HTTP/1.1\r\nHost: %s\r\n"
+            "Content-Type: application/json\r\nContent-Length: %d\r\n\r\n%s",
+            w->options->host, bodyLength, body);
+        if (exchange(w, request, length, &bodyStart) < 0) {
+            break;
+        }
+    }
+}
+
+
+/*
+================================================================================
+FUNCTION: printReport
+================================================================================
+*/
+
+static void printRow(const char *name, const Histogram *h, uint64_t ok, uint64_t rejected) {
+    printf("  %-11s %9llu %9llu %8.3f %8.3f %8.3f %8.3f %8.3f %9.3f\n", name,
+           (unsigned long long)ok, (unsigned long long)rejected,
+           h->total ? h->sum / h->total / 1000.0 : 0.0,
+           hdrPercentile(h, 50) / 1000.0, hdrPercentile(h, 90) / 1000.0,
+           hdrPercentile(h, 99) / 1000.0, hdrPercentile(h, 99.9) / 1000.0,
+           h->max / 1000.0);
+}
+
+// HdrHistogram's percentile text format (what its plotter reads)
+static int writePercentiles(const char *path, const Histogram *h) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        return -1;
+    }
+    fprintf(file, "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount",
+            "1/(1-Percentile)");
+    uint64_t seen = 0;
+    for (int i = 0; i < HDR_BUCKETS && seen < h->total; i++) {
+        if (h->counts[i] == 0) {
+            continue;
+        }
+        seen += h->counts[i];
+        double fraction = (double)seen / (double)h->total;
+        uint64_t value = hdrHighest(i) < h->max ? hdrHighest(i) : h->max;
+        if (seen < h->total) {
+            fprintf(file, "%12.3f %14.12f %10llu %14.2f\n", value / 1000.0, fraction,
+                    (unsigned long long)seen, 1.0 / (1.0 - fraction));
+        } else {
+            fprintf(file, "%12.3f %14.12f %10llu\n", value / 1000.0, fraction,
+                    (unsigned long long)seen);
+        }
+    }
+    double mean = h->total ? h->sum / h->total : 0;
+    double variance = h->total ? h->sumSquares / h->total - mean * mean : 0;
+    fprintf(file, "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n",
+            mean / 1000.0, variance > 0 ? sqrt(variance) / 1000.0 : 0.0);
+    fprintf(file, "#[Max     = %12.3f, Total count    = %12llu]\n",
+            h->max / 1000.0, (unsigned long long)h->total);
+    fclose(file);
+    return 0;
+}
+
+static void printReport(const Options *o, Worker *workers) {
+
+    static Histogram latency[OP_COUNT];
+    static Histogram all;
+    static Histogram service;
+    uint64_t ok[OP_COUNT] = { 0 };
+    uint64_t rejected[OP_COUNT] = { 0 };
+    uint64_t errors = 0;
+    uint64_t late = 0;
+    uint64_t lastAnswer = 0;
+
+    for (int c = 0; c < o->connections; c++) {
+        for (int i = 0; i < OP_COUNT; i++) {
+            hdrMerge(&latency[i], &workers[c].latency[i]);
+            hdrMerge(&all, &workers[c].latency[i]);
+            ok[i] += workers[c].ok[i];
+            rejected[i] += workers[c].rejected[i];
+        }
+        hdrMerge(&service, &workers[c].service);
+        errors += workers[c].errors;
+        late += workers[c].late;
+        if (workers[c].lastAnswer > lastAnswer) {
+            lastAnswer = workers[c].lastAnswer;
+        }
+    }
+
+    // Open loop behind schedule: the last due requests are answered late
+    double seconds = lastAnswer / 1e6 - o->warmup;
+    if (seconds < o->duration) {
+        seconds = o->duration;
+    }
+    uint64_t answered = all.total;
+    printf("\n  %llu requests in %.1f s: %.0f requests/s",
+           (unsigned long long)answered, seconds, answered / seconds);
+    if (o->rate > 0) {
+        printf(" (%.0f/s asked for)", o->rate);
+    }
+    printf(", %llu errors\n\n", (unsigned long long)errors);
+
+    printf("  %-11s %9s %9s %8s %8s %8s %8s %8s %9s\n", "(ms)", "ok", "rejected",
+           "mean", "p50", "p90", "p99", "p99.9", "max");
+    for (int i = 0; i < OP_COUNT; i++) {
+        if (o->weights[i] > 0 || latency[i].total > 0) {
+            printRow(opNames[i], &latency[i], ok[i], rejected[i]);
+        }
+    }
+    uint64_t okAll = 0;
+    uint64_t rejectedAll = 0;
+    for (int i = 0; i < OP_COUNT; i++) {
+        okAll += ok[i];
+        rejectedAll += rejected[i];
+    }
+    printRow("all", &all, okAll, rejectedAll);
+
+    printf("\n  Latency distribution%s\n",
+           o->rate > 0 ? " (from the due time: coordinated omission corrected)" : "");
+    static const double marks[] = { 50, 75, 90, 99, 99.9, 99.99, 99.999, 100 };
+    for (int i = 0; i < (int)(sizeof(marks) / sizeof(marks[0])); i++) {
+        printf("  %8.3f%%  %10.3f ms\n", marks[i], hdrPercentile(&all, marks[i]) / 1000.0);
+    }
+    if (o->rate > 0) {
+        printf("\n  Service time only (from the actual send): p50 %.3f ms, p99 %.3f ms, "
+               "max %.3f ms\n", hdrPercentile(&service, 50) / 1000.0,
+               hdrPercentile(&service, 99) / 1000.0, service.max / 1000.0);
+        if (late > 0) {
+            printf("  %llu requests went out more than 1 ms after they were due: the "
+                   "server (or this machine) did not keep up\n", (unsigned long long)late);
+        }
+    }
+    if (o->hdrPath != NULL) {
+        if (writePercentiles(o->hdrPath, &all) == 0) {
+            printf("\n  Percentile spectrum written to %s\n", o->hdrPath);
+        } else {
+            fprintf(stderr, "Error: Could not write %s\n", o->hdrPath);
+        }
+    }
+}
+
+
+/*
+================================================================================
+FUNCTION: parseOptions
+================================================================================
+*/
+
+static void printUsage(const char *program) {
+    fprintf(stderr,
+        "Usage: %s [--host HOST] [--port PORT] [--connections N] [--rate R]\n"
+        "          [--duration S] [--warmup S] [--mix OP=W,...] [--size MIN-MAX]\n"
+        "          [--algorithm first_fit|best_fit|worst_fit] [--max-live N]\n"
+        "          [--close] [--hdr FILE]\n"
+        "  --connections  Connections, one thread each (default: 8)\n"
+        "  --rate         Open loop: requests per second in all (default: closed loop)\n"
+        "  --duration     Seconds measured (default: 10), after --warmup (default: 1)\n"
+        "  --mix          Weights of allocate, deallocate, stats, blocks\n"
+        "                 (default: allocate=45,deallocate=45,stats=8,blocks=2)\n"
+        "  --size         Allocation sizes in KB, uniform (default: 1-64)\n"
+        "  --max-live     Processes one connection keeps at most (default: %d)\n"
+        "  --close        A new connection per request instead of keep-alive\n"
+        "  --hdr          Write the latency percentile spectrum to FILE\n",
+        program, DEFAULT_MAX_LIVE);
+}
+
+static int parseMix(const char *text, int *weights) {
+    memset(weights, 0, OP_COUNT * sizeof(int));
+    const char *p = text;
+    while (*p != '\0') {
+        int found = 0;
+        for (int i = 0; i < OP_COUNT; i++) {
+            size_t n = strlen(opNames[i]);
+            if (strncmp(p, opNames[i], n) == 0 && p[n] == '=') {
+                char *after;
+                weights[i] = (int)strtol(p + n + 1, &after, 10);
+                if (weights[i] < 0 || after == p + n + 1) {
+                    return 0;
+                }
+                p = *after == ',' ? after + 1 : after;
+                found = 1;
+                break;
+            }
+        }
+        if (!found) {
+            return 0;
+        }
+    }
+    return weights[OP_ALLOCATE] + weights[OP_DEALLOCATE] + weights[OP_STATS] +
+           weights[OP_BLOCKS] > 0;
+}
+
+static int parseOptions(int argc, char *argv[], Options *o) {
+
+    memset(o, 0, sizeof(*o));
+    o->host = "127.0.0.1";
+    o->port = "8080";
+    o->connections = 8;
+    o->duration = 10;
+    o->warmup = 1;
+    parseMix("allocate=45,deallocate=45,stats=8,blocks=2", o->weights);
+    o->minSize = 1;
+    o->maxSize = 64;
+    o->algorithm = "first_fit";
+    o->keepAlive = 1;
+    o->maxLive = DEFAULT_MAX_LIVE;
+
+    for (int i = 1; i < argc; i++) {
+        const char *option = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(option, "--close") == 0) {
+            o->keepAlive = 0;
+            continue;
+        }
+        if (value == NULL) {
+            return 0;
+        }
+        i++;
+        if (strcmp(option, "--host") == 0) {
+            o->host = value;
+        } else if (strcmp(option, "--port") == 0) {
+            o->port = value;
+        } else if (strcmp(option, "--connections") == 0) {
+            o->connections = atoi(value);
+        } else if (strcmp(option, "--rate") == 0) {
+            o->rate = atof(value);
+        } else if (strcmp(option, "--duration") == 0) {
+            o->duration = atof(value);
+        } else if (strcmp(option, "--warmup") == 0) {
+            o->warmup = atof(value);
+        } else if (strcmp(option, "--mix") == 0) {
+            if (!parseMix(value, o->weights)) {
+                fprintf(stderr, "Error: --mix needs OP=WEIGHT pairs, e.g. allocate=1,stats=1\n");
+                return 0;
+            }
+        } else if (strcmp(option, "--size") == 0) {
+            if (sscanf(value, "%d-%d", &o->minSize, &o->maxSize) != 2) {
+                o->minSize = o->maxSize = atoi(value);
+            }
+        } else if (strcmp(option, "--algorithm") == 0) {
+            o->algorithm = value;
+        } else if (strcmp(option, "--max-live") == 0) {
+            o->maxLive = atoi(value);
+        } else if (strcmp(option, "--hdr") == 0) {
+            o->hdrPath = value;
+        } else {
+            return 0;
+        }
+    }
+
+    if (o->connections <= 0 || o->connections > MAX_CONNECTIONS || o->rate < 0 ||
+        o->duration <= 0 || o->warmup < 0 || o->minSize <= 0 || o->maxSize < o->minSize ||
+        o->maxLive <= 0) {
+        fprintf(stderr, "Error: Out-of-range option (connections 1..%d, sizes > 0)\n",
+                MAX_CONNECTIONS);
+        return 0;
+    }
+    return 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: main
+================================================================================
+ALGORITHM:
+1. Options; check the server answers at all
+2. One thread per connection, all started from the same clock
+3. Join, free what is left allocated, merge and print
+*/
+
+int main(int argc, char *argv[]) {
+
+    // STEP 1: Options, server there?
+    Options options;
+    if (!parseOptions(argc, argv, &options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);       // A server that hangs up is an error, not an exit
+    int probe = connectServer(&options);
+    if (probe < 0) {
+        fprintf(stderr, "Error: No server on %s:%s (start one with --server)\n",
+                options.host, options.port);
+        return 1;
+    }
+    close(probe);
+
+    printf("%s loop, %d connections (%s), %.1f s + %.1f s warm-up against %s:%s\n",
+           options.rate > 0 ? "Open" : "Closed", options.connections,
+           options.keepAlive ? "keep-alive" : "one per request",
+           options.duration, options.warmup, options.host, options.port);
+    if (options.rate > 0) {
+        printf("Arrival rate %.0f requests/s (%.1f per connection)\n",
+               options.rate, options.rate / options.connections);
+    }
+    printf("Mix: allocate %d, deallocate %d, stats %d, blocks %d; sizes %d-%d KB %s\n",
+           options.weights[OP_ALLOCATE], options.weights[OP_DEALLOCATE],
+           options.weights[OP_STATS], options.weights[OP_BLOCKS],
+           options.minSize, options.maxSize, options.algorithm);
+    fflush(stdout);
+
+    // STEP 2: Workers (histograms are large: on the heap, zeroed)
+    Worker *workers = (Worker*)calloc(options.connections, sizeof(Worker));
+    pthread_t *threads = (pthread_t*)calloc(options.connections, sizeof(pthread_t));
+    if (workers == NULL || threads == NULL) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    int started = 0;
+    for (int c = 0; c < options.connections; c++) {
+        Worker *w = &workers[c];
+        w->options = &options;
+        w->index = c;
+        w->random = 0x9E3779B97F4A7C15ULL * (uint64_t)(c + 1);
+        w->fd = -1;
+        w->capacity = 64 * 1024;
+        w->buffer = (char*)malloc(w->capacity);
+        w->live = (int*)malloc(options.maxLive * sizeof(int));
+        if (w->buffer == NULL || w->live == NULL ||
+            pthread_create(&threads[c], NULL, workerThread, w) != 0) {
+            fprintf(stderr, "Error: Could not start connection %d\n", c);
+            break;
+        }
+        started++;
+    }
+
+    // STEP 3: Collect
+    for (int c = 0; c < started; c++) {
+        pthread_join(threads[c], NULL);
+        releaseLive(&workers[c]);
+        if (workers[c].fd >= 0) {
+            close(workers[c].fd);
+        }
+    }
+    options.connections = started;
+    printReport(&options, workers);
+
+    for (int c = 0; c < started; c++) {
+        free(workers[c].buffer);
+        free(workers[c].live);
+    }
+    free(workers);
+    free(threads);
+    return started > 0 ? 0 : 1;
+}
+
+
+/*
+================================================================================
+END OF FILE: load_generator.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. Histogram - HDR-style log-linear latency buckets, merge, percentiles
+2. connectServer() / exchange() - Keep-alive HTTP/1.1 client, Content-Length
+   framing, reconnect after close
+3. runOne() - Weighted operation mix, PIDs tracked per connection
+4. workerThread() - Closed loop, or open loop timed from the due time
+   (coordinated omission corrected)
+5. printReport() / writePercentiles() - Per-operation table, latency
+   distribution, HdrHistogram percentile file
+6. main() - One thread per connection, cleanup of leftover processes
+================================================================================
+*/
@@ -0,0 +1,164 @@
+/*
+================================================================================
+FILE: shm_watcher.c
+PURPOSE: Example monitor for the server's shared-memory export
+DESCRIPTION:
+    - Prints one line of counters and a memory map whenever the server's
+      state changes, by polling the export's version number
+    - Never talks to the server: no HTTP request, no system call per
+      look (only the sleep between looks)
+    - Build and run (next to ./build/memory_visualizer --server --shm-export):
+      gcc -O2 -I include -o build/shm_watcher examples/shm_watcher.c src/shm_reader.c
+      ./build/shm_watcher                     → Watch until Ctrl+C
+      ./build/shm_watcher --once              → Print the current state, exit
+      ./build/shm_watcher --name /other --interval 10
+================================================================================
+*/
+
+#include <stdio.h>          // printf, fprintf
+#include <stdlib.h>         // atoi, malloc
+#include <string.h>         // strcmp, memset
+#include <time.h>           // nanosleep, clock_gettime
+#include "../include/shm_reader.h"
+
+
+// Width of the memory map in characters
+#define MAP_WIDTH 64
+
+static const char *modeNames[] = { "list", "buddy", "paged", "tags" };
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: drawMap
+--------------------------------------------------------------------------------
+PURPOSE: One character per 1/MAP_WIDTH of user memory: '.' free, a digit
+         (PID mod 10) for the process at the middle of that slice
+
+[11111....2222222.....333...................4444.................]
+*/
+
+static void drawMap(const ShmExportCounters *counters, const ShmExportBlock *blocks,
+                    int rows, char *map) {
+    int row = 0;
+    for (int column = 0; column < MAP_WIDTH; column++) {
+        long long address = counters->osMemory +
+            ((long long)counters->userMemory * (2 * column + 1)) / (2 * MAP_WIDTH);
+        while (row < rows && blocks[row].startAddress + blocks[row].size <= address) {
+            row++;
+        }
+        if (row < rows && blocks[row].startAddress <= address && !blocks[row].isHole) {
+            map[column] = (char)('0' + blocks[row].processId % 10);
+        } else {
+            map[column] = '.';
+        }
+    }
+    map[MAP_WIDTH] = '\0';
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: printState
+--------------------------------------------------------------------------------
+*/
+
+static int printState(const ShmReader *reader, ShmExportBlock *blocks) {
+    ShmExportCounters counters;
+    uint64_t version;
+    int rows = shmReaderRead(reader, &counters, blocks, SHM_EXPORT_MAX_BLOCKS, &version);
+    if (rows < 0) {
+        fprintf(stderr, "The server stopped in the middle of a publication\n");
+        return -1;
+    }
+
+    char map[MAP_WIDTH + 1];
+    drawMap(&counters, blocks, rows, map);
+    const char *mode = counters.mode >= 0 && counters.mode <= SHM_MODE_TAGS
+        ? modeNames[counters.mode] : "?";
+    printf("v%-7llu %-5s free %6d/%-6d KB  procs %4d  holes %4d  "
+           "largest %6d KB  frag %5.1f%%  compactions %d\n",
+           (unsigned long long)version, mode, counters.freeMemory, counters.userMemory,
+           counters.numProcesses, counters.numHoles, counters.largestHole,
+           counters.fragmentation, counters.totalCompactions);
+    printf("         [%s]\n", map);
+    fflush(stdout);
+    return 0;
+}
+
+
+/*
+================================================================================
+FUNCTION: main
+================================================================================
+ALGORITHM:
+1. Map the export
+2. Every interval: read the version (one load); changed → copy and print
+*/
+
+int main(int argc, char *argv[]) {
+
+    const char *name = SHM_EXPORT_DEFAULT_NAME;
+    int intervalMs = 100;
+    int once = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+            intervalMs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--once") == 0) {
+            once = 1;
+        } else {
+            fprintf(stderr, "Usage: %s [--name SHM_NAME] [--interval MS] [--once]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (intervalMs <= 0) {
+        intervalMs = 100;
+    }
+
+    // STEP 1: Map
+    ShmReader reader;
+    if (shmReaderOpen(&reader, name) < 0) {
+        fprintf(stderr, "No export %s (start the server with --shm-export)\n", name);
+        return 1;
+    }
+    ShmExportBlock *blocks = (ShmExportBlock*)malloc(SHM_EXPORT_MAX_BLOCKS * sizeof(ShmExportBlock));
+    if (blocks == NULL) {
+        return 1;
+    }
+
+    // STEP 2: Poll
+    uint64_t shown = 0;
+    struct timespec nap = { intervalMs / 1000, (intervalMs % 1000) * 1000000L };
+    while (1) {
+        uint64_t version = shmReaderVersion(&reader);
+        if (version != shown || once) {
+            if (printState(&reader, blocks) < 0) {
+                return 1;
+            }
+            shown = version;
+            if (once) {
+                break;
+            }
+        }
+        nanosleep(&nap, NULL);
+    }
+
+    shmReaderClose(&reader);
+    free(blocks);
+    return 0;
+}
+
+
+/*
+================================================================================
+END OF FILE: shm_watcher.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. drawMap() - Memory map from the exported rows
+2. printState() - One consistent copy, printed as two lines
+3. main() - Version polling loop
+================================================================================
+*/
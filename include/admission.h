@@ -0,0 +1,149 @@
+/*
+================================================================================
+FILE: admission.h
+PURPOSE: Admission queue for allocations that do not fit yet
+DESCRIPTION:
+    - Without it, an allocation that finds no hole is simply rejected
+    - Like an OS long-term scheduler, a request may instead WAIT (with a
+      timeout) until a free or a compaction makes room
+    - Policies decide who gets in first when room appears:
+        FCFS        - strictly in arrival order (the head blocks the rest)
+        SJF         - smallest request first
+        FIRST_FIT   - the oldest request that fits
+    - Waiters are indexed by size class (power of 2), so after a free only
+      the classes up to the largest hole are looked at, never the whole
+      queue
+================================================================================
+*/
+
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include <pthread.h>             // pthread_cond_t, pthread_mutex_t
+#include "memory_structures.h"   // MemoryManager
+#include "memory_manager.h"      // AllocationAlgorithm
+
+
+// Size classes: class k holds requests of 2^k .. 2^(k+1)-1 KB
+#define ADMIT_CLASSES 32
+
+
+typedef enum {
+    ADMIT_FCFS,
+    ADMIT_SJF,
+    ADMIT_FIRST_FIT
+} AdmissionPolicy;
+
+typedef enum {
+    WAITER_QUEUED,
+    WAITER_ADMITTED,
+    WAITER_TIMED_OUT
+} WaiterState;
+
+
+/*
+================================================================================
+STRUCTURE: AdmissionWaiter
+================================================================================
+PURPOSE: One waiting allocation. It lives on the waiting thread's stack;
+         the queue only links it in.
+
+When room appears, admissionWake() allocates on the waiter's behalf
+(so nobody can take the hole in between), stores the start address and
+signals 'admitted'.
+*/
+
+typedef struct AdmissionWaiter {
+    int                     processID;
+    int                     sizeKB;
+    AllocationAlgorithm     algorithm;
+    long long               seq;            // Arrival order
+    long long               enqueuedNs;
+    int                     state;          // WaiterState
+    int                     startAddress;   // Valid once admitted
+    pthread_cond_t          admitted;
+    struct AdmissionWaiter *prev, *next;    // Within the size class
+} AdmissionWaiter;
+
+
+/*
+================================================================================
+STRUCTURE: AdmissionQueue
+================================================================================
+EXAMPLE (FIRST_FIT, largest hole = 40 KB after a free):
+class 2 (4-7 KB):   [P12 6 KB, seq 9]
+class 5 (32-63 KB): [P8 48 KB, seq 3] → [P10 36 KB, seq 7]
+class 7:            [P5 200 KB, seq 1]   ← never looked at (class > 5)
+Candidates: P12 (head of class 2) and P10 (first in class 5 that fits);
+the older one, P10, is admitted; then the hole is measured again.
+*/
+
+typedef struct AdmissionQueue {
+    AdmissionPolicy  policy;
+    AdmissionWaiter *head[ADMIT_CLASSES];   // FIFO per size class
+    AdmissionWaiter *tail[ADMIT_CLASSES];
+    int              length;
+    long long        nextSeq;
+    long long        enqueued;
+    long long        admitted;
+    long long        timedOut;
+    int              maxLength;
+    double           totalWaitMs;           // Over admitted waiters
+    double           maxWaitMs;
+} AdmissionQueue;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: setAdmissionPolicy
+--------------------------------------------------------------------------------
+PURPOSE: Create the queue (first call) and pick the policy; waiting
+         requests stay queued under the new policy
+
+RETURNS: 1 on success, 0 when out of memory
+*/
+int setAdmissionPolicy(MemoryManager *mm, AdmissionPolicy policy);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: admissionWait
+--------------------------------------------------------------------------------
+PURPOSE: Queue a request that just failed and block until it is admitted
+         or timeoutMs passes
+
+'lock' is the mutex that guards mm; the caller holds it. It is released
+while waiting (so frees can happen) and held again on return.
+
+RETURNS: Start address once admitted, -1 on timeout
+*/
+int admissionWait(MemoryManager *mm, int processID, int sizeKB,
+                  AllocationAlgorithm algorithm, int timeoutMs,
+                  pthread_mutex_t *lock, double *waitedMs);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: admissionWake
+--------------------------------------------------------------------------------
+PURPOSE: After a state change, admit every waiter that now fits, in
+         policy order
+
+The caller holds the lock that guards mm.
+
+RETURNS: Number of waiters admitted
+*/
+int admissionWake(MemoryManager *mm);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: admissionToJSON
+--------------------------------------------------------------------------------
+PURPOSE: Policy, queue length, admissions, timeouts and waiting times
+         ("null" when no request ever waited)
+*/
+void admissionToJSON(const AdmissionQueue *queue, char *buffer, int bufferSize);
+
+
+#endif /* ADMISSION_H */
@@ -0,0 +1,182 @@
+/*
+================================================================================
+FILE: boundary_tag.h
+PURPOSE: Boundary-tag allocator with its metadata inside the backing region
+DESCRIPTION:
+    - Every block starts with a HEADER and ends with a FOOTER, written into
+      the real bytes of the backing region (no malloc'd MemoryBlock nodes)
+    - Walking the heap means jumping from header to header by size
+      ("implicit free list")
+    - Freeing coalesces with BOTH neighbours in O(1): the next block's
+      header is right after ours, the previous block's footer right before
+    - Can run as an allocation mode of the MemoryManager (block list
+      unused) and be compared with the list engine on one operation stream
+================================================================================
+*/
+
+#ifndef BOUNDARY_TAG_H
+#define BOUNDARY_TAG_H
+
+#include <stddef.h>              // size_t
+#include <stdint.h>              // uint32_t, int32_t
+#include "memory_structures.h"   // MemoryManager
+
+
+/*
+================================================================================
+STRUCTURE: BoundaryTag
+================================================================================
+PURPOSE: The 8-byte header (and identical footer) of every block
+
+LAYOUT OF ONE BLOCK (sizes are multiples of 16 bytes):
+
+   offset o                                               o + size
+   | header (8) |       payload (size - 16)       | footer (8) |
+
+sizeAndFree: block size in bytes; bit 0 = 1 if the block is free
+             (sizes are multiples of 16, so the low bits are spare)
+processID:   owner PID, -1 when free
+*/
+
+typedef struct {
+    uint32_t sizeAndFree;
+    int32_t  processID;
+} BoundaryTag;
+
+#define BT_TAG_SIZE   8         // sizeof(BoundaryTag)
+#define BT_OVERHEAD   16        // header + footer
+#define BT_ALIGN      16        // Block sizes and offsets are multiples of 16
+#define BT_MIN_BLOCK  32        // Smallest block worth splitting off
+
+
+/*
+================================================================================
+STRUCTURE: BoundaryTagHeap
+================================================================================
+PURPOSE: A region of real memory managed purely by its tags
+
+The only state outside the region is this small struct of counters.
+headerReads counts tag loads during searches, to compare with the
+number of list nodes the list engine visits.
+*/
+
+typedef struct BoundaryTagHeap {
+    char     *base;             // Start of the managed bytes
+    size_t    size;             // Managed bytes (multiple of BT_ALIGN)
+    size_t    freeBytes;        // Sum of free block sizes (including tags)
+    int       numBlocks;        // Blocks in the heap (used + free)
+    int       numFree;          // Free blocks
+    long long headerReads;      // Tags read while searching
+} BoundaryTagHeap;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: btInit
+--------------------------------------------------------------------------------
+PURPOSE: Turn size bytes at base into one big free block
+
+RETURNS: 0 on success, -1 if base is NULL or the region is too small
+*/
+int btInit(BoundaryTagHeap *heap, void *base, size_t size);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: btAllocate
+--------------------------------------------------------------------------------
+PURPOSE: First fit over the implicit list, split, fill with the PID pattern
+
+RETURNS: Offset of the block's PAYLOAD from base, or -1 if nothing fits
+*/
+long btAllocate(BoundaryTagHeap *heap, int processID, size_t payloadBytes);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: btFree
+--------------------------------------------------------------------------------
+PURPOSE: Free the block whose payload starts at payloadOffset
+
+HOW IT WORKS (O(1), no search):
+1. Header = payloadOffset - 8; mark it free
+2. The next block's header is at o + size: if free, absorb it
+3. The previous block's footer is at o - 8: if free, we are absorbed
+4. Write the merged header and footer
+
+RETURNS: 1 on success, 0 if the offset is not a used block
+*/
+int btFree(BoundaryTagHeap *heap, long payloadOffset);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: btFindProcess
+--------------------------------------------------------------------------------
+PURPOSE: Payload offset of a PID's block (walks the heap), or -1
+*/
+long btFindProcess(BoundaryTagHeap *heap, int processID);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: btLargestFree / btFragmentation
+--------------------------------------------------------------------------------
+PURPOSE: Largest free payload in bytes / external fragmentation percent
+         (same formula as calculateFragmentation)
+*/
+size_t btLargestFree(BoundaryTagHeap *heap);
+float btFragmentation(BoundaryTagHeap *heap);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: btBlocksToJSON
+--------------------------------------------------------------------------------
+PURPOSE: Render the tags as blocks for /api/blocks (KB addresses, rounded)
+*/
+void btBlocksToJSON(BoundaryTagHeap *heap, int osMemory, char *buffer, int bufferSize);
+
+// The same blocks into an array (at most maxBlocks); RETURNS: how many there are
+int btBlocksToArray(BoundaryTagHeap *heap, int osMemory, MemoryBlock *blocks, int maxBlocks);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: convertToBoundaryTags / revertFromBoundaryTags
+--------------------------------------------------------------------------------
+PURPOSE: Switch the MemoryManager between the block list and boundary tags
+
+Processes are re-allocated with the same PIDs. In boundary-tag mode
+mm->head is NULL: the tags in the backing region are the only metadata.
+
+RETURNS: 1 on success, 0 on failure (result JSON explains why)
+*/
+int convertToBoundaryTags(MemoryManager *mm, char *resultBuffer, int bufferSize);
+int revertFromBoundaryTags(MemoryManager *mm, char *resultBuffer, int bufferSize);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: compareMetadataEngines
+--------------------------------------------------------------------------------
+PURPOSE: Replay ONE allocate/free stream on the list engine (first fit)
+         and the boundary-tag engine and compare their metadata
+
+REPORTS PER ENGINE:
+- metadataBytes: list = live MemoryBlock nodes * sizeof(MemoryBlock)
+  (separate malloc'd nodes); tags = blocks * 16 bytes inside the region
+- peak metadata bytes over the run
+- nodesVisited / headerReads during first-fit searches
+- cacheMisses: hardware last-level misses of the whole replay
+  (null when perf counters are unavailable)
+- mean allocation and free latency in ns
+
+RETURNS: 1 on success, 0 on bad parameters
+*/
+int compareMetadataEngines(MemoryManager *mm, int ops, int minSizeKB, int maxSizeKB,
+                           int freePercent, unsigned long long seed,
+                           char *resultBuffer, int bufferSize);
+
+
+#endif /* BOUNDARY_TAG_H */
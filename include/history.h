@@ -0,0 +1,177 @@
+/*
+================================================================================
+FILE: history.h
+PURPOSE: Time-travel through the operation history
+DESCRIPTION:
+    - Every mutation (allocate, free, compact, mode conversions, reset)
+      is appended to an op log: a few integers, never a copy of the state
+    - Every HISTORY_CHECKPOINT_INTERVAL ops the block table is saved as a
+      compact checkpoint (one small entry per block)
+    - The state after op N is rebuilt from the newest checkpoint at or
+      before N, replaying the ops in between on a scratch manager
+    - Replay never runs more than HISTORY_CHECKPOINT_INTERVAL ops, and
+      the log and checkpoints are fixed-size rings: bounded latency and
+      bounded memory
+================================================================================
+*/
+
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stddef.h>              // size_t
+#include "memory_structures.h"   // MemoryManager
+
+
+// Ops kept in the log (older ones fall off the ring)
+#define HISTORY_MAX_OPS 4096
+
+// A checkpoint after this many ops (so at most this many are replayed)
+#define HISTORY_CHECKPOINT_INTERVAL 64
+
+// Checkpoints kept (regular ones plus those forced by mode changes)
+#define HISTORY_MAX_CHECKPOINTS 128
+
+
+/*
+================================================================================
+ENUMERATION: HistoryOpType
+================================================================================
+The first seven are replayed by calling the same memory_manager.c
+function on the scratch manager. The rest change the engine (paged,
+boundary tags, deferred coalescing) or restart it; the state right after
+them is checkpointed instead whenever the block list is active again.
+*/
+
+typedef enum {
+    HISTORY_ALLOCATE,           // a = process ID, b = size KB, c = algorithm
+    HISTORY_DEALLOCATE,         // a = process ID
+    HISTORY_BUDDY_ALLOCATE,     // a = process ID, b = requested size KB
+    HISTORY_BUDDY_DEALLOCATE,   // a = process ID
+    HISTORY_COMPACT,
+    HISTORY_BUDDY_CONVERT,
+    HISTORY_BUDDY_REVERT,
+    HISTORY_RESET,
+    HISTORY_PAGED_CONVERT,      // a = frame size KB
+    HISTORY_PAGED_REVERT,
+    HISTORY_TAGS_CONVERT,
+    HISTORY_TAGS_REVERT,
+    HISTORY_DEFERRED_ENABLE,    // a = maxDeferred, b = interval ms
+    HISTORY_DEFERRED_DISABLE,
+    HISTORY_COALESCE            // a = merges
+} HistoryOpType;
+
+
+/*
+================================================================================
+STRUCTURE: HistoryOp / HistoryEntry / HistoryCheckpoint / History
+================================================================================
+HistoryOp:         One logged mutation (20 bytes)
+HistoryEntry:      One block of a checkpointed block table
+HistoryCheckpoint: The block table plus the counters replay depends on
+                   (processCounter picks buddy PIDs, nextBlockID the
+                   block IDs of new splits)
+
+EXAMPLE (interval 64):
+op log:      1 2 3 ... 64 65 ... 128 129 130
+checkpoints: 0         64        128
+/api/history?op=130 → restore checkpoint 128, replay ops 129 and 130
+*/
+
+typedef struct {
+    int  type;              // HistoryOpType
+    int  a, b, c;
+    char replayable;        // Block-list engine, a replayable type
+} HistoryOp;
+
+typedef struct {
+    int  startAddress;
+    int  size;
+    int  processID;
+    int  blockID;
+    int  buddyID;
+    char isHole;
+} HistoryEntry;
+
+typedef struct {
+    long long     op;               // State after this op (0 = start)
+    int           useBuddySystem;
+    int           processCounter;
+    int           nextBlockID;
+    int           totalMemory;
+    int           osMemory;
+    int           numEntries;
+    HistoryEntry *entries;          // malloc'd, numEntries long
+} HistoryCheckpoint;
+
+typedef struct History {
+    HistoryOp         ops[HISTORY_MAX_OPS];    // ops[n % HISTORY_MAX_OPS]
+    long long         latestOp;                // Ops recorded so far
+    HistoryCheckpoint checkpoints[HISTORY_MAX_CHECKPOINTS];
+    int               firstCheckpoint;         // Ring start
+    int               numCheckpoints;
+    int               chainBroken;  // An op since the last checkpoint can't be replayed
+    int               suspended;    // > 0 inside a conversion (its inner ops are not logged)
+    long long         reconstructions;
+    long long         opsReplayed;
+} History;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: enableHistory / destroyHistory
+--------------------------------------------------------------------------------
+PURPOSE: Start recording (checkpoint of the current state as op 0) /
+         free the log and every checkpoint
+
+Managers without a history (scratch managers in benchmarks and replay)
+record nothing.
+*/
+void enableHistory(MemoryManager *mm);
+void destroyHistory(struct History *history);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: historyRecord / historySuspend / historyResume
+--------------------------------------------------------------------------------
+PURPOSE: Log one mutation after it succeeded
+
+Called by the operations themselves. A conversion suspends recording
+around the allocations it performs internally, so it shows up as ONE op.
+After the op, a checkpoint is taken if the interval is up, or if the
+chain was broken and the block list is active again.
+*/
+void historyRecord(MemoryManager *mm, HistoryOpType type, int a, int b, int c);
+void historySuspend(MemoryManager *mm);
+void historyResume(MemoryManager *mm);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: historyReconstruct
+--------------------------------------------------------------------------------
+PURPOSE: Rebuild the state after op N and write it as JSON:
+         {"op","operation","checkpointOp","replayed","rebuildUs",
+          "blocks":[...],"stats":{...}}
+
+RETURNS: 1 on success,
+         0 if N is outside the retained range,
+        -1 if op N (or one before it) ran under the paged or boundary-tag
+           engine or with deferred coalescing; those states are not
+           reconstructable
+         On failure the buffer holds {"success":false,"message":...}
+*/
+int historyReconstruct(MemoryManager *mm, long long op, char *buffer, int bufferSize);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: historyToJSON
+--------------------------------------------------------------------------------
+PURPOSE: Retained range, checkpoint count, memory used and the most
+         recent ops
+*/
+void historyToJSON(MemoryManager *mm, char *buffer, int bufferSize);
+
+
+#endif /* HISTORY_H */
@@ -0,0 +1,118 @@
+/*
+================================================================================
+FILE: http_parser.h
+PURPOSE: Incremental HTTP/1.1 request parser that works in the receive buffer
+DESCRIPTION:
+    - The server used to do ONE read() and sscanf() the request line; a
+      request split over two packets lost its body, and a second request
+      in the same packet was thrown away
+    - httpParse() is a state machine: give it whatever has arrived, it
+      either finishes a request or remembers where it stopped, and the
+      next call goes on from there (no byte is looked at twice)
+    - Nothing is copied: method and path are NUL-terminated in place and
+      the body is a pointer + length into the same buffer. Chunked
+      bodies are decoded in place (the data only ever moves down)
+    - 'consumed' says where the next pipelined request starts
+================================================================================
+*/
+
+#ifndef HTTP_PARSER_H
+#define HTTP_PARSER_H
+
+
+// Request line + headers, and body, of one request
+#define HTTP_MAX_HEADER_BYTES 8192
+#define HTTP_MAX_BODY_BYTES   65536
+
+// One connection's receive buffer holds at least one whole request
+#define HTTP_BUFFER_SIZE (HTTP_MAX_HEADER_BYTES + HTTP_MAX_BODY_BYTES)
+
+// httpParse() results
+#define HTTP_PARSE_DONE   1     // A whole request is ready
+#define HTTP_PARSE_MORE   0     // Need more bytes
+#define HTTP_PARSE_ERROR -1     // Answer errorStatus and close
+
+
+/*
+================================================================================
+STRUCTURE: HttpParser
+================================================================================
+PURPOSE: The state of one request being parsed, and the request once done
+
+Offsets are relative to the start of the request, so the caller may
+move the unparsed bytes (memmove to the front of its buffer) between
+calls as long as it passes the new address.
+
+EXAMPLE (two pipelined requests in one read):
+"GET /api/stats HTTP/1.1\r\n\r\nPOST /api/compact HTTP/1.1\r\n..."
+ └──────── consumed = 27 ──────┘└─ next httpParse() starts here
+*/
+
+typedef struct {
+    // ----- The request (valid after HTTP_PARSE_DONE) -----
+    char *method;           // "GET", NUL-terminated in the buffer
+    char *path;             // "/api/history?op=3"
+    char *body;             // Not NUL-terminated; NULL if there is none
+    int   bodyLength;
+    int   minorVersion;     // HTTP/1.0 → 0, HTTP/1.1 → 1
+    int   keepAlive;        // 1.1 default, or "Connection: keep-alive"
+    int   consumed;         // Bytes of this request (headers + framed body)
+    int   acceptGzip;       // "Accept-Encoding: gzip, br"
+    const char *ifNoneMatch;    // Cached ETag(s) (not NUL-terminated); NULL if none
+    int   ifNoneMatchLength;
+
+    // ----- Set before the body has arrived -----
+    int   expectContinue;   // "Expect: 100-continue" (send 100 before reading on)
+
+    // ----- Set on HTTP_PARSE_ERROR -----
+    int         errorStatus;    // 400, 413, 431, 501, 505
+    const char *errorText;      // "Bad Request", ...
+
+    // ----- Parser state (private) -----
+    int state;
+    int pos;                // Next byte to look at
+    int mark;               // Start of the current token
+    int nameStart, nameEnd; // Current header name
+    int pathStart;
+    int bodyStart;
+    int bodyEnd;            // Decoded chunked body ends here
+    long long contentLength;
+    long long chunkLeft;
+    int chunked;
+    int sawLength;
+    int expect;             // Saw "Expect: 100-continue"
+    int ifNoneMatchStart;
+} HttpParser;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: httpParserReset
+--------------------------------------------------------------------------------
+PURPOSE: Get ready for the next request on the connection
+*/
+void httpParserReset(HttpParser *parser);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: httpParse
+--------------------------------------------------------------------------------
+PURPOSE: Parse on from where the last call stopped
+
+'data' is the start of the request and 'length' how many bytes of it
+have arrived so far (the same request, possibly moved, with more bytes
+after it each time). Bytes past the request are not touched.
+
+SUPPORTED:
+- Request line "METHOD SP path SP HTTP/1.x", lines ending in CRLF or LF
+- Content-Length bodies and Transfer-Encoding: chunked (with trailers)
+- Connection: keep-alive / close, Expect: 100-continue
+- Accept-Encoding (gzip or not) and If-None-Match, for static files
+
+RETURNS: HTTP_PARSE_DONE, HTTP_PARSE_MORE or HTTP_PARSE_ERROR
+*/
+int httpParse(HttpParser *parser, char *data, int length);
+
+
+#endif /* HTTP_PARSER_H */
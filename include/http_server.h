@@ -33,6 +33,9 @@ WHAT IT DOES:
 PARAMETERS:
 - mm: Pointer to MemoryManager (shared state for all requests)
 - port: Port number to listen on (e.g., 8080)
+- localPath: Unix socket of the local transport (local_transport.h),
+  or NULL for HTTP only
+- rpcPort: TCP port of the same binary protocol, or 0 for none
 
 RETURNS: 
 - 0 on normal exit
@@ -41,9 +44,28 @@ RETURNS:
 EXAMPLE USAGE:
 MemoryManager mm;
 initializeMemory(&mm, 1024, 256);
-startServer(&mm, 8080);  // Blocks here, handles requests forever
+startServer(&mm, 8080, NULL, 0);  // Blocks here, handles requests forever
 */
-int startServer(MemoryManager *mm, int port);
+int startServer(MemoryManager *mm, int port, const char *localPath, int rpcPort);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: serverLockState / serverUnlockState
+--------------------------------------------------------------------------------
+PURPOSE: Let a transport other than HTTP change mm under the same lock
+         the HTTP routes use
+
+serverUnlockState() is told how many operations changed mm while the
+lock was held. If any did, waiting allocations get another chance and
+the published snapshot is marked stale: the next GET /api/blocks or
+GET /api/stats renders a new one, instead of every operation rendering
+one nobody may ask for. The stats time series counts the operations
+and takes a sample at most once per millisecond; the shared-memory
+export (shm_export.h) is rewritten at the same rate.
+*/
+void serverLockState(void);
+void serverUnlockState(MemoryManager *mm, int operations);
 
 
 #endif
@@ -65,6 +87,10 @@ POST /api/buddy/convert → Convert to buddy system
 POST /api/buddy/revert  → Revert from buddy system
 POST /api/reset       → Reset memory
 
+Clients can skip HTTP: startServer(mm, port, path, rpcPort) also
+serves the binary protocol on a Unix socket and on a TCP port
+(local_transport.h).
+
 All responses include CORS headers for cross-origin requests
 from the React dev server (localhost:5173).
 ================================================================================
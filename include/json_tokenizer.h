@@ -0,0 +1,146 @@
+/*
+================================================================================
+FILE: json_tokenizer.h
+PURPOSE: Single-pass, zero-allocation JSON tokenizer for request bodies
+DESCRIPTION:
+    - The old helpers searched the whole body once per key with strstr()
+      ("size": found inside "maxSize": too), broke on a space before the
+      colon and could not read arrays
+    - jsonParse() walks the body ONCE and writes a flat array of tokens
+      into a caller-provided JsonDocument (no malloc); every field is
+      then a lookup over the tokens, not another scan of the text
+    - Lookups only see the keys of the object they are given, so nested
+      objects can never shadow top-level fields
+    - Every read is bounded by the length passed in (the request's
+      Content-Length), never by a terminating NUL
+================================================================================
+*/
+
+#ifndef JSON_TOKENIZER_H
+#define JSON_TOKENIZER_H
+
+
+// Tokens one document can hold; an 8 KB body of "[1,1,1,...]" needs 4096
+#define JSON_MAX_TOKENS 4096
+
+// Nesting depth of objects/arrays
+#define JSON_MAX_DEPTH 32
+
+// jsonParse() errors (negative)
+#define JSON_ERROR_NOMEM   -1   // More tokens than JSON_MAX_TOKENS
+#define JSON_ERROR_INVALID -2   // Not JSON (or nested deeper than JSON_MAX_DEPTH)
+#define JSON_ERROR_PARTIAL -3   // Text ends inside a value
+
+
+typedef enum {
+    JSON_OBJECT = 1,
+    JSON_ARRAY,
+    JSON_STRING,
+    JSON_PRIMITIVE      // Number, true, false, null
+} JsonType;
+
+
+/*
+================================================================================
+STRUCTURE: JsonToken / JsonDocument
+================================================================================
+PURPOSE: One value (or object key) of the text, by position
+
+'next' is the index of the first token AFTER this value and everything
+inside it, so a lookup jumps over a nested object in one step.
+
+EXAMPLE: {"size":100,"tags":[1,2],"algorithm":"best_fit"}
+index  type       text          size  next
+0      OBJECT     {...}         3     8
+1      STRING     size          0     2
+2      PRIMITIVE  100           0     3
+3      STRING     tags          0     4
+4      ARRAY      [1,2]         2     7
+5      PRIMITIVE  1             0     6
+6      PRIMITIVE  2             0     7
+7      STRING     algorithm     0     8   ← key; its value is token 8
+8      STRING     best_fit      0     9
+*/
+
+typedef struct {
+    int           start;    // First character (strings: after the quote)
+    int           end;      // One past the last (strings: the closing quote)
+    int           next;     // First token after this value's subtree
+    int           size;     // Objects: keys; arrays: elements
+    unsigned char type;     // JsonType
+} JsonToken;
+
+typedef struct {
+    const char *text;
+    int         length;
+    int         count;
+    JsonToken   tokens[JSON_MAX_TOKENS];
+} JsonDocument;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: jsonParse
+--------------------------------------------------------------------------------
+PURPOSE: Tokenize text[0 .. length-1] in one pass
+
+Token 0 is the top-level value. Whitespace around ':' and ',' is fine;
+anything after the top-level value except whitespace is an error.
+
+RETURNS: Number of tokens, or JSON_ERROR_NOMEM / _INVALID / _PARTIAL
+*/
+int jsonParse(JsonDocument *doc, const char *text, int length);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: jsonFind
+--------------------------------------------------------------------------------
+PURPOSE: Token index of the value of 'key' in the object at token
+         'object' (its own keys only, not nested ones)
+
+RETURNS: Token index, or -1 if 'object' is not an object or has no such key
+*/
+int jsonFind(const JsonDocument *doc, int object, const char *key);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: jsonTokenInt / jsonTokenString / jsonArrayInts
+--------------------------------------------------------------------------------
+jsonTokenInt:    Integer value of a number token (the fraction of 10.5 is
+                 dropped); true/false read as 1/0. Returns 1 on success.
+jsonTokenString: Copy a string token with escapes decoded (\uXXXX
+                 outside ASCII becomes '?'), truncated to valueSize - 1.
+                 Returns 1 on success.
+jsonArrayInts:   Integers of the array at token 'array' into values[0..max-1].
+                 Returns how many, or -1 if it is not an array of numbers
+                 or has more than max elements.
+*/
+int jsonTokenInt(const JsonDocument *doc, int token, long long *value);
+int jsonTokenString(const JsonDocument *doc, int token, char *value, int valueSize);
+int jsonArrayInts(const JsonDocument *doc, int array, int *values, int max);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: benchmarkJSONParsing
+--------------------------------------------------------------------------------
+PURPOSE: Time the old strstr() helpers against the tokenizer, both
+         extracting every field of the same request body
+
+The old helpers are kept (privately) in json_tokenizer.c for this
+comparison only.
+
+OUTPUT FORMAT:
+{"iterations":100000,"fields":10,"bodyBytes":212,
+ "strstr":{"nsPerRequest":...,"nsPerField":...},
+ "tokenizer":{"nsPerRequest":...,"nsPerField":...,"tokens":21},
+ "speedup":2.4,"sameResults":true}
+
+RETURNS: 1 on success, 0 on bad parameters
+*/
+int benchmarkJSONParsing(int iterations, char *buffer, int bufferSize);
+
+
+#endif /* JSON_TOKENIZER_H */
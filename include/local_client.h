@@ -0,0 +1,190 @@
+/*
+================================================================================
+FILE: local_client.h
+PURPOSE: Client side of the binary protocol (see local_protocol.h)
+DESCRIPTION:
+    - For programs next to a server started with --local (Unix socket)
+      or --rpc (TCP): connect, send requests one at a time or many at
+      once, optionally switch to a shared-memory ring (same machine)
+    - Any number of requests can be in flight: localSubmit() queues one
+      and returns at once, localReceive() hands back the answers in
+      order, each carrying the id its request got
+    - localAllocateBatch() and friends wrap one round trip each; the
+      batch operations carry up to LOCAL_MAX_BATCH entries per message
+    - localBenchmark() is what --local-bench runs: allocate/free pairs
+      over each path, one at a time, pipelined and as batch messages,
+      in ns per operation
+================================================================================
+*/
+
+#ifndef LOCAL_CLIENT_H
+#define LOCAL_CLIENT_H
+
+#include "local_protocol.h"
+
+
+/*
+================================================================================
+STRUCTURE: LocalConnection
+================================================================================
+PURPOSE: One client's socket and, after localAttachRing(), its ring
+
+requestTail / responseHead are this side's ring indexes (the client
+produces requests and consumes responses).
+
+The rest belongs to localSubmit() / localReceive(): requests waiting to
+be written, answers read but not yet handed out, and for every request
+in flight the most its answer can take. Those bounds add up to at most
+LOCAL_CLIENT_WINDOW bytes, so the answers always fit in the socket
+buffers: the server never blocks writing to a client that is itself
+blocked writing to the server.
+*/
+
+// Bytes of queued requests and of read-ahead answers per connection
+#define LOCAL_CLIENT_BUFFER (64 * 1024)
+
+// Answer bytes that may be owed to one connection at a time
+#define LOCAL_CLIENT_WINDOW (64 * 1024)
+
+typedef struct {
+    int              fd;
+    uint32_t         nextId;
+    LocalRingShared *ring;          // NULL: requests go over the socket
+    uint32_t         requestTail;
+    uint32_t         responseHead;
+
+    uint32_t         submitted;     // Requests queued by localSubmit()
+    uint32_t         received;      // Answers handed out by localReceive()
+    uint32_t         owed;          // Sum of bound[] over the requests in flight
+    uint32_t         bound[LOCAL_RING_SLOTS];   // Per request in flight
+    int              outFilled;
+    int              inStart;
+    int              inFilled;
+    char             out[LOCAL_CLIENT_BUFFER];
+    char             in[LOCAL_CLIENT_BUFFER];
+} LocalConnection;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: localConnect / localDisconnect
+--------------------------------------------------------------------------------
+localConnect: Connect to the server's Unix socket
+localConnectTcp: Connect to the server's --rpc port ('host' is a name
+                 or an address), Nagle off
+    RETURNS: 0, or -1 on error
+localDisconnect: Unmap the ring, close the socket (the server then
+                 removes the ring)
+*/
+int localConnect(LocalConnection *conn, const char *path);
+int localConnectTcp(LocalConnection *conn, const char *host, int port);
+void localDisconnect(LocalConnection *conn);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: localAttachRing
+--------------------------------------------------------------------------------
+PURPOSE: Ask for a shared-memory ring and map it; localCall() uses the
+         ring from then on
+
+RETURNS: 0, or -1 (the socket keeps working)
+*/
+int localAttachRing(LocalConnection *conn);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: localCall
+--------------------------------------------------------------------------------
+PURPOSE: Send 'count' requests and wait for all their responses
+
+The requests are sent back to back (one write on the socket, one tail
+update on the ring per LOCAL_RING_SLOTS) and answered in order; 'id' is
+filled in here. count = 1 is a plain round trip.
+
+Only the single-entry operations (ALLOCATE, DEALLOCATE, COMPACT), and
+not while localSubmit() requests are still in flight.
+
+RETURNS: 0, or -1 if the server went away
+*/
+int localCall(LocalConnection *conn, LocalRequest *requests, int count,
+              LocalResponse *responses);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: localSubmit / localFlush / localReceive
+--------------------------------------------------------------------------------
+PURPOSE: Pipelined requests of any operation, over the socket
+
+localSubmit: Queue 'request' followed by 'payloadBytes' of 'payload';
+    'length' and 'id' are filled in (read request->id to match the
+    answer). Nothing is written until the queue is full, localFlush()
+    or localReceive().
+    RETURNS: 0 queued, 1 the window is full (localReceive() first;
+             nothing was queued), -1 on error (server gone, message too
+             long)
+
+localFlush: Write the queued requests. RETURNS: 0, or -1
+
+localReceive: The next answer, in request order (queued requests are
+    flushed first). Up to 'maxPayload' bytes of its payload are copied
+    to 'payload' (which may be NULL with maxPayload 0).
+    RETURNS: The payload size of the answer (more than maxPayload: cut
+             short), or -1 (nothing in flight, or the server is gone)
+
+EXAMPLE (1000 stats requests in flight, answers matched by id):
+    for (...) { request.op = LOCAL_OP_STATS; localSubmit(conn, &request, NULL, 0); }
+    for (...) { localReceive(conn, &response, &counters, sizeof(counters)); }
+*/
+int localSubmit(LocalConnection *conn, LocalRequest *request,
+                const void *payload, int payloadBytes);
+int localFlush(LocalConnection *conn);
+int localReceive(LocalConnection *conn, LocalResponse *response,
+                 void *payload, int maxPayload);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: localAllocateBatch / localDeallocateBatch / localStats /
+          localBlockRange
+--------------------------------------------------------------------------------
+PURPOSE: One round trip each (none may be in flight from localSubmit)
+
+localAllocateBatch: Allocate sizes[0..count) KB with 'algorithm';
+    entries[i] gets PID and start (-1: did not fit).
+    RETURNS: Allocations that fit, or -1
+localDeallocateBatch: Free processIds[0..count); statuses[i] gets the
+    LocalStatus of each (may be NULL). RETURNS: Processes freed, or -1
+localStats: RETURNS: 0, or -1
+localBlockRange: Up to maxRows rows of the blocks in [from, to) KB (to
+    < 0: to the end of memory); *next is the 'from' that continues the
+    listing (-1: it is complete). RETURNS: Rows, or -1
+
+count is 1..LOCAL_MAX_BATCH.
+*/
+int localAllocateBatch(LocalConnection *conn, const int32_t *sizes, int count,
+                       int algorithm, LocalBatchEntry *entries);
+int localDeallocateBatch(LocalConnection *conn, const int32_t *processIds, int count,
+                         int32_t *statuses);
+int localStats(LocalConnection *conn, ShmExportCounters *counters);
+int localBlockRange(LocalConnection *conn, int from, int to,
+                    ShmExportBlock *rows, int maxRows, int *next);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: localBenchmark
+--------------------------------------------------------------------------------
+PURPOSE: Time 'pairs' allocate + free pairs against the server at 'path'
+         (or, with port > 0, its TCP port on this machine) one at a time,
+         pipelined, as batch messages and over the ring, and print ns
+         per operation
+
+RETURNS: 0, or 1 if the server could not be reached
+*/
+int localBenchmark(const char *path, int port, int pairs);
+
+
+#endif /* LOCAL_CLIENT_H */
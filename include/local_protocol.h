@@ -0,0 +1,224 @@
+/*
+================================================================================
+FILE: local_protocol.h
+PURPOSE: Wire format of the binary protocol (local transport and RPC port)
+DESCRIPTION:
+    - A benchmark running on the same machine as the server pays more for
+      HTTP than for the allocation itself: TCP, text headers, JSON both
+      ways. The local transport skips all of that
+    - Messages are small fixed structs, each starting with its own
+      length, so several can be written and read back to back on a Unix
+      domain socket or, with --rpc, a TCP connection
+    - Byte order is little-endian on the wire, which is the host order of
+      every machine this builds for (a big-endian build stops below
+      rather than talk nonsense)
+    - The batch, stats and block-range operations append an array of
+      int32 or row structs after the fixed part (the "payload"); the
+      fixed part says how many entries follow
+    - For the highest rates a client asks for a shared-memory ring: two
+      single-producer / single-consumer queues (requests in, responses
+      out) in a region both processes map. Sending a request is then a
+      store and an index bump; no system call while both sides are busy
+    - Both paths end in the same operations (operations.h) as HTTP
+================================================================================
+*/
+
+#ifndef LOCAL_PROTOCOL_H
+#define LOCAL_PROTOCOL_H
+
+#include <stdint.h>         // uint32_t, int32_t, uint16_t, int16_t
+#include "shm_export.h"     // ShmExportCounters, ShmExportBlock (STATS, BLOCK_RANGE)
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "The binary protocol is little-endian: this host needs byte swapping"
+#endif
+
+
+// Where the server listens when --local is given without a path
+#define LOCAL_DEFAULT_SOCKET "/tmp/memory_visualizer.sock"
+
+// The TCP port of --rpc when none is given
+#define LOCAL_DEFAULT_RPC_PORT 9090
+
+// Entries in one ALLOCATE_BATCH / DEALLOCATE_BATCH
+#define LOCAL_MAX_BATCH 1024
+
+// Rows in one BLOCK_RANGE answer (ask again from 'startAddress' for more)
+#define LOCAL_MAX_RANGE_ROWS 512
+
+// A message longer than this is a broken client (the connection is closed)
+#define LOCAL_MAX_MESSAGE (sizeof(LocalRequest) + LOCAL_MAX_BATCH * sizeof(int32_t))
+
+// The longest answer (BLOCK_RANGE with every row; a full ALLOCATE_BATCH
+// is 24 + 8 * 1024 bytes)
+#define LOCAL_MAX_RESPONSE \
+    (sizeof(LocalResponse) + LOCAL_MAX_RANGE_ROWS * sizeof(ShmExportBlock))
+
+
+/*
+================================================================================
+OPERATIONS AND STATUS CODES
+================================================================================
+*/
+
+typedef enum {
+    LOCAL_OP_ALLOCATE    = 1,   // arg = size in KB, flags = AllocationAlgorithm
+    LOCAL_OP_DEALLOCATE  = 2,   // arg = process ID
+    LOCAL_OP_COMPACT     = 3,   // no argument
+    LOCAL_OP_ATTACH_RING = 4,   // answered with a LocalAttachResponse
+
+    // Socket / TCP only (a ring slot has no room for a payload)
+    LOCAL_OP_ALLOCATE_BATCH   = 5,  // arg = n, flags = AllocationAlgorithm,
+                                    // payload int32 sizes[n]
+                                    // → payload LocalBatchEntry[n]
+    LOCAL_OP_DEALLOCATE_BATCH = 6,  // arg = n, payload int32 processIds[n]
+                                    // → payload int32 LocalStatus[n]
+    LOCAL_OP_STATS            = 7,  // → payload ShmExportCounters
+    LOCAL_OP_BLOCK_RANGE      = 8   // arg = from KB, payload int32 to KB
+                                    // (optional: end of memory)
+                                    // → payload ShmExportBlock[rows]
+} LocalOp;
+
+typedef enum {
+    LOCAL_STATUS_OK          = 0,
+    LOCAL_STATUS_NO_ROOM     = 1,   // Allocation failed (processId was still used)
+    LOCAL_STATUS_NOT_FOUND   = 2,   // No such process
+    LOCAL_STATUS_SLAB        = 3,   // Process belongs to a slab cache
+    LOCAL_STATUS_BAD_REQUEST = 4,   // Unknown op, bad size
+    LOCAL_STATUS_FAILED      = 5    // Nothing to compact, ring not available
+} LocalStatus;
+
+
+/*
+================================================================================
+STRUCTURE: LocalRequest / LocalResponse
+================================================================================
+PURPOSE: One request and its answer (16 and 24 bytes, plus the payload)
+
+'length' is the whole message in bytes (at least the struct). The
+single-entry operations skip bytes after the struct, so later versions
+can append fields; the others read their payload from there.
+'id' is chosen by the client and copied into the response; responses
+come back in request order. A client can therefore keep many requests
+in flight on one connection and match each answer by its id
+(local_client.h: localSubmit / localReceive).
+
+EXAMPLE:
+request  { 16, ALLOCATE, BEST_FIT, id 7, arg 200 }
+response { 24, ALLOCATE, OK,       id 7, processId 12, startAddress 387,
+           freeKB 177 }
+
+request  { 28, ALLOCATE_BATCH, FIRST_FIT, id 8, arg 3 } 10 20 30
+response { 48, ALLOCATE_BATCH, OK, id 8, processId 3 (placed), -1, 117 }
+         { 13, 387 } { 14, 397 } { 15, 417 }
+
+WHAT THE RESPONSE FIELDS MEAN PER OPERATION:
+                    processId          startAddress        status
+ALLOCATE            new PID            start (-1: failed)  OK / NO_ROOM
+DEALLOCATE          PID asked for      -1                  OK / NOT_FOUND / SLAB
+*_BATCH             entries that       -1                  OK if all did,
+                    succeeded                              NO_ROOM / NOT_FOUND
+BLOCK_RANGE         rows               next 'from' to ask  OK
+                                       for (-1: all sent)
+
+A BAD_REQUEST answer (unknown op, bad size, n out of 1..LOCAL_MAX_BATCH
+or not matching the length) has no payload and changed nothing.
+*/
+
+typedef struct {
+    uint32_t length;
+    uint16_t op;            // LocalOp
+    uint16_t flags;         // ALLOCATE: the AllocationAlgorithm
+    uint32_t id;
+    int32_t  arg;
+} LocalRequest;
+
+typedef struct {
+    uint32_t length;
+    uint16_t op;
+    int16_t  status;        // LocalStatus
+    uint32_t id;
+    int32_t  processId;     // ALLOCATE: the new PID (see the table above)
+    int32_t  startAddress;  // ALLOCATE: start (-1 on failure)
+    int32_t  freeKB;        // Free memory after the operation
+} LocalResponse;
+
+// One ALLOCATE_BATCH answer entry (startAddress -1: did not fit; the PID
+// was used all the same, as for ALLOCATE)
+typedef struct {
+    int32_t processId;
+    int32_t startAddress;
+} LocalBatchEntry;
+
+// ATTACH_RING answer: the shared memory object to map (shm_open name)
+typedef struct {
+    LocalResponse response;
+    char          name[48];
+} LocalAttachResponse;
+
+
+/*
+================================================================================
+STRUCTURE: LocalRingShared
+================================================================================
+PURPOSE: The shared-memory region of one ring client
+
+Each queue has one producer and one consumer. Indexes only grow;
+slot = index % LOCAL_RING_SLOTS. The producer's index and the
+consumer's index sit on separate cache lines, so the two sides do not
+steal one line from each other on every message.
+
+    requests:  client writes tail, server writes head
+    responses: server writes tail, client writes head
+
+A consumer that found its queue empty for a while sets 'sleeping' and
+waits on 'tail' with a futex (Linux; elsewhere it sleeps briefly and
+looks again); a producer that sees 'sleeping' after
+moving 'tail' wakes it. While traffic flows nobody sleeps and no system
+call is made.
+
+The client keeps at most LOCAL_RING_SLOTS requests unanswered, so the
+response queue can never overflow.
+*/
+
+#define LOCAL_RING_SLOTS 1024
+#define LOCAL_RING_MAGIC 0x4D564C52u    // "MVLR"
+#define LOCAL_CACHE_LINE 64
+
+typedef struct {
+    uint32_t tail;                          // Producer
+    char     producerLine[LOCAL_CACHE_LINE - sizeof(uint32_t)];
+    uint32_t head;                          // Consumer
+    uint32_t sleeping;                      // Consumer waits on 'tail'
+    char     consumerLine[LOCAL_CACHE_LINE - 2 * sizeof(uint32_t)];
+} LocalQueueIndex;
+
+typedef struct {
+    uint32_t        magic;
+    uint32_t        closed;                 // Set when the server lets go
+    char            headerLine[LOCAL_CACHE_LINE - 2 * sizeof(uint32_t)];
+    LocalQueueIndex requests;
+    LocalQueueIndex responses;
+    LocalRequest    request[LOCAL_RING_SLOTS];
+    LocalResponse   response[LOCAL_RING_SLOTS];
+} LocalRingShared;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: localQueueAwait / localQueueNotify
+--------------------------------------------------------------------------------
+localQueueAwait (consumer): Wait until the queue holds something past
+    'head' or '*closed' is set; spins first, then sleeps on a futex
+    with a timeout, so a 'closed' nobody woke for is still noticed
+    (Linux; elsewhere it sleeps 50 us at a time and looks again)
+    RETURNS: The producer's tail (== head only if closed)
+
+localQueueNotify (producer): Publish 'tail' and wake the consumer if it
+    went to sleep
+*/
+uint32_t localQueueAwait(LocalQueueIndex *queue, uint32_t head, const uint32_t *closed);
+void localQueueNotify(LocalQueueIndex *queue, uint32_t tail);
+
+
+#endif /* LOCAL_PROTOCOL_H */
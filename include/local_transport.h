@@ -0,0 +1,71 @@
+/*
+================================================================================
+FILE: local_transport.h
+PURPOSE: Server side of the binary protocol (see local_protocol.h)
+DESCRIPTION:
+    - A Unix domain socket listener (--local) and a TCP one (--rpc) next
+      to the HTTP one, one thread per client, binary messages instead
+      of HTTP + JSON: no request line to sscanf, no headers to strstr,
+      no JSON to snprintf
+    - Every complete message that arrived together is answered under ONE
+      acquisition of the server's state lock, and all answers go back in
+      one write: a client that pipelines pays the system calls and the
+      lock once per batch instead of once per operation
+    - A client that sends ATTACH_RING gets its own shared-memory ring and
+      a server thread that polls it; the socket then only tells the
+      server when the client is gone
+    - Both paths run the same operations as HTTP (operations.h); the
+      snapshot readers see the changes the next time they ask
+================================================================================
+*/
+
+#ifndef LOCAL_TRANSPORT_H
+#define LOCAL_TRANSPORT_H
+
+#include "memory_structures.h"  // MemoryManager
+#include "local_protocol.h"
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: localTransportStart
+--------------------------------------------------------------------------------
+PURPOSE: Listen on the Unix socket 'path' from a background thread
+
+A socket file left behind by a server that is gone is replaced; one
+that a running server still answers on is not.
+
+RETURNS: 0 when listening, -1 on error (message printed)
+*/
+int localTransportStart(MemoryManager *mm, const char *path);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: localTransportStartTcp
+--------------------------------------------------------------------------------
+PURPOSE: Serve the same protocol on a TCP port (Nagle off on every
+         connection), for clients that cannot reach the Unix socket
+
+ATTACH_RING works only for a client on the same machine.
+
+RETURNS: 0 when listening, -1 on error (message printed)
+*/
+int localTransportStartTcp(MemoryManager *mm, int port);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: localExecute
+--------------------------------------------------------------------------------
+PURPOSE: Run one single-entry request (ALLOCATE, DEALLOCATE, COMPACT)
+         and fill in its response; anything else is BAD_REQUEST
+
+The caller holds the server's state lock.
+
+RETURNS: 1 if mm changed, 0 if not
+*/
+int localExecute(MemoryManager *mm, const LocalRequest *request, LocalResponse *response);
+
+
+#endif /* LOCAL_TRANSPORT_H */
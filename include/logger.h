@@ -0,0 +1,114 @@
+/*
+================================================================================
+FILE: logger.h
+PURPOSE: Leveled, sampled, asynchronous logging for the engine and server
+DESCRIPTION:
+    - The engine used to printf() as it went ("[REQUEST] ...", one line
+      per process moved by compaction, "Error: Not enough free memory!");
+      under load every request paid for formatting plus a locked,
+      possibly blocking write to stdout
+    - Each message now has a level. A message below the threshold costs
+      one comparison: the LOG_* macros test the level BEFORE the
+      arguments are even evaluated, so nothing is formatted
+    - Until logStart() is called (the menu, script mode) a message is
+      printed right away, so the menu output keeps its order
+    - After logStart() (server mode) each thread formats into its own
+      ring buffer without taking any lock, and a background thread
+      writes the rings out; a full ring drops messages (counted) rather
+      than block the request
+================================================================================
+*/
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <stdio.h>      // FILE
+
+
+typedef enum {
+    LOG_LEVEL_DEBUG = 0,    // Per-item detail ("[COMPACT] Moved P3 ...")
+    LOG_LEVEL_INFO,         // Per-operation ("[REQUEST] POST /api/compact")
+    LOG_LEVEL_WARN,         // Something fell back or was refused by the OS
+    LOG_LEVEL_ERROR,        // Something failed that should not
+    LOG_LEVEL_OFF
+} LogLevel;
+
+// Default thresholds: everything from INFO for the menu, WARN and up
+// for the server (no formatting at all on the request path)
+#define LOG_DEFAULT_LEVEL        LOG_LEVEL_INFO
+#define LOG_DEFAULT_SERVER_LEVEL LOG_LEVEL_WARN
+
+// Per-thread ring: slots (power of 2) and the longest line kept
+#define LOG_RING_SLOTS 256
+#define LOG_LINE_SIZE  200
+
+
+// Messages below this level are skipped (read by the macros; set it
+// with logSetLevel())
+extern int logThreshold;
+
+#define LOG_AT(level, ...) \
+    do { \
+        if ((level) >= logThreshold) { \
+            logWrite((level), __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...)  LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...)  LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: logWrite
+--------------------------------------------------------------------------------
+PURPOSE: Record one message (use the LOG_* macros, which check the level)
+
+DEBUG and INFO messages are sampled: with logSetSampling(10) only every
+10th one of each thread is kept. WARN and ERROR are always kept.
+Messages are printed as given (they carry their own '\n').
+*/
+void logWrite(LogLevel level, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: logStart / logFlush
+--------------------------------------------------------------------------------
+logStart: Switch to asynchronous mode: start the thread that writes the
+          rings to 'out' (stdout if NULL). Returns 1 on success; on
+          failure messages keep being printed directly.
+logFlush: Wait until everything recorded so far has been written
+*/
+int logStart(FILE *out);
+void logFlush(void);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: logSetLevel / logSetSampling / logParseLevel / logLevelName
+--------------------------------------------------------------------------------
+logParseLevel: "debug", "info", "warn", "error" or "off" → the level,
+               or -1 for anything else
+*/
+void logSetLevel(LogLevel level);
+void logSetSampling(int every);
+int logParseLevel(const char *name);
+const char* logLevelName(LogLevel level);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: logStatsToJSON
+--------------------------------------------------------------------------------
+OUTPUT FORMAT:
+{"level":"warn","sampleEvery":1,"async":true,"rings":3,
+ "written":120,"dropped":0,"sampledOut":0}
+*/
+void logStatsToJSON(char *buffer, int bufferSize);
+
+
+#endif /* LOGGER_H */
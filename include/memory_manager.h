@@ -91,9 +91,11 @@ PARAMETERS:
 - processID: ID of the process requesting memory
 - size: How much memory the process needs (in KB)
 - algo: Which algorithm to use (FIRST_FIT, BEST_FIT, or WORST_FIT)
+        (ignored in paged mode: the process gets any free frames)
 
 RETURNS: 
 - Starting address where process was allocated (success)
+  (in paged mode: the address of its first frame)
 - -1 if allocation failed (no suitable hole found)
 */
 int allocateMemory(MemoryManager *mm, int processID, int size, 
@@ -111,6 +113,7 @@ WHAT IT DOES:
 2. Convert it to a hole (free space)
 3. Merge with adjacent holes if they exist
 4. Update statistics
+(In paged mode the process's frames go back to the frame bitmap)
 
 PARAMETERS:
 - mm: Pointer to MemoryManager
@@ -157,6 +160,19 @@ RETURNS:
 float calculateFragmentation(MemoryManager *mm);
 
 
+/*
+--------------------------------------------------------------------------------
+FUNCTION: largestHoleKB
+--------------------------------------------------------------------------------
+PURPOSE: Size (KB) of the largest free block: the largest hole of the
+         block list, the longest free-frame run in paged mode, or the
+         largest free block between boundary tags
+
+An allocation of up to this size succeeds with any fit algorithm.
+*/
+int largestHoleKB(MemoryManager *mm);
+
+
 /*
 --------------------------------------------------------------------------------
 FUNCTION: freeMemoryManager
@@ -429,6 +445,24 @@ RETURNS:
 int revertFromBuddySystem(MemoryManager *mm, char *resultBuffer, int bufferSize);
 
 
+/*
+--------------------------------------------------------------------------------
+FUNCTION: coalesceDeferred
+--------------------------------------------------------------------------------
+PURPOSE: Merge every pair of adjacent holes (or free buddies) left behind
+         by deferred-coalescing mode, in one batch
+
+PARAMETERS:
+- mm: Pointer to MemoryManager
+- trigger: Why the pass runs, for the stats (0 = on request,
+  1 = pressure, 2 = timer)
+
+RETURNS:
+- Number of merges performed
+*/
+int coalesceDeferred(MemoryManager *mm, int trigger);
+
+
 /*
 --------------------------------------------------------------------------------
 FUNCTION: resetMemory
@@ -446,6 +480,33 @@ PARAMETERS:
 void resetMemory(MemoryManager *mm);
 
 
+/*
+--------------------------------------------------------------------------------
+FUNCTION: resizeMemory
+--------------------------------------------------------------------------------
+PURPOSE: Reset memory with NEW total/OS sizes (POST /api/reset with
+         "total"/"osReserve", or --total/--os-reserve at startup)
+
+PARAMETERS:
+- mm: Pointer to MemoryManager
+- totalMem: New total memory in KB
+- osMem: New OS reserve in KB (0 < osMem < totalMem; use
+  checkPoolSizes() first)
+*/
+void resizeMemory(MemoryManager *mm, int totalMem, int osMem);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: checkPoolSizes
+--------------------------------------------------------------------------------
+PURPOSE: Validate explicit pool sizes
+
+RETURNS: NULL if usable, otherwise a message saying what is wrong
+*/
+const char* checkPoolSizes(int totalMem, int osMem);
+
+
 /*
 ================================================================================
 JSON / API HELPER FUNCTIONS
@@ -473,7 +534,13 @@ OUTPUT FORMAT:
   "totalAllocations": 5,
   "totalDeallocations": 2,
   "totalCompactions": 1,
-  "useBuddySystem": false
+  "useBuddySystem": false,
+  "usePagedMode": true,
+  "paged": {"frameSizeKB":4,"frames":192,"freeFrames":90,"internalFragmentationKB":6},
+  "residentPages": 13,
+  "faults": {"allocate":{...},"deallocate":{...},"compact":{...},"lastOp":{...}},
+  "translation": [{"pageSizeKB":4,"levels":4,"tlbMisses":81234,"missRate":0.016,...}],
+  "slab": {"caches":2,"slabs":5,"utilization":0.81,"internalFragmentationBytes":640,...}
 }
 
 PARAMETERS:
@@ -484,6 +551,35 @@ PARAMETERS:
 void getStatsJSON(MemoryManager *mm, char *buffer, int bufferSize);
 
 
+/*
+--------------------------------------------------------------------------------
+FUNCTION: getResidencyJSON
+--------------------------------------------------------------------------------
+PURPOSE: Report page residency of every block and page-fault cost per operation
+
+WHAT IT DOES:
+1. Scans the whole backingRegion with a single mincore() call
+2. Counts resident pages inside each block's realPtr range
+3. Adds minor/major fault deltas (getrusage) for allocate, deallocate,
+   compact and the last operation
+
+OUTPUT FORMAT:
+{
+  "pageSize": 16384,
+  "backingPages": 48,
+  "residentPages": 13,
+  "blocks": [{"blockID":1,"processId":"P1","startAddress":256,"pages":7,"residentPages":7}],
+  "faults": {"allocate":{"minor":7,"major":0,"ops":1}, ...}
+}
+
+PARAMETERS:
+- mm: Pointer to MemoryManager
+- buffer: Output buffer for the JSON string
+- bufferSize: Size of the output buffer
+*/
+void getResidencyJSON(MemoryManager *mm, char *buffer, int bufferSize);
+
+
 /*
 --------------------------------------------------------------------------------
 FUNCTION: nextPowerOf2
@@ -499,11 +595,31 @@ EXAMPLES:
 PARAMETERS:
 - n: The number to round up
 
-RETURNS: Next power of 2 >= n
+RETURNS: Next power of 2 >= n (n at most BUDDY_MAX_KB, larger n overflow)
 */
 int nextPowerOf2(int n);
 
 
+// Largest buddy block: the largest power of 2 an int holds (1 TB in KB).
+// Pools up to 2 TB are accepted; their buddy area stops at this size.
+#define BUDDY_MAX_KB (1 << 30)
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: buddyPoolSize
+--------------------------------------------------------------------------------
+PURPOSE: Size of the buddy area for a pool: the largest power of 2 that
+         fits in userMemory (at most BUDDY_MAX_KB, so it never overflows)
+
+EXAMPLES:
+  buddyPoolSize(768)  → 512
+  buddyPoolSize(1024) → 1024
+  buddyPoolSize(1.5 TB in KB) → BUDDY_MAX_KB
+*/
+int buddyPoolSize(int userMemory);
+
+
 // End of header guard
 #endif
 
@@ -530,8 +646,10 @@ WHAT WE DECLARED:
 15. convertToBuddySystem() - Switch to buddy system
 16. revertFromBuddySystem() - Switch back to standard
 17. resetMemory() - Reset to initial state
-18. getStatsJSON() - Memory stats as JSON
-19. nextPowerOf2() - Helper for buddy system
+18. getResidencyJSON() - Page residency + fault costs as JSON
+19. getStatsJSON() - Memory stats as JSON
+20. nextPowerOf2() - Helper for buddy system
+21. buddyPoolSize() - Buddy area of a pool (largest power of 2 that fits)
 
 NEXT FILE: src/memory_manager.c
 This will implement all these functions!
@@ -149,6 +149,54 @@ typedef struct Process {
 } Process;
 
 
+/*
+================================================================================
+STRUCTURE: OpFaultStats
+================================================================================
+PURPOSE: Page-fault cost of one kind of operation (allocate, free, compact)
+
+THINK OF IT LIKE:
+A meter on each kind of job. Every time an allocation runs, we read the
+kernel's fault counters before and after and add the difference here.
+
+WHY?
+The memset() fills and the memmove() in compaction touch real pages.
+The first touch of an mmap() page is a minor fault; a page that was
+swapped out costs a major fault. These counters show what each kind
+of operation really costs the OS.
+*/
+
+typedef struct OpFaultStats {
+    long minorFaults;   // Sum of ru_minflt deltas
+    long majorFaults;   // Sum of ru_majflt deltas
+    int  samples;       // How many operations were measured
+} OpFaultStats;
+
+
+/*
+================================================================================
+STRUCTURE: TranslationSummary
+================================================================================
+PURPOSE: Headline numbers of the latest address-translation run
+
+One summary per page size of the run (e.g. 4 KB and 2 MB side by side),
+so /api/stats can show how the TLB miss rate changes with page size.
+*/
+
+#define MAX_TRANSLATION_SUMMARIES 4
+
+typedef struct TranslationSummary {
+    int       pageSizeKB;       // Page size of this run
+    int       levels;           // Page table levels
+    int       tlbEntries;       // TLB entries
+    int       tlbWays;          // TLB associativity
+    long long translations;     // Addresses translated
+    long long tlbMisses;        // Translations that walked the page table
+    long long walkAccesses;     // Page-table memory accesses (misses * levels)
+    double    translationsPerSecond;
+} TranslationSummary;
+
+
 /*
 ================================================================================
 STRUCTURE 3: MemoryManager
@@ -247,6 +295,75 @@ typedef struct MemoryManager {
     // Example: backingRegion.basePtr = 0x104000000, size = 786432 bytes
     OSRegion backingRegion;
     
+    // FIELD 15: allocFaults / deallocFaults / compactFaults
+    // Purpose: Page faults caused by each kind of operation (via getrusage)
+    // Example: allocFaults.minorFaults = 192 after three 256 KB allocations
+    OpFaultStats allocFaults;
+    OpFaultStats deallocFaults;
+    OpFaultStats compactFaults;
+    
+    // FIELD 16: lastOpFaults
+    // Purpose: Fault delta of the most recent measured operation only
+    OpFaultStats lastOpFaults;
+    
+    // FIELD 17: usePagedMode
+    // Purpose: Is non-contiguous (paged) allocation active?
+    // Value: 0 = contiguous blocks (head list), 1 = frames via 'paged'
+    int usePagedMode;
+    
+    // FIELD 18: paged
+    // Purpose: Frame bitmap and page tables while usePagedMode is 1
+    // In paged mode the block list is empty (head = NULL)
+    struct PagedAllocator *paged;
+    
+    // FIELD 19: translation / numTranslationSummaries
+    // Purpose: Results of the latest /api/tlb run (one per page size)
+    // Example: [{4 KB: 1.6% misses}, {2048 KB: 0.01% misses}]
+    TranslationSummary translation[MAX_TRANSLATION_SUMMARIES];
+    int numTranslationSummaries;
+    
+    // FIELD 20: slabs
+    // Purpose: Slab caches (NULL until the first cache is created)
+    // Slabs are ordinary process blocks in the list above
+    struct SlabLayer *slabs;
+    
+    // FIELD 21: layoutGeneration
+    // Purpose: Bumped whenever existing blocks move (compaction, mode
+    // conversions), so layers that cache block addresses can refresh them
+    int layoutGeneration;
+    
+    // FIELD 22: useBoundaryTags / tags
+    // Purpose: Is the boundary-tag engine active? Its headers and footers
+    // live inside backingRegion; the block list is empty (head = NULL)
+    int useBoundaryTags;
+    struct BoundaryTagHeap *tags;
+    
+    // FIELD 23: measureFaults
+    // Purpose: 1 = sample page faults around every operation (default),
+    // 0 = skip the getrusage() calls (scratch managers in benchmarks)
+    int measureFaults;
+    
+    // FIELD 24: quick
+    // Purpose: Quick lists of deferred-coalescing mode
+    // NULL = every free merges with its neighbours immediately
+    struct QuickLists *quick;
+    
+    // FIELD 25: history
+    // Purpose: Op log and checkpoints for time travel (NULL = not
+    // recording; scratch managers never record)
+    struct History *history;
+    
+    // FIELD 26: admission
+    // Purpose: Queue of allocations waiting for room (NULL until the
+    // first request waits or a policy is set)
+    struct AdmissionQueue *admission;
+    
+    // FIELD 27: metadataOnly
+    // Purpose: 1 = never map a backing region, not even when a buddy
+    // conversion rebuilds the layout (history replay: addresses only,
+    // realPtr stays NULL, no real bytes are mapped or filled)
+    int metadataOnly;
+    
 } MemoryManager;
 
 
@@ -302,6 +419,16 @@ void blockToJSON(MemoryBlock *block, char *buffer, int bufferSize);
 void blocksToJSON(MemoryManager *mm, char *buffer, int bufferSize);
 
 
+// FUNCTION 5: blocksToArray
+// Purpose: Copy the same blocks (without the OS block) into an array
+// Parameters:
+//   - mm: pointer to MemoryManager
+//   - blocks: output array ('next' is NULL in every copy)
+//   - maxBlocks: size of the array
+// Returns: How many blocks there are (only maxBlocks of them are copied)
+int blocksToArray(MemoryManager *mm, MemoryBlock *blocks, int maxBlocks);
+
+
 // End of header guard
 #endif
 
@@ -313,12 +440,15 @@ END OF FILE: memory_structures.h
 SUMMARY OF WHAT WE DEFINED:
 1. MemoryBlock structure - represents one piece of memory (+ blockID, buddyID)
 2. Process structure - represents a program needing memory
-3. MemoryManager structure - manages all memory blocks (+ stats & buddy fields)
-4. Four function declarations:
+3. OpFaultStats structure - page-fault cost per kind of operation
+4. TranslationSummary structure - latest TLB / page-walk results
+5. MemoryManager structure - manages all memory blocks (+ stats, buddy & paged fields)
+6. Five function declarations:
    - createBlock() - now takes MemoryManager* for auto block IDs
    - displayBlock() - print block info
    - blockToJSON() - serialize block to JSON
    - blocksToJSON() - serialize all blocks to JSON array
+   - blocksToArray() - copy all blocks into an array
 
 NEXT FILE: memory_structures.c (will implement these functions)
 ================================================================================
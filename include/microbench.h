@@ -0,0 +1,103 @@
+/*
+================================================================================
+FILE: microbench.h
+PURPOSE: Microbenchmarks of the core engine functions, one at a time
+DESCRIPTION:
+    - The other benchmarks time whole paths (an HTTP request, a binary
+      round trip, a compaction with its memcpy). These time ONE engine
+      function on a heap of a chosen SHAPE, so a change to that function
+      can be shown to help (or not) with numbers
+    - A shape is: how many blocks, which fraction of them are holes, and
+      how far block sizes spread around the mean
+    - Every heap is a scratch manager without a backing region (realPtr
+      NULL, like the simulation's): no real bytes are filled, so the
+      numbers are the list work the function does, nothing else
+    - Per function and shape: a calibration sample picks how many calls
+      one sample times, WARMUP samples are thrown away, REPETITIONS
+      samples are kept and summarized (min, median, mean with its 95%
+      confidence interval, coefficient of variation, max)
+    - Functions that change the heap get a fresh copy of it before every
+      sample (restored from an image, not timed)
+================================================================================
+*/
+
+#ifndef MICROBENCH_H
+#define MICROBENCH_H
+
+
+// Values one shape dimension (--bench-blocks, ...) can list
+#define MICROBENCH_MAX_VALUES 8
+
+// Largest block count of a shape
+#define MICROBENCH_MAX_BLOCKS 1000000
+
+// Mean block size of every shape (KB)
+#define MICROBENCH_MEAN_KB 64
+
+
+/*
+================================================================================
+STRUCTURE: MicrobenchConfig
+================================================================================
+PURPOSE: Which functions, on which shapes, how many samples
+
+Every combination of blockCounts x holeRatios x spreads is one shape.
+holeRatio 0.25 = a quarter of the blocks are holes, placed at random (at
+most 0.5: holes are never neighbours, the engine would have merged them).
+spread 0.5 = sizes uniform in [32, 96] KB around the 64 KB mean.
+
+EXAMPLE:
+only = "firstFit,deallocateMemory"   → firstFit and all four merge cases
+only = "deallocateMemory/both"       → just the case that merges twice
+*/
+
+typedef struct {
+    const char *only;           // Comma-separated names or prefixes (NULL: all)
+    int    blockCounts[MICROBENCH_MAX_VALUES];
+    int    numBlockCounts;
+    double holeRatios[MICROBENCH_MAX_VALUES];
+    int    numHoleRatios;
+    double spreads[MICROBENCH_MAX_VALUES];
+    int    numSpreads;
+    int    repetitions;         // Samples kept per function and shape
+    int    warmup;              // Samples thrown away first
+    unsigned long long seed;    // Same seed = same heaps
+} MicrobenchConfig;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: microbenchDefaults
+--------------------------------------------------------------------------------
+PURPOSE: 100 / 1000 / 10000 blocks, 10% / 30% holes, spread 0 / 0.5,
+         30 repetitions after 5 warmup samples, every function
+*/
+void microbenchDefaults(MicrobenchConfig *config);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: microbenchParseList
+--------------------------------------------------------------------------------
+PURPOSE: "100,1000,10000" → values[] (for the --bench-* options)
+
+RETURNS: Number of values, or -1 if the text is not a list of numbers
+         or has more than maxValues of them
+*/
+int microbenchParseList(const char *text, double *values, int maxValues);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: runMicrobenchmarks
+--------------------------------------------------------------------------------
+PURPOSE: Run every selected function on every shape, print one table per
+         shape to stdout (times in nanoseconds per call)
+
+RETURNS: 0, or 1 if the configuration is invalid or 'only' selects nothing
+         (message on stderr)
+*/
+int runMicrobenchmarks(const MicrobenchConfig *config);
+
+
+#endif /* MICROBENCH_H */
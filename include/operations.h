@@ -0,0 +1,55 @@
+/*
+================================================================================
+FILE: operations.h
+PURPOSE: The allocate / deallocate operations shared by every front end
+DESCRIPTION:
+    - The HTTP routes, the batch routes, the script runner and the local
+      transport all turn "allocate N KB" and "free PID" into the same
+      engine calls: pick buddy or list allocation, take the next PID,
+      refuse to free a slab directly
+    - These two functions are that one place; a front end only parses
+      its own request format and formats its own answer
+    - The caller holds whatever keeps mm still (the server's state lock)
+================================================================================
+*/
+
+#ifndef OPERATIONS_H
+#define OPERATIONS_H
+
+#include "memory_manager.h"     // MemoryManager, AllocationAlgorithm
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: opAllocate
+--------------------------------------------------------------------------------
+PURPOSE: Allocate 'sizeKB' for a new process
+
+The process gets the next PID (mm->processCounter) even when the
+allocation fails, exactly as POST /api/allocate always did. In buddy
+mode 'algorithm' is ignored (buddyAllocate() picks the block).
+
+PARAMETERS:
+- processID: Receives the PID that was used (may be NULL)
+
+RETURNS: Start address, or -1 if there was no room (or sizeKB <= 0)
+*/
+int opAllocate(MemoryManager *mm, int sizeKB, AllocationAlgorithm algorithm,
+               int *processID);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: opDeallocate
+--------------------------------------------------------------------------------
+PURPOSE: Free process 'processID' (buddy or list mode)
+
+RETURNS:
+-  1: Freed
+-  0: No such process
+- -1: The process is a slab; its cache frees it (see slab_cache.h)
+*/
+int opDeallocate(MemoryManager *mm, int processID);
+
+
+#endif /* OPERATIONS_H */
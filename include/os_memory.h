@@ -67,6 +67,8 @@ RETURNS:
 SYSTEM CALL USED:
     mmap(NULL, alignedSize, PROT_READ | PROT_WRITE,
          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+    (plus MAP_NORESERVE / MADV_HUGEPAGE for large regions, and no call
+    at all for regions os_backing_for() rejects)
 */
 OSRegion os_region_alloc(size_t sizeBytes);
 
@@ -163,4 +165,123 @@ SYSTEM CALLS USED:
 void os_detect_memory_sizes(int *totalMemKB, int *osMemKB);
 
 
+/*
+--------------------------------------------------------------------------------
+FUNCTION: os_size_to_kb
+--------------------------------------------------------------------------------
+PURPOSE: Convert an explicit pool size (--total 4 --unit GB) into KB,
+         the unit every address in the simulator uses
+
+PARAMETERS:
+- value: The number given by the user
+- unit:  "KB", "MB" or "GB" (any case); NULL or "" means KB
+
+RETURNS:
+- Size in KB
+- -1 if the unit is unknown, the value is not positive, or the result
+  does not fit an int (2^31 KB = 2 TB)
+*/
+int os_size_to_kb(long long value, const char *unit);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: os_backing_for / os_backing_name
+--------------------------------------------------------------------------------
+PURPOSE: How a region of this size is backed by os_region_alloc()
+
+- OS_BACKING_MMAP:       below OS_LARGE_REGION_BYTES; plain demand-paged
+                         mmap() as always
+- OS_BACKING_MMAP_LARGE: MAP_NORESERVE (no swap reserved up front) and,
+                         on Linux, MADV_HUGEPAGE so the TLB covers the
+                         region with 2 MB pages
+- OS_BACKING_NONE:       more than half of physical RAM; allocations
+                         fill their bytes, so such a pool could never be
+                         filled. No region is mapped and the manager runs
+                         in simulated mode (realPtr NULL)
+
+os_backing_name: "mmap", "mmap_large" or "none"
+*/
+#define OS_LARGE_REGION_BYTES ((size_t)64 * 1024 * 1024)
+
+typedef enum {
+    OS_BACKING_MMAP,
+    OS_BACKING_MMAP_LARGE,
+    OS_BACKING_NONE
+} OSBackingKind;
+
+OSBackingKind os_backing_for(size_t sizeBytes);
+const char* os_backing_name(OSBackingKind kind);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: os_region_residency
+--------------------------------------------------------------------------------
+PURPOSE: Ask the kernel which pages of a region are currently resident in RAM
+
+WHAT IT DOES:
+1. Computes how many pages the region spans
+2. Issues ONE mincore() call covering the whole region
+3. Writes one byte per page into vec (bit 0 set = page is resident)
+
+PARAMETERS:
+- region: The OSRegion to scan (usually mm->backingRegion)
+- vec:    Output array, one byte per page
+- vecLen: Capacity of vec in bytes
+
+RETURNS:
+- Number of pages written into vec
+- 0 on failure (NULL region, vec too small, or mincore() error)
+
+SYSTEM CALL USED:
+    mincore(region->basePtr, region->size, vec)
+*/
+size_t os_region_residency(const OSRegion *region, unsigned char *vec, size_t vecLen);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: os_get_fault_counts
+--------------------------------------------------------------------------------
+PURPOSE: Read the page-fault counters the kernel keeps for this process
+
+WHAT IT DOES:
+    Minor faults are resolved without disk I/O (e.g. the first touch of a
+    zero-filled mmap() page). Major faults needed I/O (swap-in). Sampling
+    these before and after an operation gives that operation's fault cost.
+
+PARAMETERS:
+- minorFaults: Output - cumulative minor faults (ru_minflt)
+- majorFaults: Output - cumulative major faults (ru_majflt)
+
+SYSTEM CALL USED:
+    getrusage(RUSAGE_THREAD) where available, otherwise getrusage(RUSAGE_SELF)
+*/
+void os_get_fault_counts(long *minorFaults, long *majorFaults);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: os_cache_counter_open / os_cache_counter_read / os_cache_counter_close
+--------------------------------------------------------------------------------
+PURPOSE: Count last-level cache misses of this thread (hardware counter)
+
+WHAT IT DOES:
+    Opens a perf_event counter for PERF_COUNT_HW_CACHE_MISSES (user space
+    only). Reading it before and after a loop gives that loop's misses.
+
+RETURNS:
+- open: a counter handle (>= 0), or -1 if unavailable (macOS, containers
+  without perf access, perf_event_paranoid too strict)
+- read: the cumulative miss count, or -1 on error
+
+SYSTEM CALL USED:
+    perf_event_open() (Linux only)
+*/
+int os_cache_counter_open(void);
+long long os_cache_counter_read(int counter);
+void os_cache_counter_close(int counter);
+
+
 #endif /* OS_MEMORY_H */
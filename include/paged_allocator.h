@@ -0,0 +1,198 @@
+/*
+================================================================================
+FILE: paged_allocator.h
+PURPOSE: Non-contiguous (paged) allocation mode
+DESCRIPTION:
+    - User memory is cut into equal frames; a process gets ANY free frames,
+      not one contiguous hole
+    - A free-frame bitmap makes allocation O(pages): find free bits with
+      count-trailing-zeros, no hole list to search
+    - A per-process page table maps the process's virtual KB to frames
+    - There is no external fragmentation, so compaction is never needed;
+      the price is internal fragmentation in each process's last frame
+    - Includes a head-to-head comparison against first/best/worst fit and
+      the buddy system on the same operation stream
+================================================================================
+*/
+
+#ifndef PAGED_ALLOCATOR_H
+#define PAGED_ALLOCATOR_H
+
+#include <stdint.h>                 // uint64_t
+#include "memory_structures.h"      // MemoryManager
+
+
+/*
+================================================================================
+STRUCTURE: PagedProcess
+================================================================================
+PURPOSE: The page table of one process
+
+EXAMPLE (4 KB frames):
+P3 asks for 10 KB → 3 pages. If frames 7, 2 and 19 were free:
+pageTable = {7, 2, 19}
+Virtual KB 5 → page 1 → frame 2 → physical offset 2*4 + (5 % 4) = 9 KB
+*/
+
+typedef struct {
+    int  processID;     // -1 = this slot is unused
+    int  sizeKB;        // Size the process asked for
+    int  numPages;      // ceil(sizeKB / frameSizeKB)
+    int *pageTable;     // pageTable[virtualPage] = frame number
+} PagedProcess;
+
+
+/*
+================================================================================
+STRUCTURE: PagedAllocator
+================================================================================
+PURPOSE: Frame bitmap, frame owners and the page tables of all processes
+
+BITMAP:
+Bit f of freeBitmap is 1 when frame f is free. One 64-bit word covers 64
+frames, so __builtin_ctzll() finds the next free frame in one instruction.
+
+PROCESS TABLE:
+Indexed directly by process ID (IDs are small increasing integers), so
+finding a process's page table is one array access.
+*/
+
+typedef struct PagedAllocator {
+    int       frameSizeKB;      // Size of one frame in KB
+    int       numFrames;        // Frames in user memory
+    int       freeFrames;       // Frames currently free
+    int       numWords;         // Words in freeBitmap
+    uint64_t *freeBitmap;       // 1 bit per frame, 1 = free
+    int      *frameOwner;       // frameOwner[f] = PID, or -1 if free
+    int       searchCursor;     // Bitmap word where the next search starts
+    PagedProcess *processes;    // Indexed by process ID
+    int       processCapacity;  // Length of processes[]
+    long long internalFragKB;   // Unused KB in last frames of live processes
+    char     *base;             // Start of the backing region (may be NULL)
+} PagedAllocator;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: createPagedAllocator / destroyPagedAllocator
+--------------------------------------------------------------------------------
+PURPOSE: Set up (or tear down) the frame bitmap for userMemoryKB of memory
+
+PARAMETERS:
+- userMemoryKB: Memory to manage (leftover KB smaller than a frame is unused)
+- frameSizeKB: Frame size in KB (e.g. 4)
+- base: Backing region start, frames are base + f * frameSizeKB * 1024
+
+RETURNS: New allocator, or NULL on bad parameters / out of memory
+*/
+PagedAllocator* createPagedAllocator(int userMemoryKB, int frameSizeKB, void *base);
+void destroyPagedAllocator(PagedAllocator *pa);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: pagedAllocate
+--------------------------------------------------------------------------------
+PURPOSE: Give a process enough frames for sizeKB, wherever they are
+
+RETURNS:
+- The frame number of the process's first page (success)
+- -1 if there are not enough free frames or the PID is already present
+*/
+int pagedAllocate(PagedAllocator *pa, int processID, int sizeKB);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: pagedDeallocate
+--------------------------------------------------------------------------------
+PURPOSE: Return all frames of a process to the bitmap
+
+RETURNS: 1 if the process was found and freed, 0 otherwise
+*/
+int pagedDeallocate(PagedAllocator *pa, int processID);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: pagedTranslate
+--------------------------------------------------------------------------------
+PURPOSE: Translate a process's virtual KB offset to a physical KB offset
+
+RETURNS: Offset in KB from the start of user memory, or -1 if unmapped
+*/
+long pagedTranslate(const PagedAllocator *pa, int processID, int virtualKB);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: pagedFreeRuns / pagedLargestFreeRun
+--------------------------------------------------------------------------------
+PURPOSE: Describe how the free frames are scattered (for statistics only;
+         a paged allocator can use every free frame regardless)
+*/
+int pagedFreeRuns(const PagedAllocator *pa);
+int pagedLargestFreeRun(const PagedAllocator *pa);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: pagedBlocksToJSON
+--------------------------------------------------------------------------------
+PURPOSE: Render frames as blocks for /api/blocks
+
+Consecutive frames with the same owner are merged into one block, so the
+visualizer shows a process as several pieces when its frames are scattered.
+*/
+void pagedBlocksToJSON(const PagedAllocator *pa, int osMemory, char *buffer, int bufferSize);
+
+// The same blocks into an array (at most maxBlocks); RETURNS: how many there are
+int pagedBlocksToArray(const PagedAllocator *pa, int osMemory,
+                       MemoryBlock *blocks, int maxBlocks);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: convertToPagedMode / revertFromPagedMode
+--------------------------------------------------------------------------------
+PURPOSE: Switch the MemoryManager between contiguous and paged allocation
+
+convertToPagedMode re-allocates every current process with paged
+allocation (same PIDs). revertFromPagedMode re-allocates them with
+first fit, like revertFromBuddySystem.
+
+RETURNS: 1 on success, 0 on failure (result JSON explains why)
+*/
+int convertToPagedMode(MemoryManager *mm, int frameSizeKB, char *resultBuffer, int bufferSize);
+int revertFromPagedMode(MemoryManager *mm, char *resultBuffer, int bufferSize);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: comparePlacementModes
+--------------------------------------------------------------------------------
+PURPOSE: Replay ONE operation stream on first fit, best fit, worst fit,
+         buddy and paged allocation, and compare fragmentation and latency
+
+WHAT IT DOES:
+1. Generates a seeded allocate/free stream (see generateOpStream)
+2. For each engine, builds a fresh memory of the same size as mm
+3. Times every operation and samples fragmentation as it goes
+
+PARAMETERS:
+- mm: Supplies the memory size (it is not modified)
+- ops: Length of the stream
+- minSizeKB / maxSizeKB: Allocation size range
+- freePercent: Chance (0-100) that a step frees instead of allocates
+- frameSizeKB: Frame size for the paged engine
+- seed: Workload seed
+- resultBuffer / bufferSize: JSON output
+
+RETURNS: 1 on success, 0 on bad parameters
+*/
+int comparePlacementModes(MemoryManager *mm, int ops, int minSizeKB, int maxSizeKB,
+                          int freePercent, int frameSizeKB, unsigned long long seed,
+                          char *resultBuffer, int bufferSize);
+
+
+#endif /* PAGED_ALLOCATOR_H */
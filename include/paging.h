@@ -0,0 +1,211 @@
+/*
+================================================================================
+FILE: paging.h
+PURPOSE: Demand-paging simulator with page replacement algorithms
+DESCRIPTION:
+    - Gives every allocated process a virtual address space split into pages
+    - Carves physical frames out of the free holes of the backingRegion
+    - Replays a page reference string through six replacement policies:
+      FIFO, LRU, Clock, Second-Chance, LFU and Belady's OPT
+    - Reports page faults, fault rate and references processed per second
+================================================================================
+*/
+
+#ifndef PAGING_H
+#define PAGING_H
+
+#include <stdint.h>              // uint32_t
+#include "memory_manager.h"
+
+
+/*
+================================================================================
+ENUMERATION: PageReplacementAlgorithm
+================================================================================
+PURPOSE: Which page gets thrown out when all frames are full?
+
+FIFO          - The page that was loaded first (oldest resident)
+LRU           - The page that was used least recently
+CLOCK         - Circular scan, skipping (and clearing) recently used pages
+SECOND_CHANCE - FIFO queue, but a recently used page goes to the back once
+LFU           - The page used the fewest times (ties: least recently loaded)
+OPT           - The page whose next use is furthest in the future (Belady).
+                Needs to know the future, so it is the theoretical best.
+*/
+
+typedef enum {
+    PAGE_FIFO,
+    PAGE_LRU,
+    PAGE_CLOCK,
+    PAGE_SECOND_CHANCE,
+    PAGE_LFU,
+    PAGE_OPT
+} PageReplacementAlgorithm;
+
+#define NUM_PAGE_ALGORITHMS 6
+
+
+/*
+================================================================================
+STRUCTURE: PagingSpace
+================================================================================
+PURPOSE: The virtual pages and physical frames one simulation runs on
+
+THINK OF IT LIKE:
+Every process gets a row of numbered lockers (virtual pages). The frames
+are the real shelves in the storeroom (backing region). The page table
+says which shelf currently holds which locker's contents.
+
+GLOBAL PAGE NUMBERS:
+Page p of process i is numbered pageBase[i] + p, so one flat array can
+hold the page tables of all processes side by side.
+*/
+
+typedef struct {
+    int   numProcesses;     // Processes that take part
+    int  *processIDs;       // processIDs[i] = PID of process i
+    int  *pageBase;         // First global page number of process i
+    int  *pageCount;        // Number of virtual pages of process i
+    int   totalPages;       // Sum of pageCount[]
+    int   pageSizeKB;       // Page (and frame) size in KB
+    int   numFrames;        // Physical frames available
+    char **framePtr;        // Real address of each frame (NULL if unbacked)
+} PagingSpace;
+
+
+/*
+================================================================================
+STRUCTURE: PagingResult
+================================================================================
+PURPOSE: Outcome of replaying one reference string with one algorithm
+*/
+
+typedef struct {
+    PageReplacementAlgorithm algorithm;
+    long long references;       // References replayed
+    long long faults;           // Page not resident → had to be loaded
+    long long evictions;        // Faults that had to throw out another page
+    double    elapsedSeconds;   // Wall time of the replay loop only
+    double    refsPerSecond;    // references / elapsedSeconds
+    double    faultRate;        // faults / references
+} PagingResult;
+
+
+/*
+================================================================================
+STRUCTURE: PagingConfig
+================================================================================
+PURPOSE: Parameters of one simulation run (from the API request)
+*/
+
+typedef struct {
+    int pageSizeKB;             // Page size in KB (default 4)
+    int frames;                 // Max frames to use, 0 = every frame available
+    int length;                 // Reference string length (default 1,000,000)
+    int localityPercent;        // Working-set locality 0-100 (default 90)
+    unsigned long long seed;    // Workload seed (same seed → same string)
+} PagingConfig;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: pageAlgorithmName / parsePageAlgorithm
+--------------------------------------------------------------------------------
+PURPOSE: Convert between the enum and API names ("fifo", "lru", "clock",
+         "second_chance", "lfu", "opt")
+
+parsePageAlgorithm returns -1 for an unknown name.
+*/
+const char* pageAlgorithmName(PageReplacementAlgorithm algo);
+int parsePageAlgorithm(const char *name);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: buildPagingSpace
+--------------------------------------------------------------------------------
+PURPOSE: Set up page tables for the current processes and carve frames
+
+WHAT IT DOES:
+1. Every allocated block becomes a process with ceil(size / pageSizeKB) pages
+2. Every free hole is cut into whole frames of pageSizeKB, pointing into
+   the backing region (so frames never overlap live process data)
+3. If maxFrames > 0, only the first maxFrames frames are used
+
+RETURNS:
+- 0 on success
+- -1 if there are no processes, no frames, or memory ran out
+*/
+int buildPagingSpace(MemoryManager *mm, int pageSizeKB, int maxFrames, PagingSpace *space);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: freePagingSpace
+--------------------------------------------------------------------------------
+PURPOSE: Release the arrays allocated by buildPagingSpace
+*/
+void freePagingSpace(PagingSpace *space);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: simulatePaging
+--------------------------------------------------------------------------------
+PURPOSE: Replay a reference string with one replacement algorithm
+
+PERFORMANCE NOTES:
+- Page tables are flat arrays indexed by global page number (a perfect
+  hash), so a hit is one array load
+- LRU and LFU keep intrusive lists threaded through the frame arrays,
+  so every hit and every eviction is O(1)
+- OPT precomputes "next use" indices in one backward pass and keeps the
+  frames in a max-heap by next use (O(log frames) per reference)
+
+PARAMETERS:
+- space: Pages and frames (from buildPagingSpace)
+- refs: Global page numbers to reference
+- length: Number of references
+- algo: Replacement algorithm
+- result: Output statistics
+
+RETURNS:
+- 0 on success, -1 if working memory could not be allocated
+*/
+int simulatePaging(const PagingSpace *space, const uint32_t *refs, int length,
+                   PageReplacementAlgorithm algo, PagingResult *result);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: runPagingSimulation
+--------------------------------------------------------------------------------
+PURPOSE: Build a paging space, generate a reference string, run, report JSON
+
+PARAMETERS:
+- mm: Pointer to MemoryManager (processes and holes are read, not changed)
+- config: Run parameters
+- algorithm: One algorithm name, or "all" to compare all six on the SAME string
+- resultBuffer: Buffer for JSON result
+- bufferSize: Size of result buffer
+
+RETURNS:
+- 1 if the simulation ran
+- 0 on bad parameters or if there is nothing to page
+
+RESULT JSON FORMAT:
+{
+  "success": true,
+  "pageSizeKB": 4, "frames": 120, "virtualPages": 75, "processes": 3,
+  "references": 1000000, "localityPercent": 90, "seed": 1,
+  "results": [
+    {"algorithm":"lru","faults":5123,"evictions":5003,"faultRate":0.0051,
+     "elapsedMs":21.4,"refsPerSecond":46728971}
+  ]
+}
+*/
+int runPagingSimulation(MemoryManager *mm, const PagingConfig *config,
+                        const char *algorithm, char *resultBuffer, int bufferSize);
+
+
+#endif /* PAGING_H */
@@ -0,0 +1,106 @@
+/*
+================================================================================
+FILE: parallel_copy.h
+PURPOSE: Multi-threaded memmove for large compaction copies
+DESCRIPTION:
+    - One memmove of a multi-megabyte process is limited by what a single
+      core can pull through the memory system
+    - parallelMove() splits big moves into chunks and copies them on a
+      small pool of worker threads (plus the calling thread)
+    - Overlapping slides are done in ordered rounds so no byte is
+      overwritten before it has been read
+    - Moves below a configurable threshold stay a plain memmove
+================================================================================
+*/
+
+#ifndef PARALLEL_COPY_H
+#define PARALLEL_COPY_H
+
+#include <stddef.h>              // size_t
+#include "memory_structures.h"   // MemoryManager
+
+
+// Hard limit on copy threads (the caller counts as one)
+#define PARALLEL_COPY_MAX_THREADS 16
+
+
+/*
+================================================================================
+STRUCTURE: ParallelCopyStats
+================================================================================
+PURPOSE: What parallelMove() has done since the program started
+*/
+
+typedef struct {
+    int       threads;          // Threads per copy (1 = always serial)
+    size_t    thresholdBytes;   // Moves of at least this size go parallel
+    long long parallelMoves;    // Moves split across threads
+    long long serialMoves;      // Moves done with one memmove
+    long long parallelBytes;    // Bytes copied by parallel moves
+    long long rounds;           // Ordered rounds of overlapping moves
+} ParallelCopyStats;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: parallelMove
+--------------------------------------------------------------------------------
+PURPOSE: memmove(dest, src, n), using several threads when n is large
+
+HOW OVERLAP IS HANDLED:
+A slide by distance d = |src - dest| < n is cut into rounds of at most
+d bytes. Inside a round source and destination never overlap, so its
+chunks can be copied in parallel; the rounds run one after another,
+starting at the end the slide moves towards.
+
+EXAMPLE (compaction slides P3 down by 1 MB, n = 6 MB):
+round 1: [0, 1 MB) → 4 threads copy 256 KB each
+round 2: [1, 2 MB) → ... (reads bytes round 1 has not overwritten)
+... 6 rounds in all
+
+Small distances make rounds too small to split; such moves fall back
+to one memmove.
+*/
+void parallelMove(void *dest, const void *src, size_t n);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: setParallelCopyConfig / getParallelCopyStats
+--------------------------------------------------------------------------------
+PURPOSE: Set the thread count (1 .. PARALLEL_COPY_MAX_THREADS) and the
+         threshold in bytes, or read the counters.
+         A value of 0 keeps the current setting.
+
+DEFAULTS: threads = online CPUs (at most 8), threshold = 4 MB
+
+RETURNS: 1 on success, 0 on bad values
+*/
+int setParallelCopyConfig(int threads, size_t thresholdBytes);
+ParallelCopyStats getParallelCopyStats(void);
+void parallelCopyStatsToJSON(char *buffer, int bufferSize);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: benchmarkCompaction
+--------------------------------------------------------------------------------
+PURPOSE: Time compact() on a large scratch heap, serial vs parallel
+
+HOW IT WORKS:
+1. Build a heapMB heap with 'processes' equal blocks, free every other
+   one (every remaining block has to slide)
+2. Compact it with 1 thread, rebuild, compact with the configured pool
+3. Repeat 'runs' times and report the best time of each mode and the
+   speedup
+
+LIMITS: heapMB 16-1024; processes from 2 up to what leaves every block
+64 KB (heapMB * 16); runs 1-10
+
+RETURNS: 1 on success, 0 on bad parameters
+*/
+int benchmarkCompaction(int heapMB, int processes, int runs,
+                        char *resultBuffer, int bufferSize);
+
+
+#endif /* PARALLEL_COPY_H */
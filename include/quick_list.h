@@ -0,0 +1,123 @@
+/*
+================================================================================
+FILE: quick_list.h
+PURPOSE: Deferred coalescing with exact-size quick lists
+DESCRIPTION:
+    - Normally a free merges with its neighbours right away (and the buddy
+      system cascades merges), so freeing and re-allocating one size
+      pays a merge and then a split every time
+    - In deferred mode a freed block stays an unmerged hole and, if it is
+      small enough, is pushed on the quick list for its exact size
+    - Allocation pops that list first: a hit reuses the block as is
+    - A batch coalesce pass merges every hole at once, when too many
+      frees are pending, when an allocation fails, or on a timer
+================================================================================
+*/
+
+#ifndef QUICK_LIST_H
+#define QUICK_LIST_H
+
+#include "memory_structures.h"   // MemoryManager, MemoryBlock
+
+
+// Sizes (KB) with a quick list of their own: 1 .. QUICK_MAX_KB
+#define QUICK_MAX_KB 64
+
+
+/*
+================================================================================
+STRUCTURE: QuickLists
+================================================================================
+PURPOSE: One LIFO stack of free blocks per size, plus pass triggers and
+         hit counters
+
+STALE ENTRIES:
+A fit algorithm may take a block that is still on a quick list, so
+quickPop() checks that the block is a hole of the right size before
+using it. Entries never dangle: every path that free()s MemoryBlock
+nodes (coalesce pass, compaction, mode conversions) empties the lists.
+
+EXAMPLE (maxDeferred = 64, intervalMs = 1000):
+free P3 (8 KB) → hole stays, pushed on bin[8], pending = 1
+alloc 8 KB     → bin[8] pops P3's old block: HIT, no split
+... 64 frees pending → batch pass merges all adjacent holes
+*/
+
+typedef struct QuickLists {
+    MemoryBlock **bins[QUICK_MAX_KB + 1];   // bins[size] = stack of blocks
+    int           count[QUICK_MAX_KB + 1];
+    int           capacity[QUICK_MAX_KB + 1];
+    int           pendingFrees;     // Unmerged frees since the last pass
+    int           maxDeferred;      // Pass when pendingFrees reaches this
+    int           intervalMs;       // Pass when this much time passed (0 = off)
+    long long     lastPassNs;       // CLOCK_MONOTONIC time of the last pass
+    long long     hits;             // Allocations served from a quick list
+    long long     misses;           // Eligible allocations with an empty list
+    long long     pushes;           // Blocks put on a quick list
+    long long     passes;           // Batch coalesce passes
+    long long     pressurePasses;   // ... started by pendingFrees or a failure
+    long long     timerPasses;      // ... started by the timer
+    long long     merges;           // Hole pairs merged by all passes
+} QuickLists;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: enableDeferredCoalescing / disableDeferredCoalescing
+--------------------------------------------------------------------------------
+PURPOSE: Turn deferred mode on (works with first/best/worst fit and the
+         buddy system) or off (one final pass merges everything)
+
+PARAMETERS:
+- maxDeferred: Pending frees that force a pass (1 .. 100000)
+- intervalMs: Timer for a pass (0 = no timer). The server has no timer
+  thread, so the timer is checked at the start of every operation.
+
+RETURNS: 1 on success, 0 on failure (result JSON explains why)
+*/
+int enableDeferredCoalescing(MemoryManager *mm, int maxDeferred, int intervalMs,
+                             char *resultBuffer, int bufferSize);
+int disableDeferredCoalescing(MemoryManager *mm, char *resultBuffer, int bufferSize);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: quickPush / quickPop / quickClear
+--------------------------------------------------------------------------------
+PURPOSE: Stack operations on one size
+
+quickPush: Remember a freed hole (sizes above QUICK_MAX_KB are only
+           counted as pending). Returns 1 if the block went on a list.
+quickPop:  Newest valid hole of exactly sizeKB, or NULL; counts the hit
+           or miss for eligible sizes
+quickClear: Forget every entry and the pending count, restart the timer
+            (after a pass, or when the block list is freed)
+*/
+int quickPush(QuickLists *quick, MemoryBlock *block);
+MemoryBlock* quickPop(QuickLists *quick, int sizeKB);
+void quickClear(QuickLists *quick);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: quickPassDue
+--------------------------------------------------------------------------------
+PURPOSE: Should a batch pass run now?
+
+RETURNS: 0 = no, 1 = too many pending frees, 2 = timer expired
+*/
+int quickPassDue(QuickLists *quick);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: destroyQuickLists / quickListsToJSON
+--------------------------------------------------------------------------------
+PURPOSE: Free the stacks (the blocks themselves belong to the list) /
+         the "quickLists" section of /api/stats ("null" when disabled)
+*/
+void destroyQuickLists(QuickLists *quick);
+void quickListsToJSON(const QuickLists *quick, char *buffer, int bufferSize);
+
+
+#endif /* QUICK_LIST_H */
@@ -0,0 +1,57 @@
+/*
+================================================================================
+FILE: script.h
+PURPOSE: Headless scripted mode - run a file of commands with no menu
+DESCRIPTION:
+    - The interactive menu prints the whole memory map after every step
+      and waits for Enter; the server needs HTTP for every operation
+    - A script runs the same engine calls one line at a time, prints one
+      short result line per command and never pauses, so experiments run
+      at engine speed and the output can be diffed or piped into tools
+    - Usage:
+      ./memory_visualizer --script run.txt     → Commands from a file
+      ./memory_visualizer --script -           → Commands from stdin
+      cat run.txt | ./memory_visualizer --script
+================================================================================
+*/
+
+#ifndef SCRIPT_H
+#define SCRIPT_H
+
+#include <stdio.h>              // FILE
+#include "memory_structures.h"  // MemoryManager
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: runScript
+--------------------------------------------------------------------------------
+PURPOSE: Execute every command of 'in', writing results to 'out'
+
+COMMAND LANGUAGE (one per line, '#' starts a comment):
+alloc <KB> [first|best|worst]   → "P3 187"     (PID and start address)
+                                  "fail 500"   (no hole for 500 KB)
+free <pid>                      → "ok P3" / "fail P3"   (3 or P3)
+compact                         → "ok" / "fail"
+buddy on|off                    → "ok" / "fail"  (convert / revert)
+reset                           → "ok"
+stats                           → the /api/stats JSON on one line
+snapshot                        → the /api/blocks JSON on one line
+
+EXAMPLE:
+alloc 200 best        P1 187
+alloc 100             P2 387
+free P1               ok P1
+stats                 {"totalMemory":...}
+
+Failed allocations are results, not errors. Unknown commands and bad
+arguments are reported on stderr with their line number; the rest of
+the script still runs. A summary (commands, time, ops/s) goes to stderr
+at the end, so stdout holds only the result lines.
+
+RETURNS: Number of lines with errors (0 = the whole script was valid)
+*/
+int runScript(MemoryManager *mm, FILE *in, FILE *out);
+
+
+#endif /* SCRIPT_H */
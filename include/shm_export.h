@@ -0,0 +1,182 @@
+/*
+================================================================================
+FILE: shm_export.h
+PURPOSE: Publish the block table and counters in shared memory, read-only
+DESCRIPTION:
+    - A monitor that polls GET /api/blocks costs the server a request,
+      a JSON rendering and a lock for every look, and the monitor has
+      to parse JSON back into numbers
+    - With --shm-export the server instead writes the table and the
+      counters into one shm_open region after every change. Any number
+      of local processes map it read-only and copy it out whenever they
+      like: no request, no system call, no effect on the server
+    - A SEQLOCK keeps the copies consistent without a lock the readers
+      would have to take (and could hold up the server with):
+
+        writer: sequence++ (odd: writing)  → write  → sequence++ (even)
+        reader: s1 = sequence; copy; s2 = sequence
+                s1 odd or s1 != s2 → the writer was in the middle, copy again
+
+    - shm_reader.h is the reader side (the only part a monitor links);
+      examples/shm_watcher.c is a small monitor built on it
+================================================================================
+*/
+
+#ifndef SHM_EXPORT_H
+#define SHM_EXPORT_H
+
+#include <stdint.h>             // uint32_t, int32_t, uint64_t, int64_t
+#include "memory_structures.h"  // MemoryManager
+
+
+// The shm_open name used when --shm-export is given without one
+#define SHM_EXPORT_DEFAULT_NAME "/memory_visualizer-state"
+
+// Blocks the region has room for (more are counted but not listed)
+#define SHM_EXPORT_MAX_BLOCKS 16384
+
+#define SHM_EXPORT_MAGIC   0x4D565358u      // "MVSX"
+#define SHM_EXPORT_LAYOUT  1                // Changes when the layout does
+
+
+// Allocation mode of the exported state (ShmExportCounters.mode)
+typedef enum {
+    SHM_MODE_LIST  = 0,     // First / best / worst fit on the block list
+    SHM_MODE_BUDDY = 1,
+    SHM_MODE_PAGED = 2,
+    SHM_MODE_TAGS  = 3      // Boundary tags
+} ShmExportMode;
+
+
+/*
+================================================================================
+STRUCTURE: ShmExportCounters / ShmExportBlock
+================================================================================
+PURPOSE: The numbers of GET /api/stats and one row of GET /api/blocks
+
+Addresses and sizes are in KB, as everywhere else. The OS block
+[0, osMemory) is not a row.
+*/
+
+typedef struct {
+    int32_t totalMemory;
+    int32_t osMemory;
+    int32_t userMemory;
+    int32_t freeMemory;
+    int32_t numProcesses;
+    int32_t numHoles;
+    int32_t largestHole;
+    int32_t mode;               // ShmExportMode
+    float   fragmentation;      // Percent
+    int32_t processCounter;     // Last PID handed out
+    int32_t totalAllocations;
+    int32_t totalDeallocations;
+    int32_t totalCompactions;
+    int32_t layoutGeneration;   // Changes whenever blocks move
+} ShmExportCounters;
+
+typedef struct {
+    int32_t startAddress;
+    int32_t size;
+    int32_t processId;          // -1 for a hole
+    int32_t isHole;
+    int32_t blockId;
+    int32_t buddyId;            // -1 outside buddy mode
+} ShmExportBlock;
+
+
+/*
+================================================================================
+STRUCTURE: ShmExportRegion
+================================================================================
+PURPOSE: The whole shared region
+
+The first cache line never changes after creation. 'sequence' and
+everything after it belong to the seqlock.
+
+version      1, 2, 3, ... one per publication (0: nothing published yet)
+publishedNs  CLOCK_MONOTONIC time of the publication (same clock for
+             every process on the machine, so a reader can see its age)
+numBlocks    Rows in blocks[] (at most blockCapacity)
+totalBlocks  Blocks the heap has; more than numBlocks = table cut short
+*/
+
+typedef struct {
+    uint32_t          magic;            // SHM_EXPORT_MAGIC
+    uint32_t          layout;           // SHM_EXPORT_LAYOUT
+    uint32_t          blockCapacity;
+    int32_t           writerPid;
+    char              headerLine[64 - 4 * sizeof(uint32_t)];
+
+    uint32_t          sequence;         // Odd while the writer is inside
+    uint32_t          reserved;
+    uint64_t          version;
+    int64_t           publishedNs;
+    ShmExportCounters counters;
+    int32_t           numBlocks;
+    int32_t           totalBlocks;
+    ShmExportBlock    blocks[];         // blockCapacity rows
+} ShmExportRegion;
+
+// Bytes of a region with room for 'capacity' blocks
+#define SHM_EXPORT_REGION_SIZE(capacity) \
+    (sizeof(ShmExportRegion) + (size_t)(capacity) * sizeof(ShmExportBlock))
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: shmExportStart
+--------------------------------------------------------------------------------
+PURPOSE: Create the region 'name' (replacing one a previous server left)
+
+Readable by every local user, writable only by the server.
+
+RETURNS: 0, or -1 on error (message printed)
+*/
+int shmExportStart(const char *name);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: shmExportPublish
+--------------------------------------------------------------------------------
+PURPOSE: Write the current state into the region (nothing if the export
+         was not started)
+
+The caller keeps mm still (the server holds its state lock). The table
+is collected first, so readers only retry during the copy, not during
+the walk of the heap.
+*/
+void shmExportPublish(MemoryManager *mm);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: shmExportCounters / shmExportRange
+--------------------------------------------------------------------------------
+PURPOSE: The same counters and rows, for one caller instead of the region
+         (the binary protocol answers STATS and BLOCK_RANGE with them)
+
+shmExportCounters: Fill 'counters' from mm
+shmExportRange:    Rows of the blocks overlapping [from, to) KB, at most
+                   maxRows; *next is where the first block left out starts
+                   (-1: none left). RETURNS: rows written
+
+Both work whether or not the export was started. The caller keeps mm
+still.
+*/
+void shmExportCounters(MemoryManager *mm, ShmExportCounters *counters);
+int shmExportRange(MemoryManager *mm, int from, int to,
+                   ShmExportBlock *rows, int maxRows, int *next);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: shmExportName
+--------------------------------------------------------------------------------
+RETURNS: The name given to shmExportStart(), or NULL if not exporting
+*/
+const char* shmExportName(void);
+
+
+#endif /* SHM_EXPORT_H */
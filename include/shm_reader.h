@@ -0,0 +1,69 @@
+/*
+================================================================================
+FILE: shm_reader.h
+PURPOSE: Read the server's shared-memory export (see shm_export.h)
+DESCRIPTION:
+    - For monitors and visualizers on the same machine as a server
+      started with --shm-export: map the region once, then take
+      consistent copies of the counters and the block table as often
+      as you like, without a system call and without the server noticing
+    - Links on its own (src/shm_reader.c), no other part of the engine:
+      gcc -O2 -I include -o build/shm_watcher examples/shm_watcher.c src/shm_reader.c
+================================================================================
+*/
+
+#ifndef SHM_READER_H
+#define SHM_READER_H
+
+#include <stddef.h>         // size_t
+#include "shm_export.h"     // ShmExportRegion, ShmExportCounters, ShmExportBlock
+
+
+typedef struct {
+    const ShmExportRegion *region;      // Mapped read-only
+    size_t                 size;
+} ShmReader;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: shmReaderOpen / shmReaderClose
+--------------------------------------------------------------------------------
+shmReaderOpen: Map the export 'name' (SHM_EXPORT_DEFAULT_NAME if NULL)
+    RETURNS: 0, or -1 (no such export, or a layout this reader does not know)
+shmReaderClose: Unmap it
+*/
+int shmReaderOpen(ShmReader *reader, const char *name);
+void shmReaderClose(ShmReader *reader);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: shmReaderVersion
+--------------------------------------------------------------------------------
+PURPOSE: The publication number right now (one load): poll this and copy
+         only when it changed
+*/
+uint64_t shmReaderVersion(const ShmReader *reader);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: shmReaderRead
+--------------------------------------------------------------------------------
+PURPOSE: Copy one consistent publication
+
+PARAMETERS:
+- counters: Receives the counters
+- blocks / maxBlocks: Receives up to maxBlocks rows (blocks may be NULL
+  with maxBlocks 0 to copy only the counters)
+- version: Receives the publication number (may be NULL)
+
+RETURNS: Rows copied, or -1 if the writer stayed inside the seqlock for
+         the whole time we retried (a server that died mid-publication)
+*/
+int shmReaderRead(const ShmReader *reader, ShmExportCounters *counters,
+                  ShmExportBlock *blocks, int maxBlocks, uint64_t *version);
+
+
+#endif /* SHM_READER_H */
@@ -0,0 +1,153 @@
+/*
+================================================================================
+FILE: simulation.h
+PURPOSE: Discrete-event simulation of processes that come and go
+DESCRIPTION:
+    - Interactive mode only changes memory when someone clicks; here
+      processes ARRIVE (Poisson arrivals), live for a random LIFETIME and
+      are deallocated automatically when it runs out
+    - Time is virtual: the clock jumps straight to the next event, so a
+      simulated hour takes as long as its events take to process
+    - The event calendar is a binary min-heap ordered by event time
+    - Any AllocationAlgorithm (first / best / worst fit) or the buddy
+      system runs on a private scratch manager without a backing region
+      (no real bytes are filled, so millions of events per second are
+      possible)
+    - simulationRun() advances a bounded number of events and returns,
+      so the caller can report progress between steps
+================================================================================
+*/
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "memory_manager.h"   // MemoryManager, AllocationAlgorithm
+#include "workload.h"         // WorkloadRNG
+
+
+// Progress rows kept for one run
+#define SIM_MAX_PROGRESS 100
+
+
+/*
+================================================================================
+STRUCTURE: SimulationConfig
+================================================================================
+PURPOSE: Everything that defines one run (same config + seed = same run)
+
+Interarrival times and lifetimes are exponential with the given means;
+sizes are uniform in [minSizeKB, maxSizeKB].
+*/
+
+typedef struct {
+    AllocationAlgorithm algorithm;      // Ignored when useBuddy is set
+    int                 useBuddy;
+    int                 totalKB;        // Simulated memory (OS part included)
+    int                 osKB;
+    int                 minSizeKB;
+    int                 maxSizeKB;
+    double              meanInterarrivalMs;
+    double              meanLifetimeMs;
+    long long           maxEvents;      // Stop after this many events
+    unsigned long long  seed;
+} SimulationConfig;
+
+
+/*
+================================================================================
+STRUCTURE: SimEvent / SimulationProgress / Simulation
+================================================================================
+SimEvent: One entry of the calendar. seq breaks ties between events at
+          the same time, so runs are deterministic.
+
+EXAMPLE (calendar as a heap, earliest on top):
+            t=12.0 depart P3
+           /                \
+   t=15.5 arrive P9     t=40.2 depart P1
+*/
+
+typedef enum {
+    SIM_ARRIVAL,
+    SIM_DEPARTURE
+} SimEventType;
+
+typedef struct {
+    double    timeMs;
+    long long seq;
+    int       type;         // SimEventType
+    int       processID;    // Departures only
+} SimEvent;
+
+typedef struct {
+    double    timeMs;           // Virtual time of the row
+    long long events;
+    int       live;             // Processes in memory
+    float     fragmentation;
+    float     utilization;      // Time-averaged used / capacity so far (%)
+    long long rejected;
+} SimulationProgress;
+
+typedef struct {
+    SimulationConfig config;
+    MemoryManager    mm;            // Scratch manager (no backing region)
+    WorkloadRNG      rng;
+
+    SimEvent        *heap;          // The event calendar
+    int              heapSize;
+    int              heapCapacity;
+    long long        nextSeq;
+
+    double           nowMs;         // The virtual clock
+    int              nextProcessID;
+    int              capacityKB;    // Free memory of the empty manager
+
+    long long        events;
+    long long        arrivals;
+    long long        departures;
+    long long        rejected;      // Arrivals that found no hole
+    int              live;
+    int              peakLive;
+    double           usedKBms;      // Integral of used KB over virtual time
+    long long        wallNs;        // Time spent inside simulationRun()
+
+    SimulationProgress progress[SIM_MAX_PROGRESS];
+    int                numProgress;
+} Simulation;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: simulationCreate / simulationDestroy
+--------------------------------------------------------------------------------
+PURPOSE: Set up the scratch manager and schedule the first arrival /
+         free everything
+
+RETURNS: NULL on bad parameters or out of memory
+*/
+Simulation* simulationCreate(const SimulationConfig *config);
+void simulationDestroy(Simulation *sim);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: simulationRun
+--------------------------------------------------------------------------------
+PURPOSE: Process up to 'events' more events (fewer if maxEvents is
+         reached), then append a progress row
+
+RETURNS: Events processed by this call (0 = the run is finished)
+*/
+long long simulationRun(Simulation *sim, long long events);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: simulationToJSON
+--------------------------------------------------------------------------------
+PURPOSE: Config, progress rows and totals (events/s of wall time, mean
+         utilization, rejection rate, peak live processes)
+*/
+void simulationToJSON(const Simulation *sim, char *buffer, int bufferSize);
+
+
+#endif /* SIMULATION_H */
@@ -0,0 +1,196 @@
+/*
+================================================================================
+FILE: slab_cache.h
+PURPOSE: Slab caches for fixed-size objects (kmem_cache style)
+DESCRIPTION:
+    - One cache per object size (e.g. 64-byte objects, 200-byte objects)
+    - A slab is an ordinary block carved from the MemoryManager with
+      allocateMemory(); it then holds objectsPerSlab objects
+    - Each slab has a free bitmap; a free object is found with ctz
+    - Slabs live on a partial list or a full list; a slab that becomes
+      empty is freed right away and its block goes back to the hole list
+    - Reports slab utilization and internal fragmentation separately from
+      the contiguous allocator's external fragmentation
+================================================================================
+*/
+
+#ifndef SLAB_CACHE_H
+#define SLAB_CACHE_H
+
+#include <stdint.h>              // uint64_t
+#include "memory_structures.h"   // MemoryManager
+
+
+// Objects are aligned to this many bytes (like a real allocator)
+#define SLAB_ALIGN 8
+
+// Object handles are (slab PID << SLAB_HANDLE_SHIFT) | object index
+#define SLAB_HANDLE_SHIFT 16
+#define SLAB_MAX_OBJECTS  (1 << SLAB_HANDLE_SHIFT)
+
+
+/*
+================================================================================
+STRUCTURE: Slab
+================================================================================
+PURPOSE: One block cut into equal object slots
+
+EXAMPLE (64-byte objects, 4 KB slab):
+objectsPerSlab = 4096 / 64 = 64 → one bitmap word
+freeBits = 0xFFFF...FFF0 → objects 0-3 are in use, the next
+allocation takes object 4 (ctz of freeBits)
+*/
+
+typedef struct Slab {
+    int          processID;     // PID of the block that backs this slab
+    int          startAddress;  // Block start (KB), for display
+    char        *base;          // Real memory of the block (may be NULL)
+    int          inUse;         // Objects currently allocated
+    int          searchWord;    // Bitmap word where the next search starts
+    uint64_t    *freeBits;      // 1 bit per object, 1 = free
+    struct Slab *prev;          // Neighbours on the partial or full list
+    struct Slab *next;
+    int          onFullList;    // 1 = on cache->full, 0 = on cache->partial
+    int          cacheID;       // Owning cache
+} Slab;
+
+
+/*
+================================================================================
+STRUCTURE: SlabCache
+================================================================================
+PURPOSE: All slabs of one object size, plus counters
+*/
+
+typedef struct {
+    int       cacheID;          // -1 = destroyed
+    int       objectSize;       // Requested object size in bytes
+    int       alignedSize;      // objectSize rounded up to SLAB_ALIGN
+    int       slabSizeKB;       // Block size of one slab
+    int       objectsPerSlab;   // Slots in one slab
+    int       bitmapWords;      // uint64_t words per slab bitmap
+    Slab     *partial;          // Slabs with at least one free slot
+    Slab     *full;             // Slabs with no free slot
+    int       numSlabs;         // Slabs currently held
+    long long liveObjects;      // Objects currently allocated
+    long long totalAllocs;      // Objects ever allocated
+    long long totalFrees;       // Objects ever freed
+    int       slabsCreated;     // Blocks ever carved for this cache
+    int       slabsReleased;    // Empty slabs returned to the hole list
+} SlabCache;
+
+
+/*
+================================================================================
+STRUCTURE: SlabLayer
+================================================================================
+PURPOSE: Every cache, and a PID → slab index for O(1) frees
+
+LAYOUT GENERATION:
+Compaction and mode conversions move blocks. When mm->layoutGeneration
+no longer matches, the slab base pointers are looked up again.
+*/
+
+typedef struct SlabLayer {
+    SlabCache *caches;          // Indexed by cache ID
+    int        numCaches;
+    int        cacheCapacity;
+    Slab     **slabByPID;       // slabByPID[pid] = slab backed by that block
+    int        pidCapacity;
+    int        layoutGeneration;
+} SlabLayer;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: slabCacheCreate
+--------------------------------------------------------------------------------
+PURPOSE: Create a cache for objects of objectSize bytes
+
+PARAMETERS:
+- mm: The MemoryManager slabs are carved from (mm->slabs is created lazily)
+- objectSize: Object size in bytes (1 .. 1 MB)
+- slabSizeKB: Slab block size, 0 = smallest power of 2 KB (>= 4) that
+  holds at least 8 objects
+
+RETURNS: Cache ID (>= 0), or -1 on bad parameters (JSON explains why)
+*/
+int slabCacheCreate(MemoryManager *mm, int objectSize, int slabSizeKB,
+                    char *resultBuffer, int bufferSize);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: slabAlloc
+--------------------------------------------------------------------------------
+PURPOSE: Allocate one object from a cache
+
+HOW IT WORKS:
+1. Take the first slab on the partial list (grow a new slab if none)
+2. ctz over its free bitmap from searchWord finds a free slot
+3. Fill the object's real bytes with the slab's pattern
+4. Move the slab to the full list if that was its last slot
+
+RETURNS: Object handle (>= 0), or -1 if no slab could be carved
+*/
+long long slabAlloc(MemoryManager *mm, int cacheID);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: slabFree
+--------------------------------------------------------------------------------
+PURPOSE: Free one object; an emptied slab goes back to the hole list
+
+RETURNS: 1 on success, 0 if the handle is not a live object
+*/
+int slabFree(MemoryManager *mm, long long handle);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: slabCacheDestroy
+--------------------------------------------------------------------------------
+PURPOSE: Free every slab of a cache (all objects die) and retire its ID
+
+RETURNS: 1 on success, 0 if the cache does not exist
+*/
+int slabCacheDestroy(MemoryManager *mm, int cacheID);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: slabOwnsProcess
+--------------------------------------------------------------------------------
+PURPOSE: Is this PID a slab? (Slab blocks must not be freed directly)
+*/
+int slabOwnsProcess(const MemoryManager *mm, int processID);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: destroySlabLayer
+--------------------------------------------------------------------------------
+PURPOSE: Drop all slab metadata (used by resetMemory; blocks are NOT freed)
+*/
+void destroySlabLayer(SlabLayer *layer);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: slabCachesToJSON / slabSummaryJSON
+--------------------------------------------------------------------------------
+PURPOSE: Per-cache details (GET /api/slab) and a one-line summary
+         (the "slab" section of /api/stats)
+
+METRICS:
+- utilization: live object bytes / slab bytes (how full the slabs are)
+- internalFragmentationBytes: alignment padding of live objects plus the
+  tail of every slab that is too small for one more object
+- freeObjectBytes: free slots in partial slabs (reusable, not wasted)
+*/
+void slabCachesToJSON(const MemoryManager *mm, char *buffer, int bufferSize);
+void slabSummaryJSON(const MemoryManager *mm, char *buffer, int bufferSize);
+
+
+#endif /* SLAB_CACHE_H */
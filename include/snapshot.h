@@ -0,0 +1,77 @@
+/*
+================================================================================
+FILE: snapshot.h
+PURPOSE: Immutable, atomically published views of the memory state
+DESCRIPTION:
+    - compact() frees the whole block list and builds a new one; a reader
+      walking the list at that moment would see a torn, half-freed list
+    - Instead, after every state change the writer renders the block
+      table and the stats OFF TO THE SIDE into a new snapshot and then
+      publishes it with one pointer swap
+    - Readers (GET /api/blocks, GET /api/stats) only ever touch a
+      published snapshot, never the live list, so they never wait for a
+      compaction or a buddy conversion to finish
+    - An old snapshot stays valid until its last reader lets go
+      (RCU-style: reference counts instead of grace periods)
+================================================================================
+*/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stddef.h>              // size_t
+#include "memory_structures.h"   // MemoryManager
+
+
+// Room for the rendered block table and the stats of one snapshot
+#define SNAPSHOT_JSON_SIZE 65536
+
+
+/*
+================================================================================
+STRUCTURE: Snapshot
+================================================================================
+PURPOSE: One published version of the state. Never changed after
+         publication; freed when refs drops to 0.
+
+refs counts the publication itself (until the next publish replaces
+it) plus every reader that acquired it.
+*/
+
+typedef struct Snapshot {
+    int                refs;
+    unsigned long long version;     // 1, 2, 3, ... in publication order
+    char              *blocksJSON;  // What GET /api/blocks returns
+    char              *statsJSON;   // What GET /api/stats returns
+} Snapshot;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: snapshotPublish
+--------------------------------------------------------------------------------
+PURPOSE: Render the current state into a new snapshot and make it the
+         one readers get
+
+The caller must be the only writer of mm (the server holds its state
+lock). Rendering happens before the swap, so readers keep getting the
+previous version until the new one is complete.
+*/
+void snapshotPublish(MemoryManager *mm);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: snapshotAcquire / snapshotRelease
+--------------------------------------------------------------------------------
+PURPOSE: Get a reference to the newest snapshot (NULL before the first
+         publish) / drop it (the last reference frees the snapshot)
+
+Acquire only takes a tiny lock for the pointer load and reference
+increment; it never waits for a writer's operation.
+*/
+Snapshot* snapshotAcquire(void);
+void snapshotRelease(Snapshot *snapshot);
+
+
+#endif /* SNAPSHOT_H */
@@ -0,0 +1,97 @@
+/*
+================================================================================
+FILE: static_files.h
+PURPOSE: Serve the built React UI (UI for MAV/dist) from the API server
+DESCRIPTION:
+    - The UI used to come from a second process (the Vite dev server on
+      another port), so every POST from the browser was cross-origin and
+      was preceded by an OPTIONS preflight
+    - With the built files served by the API server itself the page and
+      the API share one origin: no preflights, one process
+    - At startup the directory is indexed once (path, size, type, ETag,
+      an open file descriptor); a request is a binary search plus a
+      sendfile() from the page cache straight to the socket, the file
+      contents never pass through a user-space buffer
+    - "file.js.gz" next to "file.js" is sent instead to browsers that
+      accept gzip (made at build time: npm run build:server)
+================================================================================
+*/
+
+#ifndef STATIC_FILES_H
+#define STATIC_FILES_H
+
+
+// Limits of the index
+#define STATIC_MAX_FILES 4096
+#define STATIC_MAX_PATH  256
+
+// Where the UI build is looked for when --ui is not given
+#define STATIC_DEFAULT_ROOT "UI for MAV/dist"
+
+
+/*
+================================================================================
+STRUCTURE: StaticFile
+================================================================================
+PURPOSE: One indexed file
+
+EXAMPLE:
+path         "/assets/index-3f2a91c4.js"
+size         143211        gzipSize 46102 (index-3f2a91c4.js.gz)
+contentType  "text/javascript; charset=utf-8"
+etag         "\"22f6b-65a1c3f0\""   (size-mtime)
+immutable    1  (Vite puts content-hashed names under /assets/: a new
+                build has new names, so the browser may keep these forever)
+*/
+
+typedef struct {
+    char        path[STATIC_MAX_PATH];
+    int         fd;
+    long long   size;
+    int         gzipFd;         // -1: no smaller .gz variant
+    long long   gzipSize;
+    const char *contentType;
+    char        etag[40];
+    int         immutable;
+} StaticFile;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: staticFilesLoad
+--------------------------------------------------------------------------------
+PURPOSE: Index every regular file under 'root' (hidden files and the
+         .gz variants themselves are not entries)
+
+RETURNS: Number of files indexed, or -1 if 'root' cannot be opened
+*/
+int staticFilesLoad(const char *root);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: staticFileFind
+--------------------------------------------------------------------------------
+PURPOSE: The file for a request path ("?query" ignored)
+
+"/" is /index.html. A path whose last part has no extension that is not
+a file ("/stats") also gets /index.html, so the UI can route on the
+client side; "/missing.js" gets NULL.
+
+RETURNS: The file, or NULL
+*/
+const StaticFile* staticFileFind(const char *path);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: staticFileCount / staticFilesRoot
+--------------------------------------------------------------------------------
+staticFileCount: Number of indexed files (0: no UI is served)
+staticFilesRoot: The directory given to staticFilesLoad()
+*/
+int staticFileCount(void);
+const char* staticFilesRoot(void);
+
+
+#endif /* STATIC_FILES_H */
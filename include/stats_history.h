@@ -0,0 +1,86 @@
+/*
+================================================================================
+FILE: stats_history.h
+PURPOSE: Fixed-memory time series of the memory statistics
+DESCRIPTION:
+    - GET /api/stats is one instant; charting fragmentation over time
+      meant the client had to poll and keep every answer itself
+    - The server now samples free memory, hole count, largest hole,
+      fragmentation and ops/s after every mutation and once per second
+    - Three rings at three resolutions: raw samples, 1-second buckets
+      and 1-minute buckets. Each bucket is the mean of what it covers
+      (plus the worst fragmentation seen), so an hour of history costs
+      60 entries, not 3600
+    - Memory is fixed: the rings never grow
+================================================================================
+*/
+
+#ifndef STATS_HISTORY_H
+#define STATS_HISTORY_H
+
+#include "memory_structures.h"   // MemoryManager
+
+
+// Ring sizes: how far back each resolution reaches
+#define STATS_RAW_SAMPLES   1024    // The latest 1024 samples
+#define STATS_SECOND_BUCKETS 600    // 10 minutes
+#define STATS_MINUTE_BUCKETS 1440   // 24 hours
+
+
+/*
+================================================================================
+STRUCTURE: StatsPoint
+================================================================================
+PURPOSE: One raw sample, or one bucket of a coarser resolution
+
+For a raw sample samples = 1 and the mean fields are the values seen.
+opsPerSec: mutations per second over the bucket (raw samples: over the
+last complete second).
+*/
+
+typedef struct {
+    long long timeMs;           // Unix time (ms) of the sample / bucket start
+    float     freeKB;           // Mean free memory
+    float     holes;            // Mean hole count
+    float     largestHoleKB;    // Mean largest hole
+    float     fragmentation;    // Mean external fragmentation %
+    float     fragmentationMax; // Worst fragmentation % in the bucket
+    float     opsPerSec;
+    int       samples;          // Raw samples merged into this point
+} StatsPoint;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: statsHistorySample
+--------------------------------------------------------------------------------
+PURPOSE: Take one sample of mm ('mutation' = operations since the last
+         sample, 1 after an HTTP operation, 0 on a timer tick) and roll
+         finished seconds and minutes up
+
+The caller must keep mm from changing during the call (the server holds
+its state lock).
+*/
+void statsHistorySample(MemoryManager *mm, int mutation);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: statsHistoryToJSON
+--------------------------------------------------------------------------------
+PURPOSE: The points of the last rangeSeconds as columns:
+         {"range","resolution","points",
+          "t":[...],"freeKB":[...],"holes":[...],"largestHoleKB":[...],
+          "fragmentation":[...],"fragmentationMax":[...],"opsPerSec":[...]}
+
+resolution: "raw", "1s", "1m", or NULL/"" to pick the finest one that
+covers the range (raw up to 1 minute, 1s up to 10 minutes, 1m beyond)
+
+RETURNS: Characters written (the JSON is truncated to whole points if
+the buffer is too small)
+*/
+int statsHistoryToJSON(int rangeSeconds, const char *resolution,
+                       char *buffer, int bufferSize);
+
+
+#endif /* STATS_HISTORY_H */
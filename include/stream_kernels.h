@@ -0,0 +1,80 @@
+/*
+================================================================================
+FILE: stream_kernels.h
+PURPOSE: Block fill and copy kernels with non-temporal (streaming) stores
+DESCRIPTION:
+    - Filling a fresh 4 MB process with its pattern byte, or zeroing a
+      freed one, pulls 4 MB through the caches that nobody reads soon;
+      it evicts the list nodes and small blocks the next operations need
+    - Non-temporal stores write around the caches straight to memory
+    - The kernel is picked once at runtime from the CPU features:
+      AVX2 (_mm256_stream_si256), else SSE2 (_mm_stream_si128), else the
+      plain C library
+    - Blocks below a threshold use regular stores (they are cheap and
+      likely to be read back while still cached)
+================================================================================
+*/
+
+#ifndef STREAM_KERNELS_H
+#define STREAM_KERNELS_H
+
+#include <stddef.h>     // size_t
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: blockFill / blockCopy
+--------------------------------------------------------------------------------
+PURPOSE: memset / memcpy for block contents
+
+blockFill(dst, value, n): Set n bytes to (unsigned char)value
+blockCopy(dst, src, n):   Copy n bytes; the ranges must NOT overlap
+
+Both use streaming stores when n >= the threshold and streaming is
+enabled, regular stores otherwise. The streaming path ends with a store
+fence, so the bytes are visible to other threads on return.
+*/
+void blockFill(void *dst, int value, size_t n);
+void blockCopy(void *dst, const void *src, size_t n);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: setStreamConfig / streamKernelName / streamStatsToJSON
+--------------------------------------------------------------------------------
+PURPOSE: Configure and report the kernels
+
+setStreamConfig(enabled, thresholdBytes):
+    enabled 1 = stream above the threshold, 0 = always regular stores,
+    -1 = keep; thresholdBytes 0 = keep. Default: enabled, 256 KB.
+streamKernelName: "avx2", "sse2" or "libc" (what the CPU allows)
+streamStatsToJSON: Settings plus counts and bytes of each path
+*/
+void setStreamConfig(int enabled, size_t thresholdBytes);
+const char* streamKernelName(void);
+void streamStatsToJSON(char *buffer, int bufferSize);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: benchmarkStreamingFills
+--------------------------------------------------------------------------------
+PURPOSE: Does a big fill slow down the operations after it?
+
+HOW IT WORKS (once with regular stores, once with streaming stores):
+1. A scratch heap holds 'residents' small processes (a list to walk)
+2. Each round allocates and frees one largeKB process (fill + zero)
+3. Then 'smallOps' small allocate/free pairs are timed: their list
+   walk and 4 KB fills hit the cache only if the big fill did not
+   evict everything
+
+REPORTS: Mean large allocate/free time and mean small-op latency for
+each mode
+
+RETURNS: 1 on success, 0 on bad parameters
+*/
+int benchmarkStreamingFills(int largeKB, int residents, int smallOps, int rounds,
+                            char *resultBuffer, int bufferSize);
+
+
+#endif /* STREAM_KERNELS_H */
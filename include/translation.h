@@ -0,0 +1,149 @@
+/*
+================================================================================
+FILE: translation.h
+PURPOSE: Address translation simulator (multi-level page tables + TLB)
+DESCRIPTION:
+    - Gives every process a virtual address space that maps onto its
+      allocated block (contiguous or paged mode)
+    - Radix page tables with 2, 3 or 4 levels of 512 entries (x86-64 style)
+    - A set-associative TLB with configurable entries, ways and LRU or
+      random replacement, tagged by address space (no flush on switch)
+    - Replays a reference stream in batches and reports TLB misses,
+      page-walk memory accesses and translations per second
+    - Compares page sizes (4 KB vs 2 MB) on the SAME reference stream
+================================================================================
+*/
+
+#ifndef TRANSLATION_H
+#define TRANSLATION_H
+
+#include <stdint.h>              // uint64_t
+#include "memory_manager.h"
+
+
+/*
+================================================================================
+ENUMERATION: TLBReplacementPolicy
+================================================================================
+PURPOSE: Which way of a full TLB set gets the new translation?
+
+TLB_LRU    - The way used least recently (hardware approximates this)
+TLB_RANDOM - Any way (cheap in hardware, surprisingly close to LRU)
+*/
+
+typedef enum {
+    TLB_LRU,
+    TLB_RANDOM
+} TLBReplacementPolicy;
+
+
+/*
+================================================================================
+STRUCTURE: TranslationConfig
+================================================================================
+PURPOSE: Parameters of one translation run (from the API request)
+
+VIRTUAL SPACE:
+Each process gets virtualKB of virtual address space (0 = its block size).
+A space larger than the block wraps around onto the block, so big spaces
+can be studied on a small simulated machine: virtual page p maps to the
+physical address of block offset (p * pageSize) mod blockSize.
+*/
+
+typedef struct {
+    int pageSizeKB;             // Page size in KB (power of 2, 4 .. 1048576)
+    int levels;                 // Page table levels: 2, 3 or 4
+    int tlbEntries;             // Total TLB entries (power of 2)
+    int tlbWays;                // Associativity (power of 2, <= tlbEntries)
+    TLBReplacementPolicy policy;
+    int virtualKB;              // Virtual space per process, 0 = block size
+    int length;                 // Number of translations
+    int localityPercent;        // Working-set locality 0-100
+    unsigned long long seed;    // Workload seed
+} TranslationConfig;
+
+
+/*
+================================================================================
+STRUCTURE: TranslationResult
+================================================================================
+PURPOSE: Outcome of replaying one reference stream with one configuration
+
+COST MODEL:
+A TLB hit costs nothing extra. A miss walks the page table: one memory
+access per level (4 for a 4-level table), which is what huge pages and
+bigger TLBs try to avoid.
+*/
+
+typedef struct {
+    int       pageSizeKB;
+    int       levels;
+    int       tlbEntries;
+    int       tlbWays;
+    TLBReplacementPolicy policy;
+    long long translations;         // References translated
+    long long tlbMisses;            // References that needed a page walk
+    long long walkAccesses;         // tlbMisses * levels
+    long long pageTableNodes;       // 512-entry tables built for all processes
+    double    missRate;             // tlbMisses / translations
+    double    elapsedSeconds;       // Wall time of the translation loop only
+    double    translationsPerSecond;
+    uint64_t  checksum;             // XOR of all physical addresses (sanity)
+} TranslationResult;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: tlbPolicyName / parseTLBPolicy
+--------------------------------------------------------------------------------
+PURPOSE: Convert between the enum and API names ("lru", "random")
+
+parseTLBPolicy returns -1 for an unknown name.
+*/
+const char* tlbPolicyName(TLBReplacementPolicy policy);
+int parseTLBPolicy(const char *name);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: runTranslationSimulation
+--------------------------------------------------------------------------------
+PURPOSE: Build page tables, generate a stream, translate it, report JSON
+
+WHAT IT DOES:
+1. Every allocated process gets a virtual space and its own page table
+2. ONE reference stream of byte addresses is generated (4 KB granular
+   locality plus a random offset), so every page size sees the same input
+3. For each page size in pageSizesKB[], the stream is translated through
+   a cold TLB and the page tables
+4. Results go to the JSON buffer and are kept in mm->translation so that
+   /api/stats shows the latest run
+
+PARAMETERS:
+- mm: Pointer to MemoryManager (processes are read; mm->translation is set)
+- config: Run parameters (config->pageSizeKB is ignored)
+- pageSizesKB / numPageSizes: Page sizes to run (at most
+  MAX_TRANSLATION_SUMMARIES)
+- resultBuffer / bufferSize: JSON output
+
+RETURNS:
+- 1 if the simulation ran
+- 0 on bad parameters or if there are no processes
+
+RESULT JSON FORMAT:
+{
+  "success": true, "processes": 3, "virtualKB": 65536,
+  "translations": 5000000, "localityPercent": 90, "seed": 1,
+  "results": [
+    {"pageSizeKB":4,"levels":4,"tlbEntries":64,"tlbWays":4,"policy":"lru",
+     "tlbMisses":81234,"missRate":0.0162,"walkAccesses":324936,
+     "pageTableNodes":40,"elapsedMs":98.1,"translationsPerSecond":50968399}
+  ]
+}
+*/
+int runTranslationSimulation(MemoryManager *mm, const TranslationConfig *config,
+                             const int *pageSizesKB, int numPageSizes,
+                             char *resultBuffer, int bufferSize);
+
+
+#endif /* TRANSLATION_H */
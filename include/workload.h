@@ -0,0 +1,136 @@
+/*
+================================================================================
+FILE: workload.h
+PURPOSE: Synthetic workload generators shared by the simulators
+DESCRIPTION:
+    - A tiny, fast, seedable pseudo-random number generator (xorshift64*)
+    - Page reference strings with tunable locality for the paging simulator
+    - Allocate/free operation streams for head-to-head allocator comparisons
+    - Same seed → same workload, so every algorithm sees identical input
+================================================================================
+*/
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdint.h>   // uint32_t, uint64_t
+
+
+/*
+================================================================================
+STRUCTURE: WorkloadRNG
+================================================================================
+PURPOSE: State of the xorshift64* random number generator
+
+WHY NOT rand()?
+- rand() is slow, has a small range, and its sequence differs between
+  macOS and Linux. Experiments must be reproducible on every machine.
+- xorshift64* is a handful of shifts and one multiply per number.
+*/
+
+typedef struct {
+    uint64_t state;     // Never 0 (workloadSeed() takes care of that)
+} WorkloadRNG;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: workloadSeed
+--------------------------------------------------------------------------------
+PURPOSE: Initialize a generator from a user-supplied seed (0 is allowed)
+*/
+void workloadSeed(WorkloadRNG *rng, uint64_t seed);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: workloadNext
+--------------------------------------------------------------------------------
+PURPOSE: Return the next 64-bit pseudo-random number
+*/
+uint64_t workloadNext(WorkloadRNG *rng);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: workloadRange
+--------------------------------------------------------------------------------
+PURPOSE: Return a pseudo-random integer in [0, n)   (n must be > 0)
+*/
+uint32_t workloadRange(WorkloadRNG *rng, uint32_t n);
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: generateReferenceString
+--------------------------------------------------------------------------------
+PURPOSE: Produce a page reference string for the demand-paging simulator
+
+THE LOCALITY MODEL:
+Programs do not touch pages uniformly at random. They loop over a small
+"working set" that drifts slowly through their address space, and the
+CPU switches between processes now and then. We model exactly that:
+
+1. A current process is chosen; with a small probability we switch.
+2. Each process has a working-set window of a few pages.
+3. With probability localityPercent/100 the reference falls inside the
+   window, otherwise anywhere in that process's pages.
+4. The window occasionally slides forward by one page.
+
+OUTPUT:
+Each reference is a GLOBAL virtual page number: page p of process i is
+pageBase[i] + p. The simulator uses it to index the page tables.
+
+PARAMETERS:
+- rng: Generator (seeded by the caller)
+- pageBase: First global page number of each process
+- pageCount: Number of virtual pages of each process (all > 0)
+- numProcesses: Number of processes
+- refs: Output array of length entries
+- length: How many references to generate
+- localityPercent: 0 = uniform random, 100 = always inside the window
+*/
+void generateReferenceString(WorkloadRNG *rng,
+                             const int *pageBase, const int *pageCount,
+                             int numProcesses,
+                             uint32_t *refs, int length,
+                             int localityPercent);
+
+
+/*
+================================================================================
+STRUCTURE: WorkloadOp
+================================================================================
+PURPOSE: One step of an allocate/free operation stream
+
+Allocations are numbered 0, 1, 2, ... in the order they appear. A free
+names the allocation it releases by that number, so the same stream can
+be replayed against any allocator: if allocation #7 failed on one engine,
+the later "free #7" is simply skipped there.
+*/
+
+typedef struct {
+    int isFree;         // 0 = allocate, 1 = free
+    int sizeKB;         // Size to allocate (allocations only)
+    int allocIndex;     // Which allocation this op creates or frees
+} WorkloadOp;
+
+
+/*
+--------------------------------------------------------------------------------
+FUNCTION: generateOpStream
+--------------------------------------------------------------------------------
+PURPOSE: Produce a random mix of allocations and frees
+
+HOW IT WORKS:
+At every step, if something is live and a freePercent-percent coin flip
+says so, a random live allocation is freed; otherwise a new allocation
+with a size uniform in [minSizeKB, maxSizeKB] is made.
+
+RETURNS: Number of allocation ops in the stream (largest allocIndex + 1)
+*/
+int generateOpStream(WorkloadRNG *rng, WorkloadOp *ops, int count,
+                     int minSizeKB, int maxSizeKB, int freePercent);
+
+
+#endif /* WORKLOAD_H */
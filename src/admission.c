@@ -0,0 +1,342 @@
+/*
+================================================================================
+FILE: admission.c
+PURPOSE: Implement the admission queue
+DESCRIPTION:
+    - Waiters are linked into the FIFO of their size class
+    - admissionWake() measures the room once, lets the policy pick a
+      candidate from the classes that can fit, admits it, measures
+      again, and stops when nobody fits
+    - The waiting thread sleeps on its own condition variable with the
+      server's state lock released
+================================================================================
+*/
+
+#include <stdio.h>      // snprintf
+#include <stdlib.h>     // calloc
+#include <time.h>       // clock_gettime, CLOCK_MONOTONIC, CLOCK_REALTIME
+#include <errno.h>      // ETIMEDOUT
+#include "../include/admission.h"
+#include "../include/memory_manager.h"
+
+
+static const char *policyNames[] = { "fcfs", "sjf", "first_fit" };
+
+
+static long long nowNanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPERS: sizeClass / link / unlink
+--------------------------------------------------------------------------------
+*/
+
+// floor(log2(sizeKB)): 1 → 0, 2-3 → 1, 4-7 → 2, ...
+static int sizeClass(int sizeKB) {
+    int k = 0;
+    while ((sizeKB >> (k + 1)) > 0 && k < ADMIT_CLASSES - 1) {
+        k++;
+    }
+    return k;
+}
+
+static void linkWaiter(AdmissionQueue *q, AdmissionWaiter *w) {
+    int k = sizeClass(w->sizeKB);
+    w->next = NULL;
+    w->prev = q->tail[k];
+    if (q->tail[k] != NULL) {
+        q->tail[k]->next = w;
+    } else {
+        q->head[k] = w;
+    }
+    q->tail[k] = w;
+    q->length++;
+}
+
+static void unlinkWaiter(AdmissionQueue *q, AdmissionWaiter *w) {
+    int k = sizeClass(w->sizeKB);
+    if (w->prev != NULL) {
+        w->prev->next = w->next;
+    } else {
+        q->head[k] = w->next;
+    }
+    if (w->next != NULL) {
+        w->next->prev = w->prev;
+    } else {
+        q->tail[k] = w->prev;
+    }
+    w->prev = w->next = NULL;
+    q->length--;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPERS: roomKB / neededKB
+--------------------------------------------------------------------------------
+PURPOSE: What the biggest request that can succeed right now is, and
+         what a request really needs (the buddy system rounds up)
+
+Paged mode takes any free frames and deferred coalescing merges holes
+when an allocation fails, so there the total free memory is the room.
+*/
+
+static int roomKB(MemoryManager *mm) {
+    if (mm->usePagedMode || mm->quick != NULL) {
+        return mm->freeMemory;
+    }
+    return largestHoleKB(mm);
+}
+
+static int neededKB(MemoryManager *mm, const AdmissionWaiter *w) {
+    return mm->useBuddySystem ? nextPowerOf2(w->sizeKB) : w->sizeKB;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: pickCandidate
+--------------------------------------------------------------------------------
+PURPOSE: The waiter the policy admits next, or NULL if it does not fit
+
+Only classes 0 .. sizeClass(room) can hold a request that fits; every
+request in a smaller class fits, in class sizeClass(room) some might.
+
+FCFS:      the oldest waiter overall (class heads are the oldest of each
+           class); if it does not fit, nobody gets in
+SJF:       the smallest waiter in the lowest non-empty class
+FIRST_FIT: the oldest of: each smaller class's head, and the first
+           waiter of the room's own class that fits
+*/
+
+static AdmissionWaiter* pickCandidate(MemoryManager *mm, AdmissionQueue *q, int room) {
+
+    AdmissionWaiter *best = NULL;
+
+    if (q->policy == ADMIT_FCFS) {
+        for (int k = 0; k < ADMIT_CLASSES; k++) {
+            if (q->head[k] != NULL && (best == NULL || q->head[k]->seq < best->seq)) {
+                best = q->head[k];
+            }
+        }
+        return (best != NULL && neededKB(mm, best) <= room) ? best : NULL;
+    }
+
+    if (room <= 0) {
+        return NULL;
+    }
+    int top = sizeClass(room);
+
+    if (q->policy == ADMIT_SJF) {
+        for (int k = 0; k <= top && best == NULL; k++) {
+            for (AdmissionWaiter *w = q->head[k]; w != NULL; w = w->next) {
+                if (best == NULL || w->sizeKB < best->sizeKB) {
+                    best = w;
+                }
+            }
+        }
+        return (best != NULL && neededKB(mm, best) <= room) ? best : NULL;
+    }
+
+    // FIRST_FIT
+    for (int k = 0; k <= top; k++) {
+        for (AdmissionWaiter *w = q->head[k]; w != NULL; w = w->next) {
+            if (neededKB(mm, w) <= room) {
+                if (best == NULL || w->seq < best->seq) {
+                    best = w;
+                }
+                break;      // Later ones in this FIFO are younger
+            }
+        }
+    }
+    return best;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: admit
+--------------------------------------------------------------------------------
+PURPOSE: Allocate for the waiter with its own process ID and algorithm
+*/
+
+static int admit(MemoryManager *mm, AdmissionWaiter *w) {
+    if (mm->useBuddySystem) {
+        // buddyAllocate() takes ++processCounter as the PID; the waiter's
+        // PID was handed out earlier, so wind the counter back and forth
+        int counter = mm->processCounter;
+        mm->processCounter = w->processID - 1;
+        int start = buddyAllocate(mm, w->sizeKB, NULL, 0);
+        mm->processCounter = counter;
+        return start;
+    }
+    return allocateMemory(mm, w->processID, w->sizeKB, w->algorithm);
+}
+
+
+/*
+================================================================================
+FUNCTION: setAdmissionPolicy
+================================================================================
+*/
+
+int setAdmissionPolicy(MemoryManager *mm, AdmissionPolicy policy) {
+    if (mm->admission == NULL) {
+        mm->admission = (AdmissionQueue*)calloc(1, sizeof(AdmissionQueue));
+        if (mm->admission == NULL) {
+            return 0;
+        }
+    }
+    mm->admission->policy = policy;
+    return 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: admissionWait
+================================================================================
+ALGORITHM:
+1. Link the waiter (on this stack frame) into its size class
+2. Sleep until admitted or the deadline passes (the lock is released
+   while sleeping)
+3. On timeout, unlink; either way record the waiting time
+*/
+
+int admissionWait(MemoryManager *mm, int processID, int sizeKB,
+                  AllocationAlgorithm algorithm, int timeoutMs,
+                  pthread_mutex_t *lock, double *waitedMs) {
+
+    if (mm->admission == NULL && !setAdmissionPolicy(mm, ADMIT_FCFS)) {
+        return -1;
+    }
+    AdmissionQueue *q = mm->admission;
+
+    // STEP 1: Queue up
+    AdmissionWaiter w;
+    w.processID = processID;
+    w.sizeKB = sizeKB;
+    w.algorithm = algorithm;
+    w.seq = q->nextSeq++;
+    w.enqueuedNs = nowNanoseconds();
+    w.state = WAITER_QUEUED;
+    w.startAddress = -1;
+    pthread_cond_init(&w.admitted, NULL);
+    linkWaiter(q, &w);
+    q->enqueued++;
+    if (q->length > q->maxLength) {
+        q->maxLength = q->length;
+    }
+
+    // Room may already be there (the policy might have let others first)
+    admissionWake(mm);
+
+    // STEP 2: Sleep (pthread_cond_timedwait() wants a CLOCK_REALTIME deadline)
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeoutMs / 1000;
+    deadline.tv_nsec += (long)(timeoutMs % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    while (w.state == WAITER_QUEUED) {
+        if (pthread_cond_timedwait(&w.admitted, lock, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+
+    // STEP 3: Leave the queue (resetMemory() keeps the queue, so q is
+    // still the one we joined)
+    double waited = (nowNanoseconds() - w.enqueuedNs) / 1e6;
+    if (waitedMs != NULL) {
+        *waitedMs = waited;
+    }
+    if (w.state == WAITER_QUEUED) {
+        unlinkWaiter(q, &w);
+        w.state = WAITER_TIMED_OUT;
+        q->timedOut++;
+    } else {
+        q->totalWaitMs += waited;
+        if (waited > q->maxWaitMs) {
+            q->maxWaitMs = waited;
+        }
+    }
+    pthread_cond_destroy(&w.admitted);
+    return w.state == WAITER_ADMITTED ? w.startAddress : -1;
+}
+
+
+/*
+================================================================================
+FUNCTION: admissionWake
+================================================================================
+*/
+
+int admissionWake(MemoryManager *mm) {
+
+    AdmissionQueue *q = mm->admission;
+    if (q == NULL || q->length == 0) {
+        return 0;       // The common case: one pointer check
+    }
+
+    int count = 0;
+    while (q->length > 0) {
+        AdmissionWaiter *w = pickCandidate(mm, q, roomKB(mm));
+        if (w == NULL) {
+            break;
+        }
+        int start = admit(mm, w);
+        if (start < 0) {
+            break;      // Room estimate was optimistic; wait for the next change
+        }
+        unlinkWaiter(q, w);
+        w->state = WAITER_ADMITTED;
+        w->startAddress = start;
+        q->admitted++;
+        pthread_cond_signal(&w->admitted);
+        count++;
+    }
+    return count;
+}
+
+
+/*
+================================================================================
+FUNCTION: admissionToJSON
+================================================================================
+*/
+
+void admissionToJSON(const AdmissionQueue *queue, char *buffer, int bufferSize) {
+    if (queue == NULL) {
+        snprintf(buffer, bufferSize, "null");
+        return;
+    }
+    snprintf(buffer, bufferSize,
+        "{\"policy\":\"%s\",\"queueLength\":%d,\"maxQueueLength\":%d,"
+        "\"enqueued\":%lld,\"admitted\":%lld,\"timedOut\":%lld,"
+        "\"meanWaitMs\":%.2f,\"maxWaitMs\":%.2f}",
+        policyNames[queue->policy], queue->length, queue->maxLength,
+        queue->enqueued, queue->admitted, queue->timedOut,
+        queue->admitted > 0 ? queue->totalWaitMs / queue->admitted : 0.0,
+        queue->maxWaitMs);
+}
+
+
+/*
+================================================================================
+END OF FILE: admission.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. pickCandidate() - FCFS / SJF / first-that-fits over the size classes
+2. admissionWait() - Queue, sleep with the lock released, time out
+3. admissionWake() - Admit every waiter that fits, in policy order
+4. admissionToJSON() - Queue length, admissions, timeouts, waiting times
+================================================================================
+*/
@@ -0,0 +1,748 @@
+/*
+================================================================================
+FILE: boundary_tag.c
+PURPOSE: Implement the boundary-tag allocator and its comparison
+DESCRIPTION:
+    - Headers and footers live in the backing bytes themselves
+    - First fit walks header to header; free coalesces in O(1)
+    - Conversion between the block list and boundary-tag mode
+    - Metadata overhead / cache-miss comparison with the list engine
+================================================================================
+*/
+
+#include <stdio.h>      // snprintf
+#include <stdlib.h>     // malloc, free
+#include <string.h>     // memset
+#include <time.h>       // clock_gettime, CLOCK_MONOTONIC
+#include "../include/boundary_tag.h"
+#include "../include/memory_manager.h"
+#include "../include/os_memory.h"
+#include "../include/workload.h"
+#include "../include/stream_kernels.h"
+#include "../include/history.h"
+
+
+// Upper bound on the comparison stream
+#define MAX_COMPARE_OPS 200000
+
+
+/*
+================================================================================
+HELPERS: Tag access
+================================================================================
+PURPOSE: Read and write the header / footer of the block at offset o
+*/
+
+static inline BoundaryTag* headerAt(const BoundaryTagHeap *heap, size_t o) {
+    return (BoundaryTag*)(heap->base + o);
+}
+
+static inline BoundaryTag* footerAt(const BoundaryTagHeap *heap, size_t o, size_t size) {
+    return (BoundaryTag*)(heap->base + o + size - BT_TAG_SIZE);
+}
+
+static inline size_t tagSize(const BoundaryTag *tag) {
+    return tag->sizeAndFree & ~(uint32_t)(BT_ALIGN - 1);
+}
+
+static inline int tagIsFree(const BoundaryTag *tag) {
+    return (int)(tag->sizeAndFree & 1u);
+}
+
+// Write identical header and footer for the block at o
+static inline void writeTags(BoundaryTagHeap *heap, size_t o, size_t size,
+                             int isFree, int processID) {
+    BoundaryTag tag;
+    tag.sizeAndFree = (uint32_t)size | (isFree ? 1u : 0u);
+    tag.processID = isFree ? -1 : processID;
+    *headerAt(heap, o) = tag;
+    *footerAt(heap, o, size) = tag;
+}
+
+
+/*
+================================================================================
+FUNCTION: btInit
+================================================================================
+*/
+
+int btInit(BoundaryTagHeap *heap, void *base, size_t size) {
+
+    memset(heap, 0, sizeof(*heap));
+    size &= ~(size_t)(BT_ALIGN - 1);
+    if (base == NULL || size < BT_MIN_BLOCK || size > 0xFFFFFFF0u) {
+        return -1;
+    }
+
+    heap->base = (char*)base;
+    heap->size = size;
+    writeTags(heap, 0, size, 1, -1);
+    heap->freeBytes = size;
+    heap->numBlocks = 1;
+    heap->numFree = 1;
+    return 0;
+}
+
+
+/*
+================================================================================
+FUNCTION: btAllocate
+================================================================================
+PURPOSE: First fit, header to header
+
+EXAMPLE (need = 1040 bytes = 1 KB payload + 16 bytes of tags):
+[used 2064][free 4112][used ...]
+→ skip the used block (one header read), the free block fits
+→ split: [used 2064][used 1040][free 3072][used ...]
+*/
+
+long btAllocate(BoundaryTagHeap *heap, int processID, size_t payloadBytes) {
+
+    size_t need = (payloadBytes + BT_OVERHEAD + BT_ALIGN - 1) & ~(size_t)(BT_ALIGN - 1);
+    if (need < BT_MIN_BLOCK) {
+        need = BT_MIN_BLOCK;
+    }
+    if (payloadBytes == 0 || need > heap->freeBytes) {
+        return -1;
+    }
+
+    size_t o = 0;
+    while (o < heap->size) {
+        const BoundaryTag *header = headerAt(heap, o);
+        size_t size = tagSize(header);
+        heap->headerReads++;
+
+        if (tagIsFree(header) && size >= need) {
+
+            // Split when the rest is big enough to be a block of its own
+            if (size - need >= BT_MIN_BLOCK) {
+                writeTags(heap, o, need, 0, processID);
+                writeTags(heap, o + need, size - need, 1, -1);
+                heap->numBlocks++;
+                heap->freeBytes -= need;
+            } else {
+                writeTags(heap, o, size, 0, processID);
+                heap->numFree--;
+                heap->freeBytes -= size;
+            }
+
+            blockFill(heap->base + o + BT_TAG_SIZE, processID & 0xFF, payloadBytes);
+            return (long)(o + BT_TAG_SIZE);
+        }
+
+        o += size;
+    }
+
+    return -1;
+}
+
+
+/*
+================================================================================
+FUNCTION: btFree
+================================================================================
+*/
+
+int btFree(BoundaryTagHeap *heap, long payloadOffset) {
+
+    if (payloadOffset < BT_TAG_SIZE || (size_t)payloadOffset >= heap->size) {
+        return 0;
+    }
+
+    size_t o = (size_t)payloadOffset - BT_TAG_SIZE;
+    const BoundaryTag *header = headerAt(heap, o);
+    size_t size = tagSize(header);
+    if (tagIsFree(header) || size < BT_MIN_BLOCK || o + size > heap->size) {
+        return 0;
+    }
+
+    // STEP 1: Clear the payload (like the list engine) and count it free
+    blockFill(heap->base + o + BT_TAG_SIZE, 0, size - BT_OVERHEAD);
+    heap->freeBytes += size;
+    heap->numFree++;
+
+    // STEP 2: Absorb the next block (its header follows our footer)
+    if (o + size < heap->size) {
+        const BoundaryTag *next = headerAt(heap, o + size);
+        if (tagIsFree(next)) {
+            size += tagSize(next);
+            heap->numBlocks--;
+            heap->numFree--;
+        }
+    }
+
+    // STEP 3: Join the previous block (its footer precedes our header)
+    if (o > 0) {
+        const BoundaryTag *prevFooter = (const BoundaryTag*)(heap->base + o - BT_TAG_SIZE);
+        if (tagIsFree(prevFooter)) {
+            size_t prevSize = tagSize(prevFooter);
+            o -= prevSize;
+            size += prevSize;
+            heap->numBlocks--;
+            heap->numFree--;
+        }
+    }
+
+    // STEP 4: One header and one footer for the merged block
+    writeTags(heap, o, size, 1, -1);
+    return 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: btFindProcess
+================================================================================
+*/
+
+long btFindProcess(BoundaryTagHeap *heap, int processID) {
+    for (size_t o = 0; o < heap->size; o += tagSize(headerAt(heap, o))) {
+        const BoundaryTag *header = headerAt(heap, o);
+        heap->headerReads++;
+        if (!tagIsFree(header) && header->processID == processID) {
+            return (long)(o + BT_TAG_SIZE);
+        }
+    }
+    return -1;
+}
+
+
+/*
+================================================================================
+FUNCTION: btLargestFree / btFragmentation
+================================================================================
+*/
+
+size_t btLargestFree(BoundaryTagHeap *heap) {
+    size_t largest = 0;
+    for (size_t o = 0; o < heap->size; o += tagSize(headerAt(heap, o))) {
+        const BoundaryTag *header = headerAt(heap, o);
+        if (tagIsFree(header) && tagSize(header) > largest) {
+            largest = tagSize(header);
+        }
+    }
+    return (largest > BT_OVERHEAD) ? largest - BT_OVERHEAD : 0;
+}
+
+float btFragmentation(BoundaryTagHeap *heap) {
+    if (heap->freeBytes == 0) {
+        return 0.0f;
+    }
+    size_t largest = btLargestFree(heap) + BT_OVERHEAD;
+    if (largest > heap->freeBytes) {
+        largest = heap->freeBytes;
+    }
+    return (float)(heap->freeBytes - largest) / (float)heap->size * 100.0f;
+}
+
+
+/*
+================================================================================
+FUNCTION: btBlocksToJSON
+================================================================================
+PURPOSE: Same JSON shape as blocksToJSON, built from the tags
+
+Each block becomes a temporary MemoryBlock serialized by blockToJSON().
+KB addresses are rounded down, so the 16 bytes of tags per block are
+visible only in realSize.
+*/
+
+// The block whose header is at offset o, in KB addresses
+static void tagBlock(BoundaryTagHeap *heap, size_t o, int osMemory, int blockID,
+                     MemoryBlock *block) {
+    const BoundaryTag *header = headerAt(heap, o);
+    size_t size = tagSize(header);
+
+    block->isHole = tagIsFree(header);
+    block->startAddress = osMemory + (int)(o / 1024);
+    block->endAddress = osMemory + (int)((o + size) / 1024) - 1;
+    block->size = block->endAddress - block->startAddress + 1;
+    block->processID = header->processID;
+    block->blockID = blockID;
+    block->buddyID = -1;
+    block->realPtr = heap->base + o;
+    block->realSize = size;
+    block->next = NULL;
+}
+
+void btBlocksToJSON(BoundaryTagHeap *heap, int osMemory, char *buffer, int bufferSize) {
+
+    int written = snprintf(buffer, bufferSize,
+        "[{\"id\":0,\"startAddress\":0,\"endAddress\":%d,"
+        "\"size\":%d,\"isHole\":false,\"processId\":\"OS\","
+        "\"blockID\":0,\"buddyID\":-1}",
+        osMemory - 1,
+        osMemory
+    );
+
+    int blockID = 1;
+    for (size_t o = 0; o < heap->size; o += tagSize(headerAt(heap, o))) {
+        MemoryBlock block;
+        tagBlock(heap, o, osMemory, blockID++, &block);
+
+        char blockJSON[512];
+        blockToJSON(&block, blockJSON, sizeof(blockJSON));
+
+        int remaining = bufferSize - written;
+        if (remaining > (int)strlen(blockJSON) + 3) {
+            written += snprintf(buffer + written, remaining, ",%s", blockJSON);
+        }
+    }
+
+    if (written < bufferSize - 1) {
+        buffer[written] = ']';
+        buffer[written + 1] = '\0';
+    }
+}
+
+int btBlocksToArray(BoundaryTagHeap *heap, int osMemory, MemoryBlock *blocks, int maxBlocks) {
+    int count = 0;
+    for (size_t o = 0; o < heap->size; o += tagSize(headerAt(heap, o))) {
+        if (count < maxBlocks) {
+            tagBlock(heap, o, osMemory, count + 1, &blocks[count]);
+        }
+        count++;
+    }
+    return count;
+}
+
+
+/*
+================================================================================
+FUNCTION: convertToBoundaryTags
+================================================================================
+PURPOSE: Move from the block list to tags in the backing region
+
+ALGORITHM:
+1. Save all current processes (IDs and sizes)
+2. Free the block list and zero the backing region
+3. Write one free block's tags over the whole region
+4. Re-allocate each saved process (same PID)
+*/
+
+int convertToBoundaryTags(MemoryManager *mm, char *resultBuffer, int bufferSize) {
+
+    // STEP 1: Validate
+    if (mm->useBoundaryTags) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Boundary-tag mode is already active\"}");
+        return 0;
+    }
+    if (mm->useBuddySystem || mm->usePagedMode) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Revert the buddy system / paged mode first\"}");
+        return 0;
+    }
+    if (mm->backingRegion.basePtr == NULL) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Boundary tags need a real backing region\"}");
+        return 0;
+    }
+
+    // STEP 2: Save current processes
+    int savedCount = 0;
+    for (MemoryBlock *b = mm->head; b != NULL; b = b->next) {
+        if (!b->isHole) savedCount++;
+    }
+    int *savedIDs = (int*)malloc(sizeof(int) * (size_t)(savedCount + 1));
+    int *savedSizes = (int*)malloc(sizeof(int) * (size_t)(savedCount + 1));
+    BoundaryTagHeap *heap = (BoundaryTagHeap*)malloc(sizeof(BoundaryTagHeap));
+    if (savedIDs == NULL || savedSizes == NULL || heap == NULL) {
+        free(savedIDs);
+        free(savedSizes);
+        free(heap);
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Out of memory\"}");
+        return 0;
+    }
+    int n = 0;
+    for (MemoryBlock *b = mm->head; b != NULL; b = b->next) {
+        if (!b->isHole) {
+            savedIDs[n] = b->processID;
+            savedSizes[n] = b->size;
+            n++;
+        }
+    }
+
+    // STEP 3: Drop the list, tag the region
+    freeMemoryManager(mm);
+    blockFill(mm->backingRegion.basePtr, 0, mm->backingRegion.size);
+    btInit(heap, mm->backingRegion.basePtr, mm->backingRegion.size);
+
+    mm->useBoundaryTags = 1;
+    mm->tags = heap;
+    mm->layoutGeneration++;
+    mm->numProcesses = 0;
+    mm->numHoles = 1;
+    mm->freeMemory = (int)(heap->freeBytes / 1024);
+
+    // STEP 4: Re-allocate with the old PIDs
+    int successCount = 0;
+    historySuspend(mm);
+    for (int i = 0; i < savedCount; i++) {
+        if (allocateMemory(mm, savedIDs[i], savedSizes[i], FIRST_FIT) != -1) {
+            successCount++;
+        }
+    }
+    historyResume(mm);
+    free(savedIDs);
+    free(savedSizes);
+
+    snprintf(resultBuffer, bufferSize,
+        "{\"success\":true,"
+        "\"message\":\"Converted to boundary tags. %d/%d processes re-allocated.\","
+        "\"processesConverted\":%d,"
+        "\"totalProcesses\":%d,"
+        "\"metadataBytes\":%d}",
+        successCount, savedCount,
+        successCount, savedCount,
+        heap->numBlocks * BT_OVERHEAD);
+
+    historyRecord(mm, HISTORY_TAGS_CONVERT, 0, 0, 0);
+    return 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: revertFromBoundaryTags
+================================================================================
+PURPOSE: Back to the block list, re-allocating with first fit
+*/
+
+int revertFromBoundaryTags(MemoryManager *mm, char *resultBuffer, int bufferSize) {
+
+    if (!mm->useBoundaryTags || mm->tags == NULL) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Boundary-tag mode is not active\"}");
+        return 0;
+    }
+
+    BoundaryTagHeap *heap = mm->tags;
+
+    // STEP 1: Save current processes by walking the tags
+    int savedCount = 0;
+    int *savedIDs = (int*)malloc(sizeof(int) * (size_t)(heap->numBlocks + 1));
+    int *savedSizes = (int*)malloc(sizeof(int) * (size_t)(heap->numBlocks + 1));
+    if (savedIDs == NULL || savedSizes == NULL) {
+        free(savedIDs);
+        free(savedSizes);
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Out of memory\"}");
+        return 0;
+    }
+    for (size_t o = 0; o < heap->size; o += tagSize(headerAt(heap, o))) {
+        const BoundaryTag *header = headerAt(heap, o);
+        if (!tagIsFree(header)) {
+            savedIDs[savedCount] = header->processID;
+            savedSizes[savedCount] = (int)((tagSize(header) - BT_OVERHEAD) / 1024);
+            savedCount++;
+        }
+    }
+
+    // STEP 2: Leave boundary-tag mode
+    free(heap);
+    mm->tags = NULL;
+    mm->useBoundaryTags = 0;
+    mm->layoutGeneration++;
+    blockFill(mm->backingRegion.basePtr, 0, mm->backingRegion.size);
+
+    // STEP 3: Standard layout
+    mm->numProcesses = 0;
+    mm->numHoles = 1;
+    mm->freeMemory = mm->userMemory;
+    mm->head = createBlock(mm, 1, mm->osMemory, mm->totalMemory - 1, -1);
+    mm->head->realPtr = mm->backingRegion.basePtr;
+    mm->head->realSize = mm->backingRegion.size;
+
+    // STEP 4: Re-allocate with first fit
+    int successCount = 0;
+    historySuspend(mm);
+    for (int i = 0; i < savedCount; i++) {
+        if (allocateMemory(mm, savedIDs[i], savedSizes[i], FIRST_FIT) != -1) {
+            successCount++;
+        }
+    }
+    historyResume(mm);
+    free(savedIDs);
+    free(savedSizes);
+
+    snprintf(resultBuffer, bufferSize,
+        "{\"success\":true,"
+        "\"message\":\"Reverted to the block list. %d/%d processes re-allocated.\","
+        "\"processesConverted\":%d,"
+        "\"totalProcesses\":%d}",
+        successCount, savedCount,
+        successCount, savedCount);
+
+    historyRecord(mm, HISTORY_TAGS_REVERT, 0, 0, 0);
+    return 1;
+}
+
+
+/*
+================================================================================
+HELPERS: Comparison
+================================================================================
+*/
+
+static long long nowNanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+typedef struct {
+    long long allocNs;          // Total allocation time
+    long long freeNs;           // Total free time
+    int       allocs;           // Successful allocations
+    int       frees;            // Frees performed
+    int       failures;         // Allocations that did not fit
+    long long visits;           // List nodes / tags read in searches
+    long long cacheMisses;      // -1 = counter unavailable
+    long long metadataBytes;    // At the end of the stream
+    long long peakMetadataBytes;
+} EngineRun;
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: replayList
+--------------------------------------------------------------------------------
+PURPOSE: Replay the stream with firstFit() and deallocateMemory()
+
+The list engine has no visit counter of its own, so when countVisits is
+set the first-fit search is repeated by hand before every allocation.
+That pass is never the timed one (see compareMetadataEngines).
+*/
+
+static void replayList(MemoryManager *mm, const WorkloadOp *stream, int ops,
+                       int *pidOf, int countVisits, EngineRun *run) {
+
+    MemoryManager scratch;
+    initializeMemory(&scratch, mm->totalMemory, mm->osMemory);
+    scratch.measureFaults = 0;
+
+    memset(run, 0, sizeof(*run));
+    int counter = (countVisits) ? -1 : os_cache_counter_open();
+    long long missesBefore = os_cache_counter_read(counter);
+
+    for (int i = 0; i < ops; i++) {
+        const WorkloadOp *op = &stream[i];
+
+        if (!op->isFree) {
+            pidOf[op->allocIndex] = -1;
+            if (countVisits) {
+                for (MemoryBlock *b = scratch.head; b != NULL; b = b->next) {
+                    run->visits++;
+                    if (b->isHole && b->size >= op->sizeKB) break;
+                }
+            }
+            long long start = nowNanoseconds();
+            int result = firstFit(&scratch, op->allocIndex + 1, op->sizeKB);
+            run->allocNs += nowNanoseconds() - start;
+            if (result != -1) {
+                pidOf[op->allocIndex] = op->allocIndex + 1;
+                run->allocs++;
+            } else {
+                run->failures++;
+            }
+        } else if (pidOf[op->allocIndex] != -1) {
+            long long start = nowNanoseconds();
+            deallocateMemory(&scratch, pidOf[op->allocIndex]);
+            run->freeNs += nowNanoseconds() - start;
+            run->frees++;
+            pidOf[op->allocIndex] = -1;
+        }
+
+        long long bytes = (long long)(scratch.numProcesses + scratch.numHoles)
+                        * (long long)sizeof(MemoryBlock);
+        if (bytes > run->peakMetadataBytes) run->peakMetadataBytes = bytes;
+    }
+
+    long long missesAfter = os_cache_counter_read(counter);
+    run->cacheMisses = (missesBefore >= 0 && missesAfter >= 0) ? missesAfter - missesBefore : -1;
+    os_cache_counter_close(counter);
+
+    run->metadataBytes = (long long)(scratch.numProcesses + scratch.numHoles)
+                       * (long long)sizeof(MemoryBlock);
+
+    freeMemoryManager(&scratch);
+    os_region_free(&scratch.backingRegion);
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: replayTags
+--------------------------------------------------------------------------------
+PURPOSE: Replay the stream on a boundary-tag heap of the same size
+*/
+
+static int replayTags(MemoryManager *mm, const WorkloadOp *stream, int ops,
+                      long *offsetOf, EngineRun *run) {
+
+    memset(run, 0, sizeof(*run));
+
+    OSRegion region = os_region_alloc((size_t)mm->userMemory * 1024);
+    BoundaryTagHeap heap;
+    if (btInit(&heap, region.basePtr, region.size) != 0) {
+        os_region_free(&region);
+        return -1;
+    }
+
+    int counter = os_cache_counter_open();
+    long long missesBefore = os_cache_counter_read(counter);
+
+    for (int i = 0; i < ops; i++) {
+        const WorkloadOp *op = &stream[i];
+
+        if (!op->isFree) {
+            long long start = nowNanoseconds();
+            long offset = btAllocate(&heap, op->allocIndex + 1, (size_t)op->sizeKB * 1024);
+            run->allocNs += nowNanoseconds() - start;
+            offsetOf[op->allocIndex] = offset;
+            if (offset != -1) run->allocs++; else run->failures++;
+        } else if (offsetOf[op->allocIndex] != -1) {
+            long long start = nowNanoseconds();
+            btFree(&heap, offsetOf[op->allocIndex]);
+            run->freeNs += nowNanoseconds() - start;
+            run->frees++;
+            offsetOf[op->allocIndex] = -1;
+        }
+
+        long long bytes = (long long)heap.numBlocks * BT_OVERHEAD;
+        if (bytes > run->peakMetadataBytes) run->peakMetadataBytes = bytes;
+    }
+
+    long long missesAfter = os_cache_counter_read(counter);
+    run->cacheMisses = (missesBefore >= 0 && missesAfter >= 0) ? missesAfter - missesBefore : -1;
+    os_cache_counter_close(counter);
+
+    run->visits = heap.headerReads;
+    run->metadataBytes = (long long)heap.numBlocks * BT_OVERHEAD;
+
+    os_region_free(&region);
+    return 0;
+}
+
+static int engineRunToJSON(const char *engine, const char *where, const EngineRun *run,
+                           char *buffer, int bufferSize) {
+    char misses[32];
+    if (run->cacheMisses >= 0) {
+        snprintf(misses, sizeof(misses), "%lld", run->cacheMisses);
+    } else {
+        snprintf(misses, sizeof(misses), "null");
+    }
+    return snprintf(buffer, bufferSize,
+        "{\"engine\":\"%s\",\"metadataLocation\":\"%s\","
+        "\"successes\":%d,\"failures\":%d,\"frees\":%d,"
+        "\"metadataBytes\":%lld,\"peakMetadataBytes\":%lld,"
+        "\"searchVisits\":%lld,\"cacheMisses\":%s,"
+        "\"allocNsMean\":%lld,\"freeNsMean\":%lld}",
+        engine, where,
+        run->allocs, run->failures, run->frees,
+        run->metadataBytes, run->peakMetadataBytes,
+        run->visits, misses,
+        (run->allocs + run->failures > 0) ? run->allocNs / (run->allocs + run->failures) : 0,
+        (run->frees > 0) ? run->freeNs / run->frees : 0);
+}
+
+
+/*
+================================================================================
+FUNCTION: compareMetadataEngines
+================================================================================
+PURPOSE: List engine vs boundary tags on one stream
+
+ORDER OF PASSES:
+1. List engine, counting visits (untimed numbers are discarded)
+2. List engine again, timed and with the cache-miss counter
+3. Boundary tags, timed and with the cache-miss counter (the tag engine
+   counts its header reads itself, so one pass is enough)
+*/
+
+int compareMetadataEngines(MemoryManager *mm, int ops, int minSizeKB, int maxSizeKB,
+                           int freePercent, unsigned long long seed,
+                           char *resultBuffer, int bufferSize) {
+
+    // STEP 1: Validate
+    if (ops <= 0 || ops > MAX_COMPARE_OPS) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"ops must be 1-%d\"}", MAX_COMPARE_OPS);
+        return 0;
+    }
+    if (minSizeKB <= 0 || maxSizeKB < minSizeKB || maxSizeKB > mm->userMemory) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Need 0 < minSize <= maxSize <= %d\"}",
+            mm->userMemory);
+        return 0;
+    }
+    if (freePercent < 0 || freePercent > 100) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"freePercent must be 0-100\"}");
+        return 0;
+    }
+
+    // STEP 2: The shared stream
+    WorkloadOp *stream = (WorkloadOp*)malloc(sizeof(WorkloadOp) * (size_t)ops);
+    int *pidOf = (int*)malloc(sizeof(int) * (size_t)ops);
+    long *offsetOf = (long*)malloc(sizeof(long) * (size_t)ops);
+    if (stream == NULL || pidOf == NULL || offsetOf == NULL) {
+        free(stream); free(pidOf); free(offsetOf);
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Out of memory\"}");
+        return 0;
+    }
+
+    WorkloadRNG rng;
+    workloadSeed(&rng, (uint64_t)seed);
+    int allocations = generateOpStream(&rng, stream, ops, minSizeKB, maxSizeKB, freePercent);
+
+    // STEP 3: Run the passes
+    EngineRun counted, listRun, tagRun;
+    replayList(mm, stream, ops, pidOf, 1, &counted);
+    replayList(mm, stream, ops, pidOf, 0, &listRun);
+    listRun.visits = counted.visits;
+    int tagsOK = (replayTags(mm, stream, ops, offsetOf, &tagRun) == 0);
+
+    // STEP 4: Report
+    int written = snprintf(resultBuffer, bufferSize,
+        "{\"success\":true,\"ops\":%d,\"allocations\":%d,"
+        "\"minSizeKB\":%d,\"maxSizeKB\":%d,\"freePercent\":%d,\"seed\":%llu,"
+        "\"listNodeBytes\":%d,\"tagBytesPerBlock\":%d,\"results\":[",
+        ops, allocations, minSizeKB, maxSizeKB, freePercent, seed,
+        (int)sizeof(MemoryBlock), BT_OVERHEAD);
+    written += engineRunToJSON("list", "malloc", &listRun,
+                               resultBuffer + written, bufferSize - written);
+    if (tagsOK && written < bufferSize) {
+        written += snprintf(resultBuffer + written, bufferSize - written, ",");
+        written += engineRunToJSON("boundary_tags", "inline", &tagRun,
+                                   resultBuffer + written, bufferSize - written);
+    }
+    if (written < bufferSize) {
+        snprintf(resultBuffer + written, bufferSize - written, "]}");
+    }
+
+    free(stream);
+    free(pidOf);
+    free(offsetOf);
+    return 1;
+}
+
+
+/*
+================================================================================
+END OF FILE: boundary_tag.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. btInit() - One free block over the whole region
+2. btAllocate() - First fit header to header, split, fill
+3. btFree() - O(1) coalescing through the neighbours' tags
+4. btFindProcess() / btLargestFree() / btFragmentation() - Heap walks
+5. btBlocksToJSON() / btBlocksToArray() - Blocks read from the tags
+6. convertToBoundaryTags() / revertFromBoundaryTags() - Switch modes
+7. compareMetadataEngines() - Metadata bytes, visits, cache misses, latency
+================================================================================
+*/
@@ -0,0 +1,469 @@
+/*
+================================================================================
+FILE: history.c
+PURPOSE: Implement the op log, checkpoints and replay
+DESCRIPTION:
+    - historyRecord() appends a few integers per mutation
+    - takeCheckpoint() copies the block table into a compact array
+    - historyReconstruct() restores a checkpoint into a scratch manager
+      (no backing region, so replay moves no real bytes) and replays
+================================================================================
+*/
+
+#include <stdio.h>      // snprintf
+#include <stdlib.h>     // malloc, calloc, free
+#include <string.h>     // memset
+#include <time.h>       // clock_gettime, CLOCK_MONOTONIC
+#include "../include/history.h"
+#include "../include/memory_manager.h"
+#include "../include/os_memory.h"
+
+
+static const char *opNames[] = {
+    "allocate", "deallocate", "buddy_allocate", "buddy_deallocate",
+    "compact", "buddy_convert", "buddy_revert", "reset",
+    "paged_convert", "paged_revert", "tags_convert", "tags_revert",
+    "deferred_enable", "deferred_disable", "coalesce"
+};
+
+
+static long long nowNanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: listEngineActive
+--------------------------------------------------------------------------------
+PURPOSE: Is the state exactly the block list (contiguous or buddy)?
+Only then can it be checkpointed and the ops on it replayed.
+*/
+
+static int listEngineActive(const MemoryManager *mm) {
+    return !mm->usePagedMode && !mm->useBoundaryTags && mm->quick == NULL;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: checkpointAt / dropOldestCheckpoint
+--------------------------------------------------------------------------------
+*/
+
+static HistoryCheckpoint* checkpointAt(History *h, int i) {
+    return &h->checkpoints[(h->firstCheckpoint + i) % HISTORY_MAX_CHECKPOINTS];
+}
+
+static void dropOldestCheckpoint(History *h) {
+    HistoryCheckpoint *oldest = checkpointAt(h, 0);
+    free(oldest->entries);
+    oldest->entries = NULL;
+    h->firstCheckpoint = (h->firstCheckpoint + 1) % HISTORY_MAX_CHECKPOINTS;
+    h->numCheckpoints--;
+}
+
+// A checkpoint is useless once the ops after it have left the log
+static void dropStaleCheckpoints(History *h) {
+    while (h->numCheckpoints > 0 &&
+           checkpointAt(h, 0)->op < h->latestOp - HISTORY_MAX_OPS) {
+        dropOldestCheckpoint(h);
+    }
+}
+
+
+/*
+================================================================================
+FUNCTION: takeCheckpoint
+================================================================================
+PURPOSE: Save the block table as the state after op h->latestOp
+
+STEPS:
+1. Make room in a full ring (the oldest checkpoint goes)
+2. Copy every block into one malloc'd array
+*/
+
+static void takeCheckpoint(MemoryManager *mm, History *h) {
+
+    // STEP 1: Make room
+    if (h->numCheckpoints == HISTORY_MAX_CHECKPOINTS) {
+        dropOldestCheckpoint(h);
+    }
+
+    // STEP 2: Copy the block table
+    int count = 0;
+    for (MemoryBlock *b = mm->head; b != NULL; b = b->next) {
+        count++;
+    }
+    HistoryEntry *entries = (HistoryEntry*)malloc((count > 0 ? count : 1) * sizeof(HistoryEntry));
+    if (entries == NULL) {
+        h->chainBroken = 1;     // Try again after the next op
+        return;
+    }
+
+    int i = 0;
+    for (MemoryBlock *b = mm->head; b != NULL; b = b->next, i++) {
+        entries[i].startAddress = b->startAddress;
+        entries[i].size = b->size;
+        entries[i].processID = b->processID;
+        entries[i].blockID = b->blockID;
+        entries[i].buddyID = b->buddyID;
+        entries[i].isHole = (char)b->isHole;
+    }
+
+    HistoryCheckpoint *cp = checkpointAt(h, h->numCheckpoints);
+    cp->op = h->latestOp;
+    cp->useBuddySystem = mm->useBuddySystem;
+    cp->processCounter = mm->processCounter;
+    cp->nextBlockID = mm->nextBlockID;
+    cp->totalMemory = mm->totalMemory;
+    cp->osMemory = mm->osMemory;
+    cp->numEntries = count;
+    cp->entries = entries;
+    h->numCheckpoints++;
+    h->chainBroken = 0;
+}
+
+
+/*
+================================================================================
+FUNCTION: enableHistory / destroyHistory
+================================================================================
+*/
+
+void enableHistory(MemoryManager *mm) {
+    if (mm->history != NULL) {
+        return;
+    }
+    History *h = (History*)calloc(1, sizeof(History));
+    if (h == NULL) {
+        return;
+    }
+    mm->history = h;
+
+    // Op 0: the state we start from (or the first op that allows one)
+    if (listEngineActive(mm)) {
+        takeCheckpoint(mm, h);
+    } else {
+        h->chainBroken = 1;
+    }
+}
+
+void destroyHistory(History *history) {
+    if (history == NULL) {
+        return;
+    }
+    while (history->numCheckpoints > 0) {
+        dropOldestCheckpoint(history);
+    }
+    free(history);
+}
+
+
+/*
+================================================================================
+FUNCTION: historyRecord / historySuspend / historyResume
+================================================================================
+*/
+
+void historyRecord(MemoryManager *mm, HistoryOpType type, int a, int b, int c) {
+
+    History *h = mm->history;
+    if (h == NULL || h->suspended > 0) {
+        return;
+    }
+
+    // STEP 1: Append the op (overwrites the op HISTORY_MAX_OPS back)
+    h->latestOp++;
+    HistoryOp *op = &h->ops[h->latestOp % HISTORY_MAX_OPS];
+    op->type = type;
+    op->a = a;
+    op->b = b;
+    op->c = c;
+    op->replayable = (char)(type <= HISTORY_BUDDY_REVERT && listEngineActive(mm));
+
+    if (!op->replayable) {
+        h->chainBroken = 1;
+    }
+    dropStaleCheckpoints(h);
+
+    // STEP 2: Checkpoint when the interval is up, or as soon as the
+    // state is the block list again after an op replay cannot repeat
+    if (!listEngineActive(mm)) {
+        return;
+    }
+    long long lastCheckpoint = h->numCheckpoints > 0
+        ? checkpointAt(h, h->numCheckpoints - 1)->op : -1;
+    if (h->chainBroken || lastCheckpoint < 0 ||
+        h->latestOp - lastCheckpoint >= HISTORY_CHECKPOINT_INTERVAL) {
+        takeCheckpoint(mm, h);
+    }
+}
+
+void historySuspend(MemoryManager *mm) {
+    if (mm->history != NULL) {
+        mm->history->suspended++;
+    }
+}
+
+void historyResume(MemoryManager *mm) {
+    if (mm->history != NULL && mm->history->suspended > 0) {
+        mm->history->suspended--;
+    }
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: restoreCheckpoint
+--------------------------------------------------------------------------------
+PURPOSE: Turn a checkpoint into a scratch manager without a backing
+         region (realPtr NULL everywhere: replay moves no real bytes).
+         metadataOnly keeps it so when a buddy convert / revert is replayed.
+*/
+
+static int restoreCheckpoint(const HistoryCheckpoint *cp, MemoryManager *scratch) {
+
+    memset(scratch, 0, sizeof(*scratch));
+    scratch->totalMemory = cp->totalMemory;
+    scratch->osMemory = cp->osMemory;
+    scratch->userMemory = cp->totalMemory - cp->osMemory;
+    scratch->processCounter = cp->processCounter;
+    scratch->nextBlockID = cp->nextBlockID;
+    scratch->useBuddySystem = cp->useBuddySystem;
+    scratch->measureFaults = 0;
+    scratch->metadataOnly = 1;      // Replayed conversions map nothing either
+
+    MemoryBlock *tail = NULL;
+    for (int i = 0; i < cp->numEntries; i++) {
+        const HistoryEntry *e = &cp->entries[i];
+        MemoryBlock *block = createBlock(NULL, e->isHole, e->startAddress,
+                                         e->startAddress + e->size - 1, e->processID);
+        if (block == NULL) {
+            freeMemoryManager(scratch);
+            return 0;
+        }
+        block->blockID = e->blockID;
+        block->buddyID = e->buddyID;
+
+        if (tail == NULL) {
+            scratch->head = block;
+        } else {
+            tail->next = block;
+        }
+        tail = block;
+
+        if (e->isHole) {
+            scratch->numHoles++;
+            scratch->freeMemory += e->size;
+        } else {
+            scratch->numProcesses++;
+        }
+    }
+    return 1;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: replayOp
+--------------------------------------------------------------------------------
+PURPOSE: Run one logged op again with the same arguments
+*/
+
+static void replayOp(MemoryManager *scratch, const HistoryOp *op) {
+    switch (op->type) {
+        case HISTORY_ALLOCATE:
+            allocateMemory(scratch, op->a, op->b, (AllocationAlgorithm)op->c);
+            break;
+        case HISTORY_DEALLOCATE:
+            deallocateMemory(scratch, op->a);
+            break;
+        case HISTORY_BUDDY_ALLOCATE:
+            scratch->processCounter = op->a - 1;    // Same PID as the original
+            buddyAllocate(scratch, op->b, NULL, 0);
+            break;
+        case HISTORY_BUDDY_DEALLOCATE:
+            buddyDeallocate(scratch, op->a, NULL, 0);
+            break;
+        case HISTORY_COMPACT:
+            compact(scratch, NULL, 0);
+            break;
+        case HISTORY_BUDDY_CONVERT:
+            convertToBuddySystem(scratch, NULL, 0);
+            break;
+        case HISTORY_BUDDY_REVERT:
+            revertFromBuddySystem(scratch, NULL, 0);
+            break;
+    }
+}
+
+
+static void opToJSON(const HistoryOp *op, long long n, char *buffer, int bufferSize) {
+    snprintf(buffer, bufferSize,
+        "{\"op\":%lld,\"type\":\"%s\",\"a\":%d,\"b\":%d,\"c\":%d,\"replayable\":%s}",
+        n, opNames[op->type], op->a, op->b, op->c,
+        op->replayable ? "true" : "false");
+}
+
+
+/*
+================================================================================
+FUNCTION: historyReconstruct
+================================================================================
+PURPOSE: The state after op N
+
+ALGORITHM:
+1. Check N is still in the log
+2. Newest checkpoint with checkpoint.op <= N
+3. Every op in (checkpoint, N] must be replayable
+4. Restore the checkpoint into a scratch manager and replay them
+5. Render the scratch manager's blocks and a few stats
+*/
+
+int historyReconstruct(MemoryManager *mm, long long op, char *buffer, int bufferSize) {
+
+    History *h = mm->history;
+    if (h == NULL) {
+        snprintf(buffer, bufferSize,
+            "{\"success\":false,\"message\":\"History is not being recorded\"}");
+        return 0;
+    }
+
+    long long start = nowNanoseconds();
+
+    // STEP 1: In range?
+    long long oldest = h->numCheckpoints > 0 ? checkpointAt(h, 0)->op : h->latestOp + 1;
+    if (op < oldest || op > h->latestOp) {
+        snprintf(buffer, bufferSize,
+            "{\"success\":false,\"message\":\"Op %lld is outside the retained history (%lld..%lld)\"}",
+            op, oldest, h->latestOp);
+        return 0;
+    }
+
+    // STEP 2: Newest checkpoint at or before op
+    const HistoryCheckpoint *cp = NULL;
+    for (int i = h->numCheckpoints - 1; i >= 0; i--) {
+        if (checkpointAt(h, i)->op <= op) {
+            cp = checkpointAt(h, i);
+            break;
+        }
+    }
+
+    // STEP 3: Can every op after it be replayed?
+    for (long long n = cp->op + 1; n <= op; n++) {
+        const HistoryOp *o = &h->ops[n % HISTORY_MAX_OPS];
+        if (!o->replayable) {
+            snprintf(buffer, bufferSize,
+                "{\"success\":false,\"message\":\"Op %lld (%s) ran outside the block-list "
+                "engine; states up to the next checkpoint cannot be rebuilt\"}",
+                n, opNames[o->type]);
+            return -1;
+        }
+    }
+
+    // STEP 4: Restore and replay
+    MemoryManager scratch;
+    if (!restoreCheckpoint(cp, &scratch)) {
+        snprintf(buffer, bufferSize,
+            "{\"success\":false,\"message\":\"Out of memory\"}");
+        return 0;
+    }
+    for (long long n = cp->op + 1; n <= op; n++) {
+        replayOp(&scratch, &h->ops[n % HISTORY_MAX_OPS]);
+    }
+    long long replayed = op - cp->op;
+    h->reconstructions++;
+    h->opsReplayed += replayed;
+
+    // STEP 5: Render
+    char *blocks = (char*)malloc(bufferSize);
+    if (blocks == NULL) {
+        freeMemoryManager(&scratch);
+        os_region_free(&scratch.backingRegion);
+        snprintf(buffer, bufferSize,
+            "{\"success\":false,\"message\":\"Out of memory\"}");
+        return 0;
+    }
+    blocksToJSON(&scratch, blocks, bufferSize);
+
+    char operation[160] = "null";
+    if (op > 0 && op > h->latestOp - HISTORY_MAX_OPS) {
+        opToJSON(&h->ops[op % HISTORY_MAX_OPS], op, operation, sizeof(operation));
+    }
+
+    snprintf(buffer, bufferSize,
+        "{\"success\":true,\"op\":%lld,\"latestOp\":%lld,\"operation\":%s,"
+        "\"checkpointOp\":%lld,\"replayed\":%lld,\"rebuildUs\":%.1f,"
+        "\"stats\":{\"freeMemory\":%d,\"numProcesses\":%d,\"numHoles\":%d,"
+        "\"fragmentation\":%.2f,\"buddySystem\":%s},"
+        "\"blocks\":%s}",
+        op, h->latestOp, operation,
+        cp->op, replayed, (nowNanoseconds() - start) / 1000.0,
+        scratch.freeMemory, scratch.numProcesses, scratch.numHoles,
+        calculateFragmentation(&scratch),
+        scratch.useBuddySystem ? "true" : "false",
+        blocks);
+
+    free(blocks);
+    freeMemoryManager(&scratch);
+    os_region_free(&scratch.backingRegion);   // metadataOnly: never mapped (no-op)
+    return 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: historyToJSON
+================================================================================
+*/
+
+void historyToJSON(MemoryManager *mm, char *buffer, int bufferSize) {
+
+    History *h = mm->history;
+    if (h == NULL) {
+        snprintf(buffer, bufferSize, "{\"enabled\":false}");
+        return;
+    }
+
+    size_t bytes = sizeof(History);
+    for (int i = 0; i < h->numCheckpoints; i++) {
+        bytes += (size_t)checkpointAt(h, i)->numEntries * sizeof(HistoryEntry);
+    }
+    long long oldest = h->numCheckpoints > 0 ? checkpointAt(h, 0)->op : h->latestOp + 1;
+
+    int w = snprintf(buffer, bufferSize,
+        "{\"enabled\":true,\"latestOp\":%lld,\"oldestOp\":%lld,"
+        "\"checkpoints\":%d,\"checkpointInterval\":%d,\"maxOps\":%d,"
+        "\"bytes\":%zu,\"reconstructions\":%lld,\"opsReplayed\":%lld,\"recent\":[",
+        h->latestOp, oldest, h->numCheckpoints,
+        HISTORY_CHECKPOINT_INTERVAL, HISTORY_MAX_OPS,
+        bytes, h->reconstructions, h->opsReplayed);
+
+    // The last 20 ops, newest first
+    long long stop = h->latestOp - 20 > 0 ? h->latestOp - 20 : 0;
+    for (long long n = h->latestOp; n > stop && w < bufferSize - 200; n--) {
+        char one[160];
+        opToJSON(&h->ops[n % HISTORY_MAX_OPS], n, one, sizeof(one));
+        w += snprintf(buffer + w, bufferSize - w, "%s%s", n == h->latestOp ? "" : ",", one);
+    }
+    if (w < bufferSize - 2) {
+        snprintf(buffer + w, bufferSize - w, "]}");
+    }
+}
+
+
+/*
+================================================================================
+END OF FILE: history.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. historyRecord() - Append one op, checkpoint on interval or after a break
+2. takeCheckpoint() - Compact copy of the block table
+3. historyReconstruct() - Restore the nearest checkpoint, replay the rest
+4. historyToJSON() - Retained range, memory used, recent ops
+================================================================================
+*/
@@ -0,0 +1,486 @@
+/*
+================================================================================
+FILE: http_parser.c
+PURPOSE: Implement the incremental HTTP/1.1 request parser
+DESCRIPTION:
+    - One state per place a request can be cut off (inside the method,
+      the path, a header name, a chunk size, ...)
+    - The loop looks at each byte once; bodies are skipped (or, for
+      chunked bodies, moved down) in one step per call
+    - Header values are only examined for the headers that change the
+      framing or the connection, and the two static files need
+================================================================================
+*/
+
+#include <string.h>     // memmove, memset
+#include <ctype.h>      // tolower, isxdigit
+#include "../include/http_parser.h"
+
+
+// Where the parser is (one state per place a request can be cut off)
+enum {
+    S_METHOD,
+    S_PATH,
+    S_VERSION,
+    S_REQUEST_LF,           // Saw '\r' after the version
+    S_HEADER_START,         // At the start of a header line (or the blank line)
+    S_HEADER_NAME,
+    S_HEADER_VALUE_START,   // Skipping spaces after ':'
+    S_HEADER_VALUE,
+    S_HEADER_LF,
+    S_HEADERS_END_LF,       // Saw '\r' of the blank line
+    S_BODY,                 // Content-Length body
+    S_CHUNK_SIZE,
+    S_CHUNK_EXT,            // ";name=value" after the size (ignored)
+    S_CHUNK_SIZE_LF,
+    S_CHUNK_DATA,
+    S_CHUNK_DATA_CR,        // CRLF after the chunk's data
+    S_CHUNK_DATA_LF,
+    S_TRAILER_START,
+    S_TRAILER_LINE,
+    S_TRAILER_END_LF,
+    S_DONE
+};
+
+// Longest method ("OPTIONS" is 7)
+#define HTTP_MAX_METHOD 15
+
+
+/*
+--------------------------------------------------------------------------------
+HELPERS: fail / equalsIgnoreCase / hasToken
+--------------------------------------------------------------------------------
+*/
+
+static int fail(HttpParser *p, int status, const char *text) {
+    p->errorStatus = status;
+    p->errorText = text;
+    return HTTP_PARSE_ERROR;
+}
+
+// s[0 .. length-1] == lower, ignoring case ('lower' is all lowercase)
+static int equalsIgnoreCase(const char *s, int length, const char *lower) {
+    int i = 0;
+    for (; i < length && lower[i] != '\0'; i++) {
+        if (tolower((unsigned char)s[i]) != lower[i]) {
+            return 0;
+        }
+    }
+    return i == length && lower[i] == '\0';
+}
+
+// Is 'token' one of the comma-separated items of s[0 .. length-1]?
+// ("Connection: keep-alive, Upgrade"; parameters after ';' are ignored)
+static int hasToken(const char *s, int length, const char *token) {
+    int i = 0;
+    while (i < length) {
+        while (i < length && (s[i] == ' ' || s[i] == '\t' || s[i] == ',')) {
+            i++;
+        }
+        int start = i;
+        while (i < length && s[i] != ',' && s[i] != ' ' && s[i] != '\t' && s[i] != ';') {
+            i++;
+        }
+        if (i > start && equalsIgnoreCase(s + start, i - start, token)) {
+            return 1;
+        }
+        while (i < length && s[i] != ',') {
+            i++;        // Skip ";q=0.8"
+        }
+    }
+    return 0;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: headerDone
+--------------------------------------------------------------------------------
+PURPOSE: Act on a complete "name: value" line
+
+Only Content-Length, Transfer-Encoding, Connection and Expect (framing)
+and Accept-Encoding and If-None-Match (static files) matter here; the
+rest are skipped without a look at their values.
+
+RETURNS: HTTP_PARSE_MORE to go on, HTTP_PARSE_ERROR to stop
+*/
+
+static int headerDone(HttpParser *p, const char *data, int valueStart, int valueEnd) {
+
+    const char *name = data + p->nameStart;
+    int nameLength = p->nameEnd - p->nameStart;
+    const char *value = data + valueStart;
+
+    // Trailing spaces are not part of the value
+    while (valueEnd > valueStart && (data[valueEnd - 1] == ' ' || data[valueEnd - 1] == '\t')) {
+        valueEnd--;
+    }
+    int valueLength = valueEnd - valueStart;
+
+    if (equalsIgnoreCase(name, nameLength, "content-length")) {
+        if (valueLength == 0) {
+            return fail(p, 400, "Bad Request");
+        }
+        long long declared = 0;
+        for (int i = 0; i < valueLength; i++) {
+            if (value[i] < '0' || value[i] > '9') {
+                return fail(p, 400, "Bad Request");
+            }
+            declared = declared * 10 + (value[i] - '0');
+            if (declared > HTTP_MAX_BODY_BYTES) {
+                return fail(p, 413, "Payload Too Large");
+            }
+        }
+        // Two different lengths: nobody can tell where the body ends
+        if (p->sawLength && declared != p->contentLength) {
+            return fail(p, 400, "Bad Request");
+        }
+        p->sawLength = 1;
+        p->contentLength = declared;
+    } else if (equalsIgnoreCase(name, nameLength, "transfer-encoding")) {
+        if (!equalsIgnoreCase(value, valueLength, "chunked")) {
+            return fail(p, 501, "Not Implemented");     // gzip, deflate, ...
+        }
+        p->chunked = 1;
+    } else if (equalsIgnoreCase(name, nameLength, "connection")) {
+        if (hasToken(value, valueLength, "close")) {
+            p->keepAlive = 0;
+        } else if (hasToken(value, valueLength, "keep-alive")) {
+            p->keepAlive = 1;
+        }
+    } else if (equalsIgnoreCase(name, nameLength, "expect")) {
+        p->expect = equalsIgnoreCase(value, valueLength, "100-continue");
+    } else if (equalsIgnoreCase(name, nameLength, "accept-encoding")) {
+        p->acceptGzip = hasToken(value, valueLength, "gzip");
+    } else if (equalsIgnoreCase(name, nameLength, "if-none-match")) {
+        p->ifNoneMatchStart = valueStart;
+        p->ifNoneMatchLength = valueLength;
+    }
+    return HTTP_PARSE_MORE;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: headersDone
+--------------------------------------------------------------------------------
+PURPOSE: The blank line was reached: decide how the body is framed
+
+RETURNS: HTTP_PARSE_DONE if there is no body, else HTTP_PARSE_MORE
+*/
+
+static int headersDone(HttpParser *p) {
+    p->bodyStart = p->pos;
+    p->bodyEnd = p->pos;
+
+    if (p->chunked) {
+        if (p->sawLength) {
+            return fail(p, 400, "Bad Request");     // Both framings at once
+        }
+        p->expectContinue = p->expect;
+        p->mark = p->pos;
+        p->state = S_CHUNK_SIZE;
+        return HTTP_PARSE_MORE;
+    }
+    if (p->contentLength > 0) {
+        p->expectContinue = p->expect;
+        p->state = S_BODY;
+        return HTTP_PARSE_MORE;
+    }
+    p->state = S_DONE;
+    return HTTP_PARSE_DONE;
+}
+
+
+/*
+================================================================================
+FUNCTION: httpParserReset
+================================================================================
+*/
+
+void httpParserReset(HttpParser *parser) {
+    memset(parser, 0, sizeof(*parser));
+    parser->state = S_METHOD;
+}
+
+
+/*
+================================================================================
+FUNCTION: httpParse
+================================================================================
+ALGORITHM:
+1. Walk the bytes from where the last call stopped, one state per byte
+   (bodies: one step for all the bytes that are there)
+2. On the request's last byte, fill in method / path / body / consumed
+3. Out of bytes: keep the state; fail if the request can never fit
+*/
+
+int httpParse(HttpParser *p, char *data, int length) {
+
+    // STEP 1: Walk on
+    while (p->state != S_DONE) {
+
+        // Bodies first: they do not go byte by byte
+        if (p->state == S_BODY) {
+            long long end = p->bodyStart + p->contentLength;
+            if (length < end) {
+                p->pos = length;
+                break;
+            }
+            p->pos = (int)end;
+            p->bodyEnd = (int)end;
+            p->state = S_DONE;
+            break;
+        }
+        if (p->state == S_CHUNK_DATA) {
+            int available = length - p->pos;
+            int n = p->chunkLeft < available ? (int)p->chunkLeft : available;
+            // Decode in place: the data moves down over the chunk headers
+            memmove(data + p->bodyEnd, data + p->pos, n);
+            p->bodyEnd += n;
+            p->pos += n;
+            p->chunkLeft -= n;
+            if (p->chunkLeft > 0) {
+                break;
+            }
+            p->state = S_CHUNK_DATA_CR;
+            continue;
+        }
+
+        if (p->pos >= length) {
+            break;
+        }
+        if (p->state < S_BODY && p->pos >= HTTP_MAX_HEADER_BYTES) {
+            return fail(p, 431, "Request Header Fields Too Large");
+        }
+
+        char c = data[p->pos];
+
+        switch (p->state) {
+
+        // ----- Request line: "METHOD SP path SP HTTP/1.x" -----
+        case S_METHOD:
+            if (c == ' ' && p->pos > 0) {
+                data[p->pos] = '\0';            // method = data
+                p->pathStart = p->pos + 1;
+                p->state = S_PATH;
+            } else if (c < 'A' || c > 'Z' || p->pos >= HTTP_MAX_METHOD) {
+                return fail(p, 400, "Bad Request");
+            }
+            break;
+
+        case S_PATH:
+            if (c == ' ' && p->pos > p->pathStart) {
+                data[p->pos] = '\0';            // path = data + pathStart
+                p->mark = p->pos + 1;
+                p->state = S_VERSION;
+            } else if ((unsigned char)c <= ' ' || c == 0x7f) {
+                return fail(p, 400, "Bad Request");
+            }
+            break;
+
+        case S_VERSION:
+            if (c == '\r' || c == '\n') {
+                const char *version = data + p->mark;
+                int versionLength = p->pos - p->mark;
+                if (versionLength == 8 && memcmp(version, "HTTP/1.", 7) == 0 &&
+                    (version[7] == '0' || version[7] == '1')) {
+                    p->minorVersion = version[7] - '0';
+                    p->keepAlive = p->minorVersion == 1;
+                } else if (versionLength >= 5 && memcmp(version, "HTTP/", 5) == 0) {
+                    return fail(p, 505, "HTTP Version Not Supported");
+                } else {
+                    return fail(p, 400, "Bad Request");
+                }
+                p->state = c == '\r' ? S_REQUEST_LF : S_HEADER_START;
+            }
+            break;
+
+        case S_REQUEST_LF:
+        case S_HEADER_LF:
+            if (c != '\n') {
+                return fail(p, 400, "Bad Request");
+            }
+            p->state = S_HEADER_START;
+            break;
+
+        // ----- Headers: "Name: value" lines up to a blank line -----
+        case S_HEADER_START:
+            if (c == '\r') {
+                p->state = S_HEADERS_END_LF;
+            } else if (c == '\n') {
+                p->pos++;
+                if (headersDone(p) == HTTP_PARSE_ERROR) {
+                    return HTTP_PARSE_ERROR;
+                }
+                continue;
+            } else if (c == ' ' || c == '\t' || c == ':') {
+                return fail(p, 400, "Bad Request");     // Folded lines are obsolete
+            } else {
+                p->nameStart = p->pos;
+                p->state = S_HEADER_NAME;
+            }
+            break;
+
+        case S_HEADER_NAME:
+            if (c == ':') {
+                p->nameEnd = p->pos;
+                p->state = S_HEADER_VALUE_START;
+            } else if (c == '\r' || c == '\n' || c == ' ' || c == '\t') {
+                return fail(p, 400, "Bad Request");
+            }
+            break;
+
+        case S_HEADER_VALUE_START:
+            if (c == ' ' || c == '\t') {
+                break;
+            }
+            p->mark = p->pos;
+            p->state = S_HEADER_VALUE;
+            continue;                           // Look at c again as a value byte
+
+        case S_HEADER_VALUE: {
+            // The rest of the line in one go
+            const char *end = memchr(data + p->pos, '\n', length - p->pos);
+            if (end == NULL) {
+                p->pos = length;
+                continue;
+            }
+            int lineEnd = (int)(end - data);
+            int valueEnd = (lineEnd > p->mark && data[lineEnd - 1] == '\r') ? lineEnd - 1 : lineEnd;
+            if (headerDone(p, data, p->mark, valueEnd) == HTTP_PARSE_ERROR) {
+                return HTTP_PARSE_ERROR;
+            }
+            p->pos = lineEnd;
+            p->state = S_HEADER_START;
+            break;
+        }
+
+        case S_HEADERS_END_LF:
+            if (c != '\n') {
+                return fail(p, 400, "Bad Request");
+            }
+            p->pos++;
+            if (headersDone(p) == HTTP_PARSE_ERROR) {
+                return HTTP_PARSE_ERROR;
+            }
+            continue;
+
+        // ----- Chunked body: "<hex size>\r\n<data>\r\n" ... "0\r\n\r\n" -----
+        case S_CHUNK_SIZE:
+            if (isxdigit((unsigned char)c)) {
+                int digit = c <= '9' ? c - '0' : tolower((unsigned char)c) - 'a' + 10;
+                p->chunkLeft = p->chunkLeft * 16 + digit;
+                if (p->chunkLeft > HTTP_MAX_BODY_BYTES) {
+                    return fail(p, 413, "Payload Too Large");
+                }
+                break;
+            }
+            if (p->pos == p->mark || (c != ';' && c != '\r' && c != '\n')) {
+                return fail(p, 400, "Bad Request");
+            }
+            p->state = c == ';' ? S_CHUNK_EXT : S_CHUNK_SIZE_LF;
+            if (c != '\n') {
+                break;
+            }
+            // A bare '\n' ends the size line too
+            // fall through
+        case S_CHUNK_SIZE_LF:
+            if (c == '\n') {
+                if (p->chunkLeft == 0) {
+                    p->state = S_TRAILER_START;
+                } else if (p->bodyEnd - p->bodyStart + p->chunkLeft > HTTP_MAX_BODY_BYTES) {
+                    return fail(p, 413, "Payload Too Large");
+                } else {
+                    p->state = S_CHUNK_DATA;
+                }
+            } else if (p->state == S_CHUNK_SIZE_LF) {
+                return fail(p, 400, "Bad Request");
+            }
+            break;
+
+        case S_CHUNK_EXT:
+            if (c == '\n') {
+                p->state = S_CHUNK_SIZE_LF;
+                continue;                       // Handle the '\n' there
+            }
+            break;
+
+        case S_CHUNK_DATA_CR:
+            if (c == '\r') {
+                p->state = S_CHUNK_DATA_LF;
+                break;
+            }
+            // A bare '\n' ends the data too
+            // fall through
+        case S_CHUNK_DATA_LF:
+            if (c != '\n') {
+                return fail(p, 400, "Bad Request");
+            }
+            p->mark = p->pos + 1;
+            p->state = S_CHUNK_SIZE;
+            break;
+
+        // ----- Trailer lines after the last chunk, then a blank line -----
+        case S_TRAILER_START:
+            if (c == '\r') {
+                p->state = S_TRAILER_END_LF;
+            } else if (c == '\n') {
+                p->state = S_DONE;
+            } else {
+                p->state = S_TRAILER_LINE;
+            }
+            break;
+
+        case S_TRAILER_LINE:
+            if (c == '\n') {
+                p->state = S_TRAILER_START;
+            }
+            break;
+
+        case S_TRAILER_END_LF:
+            if (c != '\n') {
+                return fail(p, 400, "Bad Request");
+            }
+            p->state = S_DONE;
+            break;
+        }
+
+        p->pos++;
+    }
+
+    // STEP 2: A whole request
+    if (p->state == S_DONE) {
+        p->method = data;
+        p->path = data + p->pathStart;
+        p->bodyLength = p->bodyEnd - p->bodyStart;
+        p->body = p->bodyLength > 0 ? data + p->bodyStart : NULL;
+        p->consumed = p->pos;
+        p->expectContinue = 0;
+        p->ifNoneMatch = p->ifNoneMatchLength > 0 ? data + p->ifNoneMatchStart : NULL;
+        return HTTP_PARSE_DONE;
+    }
+
+    // STEP 3: Not yet; a request that fills the whole buffer never will
+    if (length >= HTTP_BUFFER_SIZE) {
+        return fail(p, p->state < S_BODY ? 431 : 413,
+                    p->state < S_BODY ? "Request Header Fields Too Large" : "Payload Too Large");
+    }
+    return HTTP_PARSE_MORE;
+}
+
+
+/*
+================================================================================
+END OF FILE: http_parser.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. headerDone() - Content-Length, Transfer-Encoding, Connection, Expect,
+   Accept-Encoding, If-None-Match
+2. headersDone() - Pick the body framing at the blank line
+3. httpParserReset() - Fresh state for the next request
+4. httpParse() - Resumable state machine over the receive buffer, with
+   in-place chunked decoding and limits on header and body size
+================================================================================
+*/
@@ -3,7 +3,10 @@
 FILE: http_server.c
 PURPOSE: Minimal HTTP server to expose memory management as JSON API
 DESCRIPTION: 
-    - Single-threaded HTTP server using POSIX sockets
+    - HTTP server using POSIX sockets, one thread per connection
+    - State changes run one at a time under a lock; GET /api/blocks and
+      GET /api/stats are served from published snapshots instead and
+      never wait for a long compaction
     - Parses HTTP requests (GET and POST)
     - Routes requests to appropriate handlers
     - Returns JSON responses with CORS headers
@@ -16,22 +19,173 @@ DESCRIPTION:
 #include <stdio.h>           // printf, snprintf
 #include <stdlib.h>          // atoi, malloc, free
 #include <string.h>          // strlen, strcmp, strstr, memset
-#include <unistd.h>          // close, read, write
-#include <sys/socket.h>      // socket, bind, listen, accept
+#include <unistd.h>          // close, read
+#include <sys/socket.h>      // socket, bind, listen, accept, sendmsg
+#include <sys/time.h>        // struct timeval (idle timeout)
+#include <sys/uio.h>         // struct iovec
+#ifdef __linux__
+#include <sys/sendfile.h>    // sendfile (static UI files; macOS has it in sys/socket.h)
+#endif
+#include <signal.h>          // signal, SIGPIPE
+#include <errno.h>           // errno, EINTR
 #include <netinet/in.h>      // sockaddr_in, INADDR_ANY
 #include <arpa/inet.h>       // inet_ntoa
+#include <pthread.h>         // pthread_create, pthread_mutex_t
+#include <time.h>            // clock_gettime (stats sampling)
 
 // Our project headers
 #include "../include/http_server.h"
 #include "../include/memory_manager.h"
 #include "../include/memory_structures.h"
 #include "../include/os_memory.h"
+#include "../include/paging.h"
+#include "../include/paged_allocator.h"
+#include "../include/translation.h"
+#include "../include/slab_cache.h"
+#include "../include/boundary_tag.h"
+#include "../include/quick_list.h"
+#include "../include/parallel_copy.h"
+#include "../include/stream_kernels.h"
+#include "../include/snapshot.h"
+#include "../include/history.h"
+#include "../include/stats_history.h"
+#include "../include/simulation.h"
+#include "../include/admission.h"
+#include "../include/json_tokenizer.h"
+#include "../include/http_parser.h"
+#include "../include/logger.h"
+#include "../include/static_files.h"
+#include "../include/operations.h"
+#include "../include/local_transport.h"
+#include "../include/shm_export.h"
+
+// Linux-only send flags. Without them (macOS) nothing is lost: SIGPIPE is
+// ignored for the whole server (startServer), and MSG_MORE is only a hint.
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#ifndef MSG_MORE
+#define MSG_MORE 0
+#endif
+
+
+// Serializes every route that reads or changes mm (see handleRequest)
+static pthread_mutex_t stateLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Set when the local transport changed mm after the last snapshotPublish()
+static int snapshotStale = 0;
+
+// Local-transport operations not yet counted by the stats time series
+// (nor written to the shared-memory export)
+static long long unsampledOps = 0;
+static long long lastSampleNs = 0;
+static int exportStale = 0;
 
 // Buffer sizes for HTTP request/response handling
-#define MAX_REQUEST_SIZE  8192    // Max size of incoming HTTP request (8 KB)
+// (requests: HTTP_MAX_HEADER_BYTES + HTTP_MAX_BODY_BYTES, see http_parser.h)
 #define MAX_RESPONSE_SIZE 65536   // Max size of HTTP response body (64 KB)
+#define BATCH_MAX         1024    // Entries per batch allocate / deallocate
 #define MAX_HEADER_SIZE   1024    // Max size of HTTP response headers (1 KB)
 
+// A keep-alive connection with nothing to say for this long is closed
+#define KEEPALIVE_IDLE_SECONDS 15
+
+
+/*
+================================================================================
+STRUCTURE: Connection
+================================================================================
+PURPOSE: One client connection: its receive buffer and the responses that
+         have not been written yet
+
+Every connection is served by one thread, one request at a time, so
+responses are produced in request order. Pipelined requests that
+arrived together get their responses collected in 'out' and written
+with one sendmsg() when no further complete request is waiting.
+*/
+
+typedef struct {
+    int  fd;
+    int  keepAlive;         // Of the request being answered
+    int  outLength;
+    char out[MAX_HEADER_SIZE + MAX_RESPONSE_SIZE];
+    char in[HTTP_BUFFER_SIZE];
+} Connection;
+
+// The connection this thread is serving (NULL: write straight through)
+static __thread Connection *currentConnection = NULL;
+
+
+/*
+================================================================================
+HELPER FUNCTION: sendAll / connectionFlush / connectionSend
+================================================================================
+PURPOSE: Write responses without losing bytes to short writes
+
+MSG_NOSIGNAL: a client that hung up makes sendmsg() fail with EPIPE
+instead of killing the whole server with SIGPIPE.
+MSG_MORE: more follows right away (a file after its headers), so the
+kernel may hold a small piece back and send both in one packet.
+(Both are 0 where they do not exist; see the defines at the top.)
+*/
+
+static void sendAll(int fd, struct iovec *iov, int count, int flags) {
+    while (count > 0) {
+        struct msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_iov = iov;
+        message.msg_iovlen = count;
+        ssize_t sent = sendmsg(fd, &message, MSG_NOSIGNAL | flags);
+        if (sent <= 0) {
+            return;         // Client is gone; its thread will notice on read()
+        }
+        // Skip what went out (possibly part of one piece)
+        while (count > 0 && (size_t)sent >= iov->iov_len) {
+            sent -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char*)iov->iov_base + sent;
+            iov->iov_len -= sent;
+        }
+    }
+}
+
+static void connectionFlushMore(Connection *conn, int flags) {
+    if (conn->outLength > 0) {
+        struct iovec iov = { conn->out, (size_t)conn->outLength };
+        sendAll(conn->fd, &iov, 1, flags);
+        conn->outLength = 0;
+    }
+}
+
+static void connectionFlush(Connection *conn) {
+    connectionFlushMore(conn, 0);
+}
+
+// Queue header + body behind the earlier responses (big bodies go out
+// directly from where they are, after whatever is queued)
+static void connectionSend(int clientFd, const char *header, int headerLen,
+                           const char *body, int bodyLen) {
+    Connection *conn = currentConnection;
+    if (conn != NULL && conn->fd == clientFd) {
+        int room = (int)sizeof(conn->out) - conn->outLength;
+        if (headerLen + bodyLen <= room) {
+            memcpy(conn->out + conn->outLength, header, headerLen);
+            memcpy(conn->out + conn->outLength + headerLen, body, bodyLen);
+            conn->outLength += headerLen + bodyLen;
+            return;
+        }
+        connectionFlush(conn);
+    }
+    struct iovec iov[2] = {
+        { (void*)header, (size_t)headerLen },
+        { (void*)body, (size_t)bodyLen }
+    };
+    sendAll(clientFd, iov, 2, 0);
+}
+
 
 /*
 ================================================================================
@@ -43,7 +197,7 @@ WHAT IT DOES:
 1. Builds HTTP response headers (status code, content type, CORS)
 2. Appends the response body (JSON)
 3. Sends everything through the socket
-4. Closes the client connection
+4. Says whether the connection stays open (keep-alive) for more requests
 
 PARAMETERS:
 - clientFd: The client's socket file descriptor
@@ -57,106 +211,88 @@ CORS = Cross-Origin Resource Sharing
 The React dev server runs on localhost:5173
 The C server runs on localhost:8080
 Without CORS headers, the browser blocks cross-origin requests.
-We add "Access-Control-Allow-Origin: *" to allow any origin.
+We add "Access-Control-Allow-Origin: *" to allow any origin, and
+"Access-Control-Max-Age" so the browser asks (OPTIONS) once a day, not
+before every POST. When the server hands out the built UI itself (see
+static_files.h) the page and the API share one origin and there is no
+preflight at all.
 */
 
 void sendResponse(int clientFd, int statusCode, const char *statusText,
                   const char *contentType, const char *body) {
     
-    // Build the full HTTP response
-    char response[MAX_HEADER_SIZE + MAX_RESPONSE_SIZE];
     int bodyLen = (body != NULL) ? (int)strlen(body) : 0;
+    int keepAlive = currentConnection != NULL && currentConnection->fd == clientFd &&
+                    currentConnection->keepAlive;
     
     // Format: HTTP/1.1 <code> <status>\r\n<headers>\r\n\r\n<body>
-    int totalLen = snprintf(response, sizeof(response),
+    // (the body is not copied here; Content-Length frames it exactly, so
+    // the next response on a keep-alive connection starts right after it)
+    char header[MAX_HEADER_SIZE];
+    int headerLen = snprintf(header, sizeof(header),
         "HTTP/1.1 %d %s\r\n"
         "Content-Type: %s\r\n"
         "Content-Length: %d\r\n"
         "Access-Control-Allow-Origin: *\r\n"
         "Access-Control-Allow-Methods: GET, POST, OPTIONS\r\n"
         "Access-Control-Allow-Headers: Content-Type\r\n"
-        "Connection: close\r\n"
-        "\r\n"
-        "%s",
+        "Access-Control-Max-Age: 86400\r\n"
+        "Connection: %s\r\n"
+        "\r\n",
         statusCode, statusText,
         contentType,
         bodyLen,
-        body ? body : ""
+        keepAlive ? "keep-alive" : "close"
     );
     
-    // Send the response through the socket
-    write(clientFd, response, totalLen);
+    // Queue it behind earlier pipelined responses (or send it now)
+    connectionSend(clientFd, header, headerLen, body ? body : "", bodyLen);
 }
 
 
 /*
 ================================================================================
-HELPER FUNCTION: parseRequestBody
+HELPER FUNCTION: parseJSONInt
 ================================================================================
-PURPOSE: Extract the body content from an HTTP request
+PURPOSE: Extract an integer value from the request's JSON by key name
 
-HTTP requests look like:
-POST /api/allocate HTTP/1.1
-Host: localhost:8080
-Content-Type: application/json
-Content-Length: 35
+The body was tokenized ONCE by handleRequest() (json_tokenizer.c); this
+is a lookup among the top-level keys, not another scan of the text.
 
-{"size":100,"algorithm":"first_fit"}
-                                    ← Body starts after blank line (\r\n\r\n)
+EXAMPLE:
+Input JSON: {"size" : 100, "algorithm":"first_fit"}
+parseJSONInt(json, "size") → 100
 
-We find the blank line and return everything after it.
+RETURNS: The value, or -1 if the key is missing or not a number
 */
 
-const char* parseRequestBody(const char *request) {
-    
-    // Find the blank line separator (\r\n\r\n)
-    const char *body = strstr(request, "\r\n\r\n");
+int parseJSONInt(const JsonDocument *json, const char *key) {
     
-    if (body != NULL) {
-        return body + 4;  // Skip past \r\n\r\n (4 characters)
+    long long value;
+    if (json == NULL || !jsonTokenInt(json, jsonFind(json, 0, key), &value)) {
+        return -1;  // Key not found
     }
     
-    return NULL;  // No body found
+    // Clamp to int (sizes and IDs are ints everywhere)
+    if (value > 0x7fffffff) return 0x7fffffff;
+    if (value < -0x7fffffff) return -0x7fffffff;
+    return (int)value;
 }
 
 
 /*
 ================================================================================
-HELPER FUNCTION: parseJSONInt
+HELPER FUNCTION: parseSlabCache
 ================================================================================
-PURPOSE: Extract an integer value from a JSON string by key name
-
-This is a simple JSON parser for our specific use case.
-No external JSON library needed!
-
-EXAMPLE:
-Input JSON: {"size":100,"algorithm":"first_fit"}
-parseJSONInt(json, "size") → 100
+PURPOSE: The cache ID of a slab request: "cache", or "cacheId" (the key
+         /api/slab/create and GET /api/slab answer with)
 
-HOW IT WORKS:
-1. Search for "keyName": in the string
-2. Skip past the colon
-3. Parse the integer value using atoi()
+RETURNS: The ID, or -1 if neither key is there
 */
 
-int parseJSONInt(const char *json, const char *key) {
-    
-    // Build the search pattern: "key":
-    char pattern[128];
-    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
-    
-    // Find the pattern in the JSON string
-    const char *pos = strstr(json, pattern);
-    if (pos == NULL) return -1;  // Key not found
-    
-    // Move past the pattern to the value
-    pos += strlen(pattern);
-    
-    // Skip whitespace
-    while (*pos == ' ' || *pos == '\t') pos++;
-    
-    // Parse integer
-    return atoi(pos);
+static int parseSlabCache(const JsonDocument *json) {
+    int cacheID = parseJSONInt(json, "cache");
+    return (cacheID >= 0) ? cacheID : parseJSONInt(json, "cacheId");
 }
 
 
@@ -164,96 +300,122 @@ int parseJSONInt(const char *json, const char *key) {
 ================================================================================
 HELPER FUNCTION: parseJSONString
 ================================================================================
-PURPOSE: Extract a string value from a JSON string by key name
+PURPOSE: Extract a string value from the request's JSON by key name
 
 EXAMPLE:
 Input JSON: {"size":100,"algorithm":"first_fit"}
 parseJSONString(json, "algorithm", buffer, 64) → writes "first_fit" into buffer
 
-HOW IT WORKS:
-1. Search for "keyName": in the string
-2. Find the opening quote of the value
-3. Copy characters until closing quote
+Escapes (\" \\ \n ...) are decoded. 'value' is set to "" when the key
+is missing or its value is not a string.
 */
 
-void parseJSONString(const char *json, const char *key, char *value, int valueSize) {
+void parseJSONString(const JsonDocument *json, const char *key, char *value, int valueSize) {
     
-    // Initialize value to empty string
     value[0] = '\0';
-    
-    // Build search pattern: "key":
-    char pattern[128];
-    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
-    
-    // Find the pattern
-    const char *pos = strstr(json, pattern);
-    if (pos == NULL) return;
-    
-    // Move past the pattern
-    pos += strlen(pattern);
-    
-    // Skip whitespace
-    while (*pos == ' ' || *pos == '\t') pos++;
-    
-    // Check for opening quote
-    if (*pos != '"') return;
-    pos++;  // Skip opening quote
-    
-    // Copy characters until closing quote
-    int i = 0;
-    while (*pos != '"' && *pos != '\0' && i < valueSize - 1) {
-        value[i++] = *pos++;
+    if (json != NULL) {
+        jsonTokenString(json, jsonFind(json, 0, key), value, valueSize);
+    }
+}
+
+
+/*
+================================================================================
+HELPER FUNCTION: parseJSONIntArray
+================================================================================
+PURPOSE: Extract an array of integers by key name (batch endpoints)
+
+EXAMPLE:
+Input JSON: {"sizes":[100, 200, 50]}
+parseJSONIntArray(json, "sizes", values, 1024) → 3, values = {100,200,50}
+
+RETURNS: Number of elements, or -1 if missing, not an array of numbers,
+         or longer than max
+*/
+
+int parseJSONIntArray(const JsonDocument *json, const char *key, int *values, int max) {
+    if (json == NULL) {
+        return -1;
     }
-    value[i] = '\0';
+    return jsonArrayInts(json, jsonFind(json, 0, key), values, max);
 }
 
 
+// What a request did to the state (the answer of routeRequest)
+typedef enum {
+    ROUTE_READ,         // Nothing changed: nothing to publish, not an operation
+    ROUTE_SETTINGS,     // Only settings /api/stats shows: publish, do not count
+    ROUTE_MUTATED       // Blocks or counters changed: publish and count
+} RouteEffect;
+
+
 /*
 ================================================================================
-FUNCTION: handleRequest
+FUNCTION: routeRequest
 ================================================================================
 PURPOSE: Route an HTTP request to the appropriate handler
 
 WHAT IT DOES:
-1. Parse the HTTP method (GET, POST, OPTIONS)
-2. Parse the request URL path
-3. Route to the appropriate handler based on method + path
-4. Send back the JSON response
+1. Take the method, path and tokenized body from handleRequest()
+2. Route to the appropriate handler based on method + path
+3. Send back the JSON response
+
+RETURNS: What the request did to the state (RouteEffect), so only real
+changes are published and counted as operations. Benchmarks and
+simulations on their own heaps, and requests refused before reaching
+the engine, are ROUTE_READ even though they are POSTs.
 
 SUPPORTED ROUTES:
 GET  /api/status        → Health check
 GET  /api/blocks        → Get all memory blocks
 GET  /api/stats         → Get memory statistics
+GET  /api/residency     → Resident pages per block + page-fault costs
+GET  /api/history       → Op log summary; ?op=N rebuilds the state after op N
+GET  /api/stats/history → Stats time series; ?range=15m&resolution=raw|1s|1m
 POST /api/allocate      → Allocate memory
 POST /api/deallocate    → Deallocate a process
+POST /api/allocate/batch   → Many allocations from a "sizes" array
+POST /api/deallocate/batch → Free every PID of a "processIds" array
+POST /api/json/benchmark   → strstr() field helpers vs the JSON tokenizer
 POST /api/compact       → Run compaction
 POST /api/autocompact   → Auto-compact
 POST /api/buddy/convert → Convert to buddy system
 POST /api/buddy/revert  → Revert from buddy system
-POST /api/reset         → Reset memory
-OPTIONS *               → CORS preflight response
+POST /api/reset         → Reset memory (optionally to a new pool size)
+POST /api/paging/run    → Demand-paging simulation (one algorithm)
+POST /api/paging/compare → Same reference string through all six algorithms
+POST /api/paged/convert → Switch to non-contiguous (paged) allocation
+POST /api/paged/revert  → Switch back to contiguous allocation
+POST /api/paged/compare → Fits vs buddy vs paged on one allocate/free stream
+POST /api/tlb/run       → Page-table + TLB translation run (one page size)
+POST /api/tlb/compare   → Same stream with 4 KB and 2 MB pages
+GET  /api/slab          → Slab caches, utilization, internal fragmentation
+POST /api/slab/create   → New cache for one object size
+POST /api/slab/alloc    → Allocate objects from a cache
+POST /api/slab/free     → Free one object by handle
+POST /api/slab/destroy  → Release every slab of a cache
+POST /api/tags/convert  → Switch to boundary tags (metadata inside the region)
+POST /api/tags/revert   → Switch back to the block list
+POST /api/tags/compare  → List nodes vs boundary tags on one allocate/free stream
+POST /api/deferred/enable   → Deferred coalescing with exact-size quick lists
+POST /api/deferred/disable  → Back to immediate coalescing (final merge pass)
+POST /api/deferred/coalesce → Run the batch merge pass now
+POST /api/compact/config    → Threads and size threshold of parallel copies
+POST /api/compact/benchmark → Serial vs parallel compaction on a scratch heap
+POST /api/stream/config     → Streaming (non-temporal) fills on/off, threshold
+POST /api/stream/benchmark  → Small-op latency after big fills, both modes
+POST /api/simulate          → Discrete-event run: arrivals, lifetimes, expiry
+POST /api/admission/policy  → FCFS / SJF / first-fit order for waiting allocations
+POST /api/log/config        → Log level and sampling; message counters
+OPTIONS *               → CORS preflight response (handleRequest, no lock)
+GET  /<anything else>   → Built UI files (sendStaticFile, with --ui / UI for MAV/dist)
 */
 
-void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
-    
-    // STEP 1: Parse the HTTP method and path
-    // HTTP request first line: "GET /api/status HTTP/1.1"
-    char method[16] = {0};
-    char path[256] = {0};
+static RouteEffect routeRequest(int clientFd, const JsonDocument *body, MemoryManager *mm,
+                                const char *method, const char *path) {
     
-    sscanf(request, "%15s %255s", method, path);
-    
-    // Log the request for debugging
-    printf("[REQUEST] %s %s\n", method, path);
-    
-    
-    // ========== HANDLE OPTIONS (CORS PREFLIGHT) ==========
-    // Browsers send OPTIONS requests before POST requests
-    // to check if the server allows cross-origin requests
-    if (strcmp(method, "OPTIONS") == 0) {
-        sendResponse(clientFd, 200, "OK", "text/plain", "");
-        return;
-    }
+    // OPTIONS (CORS preflight) is answered by handleRequest() without
+    // the lock; browsers send it before cross-origin POSTs
     
     
     // ========== GET /api/status ==========
@@ -262,55 +424,114 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
         
         sendResponse(clientFd, 200, "OK", "application/json",
             "{\"status\":\"running\",\"message\":\"Memory Management API Server\"}");
-        return;
+        return ROUTE_READ;
     }
     
     
-    // ========== GET /api/blocks ==========
-    // Returns all memory blocks as a JSON array
-    if (strcmp(method, "GET") == 0 && strcmp(path, "/api/blocks") == 0) {
+    // GET /api/blocks and GET /api/stats never get here: handleRequest()
+    // answers them from the published snapshot
+    
+    // ========== GET /api/sysinfo ==========
+    // Returns real OS system information (page size, total RAM, etc.)
+    if (strcmp(method, "GET") == 0 && strcmp(path, "/api/sysinfo") == 0) {
         
-        char blocksJSON[MAX_RESPONSE_SIZE];
-        blocksToJSON(mm, blocksJSON, sizeof(blocksJSON));
+        char sysInfoJSON[MAX_RESPONSE_SIZE];
+        os_get_system_info_json(sysInfoJSON, sizeof(sysInfoJSON));
         
-        sendResponse(clientFd, 200, "OK", "application/json", blocksJSON);
-        return;
+        sendResponse(clientFd, 200, "OK", "application/json", sysInfoJSON);
+        return ROUTE_READ;
     }
     
     
-    // ========== GET /api/stats ==========
-    // Returns memory statistics as JSON
-    if (strcmp(method, "GET") == 0 && strcmp(path, "/api/stats") == 0) {
+    // ========== GET /api/residency ==========
+    // Returns resident-page counts per block (mincore) and
+    // minor/major page-fault deltas per operation (getrusage)
+    if (strcmp(method, "GET") == 0 && strcmp(path, "/api/residency") == 0) {
         
-        char statsJSON[MAX_RESPONSE_SIZE];
-        getStatsJSON(mm, statsJSON, sizeof(statsJSON));
+        char residencyJSON[MAX_RESPONSE_SIZE];
+        getResidencyJSON(mm, residencyJSON, sizeof(residencyJSON));
         
-        sendResponse(clientFd, 200, "OK", "application/json", statsJSON);
-        return;
+        sendResponse(clientFd, 200, "OK", "application/json", residencyJSON);
+        return ROUTE_READ;
     }
     
-    // ========== GET /api/sysinfo ==========
-    // Returns real OS system information (page size, total RAM, etc.)
-    if (strcmp(method, "GET") == 0 && strcmp(path, "/api/sysinfo") == 0) {
+    
+    // ========== GET /api/history ==========
+    // Without a query: the op log summary and the most recent ops
+    // With ?op=N: the blocks and stats as they were right after op N
+    if (strcmp(method, "GET") == 0 && strncmp(path, "/api/history", 12) == 0 &&
+        (path[12] == '\0' || path[12] == '?')) {
         
-        char sysInfoJSON[MAX_RESPONSE_SIZE];
-        os_get_system_info_json(sysInfoJSON, sizeof(sysInfoJSON));
+        char historyJSON[MAX_RESPONSE_SIZE];
+        const char *opParam = strstr(path, "op=");
         
-        sendResponse(clientFd, 200, "OK", "application/json", sysInfoJSON);
-        return;
+        if (opParam == NULL) {
+            historyToJSON(mm, historyJSON, sizeof(historyJSON));
+            sendResponse(clientFd, 200, "OK", "application/json", historyJSON);
+            return ROUTE_READ;
+        }
+        
+        int result = historyReconstruct(mm, atoll(opParam + 3),
+                                        historyJSON, sizeof(historyJSON));
+        if (result == 1) {
+            sendResponse(clientFd, 200, "OK", "application/json", historyJSON);
+        } else if (result == -1) {
+            sendResponse(clientFd, 409, "Conflict", "application/json", historyJSON);
+        } else {
+            sendResponse(clientFd, 404, "Not Found", "application/json", historyJSON);
+        }
+        return ROUTE_READ;
+    }
+    
+    
+    // ========== GET /api/stats/history ==========
+    // Fragmentation etc. over time: ?range=90s | 15m | 6h | 1d (plain
+    // number = seconds, default 10m) and optionally &resolution=raw|1s|1m
+    if (strcmp(method, "GET") == 0 && strncmp(path, "/api/stats/history", 18) == 0 &&
+        (path[18] == '\0' || path[18] == '?')) {
+        
+        int rangeSeconds = 600;
+        const char *rangeParam = strstr(path, "range=");
+        if (rangeParam != NULL) {
+            char unit = 's';
+            int amount = 0;
+            if (sscanf(rangeParam + 6, "%d%c", &amount, &unit) >= 1 && amount > 0) {
+                int scale = unit == 'm' ? 60 : unit == 'h' ? 3600 : unit == 'd' ? 86400 : 1;
+                rangeSeconds = amount * scale;
+            }
+        }
+        
+        char resolution[8] = "";
+        const char *resolutionParam = strstr(path, "resolution=");
+        if (resolutionParam != NULL) {
+            sscanf(resolutionParam + 11, "%7[^&]", resolution);
+        }
+        
+        // Up to 1440 points of 7 columns: more than one MAX_RESPONSE_SIZE
+        int bufferSize = 4 * MAX_RESPONSE_SIZE;
+        char *seriesJSON = (char*)malloc(bufferSize);
+        if (seriesJSON == NULL) {
+            sendResponse(clientFd, 500, "Internal Server Error", "application/json",
+                "{\"success\":false,\"message\":\"Out of memory\"}");
+            return ROUTE_READ;
+        }
+        statsHistoryToJSON(rangeSeconds, resolution, seriesJSON, bufferSize);
+        sendResponse(clientFd, 200, "OK", "application/json", seriesJSON);
+        free(seriesJSON);
+        return ROUTE_READ;
     }
     
     
     // ========== POST /api/allocate ==========
     // Allocate memory for a new process
-    // Body: {"size": 100, "algorithm": "first_fit"}
+    // Body: {"size": 100, "algorithm": "first_fit", "wait": 2000}
+    //       (wait is optional: ms to wait in the admission queue)
     if (strcmp(method, "POST") == 0 && strcmp(path, "/api/allocate") == 0) {
         
-        const char *body = parseRequestBody(request);
         if (body == NULL) {
             sendResponse(clientFd, 400, "Bad Request", "application/json",
                 "{\"success\":false,\"message\":\"Missing request body\"}");
-            return;
+            return ROUTE_READ;
         }
         
         // Parse requested size
@@ -318,7 +539,7 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
         if (size <= 0) {
             sendResponse(clientFd, 400, "Bad Request", "application/json",
                 "{\"success\":false,\"message\":\"Invalid size\"}");
-            return;
+            return ROUTE_READ;
         }
         
         // Parse algorithm
@@ -333,15 +554,32 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
             algo = WORST_FIT;
         }
         
+        // Optional: wait up to this many ms in the admission queue
+        // instead of failing right away
+        int waitMs = parseJSONInt(body, "wait");
+        double waitedMs = 0;
+        
         // Check if buddy system is active
         if (mm->useBuddySystem) {
             // Use buddy allocation instead
             char resultJSON[MAX_RESPONSE_SIZE];
             int result = buddyAllocate(mm, size, resultJSON, sizeof(resultJSON));
+            if (result < 0 && waitMs > 0) {
+                // The failed attempt already took its PID from the counter
+                int processID = mm->processCounter;
+                result = admissionWait(mm, processID, size, algo, waitMs, &stateLock, &waitedMs);
+                snprintf(resultJSON, sizeof(resultJSON), result >= 0
+                    ? "{\"success\":true,\"processId\":\"P%d\",\"requestedSize\":%d,"
+                      "\"allocatedSize\":%d,\"startAddress\":%d,\"waitedMs\":%.1f}"
+                    : "{\"success\":false,\"processId\":\"P%d\",\"requestedSize\":%d,"
+                      "\"allocatedSize\":%d,\"startAddress\":%d,\"waitedMs\":%.1f,"
+                      "\"message\":\"Timed out in the admission queue\"}",
+                    processID, size, nextPowerOf2(size), result, waitedMs);
+            }
             sendResponse(clientFd, (result >= 0) ? 200 : 400, 
                         (result >= 0) ? "OK" : "Bad Request",
                         "application/json", resultJSON);
-            return;
+            return ROUTE_MUTATED;
         }
         
         // Auto-assign process ID
@@ -350,6 +588,11 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
         // Allocate memory
         int startAddr = allocateMemory(mm, processID, size, algo);
         
+        // No room: queue up (the state lock is released while waiting)
+        if (startAddr < 0 && waitMs > 0) {
+            startAddr = admissionWait(mm, processID, size, algo, waitMs, &stateLock, &waitedMs);
+        }
+        
         // Build response
         char resultJSON[512];
         if (startAddr >= 0) {
@@ -358,10 +601,22 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
                 "\"processId\":\"P%d\","
                 "\"size\":%d,"
                 "\"startAddress\":%d,"
-                "\"algorithm\":\"%s\"}",
-                processID, size, startAddr, algorithm
+                "\"algorithm\":\"%s\","
+                "\"waitedMs\":%.1f}",
+                processID, size, startAddr,
+                mm->usePagedMode ? "paged" :
+                mm->useBoundaryTags ? "boundary_tags" : algorithm,
+                waitedMs
             );
             sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
+        } else if (waitMs > 0) {
+            snprintf(resultJSON, sizeof(resultJSON),
+                "{\"success\":false,"
+                "\"message\":\"Timed out after %.0f ms in the admission queue. "
+                "Requested: %d KB, Free: %d KB\"}",
+                waitedMs, size, mm->freeMemory
+            );
+            sendResponse(clientFd, 400, "Bad Request", "application/json", resultJSON);
         } else {
             snprintf(resultJSON, sizeof(resultJSON),
                 "{\"success\":false,"
@@ -370,7 +625,7 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
             );
             sendResponse(clientFd, 400, "Bad Request", "application/json", resultJSON);
         }
-        return;
+        return ROUTE_MUTATED;
     }
     
     
@@ -379,18 +634,25 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
     // Body: {"processId": 3}
     if (strcmp(method, "POST") == 0 && strcmp(path, "/api/deallocate") == 0) {
         
-        const char *body = parseRequestBody(request);
         if (body == NULL) {
             sendResponse(clientFd, 400, "Bad Request", "application/json",
                 "{\"success\":false,\"message\":\"Missing request body\"}");
-            return;
+            return ROUTE_READ;
         }
         
         int processID = parseJSONInt(body, "processId");
         if (processID <= 0) {
             sendResponse(clientFd, 400, "Bad Request", "application/json",
                 "{\"success\":false,\"message\":\"Invalid processId\"}");
-            return;
+            return ROUTE_READ;
+        }
+        
+        // Slab blocks are released by their cache, never directly
+        if (slabOwnsProcess(mm, processID)) {
+            sendResponse(clientFd, 409, "Conflict", "application/json",
+                "{\"success\":false,\"message\":\"Process is a slab; free its objects "
+                "or destroy its cache\"}");
+            return ROUTE_READ;
         }
         
         // Check if buddy system is active
@@ -398,7 +660,7 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
             char resultJSON[MAX_RESPONSE_SIZE];
             buddyDeallocate(mm, processID, resultJSON, sizeof(resultJSON));
             sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
-            return;
+            return ROUTE_MUTATED;
         }
         
         // Standard deallocation
@@ -414,7 +676,101 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
                 "{\"success\":false,\"message\":\"Process P%d not found\"}", processID);
             sendResponse(clientFd, 404, "Not Found", "application/json", resultJSON);
         }
-        return;
+        return ROUTE_MUTATED;
+    }
+    
+    
+    // ========== POST /api/allocate/batch ==========
+    // Many allocations in one request, in order
+    // Body: {"sizes":[100,200,50], "algorithm":"best_fit"}
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/allocate/batch") == 0) {
+        
+        int sizes[BATCH_MAX];
+        int count = parseJSONIntArray(body, "sizes", sizes, BATCH_MAX);
+        if (count <= 0) {
+            sendResponse(clientFd, 400, "Bad Request", "application/json",
+                "{\"success\":false,\"message\":\"sizes must be an array of 1-1024 numbers\"}");
+            return ROUTE_READ;
+        }
+        
+        char algorithm[32];
+        parseJSONString(body, "algorithm", algorithm, sizeof(algorithm));
+        AllocationAlgorithm algo = FIRST_FIT;
+        if (strcmp(algorithm, "best_fit") == 0) {
+            algo = BEST_FIT;
+        } else if (strcmp(algorithm, "worst_fit") == 0) {
+            algo = WORST_FIT;
+        }
+        
+        // Two parallel arrays: PID and start address (-1 = failed)
+        char resultJSON[MAX_RESPONSE_SIZE];
+        char addresses[MAX_RESPONSE_SIZE / 2];
+        int w = snprintf(resultJSON, sizeof(resultJSON), "{\"processIds\":[");
+        int a = snprintf(addresses, sizeof(addresses), "\"startAddresses\":[");
+        int allocated = 0;
+        for (int i = 0; i < count; i++) {
+            int processID;
+            int start = opAllocate(mm, sizes[i], algo, &processID);
+            allocated += start >= 0;
+            w += snprintf(resultJSON + w, sizeof(resultJSON) - w, "%s%d", i ? "," : "", processID);
+            a += snprintf(addresses + a, sizeof(addresses) - a, "%s%d", i ? "," : "", start);
+        }
+        snprintf(resultJSON + w, sizeof(resultJSON) - w,
+            "],%s],\"success\":true,\"allocated\":%d,\"failed\":%d}",
+            addresses, allocated, count - allocated);
+        sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
+        return ROUTE_MUTATED;
+    }
+    
+    
+    // ========== POST /api/deallocate/batch ==========
+    // Free many processes in one request
+    // Body: {"processIds":[1,2,3]}
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/deallocate/batch") == 0) {
+        
+        int processIDs[BATCH_MAX];
+        int count = parseJSONIntArray(body, "processIds", processIDs, BATCH_MAX);
+        if (count <= 0) {
+            sendResponse(clientFd, 400, "Bad Request", "application/json",
+                "{\"success\":false,\"message\":\"processIds must be an array of 1-1024 numbers\"}");
+            return ROUTE_READ;
+        }
+        
+        // Report the ones that were not freed (unknown, or owned by a slab)
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int w = snprintf(resultJSON, sizeof(resultJSON), "{\"notFreed\":[");
+        int freed = 0;
+        int notFreed = 0;
+        for (int i = 0; i < count; i++) {
+            if (opDeallocate(mm, processIDs[i]) > 0) {
+                freed++;
+            } else {
+                w += snprintf(resultJSON + w, sizeof(resultJSON) - w, "%s%d",
+                              notFreed++ ? "," : "", processIDs[i]);
+            }
+        }
+        snprintf(resultJSON + w, sizeof(resultJSON) - w,
+            "],\"success\":true,\"freed\":%d}", freed);
+        sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
+        return ROUTE_MUTATED;
+    }
+    
+    
+    // ========== POST /api/json/benchmark ==========
+    // Old strstr() field helpers vs the single-pass tokenizer
+    // Body: {"iterations":100000}   (optional)
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/json/benchmark") == 0) {
+        
+        int iterations = 100000;
+        int value = parseJSONInt(body, "iterations");
+        if (value > 0) {
+            iterations = value;
+        }
+        
+        char resultJSON[1024];
+        benchmarkJSONParsing(iterations, resultJSON, sizeof(resultJSON));
+        sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
+        return ROUTE_READ;
     }
     
     
@@ -426,7 +782,7 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
         compact(mm, resultJSON, sizeof(resultJSON));
         
         sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
-        return;
+        return ROUTE_MUTATED;
     }
     
     
@@ -437,7 +793,6 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
         
         int threshold = 30;  // Default threshold
         
-        const char *body = parseRequestBody(request);
         if (body != NULL) {
             int parsed = parseJSONInt(body, "threshold");
             if (parsed > 0) threshold = parsed;
@@ -447,7 +802,7 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
         autoCompact(mm, threshold, resultJSON, sizeof(resultJSON));
         
         sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
-        return;
+        return ROUTE_MUTATED;
     }
     
     
@@ -459,7 +814,7 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
         convertToBuddySystem(mm, resultJSON, sizeof(resultJSON));
         
         sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
-        return;
+        return ROUTE_MUTATED;
     }
     
     
@@ -471,97 +826,1172 @@ void handleRequest(int clientFd, const char *request, MemoryManager *mm) {
         revertFromBuddySystem(mm, resultJSON, sizeof(resultJSON));
         
         sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
-        return;
+        return ROUTE_MUTATED;
     }
     
     
     // ========== POST /api/reset ==========
     // Reset memory to initial state
+    // Body (optional, resizes the pool): {"total":4,"osReserve":1,"unit":"GB"}
+    //       (unit KB/MB/GB, default KB; osReserve defaults to 25% of total)
     if (strcmp(method, "POST") == 0 && strcmp(path, "/api/reset") == 0) {
         
-        resetMemory(mm);
+        int totalKB = mm->totalMemory;
+        int osKB = mm->osMemory;
         
-        sendResponse(clientFd, 200, "OK", "application/json",
-            "{\"success\":true,\"message\":\"Memory reset to initial state\"}");
-        return;
+        if (body != NULL) {
+            char unit[8] = "";
+            parseJSONString(body, "unit", unit, sizeof(unit));
+            if (unit[0] != '\0' && os_size_to_kb(1, unit) < 0) {
+                sendResponse(clientFd, 400, "Bad Request", "application/json",
+                    "{\"success\":false,\"message\":\"Unit must be KB, MB or GB\"}");
+                return ROUTE_READ;
+            }
+            
+            int value;
+            if ((value = parseJSONInt(body, "total")) != -1) {
+                totalKB = os_size_to_kb(value, unit);
+                osKB = totalKB > 0 ? totalKB / 4 : 0;
+            }
+            if ((value = parseJSONInt(body, "osReserve")) != -1) {
+                osKB = os_size_to_kb(value, unit);
+            }
+            
+            const char *problem = checkPoolSizes(totalKB, osKB);
+            if (problem != NULL) {
+                char resultJSON[256];
+                snprintf(resultJSON, sizeof(resultJSON),
+                    "{\"success\":false,\"message\":\"%s\"}", problem);
+                sendResponse(clientFd, 400, "Bad Request", "application/json", resultJSON);
+                return ROUTE_READ;
+            }
+        }
+        
+        resizeMemory(mm, totalKB, osKB);
+        
+        char resultJSON[256];
+        snprintf(resultJSON, sizeof(resultJSON),
+            "{\"success\":true,\"message\":\"Memory reset to initial state\","
+            "\"totalMemory\":%d,\"osMemory\":%d,\"backing\":\"%s\"}",
+            mm->totalMemory, mm->osMemory,
+            mm->backingRegion.basePtr != NULL
+                ? os_backing_name(os_backing_for(mm->backingRegion.size)) : "none");
+        sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
+        return ROUTE_MUTATED;
     }
     
     
-    // ========== 404 NOT FOUND ==========
-    // No matching route found
-    char notFound[256];
-    snprintf(notFound, sizeof(notFound),
-        "{\"error\":\"Not Found\",\"message\":\"Unknown endpoint: %s %s\"}", 
-        method, path);
-    
-    sendResponse(clientFd, 404, "Not Found", "application/json", notFound);
-}
-
-
-/*
-================================================================================
-FUNCTION: startServer
-================================================================================
-PURPOSE: Start the HTTP API server
-
-HOW SOCKETS WORK (simplified):
-1. socket() → Create a communication endpoint (like getting a phone)
-2. bind() → Assign a port number (like getting a phone number)
-3. listen() → Start waiting for connections (like turning on the phone)
-4. accept() → Accept a connection (like answering a call)
-5. read() → Read the client's request (like listening to the caller)
-6. handleRequest() → Process the request
-7. close() → Hang up the call
-8. Go back to step 4 (wait for next call)
-
-THIS IS THE MAIN SERVER LOOP!
-*/
-
-int startServer(MemoryManager *mm, int port) {
+    // ========== POST /api/paging/run  |  POST /api/paging/compare ==========
+    // Demand-paging simulation over the current processes
+    // Body: {"algorithm":"lru","pageSize":4,"frames":64,"length":1000000,
+    //        "locality":90,"seed":1}   (every field optional)
+    if (strcmp(method, "POST") == 0 &&
+        (strcmp(path, "/api/paging/run") == 0 || strcmp(path, "/api/paging/compare") == 0)) {
+        
+        PagingConfig config = { 4, 0, 1000000, 90, 1 };
+        char algorithm[32] = "lru";
+        
+        if (body != NULL) {
+            int value;
+            if ((value = parseJSONInt(body, "pageSize")) > 0) config.pageSizeKB = value;
+            if ((value = parseJSONInt(body, "frames")) > 0)   config.frames = value;
+            if ((value = parseJSONInt(body, "length")) > 0)   config.length = value;
+            if ((value = parseJSONInt(body, "locality")) >= 0) config.localityPercent = value;
+            if ((value = parseJSONInt(body, "seed")) >= 0)     config.seed = (unsigned long long)value;
+            
+            char parsed[32];
+            parseJSONString(body, "algorithm", parsed, sizeof(parsed));
+            if (parsed[0] != '\0') {
+                snprintf(algorithm, sizeof(algorithm), "%s", parsed);
+            }
+        }
+        if (strcmp(path, "/api/paging/compare") == 0) {
+            snprintf(algorithm, sizeof(algorithm), "all");
+        }
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int ok = runPagingSimulation(mm, &config, algorithm, resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, ok ? 200 : 400, ok ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_READ;
+    }
     
-    // STEP 1: Create a TCP socket
-    // AF_INET = IPv4 internet
-    // SOCK_STREAM = TCP (reliable, ordered)
-    // 0 = auto-select protocol
-    int serverFd = socket(AF_INET, SOCK_STREAM, 0);
     
-    if (serverFd < 0) {
-        perror("Error: Could not create socket");
-        return -1;
+    // ========== POST /api/paged/convert ==========
+    // Switch to non-contiguous allocation. Body: {"frameSize":4} (optional)
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/paged/convert") == 0) {
+        
+        int frameSize = 4;
+        if (body != NULL && parseJSONInt(body, "frameSize") > 0) {
+            frameSize = parseJSONInt(body, "frameSize");
+        }
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int ok = convertToPagedMode(mm, frameSize, resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, ok ? 200 : 400, ok ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_MUTATED;
     }
     
-    // STEP 2: Set socket options
-    // SO_REUSEADDR allows reusing the port immediately after the server stops
-    // Without this, you might get "Address already in use" error
-    int opt = 1;
-    setsockopt(serverFd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-    
-    // STEP 3: Set up the server address structure
-    struct sockaddr_in serverAddr;
-    memset(&serverAddr, 0, sizeof(serverAddr));  // Clear to zeros
-    serverAddr.sin_family = AF_INET;             // IPv4
-    serverAddr.sin_addr.s_addr = INADDR_ANY;     // Accept from any IP
-    serverAddr.sin_port = htons(port);           // Port number (network byte order)
-    // htons = "Host TO Network Short" (converts endianness)
     
-    // STEP 4: Bind socket to the port
-    // This "claims" the port number for our server
-    if (bind(serverFd, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) < 0) {
-        perror("Error: Could not bind to port");
-        close(serverFd);
-        return -1;
+    // ========== POST /api/paged/revert ==========
+    // Switch back to contiguous allocation
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/paged/revert") == 0) {
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int ok = revertFromPagedMode(mm, resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, ok ? 200 : 400, ok ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_MUTATED;
     }
     
-    // STEP 5: Start listening for connections
-    // 10 = maximum queue length for pending connections
-    if (listen(serverFd, 10) < 0) {
-        perror("Error: Could not listen on socket");
-        close(serverFd);
-        return -1;
-    }
     
-    // STEP 6: Print server info
-    printf("\n");
+    // ========== POST /api/paged/compare ==========
+    // First/best/worst fit, buddy and paged on the same allocate/free stream
+    // Body: {"ops":5000,"minSize":4,"maxSize":64,"freePercent":45,
+    //        "frameSize":4,"seed":1}   (every field optional)
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/paged/compare") == 0) {
+        
+        int ops = 5000, minSize = 4, maxSize = 64, freePercent = 45, frameSize = 4;
+        unsigned long long seed = 1;
+        
+        if (body != NULL) {
+            int value;
+            if ((value = parseJSONInt(body, "ops")) > 0)          ops = value;
+            if ((value = parseJSONInt(body, "minSize")) > 0)      minSize = value;
+            if ((value = parseJSONInt(body, "maxSize")) > 0)      maxSize = value;
+            if ((value = parseJSONInt(body, "freePercent")) >= 0) freePercent = value;
+            if ((value = parseJSONInt(body, "frameSize")) > 0)    frameSize = value;
+            if ((value = parseJSONInt(body, "seed")) >= 0)        seed = (unsigned long long)value;
+        }
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int ok = comparePlacementModes(mm, ops, minSize, maxSize, freePercent,
+                                       frameSize, seed, resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, ok ? 200 : 400, ok ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_READ;
+    }
+    
+    
+    // ========== POST /api/tags/convert ==========
+    // Move the metadata into the backing region (headers + footers)
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/tags/convert") == 0) {
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int ok = convertToBoundaryTags(mm, resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, ok ? 200 : 400, ok ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_MUTATED;
+    }
+    
+    
+    // ========== POST /api/tags/revert ==========
+    // Back to malloc'd MemoryBlock nodes
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/tags/revert") == 0) {
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int ok = revertFromBoundaryTags(mm, resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, ok ? 200 : 400, ok ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_MUTATED;
+    }
+    
+    
+    // ========== POST /api/tags/compare ==========
+    // List engine vs boundary tags on the same allocate/free stream
+    // Body: {"ops":5000,"minSize":4,"maxSize":64,"freePercent":45,"seed":1}
+    //       (every field optional)
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/tags/compare") == 0) {
+        
+        int ops = 5000, minSize = 4, maxSize = 64, freePercent = 45;
+        unsigned long long seed = 1;
+        
+        if (body != NULL) {
+            int value;
+            if ((value = parseJSONInt(body, "ops")) > 0)          ops = value;
+            if ((value = parseJSONInt(body, "minSize")) > 0)      minSize = value;
+            if ((value = parseJSONInt(body, "maxSize")) > 0)      maxSize = value;
+            if ((value = parseJSONInt(body, "freePercent")) >= 0) freePercent = value;
+            if ((value = parseJSONInt(body, "seed")) >= 0)        seed = (unsigned long long)value;
+        }
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int ok = compareMetadataEngines(mm, ops, minSize, maxSize, freePercent,
+                                        seed, resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, ok ? 200 : 400, ok ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_READ;
+    }
+    
+    
+    // ========== POST /api/deferred/enable ==========
+    // Frees stop merging; small holes go on exact-size quick lists
+    // Body: {"maxDeferred":64,"interval":1000}  (optional; interval in ms,
+    //       0 = no timer)
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/deferred/enable") == 0) {
+        
+        int maxDeferred = 64, interval = 1000;
+        if (body != NULL) {
+            int value;
+            if ((value = parseJSONInt(body, "maxDeferred")) > 0) maxDeferred = value;
+            if ((value = parseJSONInt(body, "interval")) >= 0)   interval = value;
+        }
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int ok = enableDeferredCoalescing(mm, maxDeferred, interval,
+                                          resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, ok ? 200 : 400, ok ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_MUTATED;
+    }
+    
+    
+    // ========== POST /api/deferred/disable ==========
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/deferred/disable") == 0) {
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int ok = disableDeferredCoalescing(mm, resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, ok ? 200 : 400, ok ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_MUTATED;
+    }
+    
+    
+    // ========== POST /api/deferred/coalesce ==========
+    // Run the batch merge pass without waiting for pressure or the timer
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/deferred/coalesce") == 0) {
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        if (mm->quick == NULL) {
+            snprintf(resultJSON, sizeof(resultJSON),
+                "{\"success\":false,\"message\":\"Deferred coalescing is not enabled\"}");
+            sendResponse(clientFd, 400, "Bad Request", "application/json", resultJSON);
+            return ROUTE_READ;
+        }
+        
+        int merges = coalesceDeferred(mm, 0);
+        char quickJSON[512];
+        quickListsToJSON(mm->quick, quickJSON, sizeof(quickJSON));
+        snprintf(resultJSON, sizeof(resultJSON),
+            "{\"success\":true,\"merges\":%d,\"quickLists\":%s}", merges, quickJSON);
+        
+        sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
+        return ROUTE_MUTATED;
+    }
+    
+    
+    // ========== POST /api/compact/config ==========
+    // Body: {"threads":4,"threshold":4096}  (threshold in KB; both optional)
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/compact/config") == 0) {
+        
+        int threads = 0, thresholdKB = 0;
+        if (body != NULL) {
+            int value;
+            if ((value = parseJSONInt(body, "threads")) > 0)   threads = value;
+            if ((value = parseJSONInt(body, "threshold")) > 0) thresholdKB = value;
+        }
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        if (!setParallelCopyConfig(threads, (size_t)thresholdKB * 1024)) {
+            snprintf(resultJSON, sizeof(resultJSON),
+                "{\"success\":false,\"message\":\"threads must be 1-%d\"}",
+                PARALLEL_COPY_MAX_THREADS);
+            sendResponse(clientFd, 400, "Bad Request", "application/json", resultJSON);
+            return ROUTE_READ;
+        }
+        
+        char copyJSON[256];
+        parallelCopyStatsToJSON(copyJSON, sizeof(copyJSON));
+        snprintf(resultJSON, sizeof(resultJSON),
+            "{\"success\":true,\"parallelCopy\":%s}", copyJSON);
+        sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
+        return ROUTE_SETTINGS;
+    }
+    
+    
+    // ========== POST /api/compact/benchmark ==========
+    // Body: {"heapMB":256,"processes":64,"runs":3}  (every field optional)
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/compact/benchmark") == 0) {
+        
+        int heapMB = 256, processes = 64, runs = 3;
+        if (body != NULL) {
+            int value;
+            if ((value = parseJSONInt(body, "heapMB")) > 0)    heapMB = value;
+            if ((value = parseJSONInt(body, "processes")) > 0) processes = value;
+            if ((value = parseJSONInt(body, "runs")) > 0)      runs = value;
+        }
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int ok = benchmarkCompaction(heapMB, processes, runs, resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, ok ? 200 : 400, ok ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_READ;
+    }
+    
+    
+    // ========== POST /api/stream/config ==========
+    // Body: {"enabled":1,"threshold":256}  (threshold in KB; both optional)
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/stream/config") == 0) {
+        
+        int enabled = -1, thresholdKB = 0;
+        if (body != NULL) {
+            int value;
+            if ((value = parseJSONInt(body, "enabled")) >= 0)  enabled = (value != 0);
+            if ((value = parseJSONInt(body, "threshold")) > 0) thresholdKB = value;
+        }
+        setStreamConfig(enabled, (size_t)thresholdKB * 1024);
+        
+        char streamJSON[256];
+        streamStatsToJSON(streamJSON, sizeof(streamJSON));
+        char resultJSON[MAX_RESPONSE_SIZE];
+        snprintf(resultJSON, sizeof(resultJSON),
+            "{\"success\":true,\"streamKernels\":%s}", streamJSON);
+        sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
+        return ROUTE_SETTINGS;
+    }
+    
+    
+    // ========== POST /api/stream/benchmark ==========
+    // Body: {"largeKB":8192,"residents":200,"smallOps":200,"rounds":20}
+    //       (every field optional)
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/stream/benchmark") == 0) {
+        
+        int largeKB = 8192, residents = 200, smallOps = 200, rounds = 20;
+        if (body != NULL) {
+            int value;
+            if ((value = parseJSONInt(body, "largeKB")) > 0)    largeKB = value;
+            if ((value = parseJSONInt(body, "residents")) >= 0) residents = value;
+            if ((value = parseJSONInt(body, "smallOps")) > 0)   smallOps = value;
+            if ((value = parseJSONInt(body, "rounds")) > 0)     rounds = value;
+        }
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int ok = benchmarkStreamingFills(largeKB, residents, smallOps, rounds,
+                                         resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, ok ? 200 : 400, ok ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_READ;
+    }
+    
+    
+    // ========== POST /api/admission/policy ==========
+    // Who gets in first when room appears for waiting allocations
+    // Body: {"policy":"fcfs"|"sjf"|"first_fit"}
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/admission/policy") == 0) {
+        
+        char policy[16] = "fcfs";
+        if (body != NULL) {
+            parseJSONString(body, "policy", policy, sizeof(policy));
+        }
+        
+        AdmissionPolicy chosen;
+        if (strcmp(policy, "fcfs") == 0) {
+            chosen = ADMIT_FCFS;
+        } else if (strcmp(policy, "sjf") == 0) {
+            chosen = ADMIT_SJF;
+        } else if (strcmp(policy, "first_fit") == 0) {
+            chosen = ADMIT_FIRST_FIT;
+        } else {
+            sendResponse(clientFd, 400, "Bad Request", "application/json",
+                "{\"success\":false,\"message\":\"Policy must be fcfs, sjf or first_fit\"}");
+            return ROUTE_READ;
+        }
+        
+        char resultJSON[512];
+        if (!setAdmissionPolicy(mm, chosen)) {
+            sendResponse(clientFd, 500, "Internal Server Error", "application/json",
+                "{\"success\":false,\"message\":\"Out of memory\"}");
+            return ROUTE_READ;
+        }
+        char queueJSON[384];
+        admissionToJSON(mm->admission, queueJSON, sizeof(queueJSON));
+        snprintf(resultJSON, sizeof(resultJSON),
+            "{\"success\":true,\"admission\":%s}", queueJSON);
+        sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
+        return ROUTE_SETTINGS;
+    }
+    
+    
+    // ========== POST /api/log/config ==========
+    // Change what the server logs while it runs (both fields optional;
+    // an empty body just reports the counters)
+    // Body: {"level":"debug|info|warn|error|off","sampleEvery":10}
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/log/config") == 0) {
+        
+        char level[16] = "";
+        int every = -1;
+        if (body != NULL) {
+            parseJSONString(body, "level", level, sizeof(level));
+            every = parseJSONInt(body, "sampleEvery");
+        }
+        
+        int chosen = level[0] != '\0' ? logParseLevel(level) : logThreshold;
+        if (chosen < 0 || (every != -1 && every <= 0)) {
+            sendResponse(clientFd, 400, "Bad Request", "application/json",
+                "{\"success\":false,\"message\":\"level must be debug, info, warn, error "
+                "or off; sampleEvery must be positive\"}");
+            return ROUTE_READ;
+        }
+        logSetLevel((LogLevel)chosen);
+        if (every > 0) {
+            logSetSampling(every);
+        }
+        
+        char logJSON[256];
+        char resultJSON[320];
+        logStatsToJSON(logJSON, sizeof(logJSON));
+        snprintf(resultJSON, sizeof(resultJSON), "{\"success\":true,\"log\":%s}", logJSON);
+        sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
+        return ROUTE_READ;
+    }
+    
+    
+    // ========== POST /api/simulate ==========
+    // Discrete-event simulation on a scratch manager (virtual time)
+    // Body: {"algorithm":"first_fit|best_fit|worst_fit|buddy","events":1000000,
+    //        "interarrival":10,"lifetime":500,"minSize":4,"maxSize":64,
+    //        "totalKB":8192,"osKB":512,"seed":1,"progress":10}
+    //       (every field optional; times in virtual ms, sizes in KB)
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/simulate") == 0) {
+        
+        SimulationConfig config = { FIRST_FIT, 0, 8192, 512, 4, 64, 10.0, 500.0, 1000000, 1 };
+        int progressRows = 10;
+        
+        if (body != NULL) {
+            char algorithm[32] = "first_fit";
+            parseJSONString(body, "algorithm", algorithm, sizeof(algorithm));
+            if (strcmp(algorithm, "best_fit") == 0) {
+                config.algorithm = BEST_FIT;
+            } else if (strcmp(algorithm, "worst_fit") == 0) {
+                config.algorithm = WORST_FIT;
+            } else if (strcmp(algorithm, "buddy") == 0) {
+                config.useBuddy = 1;
+            }
+            
+            int value;
+            if ((value = parseJSONInt(body, "events")) > 0)       config.maxEvents = value;
+            if ((value = parseJSONInt(body, "interarrival")) > 0) config.meanInterarrivalMs = value;
+            if ((value = parseJSONInt(body, "lifetime")) > 0)     config.meanLifetimeMs = value;
+            if ((value = parseJSONInt(body, "minSize")) > 0)      config.minSizeKB = value;
+            if ((value = parseJSONInt(body, "maxSize")) > 0)      config.maxSizeKB = value;
+            if ((value = parseJSONInt(body, "totalKB")) > 0)      config.totalKB = value;
+            if ((value = parseJSONInt(body, "osKB")) >= 0)        config.osKB = value;
+            if ((value = parseJSONInt(body, "seed")) >= 0)        config.seed = (unsigned long long)value;
+            if ((value = parseJSONInt(body, "progress")) > 0)     progressRows = value;
+        }
+        if (progressRows > SIM_MAX_PROGRESS) {
+            progressRows = SIM_MAX_PROGRESS;
+        }
+        
+        Simulation *sim = simulationCreate(&config);
+        if (sim == NULL) {
+            sendResponse(clientFd, 400, "Bad Request", "application/json",
+                "{\"success\":false,\"message\":\"Invalid simulation parameters\"}");
+            return ROUTE_READ;
+        }
+        
+        // Run in steps; every step leaves one progress row behind
+        long long step = (config.maxEvents + progressRows - 1) / progressRows;
+        while (simulationRun(sim, step) > 0) {
+            const SimulationProgress *p = &sim->progress[sim->numProgress - 1];
+            LOG_INFO("[SIM] %lld/%lld events, t=%.0f ms, live=%d, frag=%.1f%%\n",
+                     p->events, config.maxEvents, p->timeMs, p->live, p->fragmentation);
+        }
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        simulationToJSON(sim, resultJSON, sizeof(resultJSON));
+        simulationDestroy(sim);
+        
+        sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
+        return ROUTE_READ;
+    }
+    
+    
+    // ========== POST /api/tlb/run  |  POST /api/tlb/compare ==========
+    // Address translation through multi-level page tables and a TLB
+    // Body: {"pageSize":4,"levels":4,"entries":64,"ways":4,"policy":"lru",
+    //        "virtualSize":65536,"length":5000000,"locality":90,"seed":1}
+    //       (every field optional; compare ignores pageSize, runs 4 KB + 2 MB)
+    if (strcmp(method, "POST") == 0 &&
+        (strcmp(path, "/api/tlb/run") == 0 || strcmp(path, "/api/tlb/compare") == 0)) {
+        
+        TranslationConfig config = { 4, 4, 64, 4, TLB_LRU, 65536, 5000000, 90, 1 };
+        int pageSizes[2] = { 4, 2048 };
+        
+        if (body != NULL) {
+            int value;
+            if ((value = parseJSONInt(body, "pageSize")) > 0)     config.pageSizeKB = value;
+            if ((value = parseJSONInt(body, "levels")) > 0)       config.levels = value;
+            if ((value = parseJSONInt(body, "entries")) > 0)      config.tlbEntries = value;
+            if ((value = parseJSONInt(body, "ways")) > 0)         config.tlbWays = value;
+            if ((value = parseJSONInt(body, "virtualSize")) >= 0) config.virtualKB = value;
+            if ((value = parseJSONInt(body, "length")) > 0)       config.length = value;
+            if ((value = parseJSONInt(body, "locality")) >= 0)    config.localityPercent = value;
+            if ((value = parseJSONInt(body, "seed")) >= 0)        config.seed = (unsigned long long)value;
+            
+            char parsed[32];
+            parseJSONString(body, "policy", parsed, sizeof(parsed));
+            if (parsed[0] != '\0') {
+                int policy = parseTLBPolicy(parsed);
+                if (policy < 0) {
+                    sendResponse(clientFd, 400, "Bad Request", "application/json",
+                        "{\"success\":false,\"message\":\"policy must be lru or random\"}");
+                    return ROUTE_READ;
+                }
+                config.policy = (TLBReplacementPolicy)policy;
+            }
+        }
+        
+        int numPageSizes = 2;
+        if (strcmp(path, "/api/tlb/run") == 0) {
+            pageSizes[0] = config.pageSizeKB;
+            numPageSizes = 1;
+        }
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int ok = runTranslationSimulation(mm, &config, pageSizes, numPageSizes,
+                                          resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, ok ? 200 : 400, ok ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_SETTINGS;
+    }
+    
+    
+    // ========== GET /api/slab ==========
+    // All slab caches with utilization and internal fragmentation
+    if (strcmp(method, "GET") == 0 && strcmp(path, "/api/slab") == 0) {
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        slabCachesToJSON(mm, resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, 200, "OK", "application/json", resultJSON);
+        return ROUTE_READ;
+    }
+    
+    
+    // ========== POST /api/slab/create ==========
+    // Body: {"objectSize":64,"slabSize":8}   (slabSize in KB, optional)
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/slab/create") == 0) {
+        
+        if (body == NULL) {
+            sendResponse(clientFd, 400, "Bad Request", "application/json",
+                "{\"success\":false,\"message\":\"Missing request body\"}");
+            return ROUTE_READ;
+        }
+        
+        int objectSize = parseJSONInt(body, "objectSize");
+        int slabSize = parseJSONInt(body, "slabSize");
+        
+        char resultJSON[512];
+        int cacheID = slabCacheCreate(mm, objectSize, (slabSize > 0) ? slabSize : 0,
+                                      resultJSON, sizeof(resultJSON));
+        
+        sendResponse(clientFd, (cacheID >= 0) ? 200 : 400,
+                     (cacheID >= 0) ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_MUTATED;
+    }
+    
+    
+    // ========== POST /api/slab/alloc ==========
+    // Body: {"cache":0,"count":10}   (count optional, at most 4096;
+    //       "cacheId" works as well as "cache")
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/slab/alloc") == 0) {
+        
+        int cacheID = (body != NULL) ? parseSlabCache(body) : -1;
+        int count = (body != NULL) ? parseJSONInt(body, "count") : -1;
+        if (count <= 0) count = 1;
+        if (count > 4096) count = 4096;
+        
+        char resultJSON[MAX_RESPONSE_SIZE];
+        int written = snprintf(resultJSON, sizeof(resultJSON), "{\"objects\":[");
+        int allocated = 0;
+        for (int i = 0; i < count; i++) {
+            long long handle = slabAlloc(mm, cacheID);
+            if (handle < 0) {
+                break;
+            }
+            written += snprintf(resultJSON + written, sizeof(resultJSON) - written,
+                                "%s%lld", (allocated == 0) ? "" : ",", handle);
+            allocated++;
+        }
+        snprintf(resultJSON + written, sizeof(resultJSON) - written,
+            "],\"success\":%s,\"allocated\":%d,\"requested\":%d}",
+            (allocated > 0) ? "true" : "false", allocated, count);
+        
+        // Nothing allocated: say why instead of an empty list
+        if (allocated == 0) {
+            const SlabLayer *layer = mm->slabs;
+            const char *why = "No hole is large enough for a new slab";
+            if (mm->useBuddySystem || mm->usePagedMode || mm->useBoundaryTags) {
+                why = "Slabs are carved from the block list: "
+                      "revert buddy, paged or boundary-tag mode first";
+            } else if (layer == NULL || cacheID < 0 || cacheID >= layer->numCaches ||
+                       layer->caches[cacheID].cacheID == -1) {
+                why = "Unknown cache";
+            }
+            snprintf(resultJSON, sizeof(resultJSON),
+                "{\"success\":false,\"message\":\"%s\",\"allocated\":0,\"requested\":%d}",
+                why, count);
+        }
+        
+        sendResponse(clientFd, (allocated > 0) ? 200 : 400,
+                     (allocated > 0) ? "OK" : "Bad Request",
+                     "application/json", resultJSON);
+        return ROUTE_MUTATED;
+    }
+    
+    
+    // ========== POST /api/slab/free ==========
+    // Body: {"object":196608}   (handle returned by /api/slab/alloc)
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/slab/free") == 0) {
+        
+        // Handles are (PID << SLAB_HANDLE_SHIFT) | index: past INT_MAX as
+        // soon as a slab's PID is, so not read with parseJSONInt()
+        long long handle = -1;
+        if (body == NULL || !jsonTokenInt(body, jsonFind(body, 0, "object"), &handle)) {
+            handle = -1;
+        }
+        
+        if (slabFree(mm, handle)) {
+            sendResponse(clientFd, 200, "OK", "application/json", "{\"success\":true}");
+        } else {
+            sendResponse(clientFd, 404, "Not Found", "application/json",
+                "{\"success\":false,\"message\":\"Not a live slab object\"}");
+        }
+        return ROUTE_MUTATED;
+    }
+    
+    
+    // ========== POST /api/slab/destroy ==========
+    // Body: {"cache":0}   (or {"cacheId":0})
+    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/slab/destroy") == 0) {
+        
+        int cacheID = (body != NULL) ? parseSlabCache(body) : -1;
+        
+        if (slabCacheDestroy(mm, cacheID)) {
+            sendResponse(clientFd, 200, "OK", "application/json", "{\"success\":true}");
+        } else {
+            sendResponse(clientFd, 404, "Not Found", "application/json",
+                "{\"success\":false,\"message\":\"Unknown cache\"}");
+        }
+        return ROUTE_MUTATED;
+    }
+    
+    
+    // ========== 404 NOT FOUND ==========
+    // No matching route found
+    char notFound[256];
+    snprintf(notFound, sizeof(notFound),
+        "{\"error\":\"Not Found\",\"message\":\"Unknown endpoint: %s %s\"}", 
+        method, path);
+    
+    sendResponse(clientFd, 404, "Not Found", "application/json", notFound);
+    return ROUTE_READ;
+}
+
+
+/*
+================================================================================
+HELPER FUNCTION: sendFileChunk
+================================================================================
+PURPOSE: Send (part of) a file from *offset to the socket, advance *offset
+
+Linux: sendfile(out, in, &offset, count). macOS: sendfile(in, out, offset,
+&length, NULL, 0), which reports what it sent in 'length' even when it
+was interrupted. Elsewhere: pread() into a buffer, then send().
+
+RETURNS: Bytes sent (> 0), or -1 with errno set (EINTR: try again)
+*/
+
+static ssize_t sendFileChunk(int clientFd, int fd, off_t *offset, size_t count) {
+#if defined(__linux__)
+    return sendfile(clientFd, fd, offset, count);
+#elif defined(__APPLE__)
+    off_t length = (off_t)count;
+    int result = sendfile(fd, clientFd, *offset, &length, NULL, 0);
+    if (length > 0) {
+        *offset += length;
+        return (ssize_t)length;
+    }
+    return result < 0 ? -1 : 0;
+#else
+    char buffer[64 * 1024];
+    ssize_t got = pread(fd, buffer, count < sizeof(buffer) ? count : sizeof(buffer), *offset);
+    if (got <= 0) {
+        return -1;
+    }
+    for (ssize_t done = 0; done < got; ) {
+        ssize_t n = send(clientFd, buffer + done, (size_t)(got - done), MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return -1;
+        }
+        done += n;
+    }
+    *offset += got;
+    return got;
+#endif
+}
+
+
+/*
+================================================================================
+HELPER FUNCTION: sendStaticFile
+================================================================================
+PURPOSE: Answer GET/HEAD for a file of the UI build
+
+WHAT IT DOES:
+1. 304 Not Modified if the browser already has this version (ETag)
+2. Headers: type, length, caching, gzip if the .gz variant is used
+3. sendfile(): the kernel copies page cache → socket, the file never
+   passes through our memory. The file offset is passed in, so many
+   threads can send the same open file at once.
+
+CACHING:
+assets/ files → "max-age=31536000, immutable" (the name changes with the
+                content, so a cached copy is never stale)
+the rest      → "no-cache" (index.html must be checked every time, a
+                304 makes that cheap)
+*/
+
+static void sendStaticFile(int clientFd, const HttpParser *request, const StaticFile *file) {
+    
+    int headOnly = strcmp(request->method, "HEAD") == 0;
+    int useGzip = request->acceptGzip && file->gzipFd >= 0;
+    int fd = useGzip ? file->gzipFd : file->fd;
+    long long size = useGzip ? file->gzipSize : file->size;
+    
+    // STEP 1: Does the browser have it already? ("*" or a list of ETags)
+    int notModified = 0;
+    if (request->ifNoneMatch != NULL) {
+        int tagLength = (int)strlen(file->etag);
+        for (int i = 0; i + tagLength <= request->ifNoneMatchLength; i++) {
+            if (memcmp(request->ifNoneMatch + i, file->etag, tagLength) == 0) {
+                notModified = 1;
+                break;
+            }
+        }
+        notModified |= request->ifNoneMatchLength == 1 && request->ifNoneMatch[0] == '*';
+    }
+    
+    // STEP 2: Headers
+    int keepAlive = currentConnection != NULL && currentConnection->fd == clientFd &&
+                    currentConnection->keepAlive;
+    char header[MAX_HEADER_SIZE];
+    int headerLen = snprintf(header, sizeof(header),
+        "HTTP/1.1 %s\r\n"
+        "Content-Type: %s\r\n"
+        "Content-Length: %lld\r\n"
+        "Cache-Control: %s\r\n"
+        "ETag: %s\r\n"
+        "Vary: Accept-Encoding\r\n"
+        "%s"
+        "Connection: %s\r\n"
+        "\r\n",
+        notModified ? "304 Not Modified" : "200 OK",
+        file->contentType,
+        notModified ? 0LL : size,
+        file->immutable ? "public, max-age=31536000, immutable" : "no-cache",
+        file->etag,
+        useGzip ? "Content-Encoding: gzip\r\n" : "",
+        keepAlive ? "keep-alive" : "close");
+    connectionSend(clientFd, header, headerLen, "", 0);
+    if (notModified || headOnly) {
+        return;
+    }
+    
+    // STEP 3: Everything queued before it goes first, then the file
+    if (currentConnection != NULL && currentConnection->fd == clientFd) {
+        connectionFlushMore(currentConnection, MSG_MORE);
+    }
+    off_t offset = 0;
+    while (offset < size) {
+        ssize_t sent = sendFileChunk(clientFd, fd, &offset, (size_t)(size - offset));
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            // Client gone mid-file: the framing is lost, end the connection
+            if (currentConnection != NULL && currentConnection->fd == clientFd) {
+                currentConnection->keepAlive = 0;
+            }
+            return;
+        }
+    }
+}
+
+
+/*
+================================================================================
+FUNCTION: handleRequest (snapshot fast path + state lock)
+================================================================================
+PURPOSE: Answer one parsed request: either from the published snapshot,
+         or tokenize the body and run the route under the state lock
+
+WHY TWO PATHS:
+- GET /api/blocks and GET /api/stats are what the frontend polls; they
+  read an immutable snapshot and never wait for a compaction
+- The UI's own files and CORS preflights do not touch mm at all
+- Every other route may read or change mm, so those run one at a time;
+  a POST publishes a fresh snapshot before it lets go of the lock
+*/
+
+void handleRequest(int clientFd, const HttpParser *request, MemoryManager *mm) {
+    
+    // STEP 1: Method and path, already cut out by httpParse()
+    const char *method = request->method;
+    const char *path = request->path;
+    
+    LOG_INFO("[REQUEST] %s %s\n", method, path);
+    
+    // STEP 1b: The UI's files (the index never changes after startup,
+    // so no lock) and CORS preflights (nothing to lock for either)
+    int isGet = strcmp(method, "GET") == 0 || strcmp(method, "HEAD") == 0;
+    if (isGet && staticFileCount() > 0 && strncmp(path, "/api/", 5) != 0) {
+        const StaticFile *file = staticFileFind(path);
+        if (file != NULL) {
+            sendStaticFile(clientFd, request, file);
+        } else {
+            sendResponse(clientFd, 404, "Not Found", "application/json",
+                "{\"error\":\"Not Found\",\"message\":\"No such file in the UI build\"}");
+        }
+        return;
+    }
+    if (strcmp(method, "OPTIONS") == 0) {
+        sendResponse(clientFd, 204, "No Content", "text/plain", "");
+        return;
+    }
+    
+    // STEP 2: Snapshot reads
+    int wantBlocks = strcmp(method, "GET") == 0 && strcmp(path, "/api/blocks") == 0;
+    int wantStats = strcmp(method, "GET") == 0 && strcmp(path, "/api/stats") == 0;
+    
+    if (wantBlocks || wantStats) {
+        // Changed by the local transport since: publish first
+        if (__atomic_load_n(&snapshotStale, __ATOMIC_ACQUIRE)) {
+            pthread_mutex_lock(&stateLock);
+            if (snapshotStale) {
+                snapshotPublish(mm);
+                __atomic_store_n(&snapshotStale, 0, __ATOMIC_RELEASE);
+            }
+            pthread_mutex_unlock(&stateLock);
+        }
+        
+        Snapshot *snapshot = snapshotAcquire();
+        if (snapshot != NULL) {
+            sendResponse(clientFd, 200, "OK", "application/json",
+                wantBlocks ? snapshot->blocksJSON : snapshot->statsJSON);
+            snapshotRelease(snapshot);
+            return;
+        }
+        
+        // Nothing published yet: render from the live state under the lock
+        char json[MAX_RESPONSE_SIZE];
+        pthread_mutex_lock(&stateLock);
+        if (wantBlocks) {
+            blocksToJSON(mm, json, sizeof(json));
+        } else {
+            getStatsJSON(mm, json, sizeof(json));
+        }
+        pthread_mutex_unlock(&stateLock);
+        sendResponse(clientFd, 200, "OK", "application/json", json);
+        return;
+    }
+    
+    // STEP 3: Tokenize the JSON body once, before taking the lock
+    // (an empty body is no body; a malformed one is refused here)
+    JsonDocument doc;
+    const JsonDocument *body = NULL;
+    if (request->bodyLength > 0) {
+        int tokens = jsonParse(&doc, request->body, request->bodyLength);
+        if (tokens < 0) {
+            sendResponse(clientFd, 400, "Bad Request", "application/json",
+                tokens == JSON_ERROR_NOMEM
+                    ? "{\"success\":false,\"message\":\"JSON body has too many values\"}"
+                    : "{\"success\":false,\"message\":\"Invalid JSON body\"}");
+            return;
+        }
+        body = &doc;
+    }
+    
+    // STEP 4: Everything else runs alone; changes get published
+    pthread_mutex_lock(&stateLock);
+    RouteEffect effect = routeRequest(clientFd, body, mm, method, path);
+    if (effect != ROUTE_READ) {
+        admissionWake(mm);      // A free or compaction may have made room
+        snapshotPublish(mm);
+        __atomic_store_n(&snapshotStale, 0, __ATOMIC_RELEASE);
+        shmExportPublish(mm);
+        exportStale = 0;
+    }
+    if (effect == ROUTE_MUTATED) {
+        statsHistorySample(mm, 1);
+    }
+    pthread_mutex_unlock(&stateLock);
+}
+
+
+/*
+================================================================================
+FUNCTION: serverLockState / serverUnlockState
+================================================================================
+PURPOSE: The state lock for the local transport (see http_server.h)
+*/
+
+void serverLockState(void) {
+    pthread_mutex_lock(&stateLock);
+}
+
+void serverUnlockState(MemoryManager *mm, int operations) {
+    if (operations > 0) {
+        admissionWake(mm);
+        __atomic_store_n(&snapshotStale, 1, __ATOMIC_RELEASE);
+        
+        // One sample (and shared-memory export) per millisecond at most;
+        // both walk the block list. The tick thread catches up the rest.
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        long long nowNs = now.tv_sec * 1000000000LL + now.tv_nsec;
+        unsampledOps += operations;
+        exportStale = 1;
+        if (nowNs - lastSampleNs >= 1000000) {
+            statsHistorySample(mm, (int)unsampledOps);
+            shmExportPublish(mm);
+            unsampledOps = 0;
+            exportStale = 0;
+            lastSampleNs = nowNs;
+        }
+    }
+    pthread_mutex_unlock(&stateLock);
+}
+
+
+/*
+================================================================================
+FUNCTION: statsTickThread
+================================================================================
+PURPOSE: One stats sample per second, so the time series keeps going
+         while nobody changes anything
+*/
+
+static void* statsTickThread(void *arg) {
+    MemoryManager *mm = (MemoryManager*)arg;
+    while (1) {
+        sleep(1);
+        pthread_mutex_lock(&stateLock);
+        statsHistorySample(mm, (int)unsampledOps);
+        unsampledOps = 0;
+        if (exportStale) {
+            shmExportPublish(mm);
+            exportStale = 0;
+        }
+        pthread_mutex_unlock(&stateLock);
+    }
+    return NULL;
+}
+
+
+/*
+================================================================================
+FUNCTION: connectionThread
+================================================================================
+PURPOSE: Serve one accepted connection on its own thread
+*/
+
+typedef struct {
+    int clientFd;
+    MemoryManager *mm;
+} ConnectionArgs;
+
+/*
+ALGORITHM (serveConnection):
+1. Answer every complete request already in the buffer, in order
+   (a request cut off by the end of the buffer waits for more bytes)
+2. Write their responses together
+3. Move a partial request to the front if the buffer is full, then read
+   more; stop on close, error, idle timeout or "Connection: close"
+
+in: [ answered ....... | partial request | free space ]
+    0                start             filled        HTTP_BUFFER_SIZE
+*/
+
+static void serveConnection(int clientFd, MemoryManager *mm) {
+    
+    Connection *conn = (Connection*)malloc(sizeof(Connection));
+    if (conn == NULL) {
+        close(clientFd);
+        return;
+    }
+    conn->fd = clientFd;
+    conn->keepAlive = 0;
+    conn->outLength = 0;
+    currentConnection = conn;
+    
+    // An idle keep-alive connection gives its thread back after a while
+    struct timeval idle = { KEEPALIVE_IDLE_SECONDS, 0 };
+    setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &idle, sizeof(idle));
+    
+    HttpParser parser;
+    httpParserReset(&parser);
+    int start = 0;
+    int filled = 0;
+    int open = 1;
+    
+    while (open) {
+        
+        // STEP 1: Every complete request received so far
+        while (1) {
+            int result = httpParse(&parser, conn->in + start, filled - start);
+            
+            if (result == HTTP_PARSE_MORE) {
+                // The client waits for this before sending a large body
+                if (parser.expectContinue) {
+                    static const char goOn[] = "HTTP/1.1 100 Continue\r\n\r\n";
+                    connectionSend(clientFd, goOn, sizeof(goOn) - 1, "", 0);
+                    parser.expectContinue = 0;
+                }
+                break;
+            }
+            
+            if (result == HTTP_PARSE_ERROR) {
+                // Framing is lost: answer and close
+                char error[128];
+                snprintf(error, sizeof(error),
+                    "{\"success\":false,\"message\":\"%s\"}", parser.errorText);
+                conn->keepAlive = 0;
+                sendResponse(clientFd, parser.errorStatus, parser.errorText,
+                             "application/json", error);
+                open = 0;
+                break;
+            }
+            
+            conn->keepAlive = parser.keepAlive;
+            handleRequest(clientFd, &parser, mm);
+            start += parser.consumed;
+            httpParserReset(&parser);
+            if (!conn->keepAlive) {
+                open = 0;
+                break;
+            }
+        }
+        
+        // STEP 2: Their responses, in order, in one write
+        connectionFlush(conn);
+        if (!open) {
+            break;
+        }
+        
+        // STEP 3: Make room (offsets in the parser are relative to start)
+        if (start == filled) {
+            start = filled = 0;
+        } else if (filled == HTTP_BUFFER_SIZE) {
+            memmove(conn->in, conn->in + start, filled - start);
+            filled -= start;
+            start = 0;
+        }
+        ssize_t bytesRead = read(clientFd, conn->in + filled, HTTP_BUFFER_SIZE - filled);
+        if (bytesRead <= 0) {
+            break;      // Closed, error, or idle too long
+        }
+        filled += (int)bytesRead;
+    }
+    
+    currentConnection = NULL;
+    close(clientFd);
+    free(conn);
+}
+
+static void* connectionThread(void *arg) {
+    ConnectionArgs args = *(ConnectionArgs*)arg;
+    free(arg);
+    serveConnection(args.clientFd, args.mm);
+    return NULL;
+}
+
+
+/*
+================================================================================
+FUNCTION: startServer
+================================================================================
+PURPOSE: Start the HTTP API server
+
+HOW SOCKETS WORK (simplified):
+1. socket() → Create a communication endpoint (like getting a phone)
+2. bind() → Assign a port number (like getting a phone number)
+3. listen() → Start waiting for connections (like turning on the phone)
+4. accept() → Accept a connection (like answering a call)
+5. pthread_create() → A new thread takes the call from here on:
+   read() and answer requests until the client is done, then close()
+6. Go back to step 4 (wait for next call) without waiting for it
+
+THIS IS THE MAIN SERVER LOOP!
+*/
+
+int startServer(MemoryManager *mm, int port, const char *localPath, int rpcPort) {
+    
+    // A client that disconnects mid-response must not stop the server
+    // (sendfile() has no MSG_NOSIGNAL, and macOS has no MSG_NOSIGNAL at all)
+    signal(SIGPIPE, SIG_IGN);
+    
+    // STEP 1: Create a TCP socket
+    // AF_INET = IPv4 internet
+    // SOCK_STREAM = TCP (reliable, ordered)
+    // 0 = auto-select protocol
+    int serverFd = socket(AF_INET, SOCK_STREAM, 0);
+    
+    if (serverFd < 0) {
+        perror("Error: Could not create socket");
+        return -1;
+    }
+    
+    // STEP 2: Set socket options
+    // SO_REUSEADDR allows reusing the port immediately after the server stops
+    // Without this, you might get "Address already in use" error
+    int opt = 1;
+    setsockopt(serverFd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    
+    // STEP 3: Set up the server address structure
+    struct sockaddr_in serverAddr;
+    memset(&serverAddr, 0, sizeof(serverAddr));  // Clear to zeros
+    serverAddr.sin_family = AF_INET;             // IPv4
+    serverAddr.sin_addr.s_addr = INADDR_ANY;     // Accept from any IP
+    serverAddr.sin_port = htons(port);           // Port number (network byte order)
+    // htons = "Host TO Network Short" (converts endianness)
+    
+    // STEP 4: Bind socket to the port
+    // This "claims" the port number for our server
+    if (bind(serverFd, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) < 0) {
+        perror("Error: Could not bind to port");
+        close(serverFd);
+        return -1;
+    }
+    
+    // STEP 5: Start listening for connections
+    // 10 = maximum queue length for pending connections
+    if (listen(serverFd, 10) < 0) {
+        perror("Error: Could not listen on socket");
+        close(serverFd);
+        return -1;
+    }
+    
+    // STEP 6: Print server info
+    printf("\n");
     printf("╔══════════════════════════════════════════════════╗\n");
     printf("║  MEMORY MANAGEMENT API SERVER                    ║\n");
     printf("╠══════════════════════════════════════════════════╣\n");
@@ -571,18 +2001,95 @@ int startServer(MemoryManager *mm, int port) {
     printf("║  GET  /api/status         Health check           ║\n");
     printf("║  GET  /api/blocks         Get memory blocks      ║\n");
     printf("║  GET  /api/stats          Get statistics         ║\n");
+    printf("║  GET  /api/residency      Resident pages/faults  ║\n");
+    printf("║  GET  /api/history?op=N   State after op N       ║\n");
+    printf("║  GET  /api/stats/history  Stats over time        ║\n");
     printf("║  POST /api/allocate       Allocate memory        ║\n");
     printf("║  POST /api/deallocate     Free memory            ║\n");
+    printf("║  POST /api/allocate/batch   Many allocations     ║\n");
+    printf("║  POST /api/deallocate/batch Many frees           ║\n");
+    printf("║  POST /api/json/benchmark   Parser benchmark     ║\n");
     printf("║  POST /api/compact        Run compaction         ║\n");
     printf("║  POST /api/autocompact    Auto-compact           ║\n");
     printf("║  POST /api/buddy/convert  Enable buddy system    ║\n");
     printf("║  POST /api/buddy/revert   Disable buddy system   ║\n");
     printf("║  POST /api/reset          Reset memory           ║\n");
+    printf("║  POST /api/paging/run     Paging simulation      ║\n");
+    printf("║  POST /api/paging/compare All paging algorithms  ║\n");
+    printf("║  POST /api/paged/convert  Enable paged mode      ║\n");
+    printf("║  POST /api/paged/revert   Disable paged mode     ║\n");
+    printf("║  POST /api/paged/compare  Fits vs buddy vs paged ║\n");
+    printf("║  POST /api/tlb/run        Page table + TLB run   ║\n");
+    printf("║  POST /api/tlb/compare    4 KB vs 2 MB pages     ║\n");
+    printf("║  GET  /api/slab           Slab caches            ║\n");
+    printf("║  POST /api/slab/create    New slab cache         ║\n");
+    printf("║  POST /api/slab/alloc     Allocate objects       ║\n");
+    printf("║  POST /api/slab/free      Free an object         ║\n");
+    printf("║  POST /api/slab/destroy   Destroy a slab cache   ║\n");
+    printf("║  POST /api/tags/convert   Enable boundary tags   ║\n");
+    printf("║  POST /api/tags/revert    Disable boundary tags  ║\n");
+    printf("║  POST /api/tags/compare   List vs boundary tags  ║\n");
+    printf("║  POST /api/deferred/enable   Quick lists on      ║\n");
+    printf("║  POST /api/deferred/disable  Quick lists off     ║\n");
+    printf("║  POST /api/deferred/coalesce Batch merge now     ║\n");
+    printf("║  POST /api/compact/config    Copy threads        ║\n");
+    printf("║  POST /api/compact/benchmark Parallel compaction ║\n");
+    printf("║  POST /api/stream/config     Streaming stores    ║\n");
+    printf("║  POST /api/stream/benchmark  Cache pollution     ║\n");
+    printf("║  POST /api/simulate          Event simulation    ║\n");
+    printf("║  POST /api/admission/policy  Waiting allocations ║\n");
+    printf("║  POST /api/log/config        Log level, sampling ║\n");
     printf("║                                                  ║\n");
+    if (staticFileCount() > 0) {
+        printf("║  UI: http://localhost:%-5d/ (%4d files)        ║\n",
+               port, staticFileCount());
+        printf("║                                                  ║\n");
+    }
+    if (shmExportName() != NULL) {
+        printf("║  Shared-memory export (read-only, seqlock):      ║\n");
+        printf("║    %-46.46s║\n", shmExportName());
+        printf("║                                                  ║\n");
+    }
+    if (localPath != NULL) {
+        printf("║  Local transport (binary, Unix socket + ring):   ║\n");
+        printf("║    %-46.46s║\n", localPath);
+        printf("║                                                  ║\n");
+    }
+    if (rpcPort > 0) {
+        printf("║  Binary RPC (same protocol, TCP):                ║\n");
+        printf("║    port %-41d║\n", rpcPort);
+        printf("║                                                  ║\n");
+    }
     printf("║  Press Ctrl+C to stop the server                 ║\n");
     printf("╚══════════════════════════════════════════════════╝\n");
     printf("\nWaiting for connections...\n\n");
     
+    // Log messages from here on are written by a background thread
+    logStart(stdout);
+    
+    // Record every mutation from here on (op 0 = the state right now)
+    enableHistory(mm);
+    
+    // Readers get a snapshot from the very first request on
+    // (and shared-memory readers the state before the first change)
+    snapshotPublish(mm);
+    shmExportPublish(mm);
+    
+    // Stats time series: first sample now, then one per second
+    statsHistorySample(mm, 0);
+    pthread_t tickThread;
+    if (pthread_create(&tickThread, NULL, statsTickThread, mm) == 0) {
+        pthread_detach(tickThread);
+    }
+    
+    // Binary clients: no HTTP (local_transport.h); Unix socket, TCP
+    if (localPath != NULL) {
+        localTransportStart(mm, localPath);
+    }
+    if (rpcPort > 0) {
+        localTransportStartTcp(mm, rpcPort);
+    }
+    
     // STEP 7: Main server loop — handle requests forever
     while (1) {
         
@@ -597,19 +2104,19 @@ int startServer(MemoryManager *mm, int port) {
             continue;  // Try again
         }
         
-        // Read the client's HTTP request
-        char request[MAX_REQUEST_SIZE];
-        memset(request, 0, sizeof(request));
-        
-        ssize_t bytesRead = read(clientFd, request, sizeof(request) - 1);
-        
-        if (bytesRead > 0) {
-            // Handle the request
-            handleRequest(clientFd, request, mm);
+        // Hand the connection to its own thread (inline if that fails)
+        ConnectionArgs *args = (ConnectionArgs*)malloc(sizeof(ConnectionArgs));
+        pthread_t thread;
+        if (args != NULL) {
+            args->clientFd = clientFd;
+            args->mm = mm;
+            if (pthread_create(&thread, NULL, connectionThread, args) == 0) {
+                pthread_detach(thread);
+                continue;
+            }
+            free(args);
         }
-        
-        // Close the client connection
-        close(clientFd);
+        serveConnection(clientFd, mm);
     }
     
     // Close the server socket (we never actually reach here)
@@ -625,11 +2132,21 @@ END OF FILE: http_server.c
 
 WHAT WE IMPLEMENTED:
 1. sendResponse() - Send HTTP response with CORS headers
-2. parseRequestBody() - Extract body from HTTP request
-3. parseJSONInt() - Parse integer from JSON string
-4. parseJSONString() - Parse string from JSON string
-5. handleRequest() - Route HTTP requests to handlers
-6. startServer() - Main server loop with POSIX sockets
+2. connectionSend() / connectionFlush() - Ordered, batched keep-alive writes
+   sendStaticFile() - UI files by sendfile(), gzip variants, ETag / 304
+   sendFileChunk() - sendfile() on Linux / macOS, pread + send elsewhere
+3. parseJSONInt() - Integer field of the tokenized body
+4. parseJSONString() / parseJSONIntArray() - String and integer-array fields
+5. routeRequest() - Route HTTP requests to handlers
+6. handleRequest() - Snapshot reads, serialized state changes
+   serverLockState() / serverUnlockState() - The same lock for the local
+   transport, with a lazily republished snapshot
+   Every change also goes to the shared-memory export (shm_export.c)
+7. statsTickThread() - Once-a-second stats sample
+8. serveConnection() - Keep-alive loop over pipelined requests
+   (parsed incrementally by httpParse(), see http_parser.c)
+   Request lines and progress go through the async logger (logger.c)
+9. startServer() - Main server loop with POSIX sockets
 
 KEY NETWORKING CONCEPTS:
 - Socket: Communication endpoint (like a phone)
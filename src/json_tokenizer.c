@@ -0,0 +1,521 @@
+/*
+================================================================================
+FILE: json_tokenizer.c
+PURPOSE: Implement the single-pass JSON tokenizer and its lookups
+DESCRIPTION:
+    - A small state machine over the characters: what may come next
+      (a key, a ':', a value, a ',' or a closing bracket) decides
+      whether a character is valid
+    - Open objects/arrays sit on a fixed-size stack of token indices;
+      closing one fills in its end and 'next'
+================================================================================
+*/
+
+#include <stdio.h>      // snprintf
+#include <stdlib.h>     // atoi
+#include <string.h>     // strlen, strstr, memcmp
+#include <time.h>       // clock_gettime, CLOCK_MONOTONIC
+#include "../include/json_tokenizer.h"
+
+
+// What the tokenizer accepts at the current position
+typedef enum {
+    EXPECT_VALUE,           // After ':' or ',' in an array, or at the start
+    EXPECT_VALUE_OR_CLOSE,  // Right after '['
+    EXPECT_KEY,             // After ',' in an object
+    EXPECT_KEY_OR_CLOSE,    // Right after '{'
+    EXPECT_COLON,
+    EXPECT_COMMA_OR_CLOSE,
+    EXPECT_END              // The top-level value is complete
+} Expect;
+
+
+/*
+--------------------------------------------------------------------------------
+TABLE: charClass
+--------------------------------------------------------------------------------
+PURPOSE: One lookup instead of a chain of comparisons per character
+         (the inner loops run once per byte of the body)
+*/
+
+#define CC_SPACE  1     // ' ' \t \r \n
+#define CC_END    2     // Ends a primitive: whitespace , ] }
+#define CC_STOP   4     // Ends a string scan or is invalid in one: " \ controls
+
+static const unsigned char charClass[256] = {
+    [0x00 ... 0x08] = CC_STOP,      // Control characters except \t \n \r
+    [0x0b ... 0x0c] = CC_STOP,
+    [0x0e ... 0x1f] = CC_STOP,
+    ['\t'] = CC_SPACE | CC_END | CC_STOP,
+    ['\r'] = CC_SPACE | CC_END | CC_STOP,
+    ['\n'] = CC_SPACE | CC_END | CC_STOP,
+    [' ']  = CC_SPACE | CC_END,
+    [',']  = CC_END,
+    [']']  = CC_END,
+    ['}']  = CC_END,
+    ['"']  = CC_STOP,
+    ['\\'] = CC_STOP
+};
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: newToken
+--------------------------------------------------------------------------------
+*/
+
+static int newToken(JsonDocument *doc, JsonType type, int start, int end) {
+    if (doc->count >= JSON_MAX_TOKENS) {
+        return -1;
+    }
+    int index = doc->count++;
+    JsonToken *t = &doc->tokens[index];
+    t->type = (unsigned char)type;
+    t->start = start;
+    t->end = end;
+    t->next = index + 1;
+    t->size = 0;
+    return index;
+}
+
+
+/*
+================================================================================
+FUNCTION: jsonParse
+================================================================================
+ALGORITHM (one pass over the text):
+1. Skip whitespace
+2. '{' / '[': open a container token, push it
+3. '}' / ']': must close the container on top; fill in end and next
+4. '"': a key (inside an object, where a key is expected) or a string
+5. ':' / ',': move the expectation along
+6. Anything else: a primitive running to the next delimiter
+*/
+
+int jsonParse(JsonDocument *doc, const char *text, int length) {
+
+    int stack[JSON_MAX_DEPTH];      // Token indices of open containers
+    int depth = 0;
+    Expect expect = EXPECT_VALUE;
+
+    doc->text = text;
+    doc->length = length;
+    doc->count = 0;
+    const unsigned char *bytes = (const unsigned char*)text;
+
+    for (int i = 0; i < length; i++) {
+        char c = text[i];
+
+        // STEP 1: Whitespace
+        if (charClass[bytes[i]] & CC_SPACE) {
+            continue;
+        }
+
+        int valueExpected = expect == EXPECT_VALUE || expect == EXPECT_VALUE_OR_CLOSE;
+        JsonToken *parent = depth > 0 ? &doc->tokens[stack[depth - 1]] : NULL;
+
+        // STEP 2: Open a container
+        if (c == '{' || c == '[') {
+            if (!valueExpected || depth == JSON_MAX_DEPTH) {
+                return JSON_ERROR_INVALID;
+            }
+            int index = newToken(doc, c == '{' ? JSON_OBJECT : JSON_ARRAY, i, i + 1);
+            if (index < 0) {
+                return JSON_ERROR_NOMEM;
+            }
+            if (parent != NULL && parent->type == JSON_ARRAY) {
+                parent->size++;
+            }
+            stack[depth++] = index;
+            expect = c == '{' ? EXPECT_KEY_OR_CLOSE : EXPECT_VALUE_OR_CLOSE;
+            continue;
+        }
+
+        // STEP 3: Close the container on top
+        if (c == '}' || c == ']') {
+            JsonType wanted = c == '}' ? JSON_OBJECT : JSON_ARRAY;
+            int canClose = expect == EXPECT_COMMA_OR_CLOSE ||
+                (wanted == JSON_OBJECT && expect == EXPECT_KEY_OR_CLOSE) ||
+                (wanted == JSON_ARRAY && expect == EXPECT_VALUE_OR_CLOSE);
+            if (parent == NULL || parent->type != wanted || !canClose) {
+                return JSON_ERROR_INVALID;
+            }
+            parent->end = i + 1;
+            parent->next = doc->count;
+            depth--;
+            expect = depth > 0 ? EXPECT_COMMA_OR_CLOSE : EXPECT_END;
+            continue;
+        }
+
+        // STEP 4: Key or string
+        if (c == '"') {
+            int isKey = expect == EXPECT_KEY || expect == EXPECT_KEY_OR_CLOSE;
+            if (!isKey && !valueExpected) {
+                return JSON_ERROR_INVALID;
+            }
+            int j = i + 1;
+            while (j < length) {
+                if (!(charClass[bytes[j]] & CC_STOP)) {
+                    j++;
+                } else if (text[j] == '\\') {
+                    j += 2;
+                } else if (text[j] == '"') {
+                    break;
+                } else {
+                    return JSON_ERROR_INVALID;     // Raw control character
+                }
+            }
+            if (j >= length) {
+                return JSON_ERROR_PARTIAL;
+            }
+            if (newToken(doc, JSON_STRING, i + 1, j) < 0) {
+                return JSON_ERROR_NOMEM;
+            }
+            if (isKey) {
+                parent->size++;
+                expect = EXPECT_COLON;
+            } else {
+                if (parent != NULL && parent->type == JSON_ARRAY) {
+                    parent->size++;
+                }
+                expect = depth > 0 ? EXPECT_COMMA_OR_CLOSE : EXPECT_END;
+            }
+            i = j;
+            continue;
+        }
+
+        // STEP 5: Separators
+        if (c == ':') {
+            if (expect != EXPECT_COLON) {
+                return JSON_ERROR_INVALID;
+            }
+            expect = EXPECT_VALUE;
+            continue;
+        }
+        if (c == ',') {
+            if (expect != EXPECT_COMMA_OR_CLOSE) {
+                return JSON_ERROR_INVALID;
+            }
+            expect = parent->type == JSON_OBJECT ? EXPECT_KEY : EXPECT_VALUE;
+            continue;
+        }
+
+        // STEP 6: Primitive (number, true, false, null)
+        if (!valueExpected || !(c == '-' || (c >= '0' && c <= '9') ||
+                                c == 't' || c == 'f' || c == 'n')) {
+            return JSON_ERROR_INVALID;
+        }
+        int j = i;
+        while (j < length && !(charClass[bytes[j]] & CC_END)) {
+            if ((charClass[bytes[j]] & CC_STOP) || text[j] == ':') {
+                return JSON_ERROR_INVALID;
+            }
+            j++;
+        }
+        if (newToken(doc, JSON_PRIMITIVE, i, j) < 0) {
+            return JSON_ERROR_NOMEM;
+        }
+        if (parent != NULL && parent->type == JSON_ARRAY) {
+            parent->size++;
+        }
+        expect = depth > 0 ? EXPECT_COMMA_OR_CLOSE : EXPECT_END;
+        i = j - 1;
+    }
+
+    if (depth > 0 || (doc->count > 0 && expect != EXPECT_END)) {
+        return JSON_ERROR_PARTIAL;
+    }
+    if (doc->count == 0) {
+        return JSON_ERROR_INVALID;      // Only whitespace
+    }
+    return doc->count;
+}
+
+
+/*
+================================================================================
+FUNCTION: jsonFind
+================================================================================
+*/
+
+int jsonFind(const JsonDocument *doc, int object, const char *key) {
+    if (object < 0 || object >= doc->count || doc->tokens[object].type != JSON_OBJECT) {
+        return -1;
+    }
+    int keyLength = (int)strlen(key);
+
+    // Keys and values alternate; 'next' skips whatever a value contains
+    int i = object + 1;
+    for (int k = 0; k < doc->tokens[object].size; k++) {
+        const JsonToken *name = &doc->tokens[i];
+        int value = i + 1;
+        if (name->end - name->start == keyLength &&
+            memcmp(doc->text + name->start, key, keyLength) == 0) {
+            return value;
+        }
+        i = doc->tokens[value].next;
+    }
+    return -1;
+}
+
+
+/*
+================================================================================
+FUNCTION: jsonTokenInt
+================================================================================
+*/
+
+int jsonTokenInt(const JsonDocument *doc, int token, long long *value) {
+    if (token < 0 || token >= doc->count || doc->tokens[token].type != JSON_PRIMITIVE) {
+        return 0;
+    }
+    const char *p = doc->text + doc->tokens[token].start;
+    const char *end = doc->text + doc->tokens[token].end;
+
+    if (end - p == 4 && memcmp(p, "true", 4) == 0) {
+        *value = 1;
+        return 1;
+    }
+    if (end - p == 5 && memcmp(p, "false", 5) == 0) {
+        *value = 0;
+        return 1;
+    }
+
+    int negative = 0;
+    if (p < end && *p == '-') {
+        negative = 1;
+        p++;
+    }
+    if (p >= end || *p < '0' || *p > '9') {
+        return 0;       // null, or not a number
+    }
+    long long result = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (result < 1000000000000000000LL) {   // Saturate instead of overflowing
+            result = result * 10 + (*p - '0');
+        }
+        p++;
+    }
+    *value = negative ? -result : result;
+    return 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: jsonTokenString
+================================================================================
+*/
+
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+int jsonTokenString(const JsonDocument *doc, int token, char *value, int valueSize) {
+    if (valueSize <= 0) {
+        return 0;
+    }
+    value[0] = '\0';
+    if (token < 0 || token >= doc->count || doc->tokens[token].type != JSON_STRING) {
+        return 0;
+    }
+
+    const char *p = doc->text + doc->tokens[token].start;
+    const char *end = doc->text + doc->tokens[token].end;
+    int w = 0;
+    while (p < end && w < valueSize - 1) {
+        char c = *p++;
+        if (c == '\\' && p < end) {
+            char e = *p++;
+            switch (e) {
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case 'r': c = '\r'; break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'u': {
+                    int code = 0;
+                    for (int k = 0; k < 4 && p < end; k++, p++) {
+                        int d = hexDigit(*p);
+                        code = code * 16 + (d < 0 ? 0 : d);
+                    }
+                    c = code < 0x80 ? (char)code : '?';
+                    break;
+                }
+                default:  c = e; break;     // \" \\ \/
+            }
+        }
+        value[w++] = c;
+    }
+    value[w] = '\0';
+    return 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: jsonArrayInts
+================================================================================
+*/
+
+int jsonArrayInts(const JsonDocument *doc, int array, int *values, int max) {
+    if (array < 0 || array >= doc->count || doc->tokens[array].type != JSON_ARRAY ||
+        doc->tokens[array].size > max) {
+        return -1;
+    }
+    int i = array + 1;
+    for (int k = 0; k < doc->tokens[array].size; k++) {
+        long long v;
+        if (!jsonTokenInt(doc, i, &v)) {
+            return -1;
+        }
+        values[k] = (int)v;
+        i = doc->tokens[i].next;
+    }
+    return doc->tokens[array].size;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPERS: legacyParseInt / legacyParseString
+--------------------------------------------------------------------------------
+PURPOSE: The strstr() helpers the server used before the tokenizer,
+         unchanged, so the benchmark compares against the real thing
+*/
+
+static int legacyParseInt(const char *json, const char *key) {
+    char pattern[128];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char *pos = strstr(json, pattern);
+    if (pos == NULL) return -1;
+    pos += strlen(pattern);
+    while (*pos == ' ' || *pos == '\t') pos++;
+    return atoi(pos);
+}
+
+static void legacyParseString(const char *json, const char *key, char *value, int valueSize) {
+    value[0] = '\0';
+    char pattern[128];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char *pos = strstr(json, pattern);
+    if (pos == NULL) return;
+    pos += strlen(pattern);
+    while (*pos == ' ' || *pos == '\t') pos++;
+    if (*pos != '"') return;
+    pos++;
+    int i = 0;
+    while (*pos != '"' && *pos != '\0' && i < valueSize - 1) {
+        value[i++] = *pos++;
+    }
+    value[i] = '\0';
+}
+
+
+static long long nowNanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+
+/*
+================================================================================
+FUNCTION: benchmarkJSONParsing
+================================================================================
+ALGORITHM:
+1. One realistic body (the simulate request: 9 numbers, 1 string)
+2. Old way: one snprintf + strstr per field, 'iterations' times
+3. New way: one jsonParse + one jsonFind per field, 'iterations' times
+4. Check both read the same values
+*/
+
+int benchmarkJSONParsing(int iterations, char *buffer, int bufferSize) {
+
+    if (iterations <= 0) {
+        return 0;
+    }
+
+    // STEP 1: The body and its fields
+    static const char body[] =
+        "{\"algorithm\":\"best_fit\",\"buddy\":0,\"total\":8192,\"os\":512,"
+        "\"minSize\":4,\"maxSize\":64,\"interarrival\":10,\"lifetime\":500,"
+        "\"events\":1000000,\"seed\":42}";
+    static const char *intKeys[] = {
+        "buddy", "total", "os", "minSize", "maxSize",
+        "interarrival", "lifetime", "events", "seed"
+    };
+    const int numInts = (int)(sizeof(intKeys) / sizeof(intKeys[0]));
+    const int bodyLength = (int)strlen(body);
+
+    volatile long long sink = 0;     // Keeps the loops from being optimized away
+    long long legacySum = 0, tokenSum = 0;
+    char algorithm[32];
+
+    // STEP 2: strstr() per field
+    long long start = nowNanoseconds();
+    for (int n = 0; n < iterations; n++) {
+        long long sum = 0;
+        for (int k = 0; k < numInts; k++) {
+            sum += legacyParseInt(body, intKeys[k]);
+        }
+        legacyParseString(body, "algorithm", algorithm, sizeof(algorithm));
+        sum += algorithm[0];
+        sink += sum;
+        legacySum = sum;
+    }
+    long long legacyNs = nowNanoseconds() - start;
+
+    // STEP 3: One pass, then lookups
+    static JsonDocument doc;    // 80 KB: kept off the stack
+    int tokens = 0;
+    start = nowNanoseconds();
+    for (int n = 0; n < iterations; n++) {
+        tokens = jsonParse(&doc, body, bodyLength);
+        long long sum = 0;
+        for (int k = 0; k < numInts; k++) {
+            long long v = -1;
+            jsonTokenInt(&doc, jsonFind(&doc, 0, intKeys[k]), &v);
+            sum += v;
+        }
+        jsonTokenString(&doc, jsonFind(&doc, 0, "algorithm"), algorithm, sizeof(algorithm));
+        sum += algorithm[0];
+        sink += sum;
+        tokenSum = sum;
+    }
+    long long tokenNs = nowNanoseconds() - start;
+    (void)sink;
+
+    // STEP 4: Report
+    int fields = numInts + 1;
+    double legacyPerRequest = (double)legacyNs / iterations;
+    double tokenPerRequest = (double)tokenNs / iterations;
+    snprintf(buffer, bufferSize,
+        "{\"iterations\":%d,\"fields\":%d,\"bodyBytes\":%d,"
+        "\"strstr\":{\"nsPerRequest\":%.1f,\"nsPerField\":%.1f},"
+        "\"tokenizer\":{\"nsPerRequest\":%.1f,\"nsPerField\":%.1f,\"tokens\":%d},"
+        "\"speedup\":%.2f,\"sameResults\":%s}",
+        iterations, fields, bodyLength,
+        legacyPerRequest, legacyPerRequest / fields,
+        tokenPerRequest, tokenPerRequest / fields, tokens,
+        tokenPerRequest > 0 ? legacyPerRequest / tokenPerRequest : 0.0,
+        legacySum == tokenSum ? "true" : "false");
+    return 1;
+}
+
+
+/*
+================================================================================
+END OF FILE: json_tokenizer.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. jsonParse() - One pass, flat token array, bounded by the given length
+2. jsonFind() - Key lookup within one object, skipping subtrees via 'next'
+3. jsonTokenInt() / jsonTokenString() / jsonArrayInts() - Value readers
+4. benchmarkJSONParsing() - Old strstr() helpers vs the tokenizer
+================================================================================
+*/
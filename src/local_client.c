@@ -0,0 +1,627 @@
+/*
+================================================================================
+FILE: local_client.c
+PURPOSE: Implement the binary protocol client and its benchmark
+================================================================================
+*/
+
+#include <stdio.h>          // printf, fprintf
+#include <string.h>         // memset, memcpy, strlen
+#include <unistd.h>         // read, write, close
+#include <errno.h>          // errno, EINTR
+#include <fcntl.h>          // O_RDWR
+#include <time.h>           // clock_gettime
+#include <sys/socket.h>     // socket, connect
+#include <sys/un.h>         // sockaddr_un
+#include <netdb.h>          // getaddrinfo
+#include <netinet/in.h>     // IPPROTO_TCP
+#include <netinet/tcp.h>    // TCP_NODELAY
+#include <sys/mman.h>       // shm_open, shm_unlink, mmap, munmap
+#include "../include/local_client.h"
+#include "../include/memory_manager.h"     // FIRST_FIT
+
+// macOS has no MSG_NOSIGNAL; there the socket itself gets SO_NOSIGPIPE
+// (noSigpipe), so a server that went away is an error, not a SIGPIPE
+// that kills the program using this client
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+
+// Requests per localCall() in the batched benchmark runs
+#define BENCH_BATCH 64
+
+
+/*
+--------------------------------------------------------------------------------
+HELPERS: writeAll / readAll
+--------------------------------------------------------------------------------
+PURPOSE: Move exactly 'length' bytes (short transfers are retried)
+
+RETURNS: 0, or -1 on error / end of stream
+*/
+
+static int writeAll(int fd, const void *data, size_t length) {
+    const char *p = (const char*)data;
+    while (length > 0) {
+        ssize_t n = send(fd, p, length, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return -1;
+        }
+        p += n;
+        length -= (size_t)n;
+    }
+    return 0;
+}
+
+static int readAll(int fd, void *data, size_t length) {
+    char *p = (char*)data;
+    while (length > 0) {
+        ssize_t n = read(fd, p, length);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return -1;
+        }
+        p += n;
+        length -= (size_t)n;
+    }
+    return 0;
+}
+
+
+// Writes to a closed socket fail with EPIPE instead of raising SIGPIPE
+// (where the flag exists; Linux uses MSG_NOSIGNAL per send instead)
+static void noSigpipe(int fd) {
+#ifdef SO_NOSIGPIPE
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#else
+    (void)fd;
+#endif
+}
+
+
+/*
+================================================================================
+FUNCTION: localConnect / localDisconnect
+================================================================================
+*/
+
+int localConnect(LocalConnection *conn, const char *path) {
+
+    memset(conn, 0, sizeof(*conn));
+    conn->fd = -1;
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    memcpy(address.sun_path, path, strlen(path) + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    noSigpipe(fd);
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    conn->fd = fd;
+    return 0;
+}
+
+int localConnectTcp(LocalConnection *conn, const char *host, int port) {
+
+    memset(conn, 0, sizeof(*conn));
+    conn->fd = -1;
+
+    char service[16];
+    snprintf(service, sizeof(service), "%d", port);
+    struct addrinfo hints;
+    struct addrinfo *found;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host, service, &hints, &found) != 0) {
+        return -1;
+    }
+    for (struct addrinfo *a = found; a != NULL && conn->fd < 0; a = a->ai_next) {
+        int fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        noSigpipe(fd);
+        if (connect(fd, a->ai_addr, a->ai_addrlen) < 0) {
+            close(fd);
+            continue;
+        }
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        conn->fd = fd;
+    }
+    freeaddrinfo(found);
+    return conn->fd >= 0 ? 0 : -1;
+}
+
+void localDisconnect(LocalConnection *conn) {
+    if (conn->ring != NULL) {
+        munmap(conn->ring, sizeof(LocalRingShared));
+        conn->ring = NULL;
+    }
+    if (conn->fd >= 0) {
+        close(conn->fd);
+        conn->fd = -1;
+    }
+}
+
+
+/*
+================================================================================
+FUNCTION: localAttachRing
+================================================================================
+ALGORITHM:
+1. ATTACH_RING over the socket; the answer names the shared memory object
+2. Map it, then remove the name: the mapping stays, and nothing is left
+   in /dev/shm if either side dies
+*/
+
+int localAttachRing(LocalConnection *conn) {
+
+    // STEP 1: Ask
+    LocalRequest request = { sizeof(LocalRequest), LOCAL_OP_ATTACH_RING, 0, conn->nextId++, 0 };
+    LocalAttachResponse answer;
+    if (writeAll(conn->fd, &request, sizeof(request)) < 0 ||
+        readAll(conn->fd, &answer, sizeof(answer)) < 0 ||
+        answer.response.status != LOCAL_STATUS_OK) {
+        return -1;
+    }
+    answer.name[sizeof(answer.name) - 1] = '\0';
+
+    // STEP 2: Map
+    int fd = shm_open(answer.name, O_RDWR, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    void *region = mmap(NULL, sizeof(LocalRingShared), PROT_READ | PROT_WRITE,
+                        MAP_SHARED, fd, 0);
+    close(fd);
+    shm_unlink(answer.name);
+    if (region == MAP_FAILED) {
+        return -1;
+    }
+    if (((LocalRingShared*)region)->magic != LOCAL_RING_MAGIC) {
+        munmap(region, sizeof(LocalRingShared));
+        return -1;
+    }
+    conn->ring = (LocalRingShared*)region;
+    conn->requestTail = 0;
+    conn->responseHead = 0;
+    return 0;
+}
+
+
+/*
+================================================================================
+FUNCTION: localCall
+================================================================================
+SOCKET: one write of all requests (at most LOCAL_RING_SLOTS at a time,
+so neither side's socket buffer can fill up while the other is still
+writing), then read the fixed-size responses.
+
+RING: push requests while fewer than LOCAL_RING_SLOTS are unanswered,
+publish the tail once, take whatever responses are ready, repeat.
+*/
+
+int localCall(LocalConnection *conn, LocalRequest *requests, int count,
+              LocalResponse *responses) {
+
+    for (int i = 0; i < count; i++) {
+        requests[i].length = sizeof(LocalRequest);
+        requests[i].id = conn->nextId++;
+    }
+
+    // Socket
+    if (conn->ring == NULL) {
+        if (conn->submitted != conn->received) {
+            return -1;      // Those answers would come first
+        }
+        for (int done = 0; done < count; ) {
+            int n = count - done < LOCAL_RING_SLOTS ? count - done : LOCAL_RING_SLOTS;
+            if (writeAll(conn->fd, requests + done, n * sizeof(LocalRequest)) < 0 ||
+                readAll(conn->fd, responses + done, n * sizeof(LocalResponse)) < 0) {
+                return -1;
+            }
+            done += n;
+        }
+        return 0;
+    }
+
+    // Ring
+    LocalRingShared *ring = conn->ring;
+    int sent = 0;
+    int received = 0;
+    while (received < count) {
+        uint32_t tail = conn->requestTail;
+        while (sent < count && tail - conn->responseHead < LOCAL_RING_SLOTS) {
+            ring->request[tail % LOCAL_RING_SLOTS] = requests[sent++];
+            tail++;
+        }
+        if (tail != conn->requestTail) {
+            conn->requestTail = tail;
+            localQueueNotify(&ring->requests, tail);
+        }
+
+        uint32_t head = conn->responseHead;
+        uint32_t ready = localQueueAwait(&ring->responses, head, &ring->closed);
+        if (ready == head) {
+            return -1;      // Server let go of the ring
+        }
+        while (head != ready) {
+            responses[received++] = ring->response[head % LOCAL_RING_SLOTS];
+            head++;
+        }
+        conn->responseHead = head;
+        __atomic_store_n(&ring->responses.head, head, __ATOMIC_RELEASE);
+    }
+    return 0;
+}
+
+
+/*
+================================================================================
+FUNCTION: localSubmit / localFlush / localReceive
+================================================================================
+WINDOW: every request in flight reserves the longest answer it can get
+(answerBound). A request that would take the total past
+LOCAL_CLIENT_WINDOW waits until earlier answers were received, so the
+server's answers never fill both socket buffers while we are still
+writing requests.
+
+RECEIVE: read as much as has arrived into 'in' (many answers per
+read()), hand out one answer per call.
+*/
+
+// The longest answer 'request' can get
+static uint32_t answerBound(const LocalRequest *request) {
+    int count = request->arg < 0 ? 0 :
+                request->arg > LOCAL_MAX_BATCH ? LOCAL_MAX_BATCH : request->arg;
+    switch (request->op) {
+    case LOCAL_OP_ALLOCATE_BATCH:
+        return sizeof(LocalResponse) + count * sizeof(LocalBatchEntry);
+    case LOCAL_OP_DEALLOCATE_BATCH:
+        return sizeof(LocalResponse) + count * sizeof(int32_t);
+    case LOCAL_OP_STATS:
+        return sizeof(LocalResponse) + sizeof(ShmExportCounters);
+    case LOCAL_OP_BLOCK_RANGE:
+        return LOCAL_MAX_RESPONSE;
+    case LOCAL_OP_ATTACH_RING:
+        return sizeof(LocalAttachResponse);
+    default:
+        return sizeof(LocalResponse);
+    }
+}
+
+int localSubmit(LocalConnection *conn, LocalRequest *request,
+                const void *payload, int payloadBytes) {
+
+    uint32_t length = sizeof(LocalRequest) + payloadBytes;
+    if (payloadBytes < 0 || length > LOCAL_MAX_MESSAGE) {
+        return -1;
+    }
+    uint32_t bound = answerBound(request);
+    if (conn->submitted - conn->received == LOCAL_RING_SLOTS ||
+        conn->owed + bound > LOCAL_CLIENT_WINDOW) {
+        return 1;
+    }
+    if (conn->outFilled + (int)length > LOCAL_CLIENT_BUFFER && localFlush(conn) < 0) {
+        return -1;
+    }
+
+    request->length = length;
+    request->id = conn->nextId++;
+    memcpy(conn->out + conn->outFilled, request, sizeof(LocalRequest));
+    if (payloadBytes > 0) {
+        memcpy(conn->out + conn->outFilled + sizeof(LocalRequest), payload, payloadBytes);
+    }
+    conn->outFilled += length;
+    conn->bound[conn->submitted % LOCAL_RING_SLOTS] = bound;
+    conn->owed += bound;
+    conn->submitted++;
+    return 0;
+}
+
+int localFlush(LocalConnection *conn) {
+    if (conn->outFilled > 0 && writeAll(conn->fd, conn->out, conn->outFilled) < 0) {
+        return -1;
+    }
+    conn->outFilled = 0;
+    return 0;
+}
+
+int localReceive(LocalConnection *conn, LocalResponse *response,
+                 void *payload, int maxPayload) {
+
+    if (conn->submitted == conn->received || localFlush(conn) < 0) {
+        return -1;
+    }
+
+    // STEP 1: A whole answer in 'in'
+    uint32_t length = 0;
+    while (1) {
+        int available = conn->inFilled - conn->inStart;
+        if (available >= (int)sizeof(LocalResponse)) {
+            memcpy(&length, conn->in + conn->inStart, sizeof(length));
+            if (length < sizeof(LocalResponse) || length > LOCAL_MAX_RESPONSE) {
+                return -1;      // Not an answer of this protocol
+            }
+            if (available >= (int)length) {
+                break;
+            }
+        }
+        if (conn->inStart > 0) {
+            memmove(conn->in, conn->in + conn->inStart, available);
+            conn->inStart = 0;
+            conn->inFilled = available;
+        }
+        ssize_t n = read(conn->fd, conn->in + conn->inFilled,
+                         LOCAL_CLIENT_BUFFER - conn->inFilled);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return -1;
+        }
+        conn->inFilled += (int)n;
+    }
+
+    // STEP 2: Hand it out
+    const char *answer = conn->in + conn->inStart;
+    int payloadBytes = (int)(length - sizeof(LocalResponse));
+    memcpy(response, answer, sizeof(LocalResponse));
+    if (payload != NULL && maxPayload > 0) {
+        memcpy(payload, answer + sizeof(LocalResponse),
+               payloadBytes < maxPayload ? payloadBytes : maxPayload);
+    }
+    conn->inStart += length;
+    conn->owed -= conn->bound[conn->received % LOCAL_RING_SLOTS];
+    conn->received++;
+    return payloadBytes;
+}
+
+
+/*
+================================================================================
+FUNCTION: localAllocateBatch / localDeallocateBatch / localStats /
+          localBlockRange
+================================================================================
+*/
+
+// Submit one request, receive its answer. RETURNS: payload size, or -1
+static int roundTrip(LocalConnection *conn, LocalRequest *request,
+                     const void *payload, int payloadBytes,
+                     LocalResponse *response, void *answer, int maxAnswer) {
+    if (conn->submitted != conn->received ||
+        localSubmit(conn, request, payload, payloadBytes) != 0) {
+        return -1;
+    }
+    return localReceive(conn, response, answer, maxAnswer);
+}
+
+int localAllocateBatch(LocalConnection *conn, const int32_t *sizes, int count,
+                       int algorithm, LocalBatchEntry *entries) {
+    LocalRequest request = { 0, LOCAL_OP_ALLOCATE_BATCH, (uint16_t)algorithm, 0, count };
+    LocalResponse response;
+    if (count <= 0 || count > LOCAL_MAX_BATCH ||
+        roundTrip(conn, &request, sizes, count * sizeof(int32_t), &response,
+                  entries, count * sizeof(LocalBatchEntry)) < 0 ||
+        response.status == LOCAL_STATUS_BAD_REQUEST) {
+        return -1;
+    }
+    return response.processId;
+}
+
+int localDeallocateBatch(LocalConnection *conn, const int32_t *processIds, int count,
+                         int32_t *statuses) {
+    LocalRequest request = { 0, LOCAL_OP_DEALLOCATE_BATCH, 0, 0, count };
+    LocalResponse response;
+    if (count <= 0 || count > LOCAL_MAX_BATCH ||
+        roundTrip(conn, &request, processIds, count * sizeof(int32_t), &response,
+                  statuses, statuses != NULL ? count * sizeof(int32_t) : 0) < 0 ||
+        response.status == LOCAL_STATUS_BAD_REQUEST) {
+        return -1;
+    }
+    return response.processId;
+}
+
+int localStats(LocalConnection *conn, ShmExportCounters *counters) {
+    LocalRequest request = { 0, LOCAL_OP_STATS, 0, 0, 0 };
+    LocalResponse response;
+    int bytes = roundTrip(conn, &request, NULL, 0, &response, counters, sizeof(*counters));
+    return bytes == (int)sizeof(*counters) ? 0 : -1;
+}
+
+int localBlockRange(LocalConnection *conn, int from, int to,
+                    ShmExportBlock *rows, int maxRows, int *next) {
+    LocalRequest request = { 0, LOCAL_OP_BLOCK_RANGE, 0, 0, from };
+    LocalResponse response;
+    int32_t end = to;
+    int bytes = roundTrip(conn, &request, &end, to >= 0 ? sizeof(end) : 0, &response,
+                          rows, maxRows * sizeof(ShmExportBlock));
+    if (bytes < 0) {
+        return -1;
+    }
+    int count = response.processId < maxRows ? response.processId : maxRows;
+    // Rows cut off here (maxRows too small) are asked for again
+    if (count == response.processId) {
+        *next = response.startAddress;
+    } else {
+        *next = count > 0 ? rows[count - 1].startAddress + rows[count - 1].size : from;
+    }
+    return count;
+}
+
+
+/*
+================================================================================
+FUNCTION: localBenchmark
+================================================================================
+PURPOSE: ns per operation over each path
+
+Each pair is "allocate 1 KB first fit" then "free that PID", so the
+heap stays small and every run measures the same work; what differs
+between the rows is only the transport and the batching ("batch
+messages": one ALLOCATE_BATCH and one DEALLOCATE_BATCH per 64 pairs).
+*/
+
+static double nowSeconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// Seconds for 'pairs' pairs as batch messages of 'batch'; -1 on error
+static double runBatchMessages(LocalConnection *conn, int pairs, int batch) {
+    int32_t values[BENCH_BATCH];
+    LocalBatchEntry entries[BENCH_BATCH];
+    double start = nowSeconds();
+
+    for (int done = 0; done < pairs; ) {
+        int n = pairs - done < batch ? pairs - done : batch;
+        for (int i = 0; i < n; i++) {
+            values[i] = 1;
+        }
+        if (localAllocateBatch(conn, values, n, FIRST_FIT, entries) < 0) {
+            return -1;
+        }
+        for (int i = 0; i < n; i++) {
+            values[i] = entries[i].processId;
+        }
+        if (localDeallocateBatch(conn, values, n, NULL) < 0) {
+            return -1;
+        }
+        done += n;
+    }
+    return nowSeconds() - start;
+}
+
+// Seconds for 'pairs' pairs, 'batch' requests per localCall() (negative:
+// batch messages of -batch); -1 on error
+static double runPairs(LocalConnection *conn, int pairs, int batch) {
+    LocalRequest requests[BENCH_BATCH];
+    LocalResponse responses[BENCH_BATCH];
+    if (batch < 0) {
+        return runBatchMessages(conn, pairs, -batch);
+    }
+    double start = nowSeconds();
+
+    for (int done = 0; done < pairs; ) {
+        int n = pairs - done < batch ? pairs - done : batch;
+        for (int i = 0; i < n; i++) {
+            requests[i].op = LOCAL_OP_ALLOCATE;
+            requests[i].flags = FIRST_FIT;
+            requests[i].arg = 1;
+        }
+        if (localCall(conn, requests, n, responses) < 0) {
+            return -1;
+        }
+        for (int i = 0; i < n; i++) {
+            requests[i].op = LOCAL_OP_DEALLOCATE;
+            requests[i].flags = 0;
+            requests[i].arg = responses[i].processId;
+        }
+        if (localCall(conn, requests, n, responses) < 0) {
+            return -1;
+        }
+        done += n;
+    }
+    return nowSeconds() - start;
+}
+
+static int benchRow(LocalConnection *conn, const char *label, int pairs, int batch) {
+    if (runPairs(conn, pairs / 10 + 1, batch) < 0) {       // Warm-up
+        return -1;
+    }
+    double seconds = runPairs(conn, pairs, batch);
+    if (seconds < 0) {
+        return -1;
+    }
+    double operations = 2.0 * pairs;
+    printf("  %-28s %9.0f ns/op %12.0f ops/s\n",
+           label, seconds * 1e9 / operations, operations / seconds);
+    return 0;
+}
+
+int localBenchmark(const char *path, int port, int pairs) {
+
+    // 130 KB of buffers: not for the stack
+    static LocalConnection conn;
+    if (port > 0 ? localConnectTcp(&conn, "127.0.0.1", port) < 0
+                 : localConnect(&conn, path) < 0) {
+        if (port > 0) {
+            fprintf(stderr, "Error: No server on port %d (start one with --server --rpc)\n",
+                    port);
+        } else {
+            fprintf(stderr, "Error: No server on %s (start one with --server --local)\n",
+                    path);
+        }
+        return 1;
+    }
+
+    const char *socketName = port > 0 ? "tcp" : "socket";
+    char label[3][40];
+    snprintf(label[0], sizeof(label[0]), "%s, one at a time", socketName);
+    snprintf(label[1], sizeof(label[1]), "%s, batches of 64", socketName);
+    snprintf(label[2], sizeof(label[2]), "%s, batch messages of 64", socketName);
+    if (port > 0) {
+        printf("Binary RPC: %d allocate + free pairs against 127.0.0.1:%d\n", pairs, port);
+    } else {
+        printf("Local transport: %d allocate + free pairs against %s\n", pairs, path);
+    }
+    int failed = benchRow(&conn, label[0], pairs, 1) < 0 ||
+                 benchRow(&conn, label[1], pairs, BENCH_BATCH) < 0 ||
+                 benchRow(&conn, label[2], pairs, -BENCH_BATCH) < 0;
+
+    // The ring is a same-machine shortcut of the Unix socket
+    int ringWanted = !failed && port <= 0;
+    if (ringWanted && localAttachRing(&conn) == 0) {
+        failed = benchRow(&conn, "ring, one at a time", pairs, 1) < 0 ||
+                 benchRow(&conn, "ring, batches of 64", pairs, BENCH_BATCH) < 0;
+    } else if (ringWanted) {
+        fprintf(stderr, "Warning: The server gave no ring; socket only\n");
+    }
+
+    localDisconnect(&conn);
+    if (failed) {
+        fprintf(stderr, "Error: Server went away during the benchmark\n");
+        return 1;
+    }
+    return 0;
+}
+
+
+/*
+================================================================================
+END OF FILE: local_client.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. writeAll() / readAll() / noSigpipe() - Whole-buffer socket I/O, no SIGPIPE
+2. localConnect() / localConnectTcp() / localDisconnect() - Unix socket
+   or TCP, ring unmapped
+3. localAttachRing() - ATTACH_RING, map the object, remove its name
+4. localCall() - Batched requests over the socket or the ring
+5. localSubmit() / localFlush() / localReceive() - Pipelined requests of
+   any operation, answer bytes kept within a window
+6. localAllocateBatch() / localDeallocateBatch() / localStats() /
+   localBlockRange() - One round trip each
+7. localBenchmark() - ns/op per transport, single, pipelined, batch messages
+================================================================================
+*/
@@ -0,0 +1,783 @@
+/*
+================================================================================
+FILE: local_transport.c
+PURPOSE: Serve binary clients over a Unix socket, TCP and shared-memory rings
+DESCRIPTION:
+    - One listener thread per socket accepts; every client gets a thread
+      that reads whatever has arrived, answers every complete message
+      under one state-lock acquisition and writes all the answers at
+      once (a Unix client and a TCP client are served the same way)
+    - ATTACH_RING creates a shared memory object (shm_open), hands its
+      name to the client and starts a thread that polls the ring; when
+      the socket closes the ring thread is stopped and the object removed
+    - localQueueAwait() / localQueueNotify() are the wait and wake halves
+      both processes use on a ring queue (spin, then futex; a short
+      sleep-and-look-again where there is no futex)
+================================================================================
+*/
+
+#include <stdio.h>          // snprintf, fprintf, perror
+#include <stdlib.h>         // malloc, free
+#include <string.h>         // memcpy, memset, strlen
+#include <unistd.h>         // read, close, unlink, getpid, ftruncate, sysconf
+#include <errno.h>          // errno, EINTR
+#include <fcntl.h>          // O_CREAT, O_EXCL, O_RDWR
+#include <pthread.h>        // pthread_create, pthread_join
+#include <time.h>           // struct timespec, nanosleep
+#include <sys/socket.h>     // socket, bind, listen, accept, send
+#include <sys/un.h>         // sockaddr_un
+#include <netinet/in.h>     // sockaddr_in, INADDR_ANY, IPPROTO_TCP
+#include <netinet/tcp.h>    // TCP_NODELAY
+#include <arpa/inet.h>      // htons
+#include <sys/mman.h>       // shm_open, shm_unlink, mmap, munmap
+#ifdef __linux__
+#include <sys/syscall.h>    // syscall, SYS_futex
+#include <linux/futex.h>    // FUTEX_WAIT, FUTEX_WAKE
+#endif
+#include "../include/local_transport.h"
+#include "../include/operations.h"
+#include "../include/http_server.h"
+#include "../include/logger.h"
+
+// macOS has no MSG_NOSIGNAL. The local transport only runs inside the
+// server, which ignores SIGPIPE (startServer), so 0 loses nothing.
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+
+// Empty polls before a consumer goes to sleep (some tens of microseconds;
+// none on a single CPU, where spinning only delays the producer)
+#define LOCAL_SPIN_POLLS 20000
+
+// A sleeping consumer looks at 'closed' at least this often
+#define LOCAL_SLEEP_NS (100 * 1000000L)
+
+// Without a futex nobody can wake a sleeper: it looks again this often
+#define LOCAL_POLL_SLEEP_NS (50 * 1000L)
+
+// Bytes read at once (at least one LOCAL_MAX_MESSAGE). 'out' is sent
+// whenever the next answer might not fit, so it needs room for a few
+// LOCAL_MAX_RESPONSE answers and for many small ones
+#define LOCAL_READ_BUFFER  (LOCAL_RING_SLOTS * sizeof(LocalRequest))
+#define LOCAL_WRITE_BUFFER (64 * 1024)
+
+
+/*
+================================================================================
+STRUCTURE: LocalClient
+================================================================================
+PURPOSE: One connected client: its socket buffers and, once attached,
+         its ring and the thread serving it
+*/
+
+typedef struct {
+    int              fd;
+    MemoryManager   *mm;
+    LocalRingShared *ring;          // NULL until ATTACH_RING
+    pthread_t        ringThread;
+    char             ringName[48];
+    char             in[LOCAL_READ_BUFFER];
+    char             out[LOCAL_WRITE_BUFFER];
+} LocalClient;
+
+static unsigned int ringsCreated = 0;
+static int spinPolls = -1;      // LOCAL_SPIN_POLLS or 0, decided once
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: cpuRelax
+--------------------------------------------------------------------------------
+PURPOSE: Tell the core we are spinning (frees the pipeline for the other
+         hyper-thread and saves power while polling)
+*/
+
+static inline void cpuRelax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPERS: waitOnWord / wakeWord
+--------------------------------------------------------------------------------
+PURPOSE: Sleep while *word still holds 'expected' / wake one such sleeper
+
+Linux: a futex (not FUTEX_PRIVATE: the two sides are different
+processes), at most LOCAL_SLEEP_NS. Elsewhere (macOS has no public
+futex): sleep LOCAL_POLL_SLEEP_NS and let the caller look again; the
+wake is then a no-op. Both may return early, callers always re-check.
+*/
+
+static void waitOnWord(uint32_t *word, uint32_t expected) {
+#ifdef __linux__
+    struct timespec timeout = { 0, LOCAL_SLEEP_NS };
+    syscall(SYS_futex, word, FUTEX_WAIT, expected, &timeout, NULL, 0);
+#else
+    (void)word;
+    (void)expected;
+    struct timespec pause = { 0, LOCAL_POLL_SLEEP_NS };
+    nanosleep(&pause, NULL);
+#endif
+}
+
+static void wakeWord(uint32_t *word) {
+#ifdef __linux__
+    syscall(SYS_futex, word, FUTEX_WAKE, 1, NULL, NULL, 0);
+#else
+    (void)word;
+#endif
+}
+
+
+/*
+================================================================================
+FUNCTION: localQueueAwait / localQueueNotify
+================================================================================
+ALGORITHM (await):
+1. Poll 'tail' up to LOCAL_SPIN_POLLS times: at full rate the next
+   message is already there and no system call is made (with one CPU
+   the producer cannot run while we poll, so go straight to step 2)
+2. Announce 'sleeping', look once more (the producer checks 'sleeping'
+   only AFTER moving tail, so one of the two sees the other), then
+   wait for 'tail' to change from 'head' (waitOnWord)
+*/
+
+uint32_t localQueueAwait(LocalQueueIndex *queue, uint32_t head, const uint32_t *closed) {
+
+    if (spinPolls < 0) {
+        spinPolls = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? LOCAL_SPIN_POLLS : 0;
+    }
+    int spins = 0;
+    while (1) {
+        // STEP 1: Poll
+        uint32_t tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+        if (tail != head || __atomic_load_n(closed, __ATOMIC_ACQUIRE)) {
+            return tail;
+        }
+        if (spins++ < spinPolls) {
+            cpuRelax();
+            continue;
+        }
+
+        // STEP 2: Sleep until the producer moves tail
+        __atomic_store_n(&queue->sleeping, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&queue->tail, __ATOMIC_SEQ_CST) == head &&
+            !__atomic_load_n(closed, __ATOMIC_ACQUIRE)) {
+            waitOnWord(&queue->tail, head);
+        }
+        __atomic_store_n(&queue->sleeping, 0, __ATOMIC_RELAXED);
+        spins = 0;
+    }
+}
+
+void localQueueNotify(LocalQueueIndex *queue, uint32_t tail) {
+    __atomic_store_n(&queue->tail, tail, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&queue->sleeping, __ATOMIC_SEQ_CST)) {
+        wakeWord(&queue->tail);
+    }
+}
+
+
+/*
+================================================================================
+FUNCTION: localExecute
+================================================================================
+PURPOSE: One request → the shared operations → one response
+*/
+
+int localExecute(MemoryManager *mm, const LocalRequest *request, LocalResponse *response) {
+
+    int changed = 0;
+    int processID = 0;
+    int result;
+
+    response->length = sizeof(LocalResponse);
+    response->op = request->op;
+    response->id = request->id;
+    response->status = LOCAL_STATUS_OK;
+    response->processId = 0;
+    response->startAddress = -1;
+
+    switch (request->op) {
+
+    case LOCAL_OP_ALLOCATE:
+        if (request->arg <= 0 || request->flags > WORST_FIT) {
+            response->status = LOCAL_STATUS_BAD_REQUEST;
+            break;
+        }
+        result = opAllocate(mm, request->arg, (AllocationAlgorithm)request->flags, &processID);
+        response->processId = processID;
+        response->startAddress = result;
+        response->status = result >= 0 ? LOCAL_STATUS_OK : LOCAL_STATUS_NO_ROOM;
+        changed = result >= 0;
+        break;
+
+    case LOCAL_OP_DEALLOCATE:
+        result = opDeallocate(mm, request->arg);
+        response->processId = request->arg;
+        response->status = result > 0 ? LOCAL_STATUS_OK :
+                           result < 0 ? LOCAL_STATUS_SLAB : LOCAL_STATUS_NOT_FOUND;
+        changed = result > 0;
+        break;
+
+    case LOCAL_OP_COMPACT:
+        changed = compact(mm, NULL, 0);
+        response->status = changed ? LOCAL_STATUS_OK : LOCAL_STATUS_FAILED;
+        break;
+
+    default:
+        // ATTACH_RING is handled by the socket thread; the payload
+        // operations cannot be sent on a ring (no room in a slot)
+        response->status = LOCAL_STATUS_BAD_REQUEST;
+        break;
+    }
+
+    response->freeKB = mm->freeMemory;
+    return changed;
+}
+
+
+/*
+================================================================================
+FUNCTION: answerMessage
+================================================================================
+PURPOSE: One socket message (any op but ATTACH_RING) → its whole answer
+
+The payload is copied out with memcpy: a message can start anywhere in
+the read buffer. Batches are checked completely before the first entry
+runs, so a BAD_REQUEST never leaves half a batch done.
+
+RETURNS: Bytes written to 'out' (at most LOCAL_MAX_RESPONSE);
+         '*operations' grows by the operations that changed mm
+*/
+
+static int answerMessage(MemoryManager *mm, const char *message, uint32_t length,
+                         char *out, int *operations) {
+
+    LocalRequest request;
+    memcpy(&request, message, sizeof(request));
+    const char *payload = message + sizeof(LocalRequest);
+    uint32_t payloadBytes = length - sizeof(LocalRequest);
+    char *body = out + sizeof(LocalResponse);
+
+    LocalResponse response;
+    response.length = sizeof(LocalResponse);
+    response.op = request.op;
+    response.id = request.id;
+    response.status = LOCAL_STATUS_OK;
+    response.processId = 0;
+    response.startAddress = -1;
+
+    int32_t value;
+    int count = request.arg;
+    int done = 0;
+
+    switch (request.op) {
+
+    case LOCAL_OP_ALLOCATE_BATCH:
+        // STEP 1: n sizes, all positive, and a known algorithm
+        if (count <= 0 || count > LOCAL_MAX_BATCH ||
+            payloadBytes != (uint32_t)count * sizeof(int32_t) || request.flags > WORST_FIT) {
+            response.status = LOCAL_STATUS_BAD_REQUEST;
+            break;
+        }
+        for (int i = 0; i < count; i++) {
+            memcpy(&value, payload + i * sizeof(int32_t), sizeof(value));
+            if (value <= 0) {
+                response.status = LOCAL_STATUS_BAD_REQUEST;
+                break;
+            }
+        }
+        if (response.status != LOCAL_STATUS_OK) {
+            break;
+        }
+
+        // STEP 2: Place them in order
+        for (int i = 0; i < count; i++) {
+            LocalBatchEntry entry;
+            int processID = 0;
+            memcpy(&value, payload + i * sizeof(int32_t), sizeof(value));
+            entry.startAddress = opAllocate(mm, value, (AllocationAlgorithm)request.flags,
+                                            &processID);
+            entry.processId = processID;
+            done += entry.startAddress >= 0;
+            memcpy(body + i * sizeof(entry), &entry, sizeof(entry));
+        }
+        response.length += count * sizeof(LocalBatchEntry);
+        response.processId = done;
+        response.status = done == count ? LOCAL_STATUS_OK : LOCAL_STATUS_NO_ROOM;
+        *operations += done;
+        break;
+
+    case LOCAL_OP_DEALLOCATE_BATCH:
+        if (count <= 0 || count > LOCAL_MAX_BATCH ||
+            payloadBytes != (uint32_t)count * sizeof(int32_t)) {
+            response.status = LOCAL_STATUS_BAD_REQUEST;
+            break;
+        }
+        for (int i = 0; i < count; i++) {
+            memcpy(&value, payload + i * sizeof(int32_t), sizeof(value));
+            int result = opDeallocate(mm, value);
+            int32_t status = result > 0 ? LOCAL_STATUS_OK :
+                             result < 0 ? LOCAL_STATUS_SLAB : LOCAL_STATUS_NOT_FOUND;
+            done += result > 0;
+            memcpy(body + i * sizeof(status), &status, sizeof(status));
+        }
+        response.length += count * sizeof(int32_t);
+        response.processId = done;
+        response.status = done == count ? LOCAL_STATUS_OK : LOCAL_STATUS_NOT_FOUND;
+        *operations += done;
+        break;
+
+    case LOCAL_OP_STATS: {
+        ShmExportCounters counters;
+        shmExportCounters(mm, &counters);
+        memcpy(body, &counters, sizeof(counters));
+        response.length += sizeof(counters);
+        break;
+    }
+
+    case LOCAL_OP_BLOCK_RANGE: {
+        int to = mm->totalMemory;
+        if (payloadBytes >= sizeof(int32_t)) {
+            memcpy(&to, payload, sizeof(to));
+        }
+        ShmExportBlock rows[LOCAL_MAX_RANGE_ROWS];
+        int next;
+        int found = shmExportRange(mm, request.arg, to, rows, LOCAL_MAX_RANGE_ROWS, &next);
+        memcpy(body, rows, found * sizeof(ShmExportBlock));
+        response.length += found * sizeof(ShmExportBlock);
+        response.processId = found;
+        response.startAddress = next;
+        break;
+    }
+
+    default:
+        // The single-entry operations, exactly as on a ring
+        *operations += localExecute(mm, &request, &response);
+        memcpy(out, &response, sizeof(response));
+        return sizeof(response);
+    }
+
+    response.freeKB = mm->freeMemory;
+    memcpy(out, &response, sizeof(response));
+    return (int)response.length;
+}
+
+
+/*
+================================================================================
+FUNCTION: ringThread
+================================================================================
+PURPOSE: Serve one client's ring until the client is gone
+
+ALGORITHM:
+1. Wait for requests past 'head'
+2. Answer all of them under one lock acquisition, straight into the
+   response slots (stop early if the client let the responses pile up)
+3. Hand the request slots back, publish the responses
+*/
+
+static void* ringThread(void *arg) {
+
+    LocalClient *client = (LocalClient*)arg;
+    LocalRingShared *ring = client->ring;
+    uint32_t head = 0;
+    uint32_t responseTail = 0;
+
+    while (1) {
+        // STEP 1: Wait
+        uint32_t tail = localQueueAwait(&ring->requests, head, &ring->closed);
+        if (tail == head) {
+            break;      // Closed
+        }
+
+        // STEP 2: Answer
+        int changed = 0;
+        serverLockState();
+        while (head != tail &&
+               responseTail - __atomic_load_n(&ring->responses.head, __ATOMIC_ACQUIRE)
+                   < LOCAL_RING_SLOTS) {
+            changed += localExecute(client->mm, &ring->request[head % LOCAL_RING_SLOTS],
+                                    &ring->response[responseTail % LOCAL_RING_SLOTS]);
+            head++;
+            responseTail++;
+        }
+        serverUnlockState(client->mm, changed);
+
+        // STEP 3: Publish
+        __atomic_store_n(&ring->requests.head, head, __ATOMIC_RELEASE);
+        localQueueNotify(&ring->responses, responseTail);
+    }
+    return NULL;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPERS: attachRing / detachRing
+--------------------------------------------------------------------------------
+PURPOSE: Create a client's ring and its thread / stop and remove them
+*/
+
+static int attachRing(LocalClient *client) {
+
+    if (client->ring != NULL) {
+        return 0;       // One ring per connection
+    }
+
+    snprintf(client->ringName, sizeof(client->ringName), "/memory_visualizer-%d-%u",
+             (int)getpid(), __atomic_fetch_add(&ringsCreated, 1, __ATOMIC_RELAXED));
+    int fd = shm_open(client->ringName, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        LOG_WARN("[LOCAL] shm_open %s failed\n", client->ringName);
+        return 0;
+    }
+    void *region = MAP_FAILED;
+    if (ftruncate(fd, sizeof(LocalRingShared)) == 0) {
+        region = mmap(NULL, sizeof(LocalRingShared), PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (region == MAP_FAILED) {
+        shm_unlink(client->ringName);
+        return 0;
+    }
+
+    LocalRingShared *ring = (LocalRingShared*)region;
+    memset(ring, 0, sizeof(LocalRingShared));
+    ring->magic = LOCAL_RING_MAGIC;
+    client->ring = ring;
+
+    if (pthread_create(&client->ringThread, NULL, ringThread, client) != 0) {
+        munmap(ring, sizeof(LocalRingShared));
+        shm_unlink(client->ringName);
+        client->ring = NULL;
+        return 0;
+    }
+    LOG_INFO("[LOCAL] Ring %s attached\n", client->ringName);
+    return 1;
+}
+
+static void detachRing(LocalClient *client) {
+
+    if (client->ring == NULL) {
+        return;
+    }
+    // The ring thread may be asleep on the request queue
+    __atomic_store_n(&client->ring->closed, 1, __ATOMIC_SEQ_CST);
+    wakeWord(&client->ring->requests.tail);
+    pthread_join(client->ringThread, NULL);
+
+    munmap(client->ring, sizeof(LocalRingShared));
+    shm_unlink(client->ringName);      // Normally the client did already
+    client->ring = NULL;
+}
+
+
+/*
+================================================================================
+FUNCTION: clientThread
+================================================================================
+PURPOSE: Serve one socket client until it disconnects
+
+ALGORITHM:
+1. Read whatever has arrived
+2. Answer every complete message; the state lock is taken at the first
+   one and held until the last (ATTACH_RING does not need it). If the
+   next answer might not fit in 'out', unlock and send what is there
+   first: a slow reader must never keep the lock from everybody else
+3. Write all the answers with one send(), keep a partial message
+*/
+
+// send() all of 'length' bytes. RETURNS: 0, or -1 if the client is gone
+static int sendAll(int fd, const char *data, int length) {
+    int sent = 0;
+    while (sent < length) {
+        ssize_t n = send(fd, data + sent, length - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return -1;
+        }
+        sent += (int)n;
+    }
+    return 0;
+}
+
+static void* clientThread(void *arg) {
+
+    LocalClient *client = (LocalClient*)arg;
+    int filled = 0;
+
+    while (1) {
+        // STEP 1: Read
+        ssize_t bytesRead = read(client->fd, client->in + filled, sizeof(client->in) - filled);
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesRead <= 0) {
+            break;
+        }
+        filled += (int)bytesRead;
+
+        // STEP 2: Every complete message
+        int start = 0;
+        int outLength = 0;
+        int locked = 0;
+        int changed = 0;
+        int broken = 0;
+        while (filled - start >= (int)sizeof(uint32_t)) {
+            uint32_t length;
+            memcpy(&length, client->in + start, sizeof(length));
+            if (length < sizeof(LocalRequest) || length > LOCAL_MAX_MESSAGE) {
+                broken = 1;
+                break;
+            }
+            if ((uint32_t)(filled - start) < length) {
+                break;
+            }
+            if (outLength + LOCAL_MAX_RESPONSE > sizeof(client->out)) {
+                if (locked) {
+                    serverUnlockState(client->mm, changed);
+                    locked = 0;
+                    changed = 0;
+                }
+                if (sendAll(client->fd, client->out, outLength) < 0) {
+                    broken = 1;
+                    break;
+                }
+                outLength = 0;
+            }
+            const char *message = client->in + start;
+            LocalRequest request;
+            memcpy(&request, message, sizeof(request));
+            start += length;
+
+            if (request.op == LOCAL_OP_ATTACH_RING) {
+                LocalAttachResponse answer;
+                memset(&answer, 0, sizeof(answer));
+                answer.response.length = sizeof(answer);
+                answer.response.op = request.op;
+                answer.response.id = request.id;
+                answer.response.startAddress = -1;
+                if (attachRing(client)) {
+                    answer.response.status = LOCAL_STATUS_OK;
+                    snprintf(answer.name, sizeof(answer.name), "%s", client->ringName);
+                } else {
+                    answer.response.status = LOCAL_STATUS_FAILED;
+                }
+                memcpy(client->out + outLength, &answer, sizeof(answer));
+                outLength += sizeof(answer);
+                continue;
+            }
+
+            if (!locked) {
+                serverLockState();
+                locked = 1;
+            }
+            outLength += answerMessage(client->mm, message, length,
+                                       client->out + outLength, &changed);
+        }
+        if (locked) {
+            serverUnlockState(client->mm, changed);
+        }
+
+        // STEP 3: Answers out, partial message to the front
+        if (!broken && sendAll(client->fd, client->out, outLength) < 0) {
+            broken = 1;
+        }
+        if (broken) {
+            break;
+        }
+        memmove(client->in, client->in + start, filled - start);
+        filled -= start;
+    }
+
+    detachRing(client);
+    close(client->fd);
+    free(client);
+    return NULL;
+}
+
+
+/*
+================================================================================
+FUNCTION: listenerThread
+================================================================================
+*/
+
+typedef struct {
+    int            fd;
+    MemoryManager *mm;
+    int            tcp;     // Answers go out at once, not when Nagle allows
+} Listener;
+
+static void* listenerThread(void *arg) {
+
+    Listener listener = *(Listener*)arg;
+    free(arg);
+
+    while (1) {
+        int fd = accept(listener.fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno != EINTR) {
+                perror("Error: Could not accept local connection");
+            }
+            continue;
+        }
+        if (listener.tcp) {
+            int on = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+        LocalClient *client = (LocalClient*)malloc(sizeof(LocalClient));
+        pthread_t thread;
+        if (client == NULL) {
+            close(fd);
+            continue;
+        }
+        client->fd = fd;
+        client->mm = listener.mm;
+        client->ring = NULL;
+        if (pthread_create(&thread, NULL, clientThread, client) != 0) {
+            close(fd);
+            free(client);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+    return NULL;
+}
+
+
+// Accept on 'fd' from a background thread. RETURNS: 0, or -1 (fd closed)
+static int startListener(MemoryManager *mm, int fd, int tcp) {
+    Listener *listener = (Listener*)malloc(sizeof(Listener));
+    pthread_t thread;
+    if (listener == NULL) {
+        close(fd);
+        return -1;
+    }
+    listener->fd = fd;
+    listener->mm = mm;
+    listener->tcp = tcp;
+    if (pthread_create(&thread, NULL, listenerThread, listener) != 0) {
+        free(listener);
+        close(fd);
+        return -1;
+    }
+    pthread_detach(thread);
+    return 0;
+}
+
+
+/*
+================================================================================
+FUNCTION: localTransportStart
+================================================================================
+ALGORITHM:
+1. socket(AF_UNIX): the address is a path in the file system
+2. If the path answers, another server is using it: leave it alone;
+   otherwise remove the leftover file and bind
+3. listen() and accept from a background thread
+*/
+
+int localTransportStart(MemoryManager *mm, const char *path) {
+
+    // STEP 1: Socket and address
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Error: Local socket path too long: %s\n", path);
+        return -1;
+    }
+    memcpy(address.sun_path, path, strlen(path) + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("Error: Could not create local socket");
+        return -1;
+    }
+
+    // STEP 2: Live server or leftover file?
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) == 0) {
+        fprintf(stderr, "Error: Another server is listening on %s\n", path);
+        close(fd);
+        return -1;
+    }
+    close(fd);
+    unlink(path);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || bind(fd, (struct sockaddr*)&address, sizeof(address)) < 0 ||
+        listen(fd, 64) < 0) {
+        perror("Error: Could not listen on local socket");
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+
+    // STEP 3: Accept in the background
+    return startListener(mm, fd, 0);
+}
+
+
+/*
+================================================================================
+FUNCTION: localTransportStartTcp
+================================================================================
+PURPOSE: The same listener on a TCP port (like the HTTP one: every
+         interface, SO_REUSEADDR for quick restarts)
+*/
+
+int localTransportStartTcp(MemoryManager *mm, int port) {
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("Error: Could not create RPC socket");
+        return -1;
+    }
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(port);
+    if (bind(fd, (struct sockaddr*)&address, sizeof(address)) < 0 || listen(fd, 64) < 0) {
+        perror("Error: Could not listen on the RPC port");
+        close(fd);
+        return -1;
+    }
+    return startListener(mm, fd, 1);
+}
+
+
+/*
+================================================================================
+END OF FILE: local_transport.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. localQueueAwait() / localQueueNotify() - Spin, then futex sleep / wake
+   waitOnWord() / wakeWord() - futex on Linux, short sleep poll elsewhere
+2. localExecute() - Binary request → opAllocate / opDeallocate / compact
+3. answerMessage() - Batches, stats and block ranges (payload both ways)
+4. ringThread() - Drain a client's ring, one lock per batch
+5. attachRing() / detachRing() - shm_open region per client
+6. clientThread() - Length-prefixed messages, one lock and one send per
+   batch, never sending under the lock
+7. listenerThread() / localTransportStart() / localTransportStartTcp()
+   - Unix socket and TCP listeners
+================================================================================
+*/
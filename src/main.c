@@ -3,12 +3,18 @@
 FILE: main.c
 PURPOSE: Main program - Entry point for the Memory Allocation Visualizer
 DESCRIPTION: 
-    - Supports TWO modes:
+    - Supports THREE modes:
       1. Interactive menu (default) - Text-based memory allocation visualizer
       2. HTTP server mode (--server flag) - JSON API for React frontend
+      3. Script mode (--script flag) - Headless commands from a file or pipe
     - Usage:
       ./memory_visualizer              → Interactive menu mode
       ./memory_visualizer --server 8080 → Start HTTP API server on port 8080
+      ./memory_visualizer --script run.txt → Run commands, print results
+      ./memory_visualizer --local-bench → Time a --local server's transport
+      ./memory_visualizer --server 8080 --rpc 9090 → Plus binary RPC on TCP
+      ./memory_visualizer --microbench firstFit → Time engine functions
+      ... --total 4 --os-reserve 1 --unit GB → Explicit pool size
 ================================================================================
 */
 
@@ -16,9 +22,17 @@ DESCRIPTION:
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>      // open, O_WRONLY (script mode)
+#include <unistd.h>     // dup, dup2 (script mode)
 #include "../include/memory_manager.h"
 #include "../include/http_server.h"
 #include "../include/os_memory.h"
+#include "../include/script.h"
+#include "../include/logger.h"
+#include "../include/static_files.h"
+#include "../include/local_client.h"
+#include "../include/shm_export.h"
+#include "../include/microbench.h"
 
 
 /*
@@ -294,19 +308,353 @@ void compareAlgorithms(MemoryManager *mm) {
 }
 
 
+/*
+================================================================================
+STRUCTURE: CommandLine
+================================================================================
+PURPOSE: Everything the options asked for, in any order
+
+EXAMPLE:
+./memory_visualizer --total 4 --os-reserve 1 --unit GB --script run.txt
+  → scriptMode = 1, scriptPath = "run.txt",
+    totalValue = 4, osValue = 1, unit = "GB"
+*/
+
+typedef struct {
+    int         serverMode;
+    int         port;
+    int         scriptMode;
+    const char *scriptPath;     // NULL or "-" = stdin
+    long long   totalValue;     // 0 = not given (detect from RAM)
+    long long   osValue;        // 0 = not given (25% of the total)
+    const char *unit;           // NULL = KB
+    int         logLevel;       // -1 = not given (INFO; WARN for the server)
+    int         logSample;      // Keep every Nth DEBUG/INFO message
+    const char *uiRoot;         // NULL = STATIC_DEFAULT_ROOT if it exists
+    const char *localPath;      // Unix socket of the local transport (NULL: off)
+    int         rpcPort;        // TCP port of the binary protocol (0: off)
+    int         benchPairs;     // --local-bench: allocate + free pairs (0: off)
+    const char *shmName;        // --shm-export: shm_open name (NULL: off)
+    int         microbench;     // --microbench: time engine functions
+    MicrobenchConfig bench;     // Its selection and heap shapes (--bench-*)
+} CommandLine;
+
+
+/*
+================================================================================
+FUNCTION: printUsage
+================================================================================
+*/
+
+void printUsage(const char *program) {
+    fprintf(stderr,
+        "Usage: %s [--server [port] | --script [file|-]]\n"
+        "          [--total N] [--os-reserve N] [--unit KB|MB|GB]\n"
+        "          [--log-level debug|info|warn|error|off] [--log-sample N]\n"
+        "          [--ui DIR] [--local [SOCKET]] [--rpc [PORT]]\n"
+        "          [--local-bench [PAIRS]] [--shm-export [NAME]]\n"
+        "          [--microbench [NAMES]] [--bench-blocks N,N..]\n"
+        "          [--bench-holes R,R..] [--bench-spread S,S..]\n"
+        "          [--bench-reps N] [--bench-warmup N]\n"
+        "  --total       Pool size (default: detected from physical RAM)\n"
+        "  --os-reserve  OS part of the pool (default: 25%% of the total)\n"
+        "  --unit        Unit of --total and --os-reserve (default: KB)\n"
+        "  --log-level   Least important message printed\n"
+        "                (default: info; warn once the server is up)\n"
+        "  --log-sample  Print only every Nth debug/info message (default: 1)\n"
+        "  --ui          Built UI the server hands out at / (default: %s)\n"
+        "  --local       Also serve binary requests on a Unix socket\n"
+        "                (default: %s)\n"
+        "  --rpc         Also serve binary requests on a TCP port\n"
+        "                (default: %d)\n"
+        "  --local-bench Time allocate + free pairs against a --local server\n"
+        "                (or its --rpc port; default: 100000 pairs)\n"
+        "  --shm-export  Publish blocks and counters in shared memory\n"
+        "                (default: %s)\n"
+        "  --microbench  Time engine functions on scratch heaps, one at a time\n"
+        "                (comma-separated names; default: all of them)\n"
+        "  --bench-blocks / --bench-holes / --bench-spread  Heap shapes:\n"
+        "                blocks, hole fraction (0-0.5), size spread (0-0.95)\n"
+        "                (default: 100,1000,10000 / 0.1,0.3 / 0,0.5)\n"
+        "  --bench-reps / --bench-warmup  Samples kept / thrown away first\n"
+        "                (default: 30 / 5)\n",
+        program, STATIC_DEFAULT_ROOT, LOCAL_DEFAULT_SOCKET, LOCAL_DEFAULT_RPC_PORT,
+        SHM_EXPORT_DEFAULT_NAME);
+}
+
+
+/*
+================================================================================
+FUNCTION: parseBenchOption
+================================================================================
+PURPOSE: One of --bench-blocks / -holes / -spread (lists) or
+         --bench-reps / -warmup (numbers) into the microbenchmark config
+
+RETURNS: 1 on success, 0 on an unknown option or a bad value
+*/
+
+int parseBenchOption(const char *option, const char *value, MicrobenchConfig *bench) {
+    
+    double values[MICROBENCH_MAX_VALUES];
+    int count = microbenchParseList(value, values, MICROBENCH_MAX_VALUES);
+    if (count < 0) {
+        fprintf(stderr, "Error: %s needs up to %d comma-separated numbers\n",
+                option, MICROBENCH_MAX_VALUES);
+        return 0;
+    }
+    
+    if (strcmp(option, "--bench-blocks") == 0) {
+        for (int i = 0; i < count; i++) {
+            bench->blockCounts[i] = (int)values[i];
+        }
+        bench->numBlockCounts = count;
+    } else if (strcmp(option, "--bench-holes") == 0) {
+        memcpy(bench->holeRatios, values, sizeof(double) * count);
+        bench->numHoleRatios = count;
+    } else if (strcmp(option, "--bench-spread") == 0) {
+        memcpy(bench->spreads, values, sizeof(double) * count);
+        bench->numSpreads = count;
+    } else if (strcmp(option, "--bench-reps") == 0 && count == 1) {
+        bench->repetitions = (int)values[0];
+    } else if (strcmp(option, "--bench-warmup") == 0 && count == 1) {
+        bench->warmup = (int)values[0];
+    } else {
+        fprintf(stderr, "Error: Unknown option or bad value: %s %s\n", option, value);
+        return 0;
+    }
+    return 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: parseCommandLine
+================================================================================
+PURPOSE: Fill a CommandLine from argv
+
+The port and the script file are optional: they are taken only if the
+next word is not another option ("-" alone means stdin).
+
+RETURNS: 1 on success, 0 on an unknown option or a missing value
+*/
+
+int parseCommandLine(int argc, char *argv[], CommandLine *cl) {
+    
+    memset(cl, 0, sizeof(*cl));
+    cl->port = 8080;
+    cl->logLevel = -1;
+    cl->logSample = 1;
+    microbenchDefaults(&cl->bench);
+    
+    for (int i = 1; i < argc; i++) {
+        const char *option = argv[i];
+        int hasValue = i + 1 < argc && argv[i + 1][0] != '-';
+        
+        if (strcmp(option, "--server") == 0) {
+            cl->serverMode = 1;
+            if (hasValue) {
+                // Get port number (default: 8080)
+                cl->port = atoi(argv[++i]);
+                if (cl->port <= 0 || cl->port > 65535) {
+                    printf("Error: Invalid port number. Using default 8080.\n");
+                    cl->port = 8080;
+                }
+            }
+        } else if (strcmp(option, "--script") == 0) {
+            cl->scriptMode = 1;
+            if (hasValue || (i + 1 < argc && strcmp(argv[i + 1], "-") == 0)) {
+                cl->scriptPath = argv[++i];
+            }
+        } else if (strcmp(option, "--total") == 0 && hasValue) {
+            cl->totalValue = atoll(argv[++i]);
+            if (cl->totalValue <= 0) {
+                fprintf(stderr, "Error: --total needs a positive number\n");
+                return 0;
+            }
+        } else if (strcmp(option, "--os-reserve") == 0 && hasValue) {
+            cl->osValue = atoll(argv[++i]);
+            if (cl->osValue <= 0) {
+                fprintf(stderr, "Error: --os-reserve needs a positive number\n");
+                return 0;
+            }
+        } else if (strcmp(option, "--unit") == 0 && hasValue) {
+            cl->unit = argv[++i];
+        } else if (strcmp(option, "--log-level") == 0 && hasValue) {
+            cl->logLevel = logParseLevel(argv[++i]);
+            if (cl->logLevel < 0) {
+                fprintf(stderr, "Error: --log-level must be debug, info, warn, error or off\n");
+                return 0;
+            }
+        } else if (strcmp(option, "--ui") == 0 && hasValue) {
+            cl->uiRoot = argv[++i];
+        } else if (strcmp(option, "--local") == 0) {
+            cl->localPath = hasValue ? argv[++i] : LOCAL_DEFAULT_SOCKET;
+        } else if (strcmp(option, "--rpc") == 0) {
+            cl->rpcPort = hasValue ? atoi(argv[++i]) : LOCAL_DEFAULT_RPC_PORT;
+            if (cl->rpcPort <= 0 || cl->rpcPort > 65535) {
+                fprintf(stderr, "Error: --rpc needs a port number\n");
+                return 0;
+            }
+        } else if (strcmp(option, "--shm-export") == 0) {
+            cl->shmName = hasValue ? argv[++i] : SHM_EXPORT_DEFAULT_NAME;
+        } else if (strcmp(option, "--local-bench") == 0) {
+            cl->benchPairs = hasValue ? atoi(argv[++i]) : 100000;
+            if (cl->benchPairs <= 0) {
+                fprintf(stderr, "Error: --local-bench needs a positive number\n");
+                return 0;
+            }
+        } else if (strcmp(option, "--microbench") == 0) {
+            cl->microbench = 1;
+            if (hasValue) {
+                cl->bench.only = argv[++i];
+            }
+        } else if (strncmp(option, "--bench-", 8) == 0 && hasValue) {
+            if (!parseBenchOption(option, argv[++i], &cl->bench)) {
+                return 0;
+            }
+        } else if (strcmp(option, "--log-sample") == 0 && hasValue) {
+            cl->logSample = atoi(argv[++i]);
+            if (cl->logSample <= 0) {
+                fprintf(stderr, "Error: --log-sample needs a positive number\n");
+                return 0;
+            }
+        } else {
+            fprintf(stderr, "Error: Unknown option or missing value: %s\n", option);
+            return 0;
+        }
+    }
+    
+    if (cl->serverMode && cl->scriptMode) {
+        fprintf(stderr, "Error: --server and --script cannot be combined\n");
+        return 0;
+    }
+    if (cl->benchPairs > 0 && (cl->serverMode || cl->scriptMode)) {
+        fprintf(stderr, "Error: --local-bench is a client; run it next to a server\n");
+        return 0;
+    }
+    if (cl->microbench && (cl->serverMode || cl->scriptMode || cl->benchPairs > 0)) {
+        fprintf(stderr, "Error: --microbench runs on its own scratch heaps, alone\n");
+        return 0;
+    }
+    return 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: choosePoolSizes
+================================================================================
+PURPOSE: Turn the options into KB sizes for initializeMemory()
+
+- No --total: detect from physical RAM (os_detect_memory_sizes)
+- --total without --os-reserve: the OS gets 25%, as when detected
+- Values are in --unit (KB by default); sizes up to 2 TB fit
+
+RETURNS: 1 on success, 0 (after printing why) on invalid sizes
+*/
+
+int choosePoolSizes(const CommandLine *cl, int *totalKB, int *osKB) {
+    
+    if (cl->unit != NULL && os_size_to_kb(1, cl->unit) < 0) {
+        fprintf(stderr, "Error: --unit must be KB, MB or GB\n");
+        return 0;
+    }
+    
+    if (cl->totalValue > 0) {
+        *totalKB = os_size_to_kb(cl->totalValue, cl->unit);
+        *osKB = *totalKB > 0 ? *totalKB / 4 : 0;
+    } else {
+        os_detect_memory_sizes(totalKB, osKB);
+    }
+    if (cl->osValue > 0) {
+        *osKB = os_size_to_kb(cl->osValue, cl->unit);
+    }
+    
+    const char *problem = checkPoolSizes(*totalKB, *osKB);
+    if (problem != NULL) {
+        fprintf(stderr, "Error: %s\n", problem);
+        return 0;
+    }
+    return 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: splitResultsFromChatter
+================================================================================
+PURPOSE: Keep the real stdout for script results only
+
+The engine reports as it goes (printf: detection, "[COMPACT] Moved ...",
+"Error: Not enough free memory!"). In script mode stdout must hold just
+the result lines, so the original stdout is duplicated for the results
+and file descriptor 1 (where printf writes) is pointed at /dev/null.
+
+RETURNS: The stream for results (stdout itself if the split failed)
+*/
+
+FILE* splitResultsFromChatter() {
+    
+    fflush(stdout);
+    
+    int resultsFd = dup(STDOUT_FILENO);
+    int devNull = open("/dev/null", O_WRONLY);
+    FILE *results = NULL;
+    if (resultsFd >= 0 && devNull >= 0) {
+        results = fdopen(resultsFd, "w");
+    }
+    
+    if (results != NULL) {
+        dup2(devNull, STDOUT_FILENO);
+    } else if (resultsFd >= 0) {
+        close(resultsFd);
+    }
+    if (devNull >= 0) {
+        close(devNull);
+    }
+    return results != NULL ? results : stdout;
+}
+
+
 /*
 ================================================================================
 FUNCTION: main
 ================================================================================
 PURPOSE: Main program entry point
 
-SUPPORTS TWO MODES:
+SUPPORTS THREE MODES:
 1. Interactive menu (default):
    ./memory_visualizer
    
 2. HTTP server mode:
    ./memory_visualizer --server 8080
 
+3. Script mode (file, or stdin when the file is "-" or missing):
+   ./memory_visualizer --script run.txt
+   cat run.txt | ./memory_visualizer --script
+
+Any mode can be given an explicit pool instead of the detected one:
+   ./memory_visualizer --server 8080 --total 4 --os-reserve 1 --unit GB
+
+Logging: the server prints only warnings once it is up; to see every
+request (every 10th one):
+   ./memory_visualizer --server 8080 --log-level info --log-sample 10
+
+Same-machine clients without HTTP (local_protocol.h), and their timing:
+   ./memory_visualizer --server 8080 --local
+   ./memory_visualizer --local-bench 100000
+
+The same protocol on a TCP port (binary RPC), and its timing:
+   ./memory_visualizer --server 8080 --rpc 9090
+   ./memory_visualizer --local-bench 100000 --rpc 9090
+
+Monitors without HTTP: blocks and counters in shared memory (shm_reader.h)
+   ./memory_visualizer --server 8080 --shm-export
+
+One engine function at a time, on heaps of chosen shapes (microbench.h):
+   ./memory_visualizer --microbench
+   ./memory_visualizer --microbench firstFit,compact --bench-blocks 1000,100000
+
 HOW THE --server FLAG WORKS:
 We check command-line arguments (argc/argv):
 - argc = count of arguments
@@ -329,36 +677,105 @@ int main(int argc, char *argv[]) {
     int nextProcessID = 1;      // Next available process ID
     char algoName[20] = "NONE"; // Current algorithm name
     
-    // Dynamically detect system memory using OS system calls
-    // Uses sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGE_SIZE) to detect real RAM
-    int detectedTotal, detectedOS;
-    os_detect_memory_sizes(&detectedTotal, &detectedOS);
-    initializeMemory(&mm, detectedTotal, detectedOS);
+    // ========== PARSE COMMAND-LINE OPTIONS ==========
+    CommandLine cl;
+    if (!parseCommandLine(argc, argv, &cl)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    // Script mode: silence the engine's own messages from the start
+    // (and do not even format them unless a level was asked for); the
+    // microbenchmarks would otherwise time compact()'s report as well
+    FILE *scriptOut = cl.scriptMode ? splitResultsFromChatter() : NULL;
+    if (cl.logLevel >= 0) {
+        logSetLevel((LogLevel)cl.logLevel);
+    } else if (cl.scriptMode || cl.microbench) {
+        logSetLevel(LOG_LEVEL_WARN);
+    }
+    logSetSampling(cl.logSample);
+    
+    // Microbenchmarks: scratch heaps of their own, no pool either
+    if (cl.microbench) {
+        return runMicrobenchmarks(&cl.bench);
+    }
+    
+    // Benchmark client: talks to a running server, has no pool of its own
+    if (cl.benchPairs > 0) {
+        return localBenchmark(cl.localPath != NULL ? cl.localPath : LOCAL_DEFAULT_SOCKET,
+                              cl.rpcPort, cl.benchPairs);
+    }
+    
+    // Pool sizes: explicit (--total / --os-reserve / --unit) or detected
+    // from physical RAM via sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGE_SIZE)
+    int totalKB, osKB;
+    if (!choosePoolSizes(&cl, &totalKB, &osKB)) {
+        return 1;
+    }
+    initializeMemory(&mm, totalKB, osKB);
     
     // ========== CHECK FOR --server FLAG ==========
     // If user passed "--server", start the HTTP API server
     // instead of the interactive menu
-    if (argc >= 2 && strcmp(argv[1], "--server") == 0) {
+    if (cl.serverMode) {
         
-        // Get port number (default: 8080)
-        int port = 8080;
-        if (argc >= 3) {
-            port = atoi(argv[2]);
-            if (port <= 0 || port > 65535) {
-                printf("Error: Invalid port number. Using default 8080.\n");
-                port = 8080;
-            }
+        // The built UI, if there is one: the browser then loads the page
+        // and calls the API on the same origin (no CORS preflights)
+        int uiFiles = staticFilesLoad(cl.uiRoot != NULL ? cl.uiRoot : STATIC_DEFAULT_ROOT);
+        if (uiFiles > 0) {
+            printf("Serving the UI from %s (%d files)\n", staticFilesRoot(), uiFiles);
+        } else if (cl.uiRoot != NULL) {
+            fprintf(stderr, "Warning: no UI files in %s (run npm run build:server)\n",
+                    cl.uiRoot);
+        }
+        
+        // Blocks and counters for local monitors (examples/shm_watcher.c)
+        if (cl.shmName != NULL && shmExportStart(cl.shmName) < 0) {
+            fprintf(stderr, "Warning: continuing without the shared-memory export\n");
+        }
+        
+        // The startup report above was printed; from here on only
+        // warnings, unless --log-level said otherwise
+        if (cl.logLevel < 0) {
+            logSetLevel(LOG_DEFAULT_SERVER_LEVEL);
         }
         
         // Start the HTTP server (this blocks until Ctrl+C)
         printf("Starting HTTP API server...\n");
-        startServer(&mm, port);
+        startServer(&mm, cl.port, cl.localPath, cl.rpcPort);
         
         // Cleanup (only reached if server stops)
         freeMemoryManager(&mm);
         return 0;
     }
     
+    // ========== CHECK FOR --script FLAG ==========
+    // Run a command file (or stdin) without the menu, the memory map
+    // printing or the Enter pauses; see script.h for the commands
+    if (cl.scriptMode) {
+        
+        FILE *in = stdin;
+        if (cl.scriptPath != NULL && strcmp(cl.scriptPath, "-") != 0) {
+            in = fopen(cl.scriptPath, "r");
+            if (in == NULL) {
+                fprintf(stderr, "Error: Cannot open script %s\n", cl.scriptPath);
+                freeMemoryManager(&mm);
+                return 1;
+            }
+        }
+        
+        int errors = runScript(&mm, in, scriptOut);
+        
+        if (in != stdin) {
+            fclose(in);
+        }
+        freeMemoryManager(&mm);
+        if (scriptOut != stdout) {
+            fclose(scriptOut);
+        }
+        return errors > 0 ? 1 : 0;
+    }
+    
     // ========== INTERACTIVE MENU MODE ==========
     // Display welcome banner
     printWelcome();
@@ -635,9 +1052,12 @@ WHAT WE IMPLEMENTED:
 2. printWelcome() - Welcome banner (updated with compaction/buddy info)
 3. drawMemoryVisualization() - ASCII art memory representation
 4. compareAlgorithms() - Test and compare all three algorithms
-5. main() - Main program with TWO modes:
+   parseCommandLine() / choosePoolSizes() - Options, explicit pool sizes
+   splitResultsFromChatter() - Results-only stdout for script mode
+5. main() - Main program with THREE modes:
    - Interactive menu mode (default)
    - HTTP server mode (--server flag)
+   - Script mode (--script flag)
 
 FEATURES:
 ✓ Interactive menu (10 options: 0-9)
@@ -655,6 +1075,8 @@ FEATURES:
 HOW TO USE:
   Interactive:  ./memory_visualizer
   HTTP Server:  ./memory_visualizer --server 8080
+  Script:       ./memory_visualizer --script run.txt
+  Pool size:    ./memory_visualizer --total 512 --unit MB
 
 COMPLETE PROJECT - READY TO COMPILE AND RUN!
 ================================================================================
@@ -19,6 +19,64 @@ DESCRIPTION:
 #include <string.h>     // For strlen, strcpy, memset, memcpy, memmove
 #include "../include/memory_manager.h"
 #include "../include/os_memory.h"
+#include "../include/paged_allocator.h"
+#include "../include/slab_cache.h"
+#include "../include/boundary_tag.h"
+#include "../include/quick_list.h"
+#include "../include/parallel_copy.h"
+#include "../include/stream_kernels.h"
+#include "../include/history.h"
+#include "../include/admission.h"
+#include "../include/logger.h"
+
+
+/*
+================================================================================
+HELPER: Page-fault probes
+================================================================================
+PURPOSE: Measure how many page faults one operation caused
+
+HOW IT WORKS:
+faultProbeBegin() samples the kernel counters (getrusage) before the
+operation, faultProbeEnd() samples them again and adds the difference to
+the bucket for that kind of operation (and records it as the last op).
+
+EXAMPLE:
+A first-fit allocation of 256 KB memsets 64 fresh 4 KB pages, so the
+allocFaults bucket grows by roughly 64 minor faults.
+
+With mm->measureFaults = 0 both calls do nothing (two syscalls per
+operation would dominate a latency benchmark).
+*/
+
+typedef struct {
+    long minorFaults;
+    long majorFaults;
+    int  active;
+} FaultProbe;
+
+static void faultProbeBegin(const MemoryManager *mm, FaultProbe *probe) {
+    probe->active = mm->measureFaults;
+    if (probe->active) {
+        os_get_fault_counts(&probe->minorFaults, &probe->majorFaults);
+    }
+}
+
+static void faultProbeEnd(MemoryManager *mm, const FaultProbe *probe, OpFaultStats *bucket) {
+    if (!probe->active) {
+        return;
+    }
+    long minorNow, majorNow;
+    os_get_fault_counts(&minorNow, &majorNow);
+    
+    mm->lastOpFaults.minorFaults = minorNow - probe->minorFaults;
+    mm->lastOpFaults.majorFaults = majorNow - probe->majorFaults;
+    mm->lastOpFaults.samples = 1;
+    
+    bucket->minorFaults += mm->lastOpFaults.minorFaults;
+    bucket->majorFaults += mm->lastOpFaults.majorFaults;
+    bucket->samples++;
+}
 
 
 /*
@@ -67,9 +125,25 @@ void initializeMemory(MemoryManager *mm, int totalMem, int osMem) {
     mm->processCounter = 0;       // No processes assigned yet
     mm->nextBlockID = 1;          // Start block IDs at 1 (0 is reserved for OS)
     mm->useBuddySystem = 0;      // Standard allocation by default
+    mm->usePagedMode = 0;        // Contiguous blocks by default
+    mm->paged = NULL;
     mm->totalAllocations = 0;
     mm->totalDeallocations = 0;
     mm->totalCompactions = 0;
+    memset(&mm->allocFaults, 0, sizeof(mm->allocFaults));
+    memset(&mm->deallocFaults, 0, sizeof(mm->deallocFaults));
+    memset(&mm->compactFaults, 0, sizeof(mm->compactFaults));
+    memset(&mm->lastOpFaults, 0, sizeof(mm->lastOpFaults));
+    mm->numTranslationSummaries = 0;
+    mm->slabs = NULL;             // Created by the first slab cache
+    mm->layoutGeneration = 0;
+    mm->useBoundaryTags = 0;      // Block list by default
+    mm->tags = NULL;
+    mm->measureFaults = 1;
+    mm->quick = NULL;             // Immediate coalescing by default
+    mm->history = NULL;           // Not recording
+    mm->admission = NULL;         // Failed allocations are rejected
+    mm->metadataOnly = 0;         // Real backing memory when it can be had
     
     // STEP 7: Allocate REAL OS memory via mmap()
     // This is the key upgrade: we now have a real memory region from the OS!
@@ -77,13 +151,17 @@ void initializeMemory(MemoryManager *mm, int totalMem, int osMem) {
     size_t backingSizeBytes = (size_t)mm->userMemory * 1024;
     mm->backingRegion = os_region_alloc(backingSizeBytes);
     
-    if (mm->backingRegion.basePtr == NULL) {
-        printf("WARNING: Failed to allocate real OS memory backing region!\n");
-        printf("         Falling back to simulated mode (realPtr will be NULL)\n");
+    if (mm->backingRegion.basePtr == NULL &&
+        os_backing_for(backingSizeBytes) == OS_BACKING_NONE) {
+        LOG_WARN("[REAL OS MEMORY] Pool larger than half of physical RAM\n"
+                 "         Simulated mode: addresses only (realPtr will be NULL)\n");
+    } else if (mm->backingRegion.basePtr == NULL) {
+        LOG_WARN("WARNING: Failed to allocate real OS memory backing region!\n"
+                 "         Falling back to simulated mode (realPtr will be NULL)\n");
     } else {
-        printf("[REAL OS MEMORY] Backing region allocated at %p (%zu bytes)\n",
-               mm->backingRegion.basePtr, mm->backingRegion.size);
-        printf("[REAL OS MEMORY] System page size: %zu bytes\n", os_get_page_size());
+        LOG_INFO("[REAL OS MEMORY] Backing region allocated at %p (%zu bytes)\n",
+                 mm->backingRegion.basePtr, mm->backingRegion.size);
+        LOG_INFO("[REAL OS MEMORY] System page size: %zu bytes\n", os_get_page_size());
     }
     
     // STEP 8: Create the initial hole
@@ -104,14 +182,15 @@ void initializeMemory(MemoryManager *mm, int totalMem, int osMem) {
     }
     
     // STEP 10: Print confirmation message
-    printf("\n=== Memory Initialized ===\n");
-    printf("Total Memory: %d KB\n", mm->totalMemory);
-    printf("OS Memory: %d KB\n", mm->osMemory);
-    printf("User Memory: %d KB\n", mm->userMemory);
+    LOG_INFO("\n=== Memory Initialized ===\n"
+             "Total Memory: %d KB\n"
+             "OS Memory: %d KB\n"
+             "User Memory: %d KB\n",
+             mm->totalMemory, mm->osMemory, mm->userMemory);
     if (mm->backingRegion.basePtr != NULL) {
-        printf("Backing: mmap() at %p\n", mm->backingRegion.basePtr);
+        LOG_INFO("Backing: mmap() at %p\n", mm->backingRegion.basePtr);
     }
-    printf("==========================\n\n");
+    LOG_INFO("==========================\n\n");
 }
 
 /*
@@ -192,7 +271,7 @@ int firstFit(MemoryManager *mm, int processID, int size) {
                 
                 // Write a pattern byte into REAL memory to prove it's real!
                 if (current->realPtr != NULL) {
-                    memset(current->realPtr, processID & 0xFF, current->realSize);
+                    blockFill(current->realPtr, processID & 0xFF, current->realSize);
                 }
                 
                 // Update statistics
@@ -222,7 +301,7 @@ int firstFit(MemoryManager *mm, int processID, int size) {
                 
                 // Write pattern byte into REAL memory
                 if (current->realPtr != NULL) {
-                    memset(current->realPtr, processID & 0xFF, current->realSize);
+                    blockFill(current->realPtr, processID & 0xFF, current->realSize);
                 }
                 
                 // CREATE new hole for the remaining space
@@ -342,7 +421,7 @@ int bestFit(MemoryManager *mm, int processID, int size) {
         bestBlock->processID = processID;
         bestBlock->realSize = (size_t)size * 1024;
         if (bestBlock->realPtr != NULL) {
-            memset(bestBlock->realPtr, processID & 0xFF, bestBlock->realSize);
+            blockFill(bestBlock->realPtr, processID & 0xFF, bestBlock->realSize);
         }
         mm->numHoles--;
     } 
@@ -358,7 +437,7 @@ int bestFit(MemoryManager *mm, int processID, int size) {
         bestBlock->processID = processID;
         bestBlock->realSize = (size_t)size * 1024;
         if (bestBlock->realPtr != NULL) {
-            memset(bestBlock->realPtr, processID & 0xFF, bestBlock->realSize);
+            blockFill(bestBlock->realPtr, processID & 0xFF, bestBlock->realSize);
         }
         
         // Create new hole for remaining space
@@ -435,7 +514,7 @@ int worstFit(MemoryManager *mm, int processID, int size) {
         worstBlock->processID = processID;
         worstBlock->realSize = (size_t)size * 1024;
         if (worstBlock->realPtr != NULL) {
-            memset(worstBlock->realPtr, processID & 0xFF, worstBlock->realSize);
+            blockFill(worstBlock->realPtr, processID & 0xFF, worstBlock->realSize);
         }
         mm->numHoles--;
     } 
@@ -451,7 +530,7 @@ int worstFit(MemoryManager *mm, int processID, int size) {
         worstBlock->processID = processID;
         worstBlock->realSize = (size_t)size * 1024;
         if (worstBlock->realPtr != NULL) {
-            memset(worstBlock->realPtr, processID & 0xFF, worstBlock->realSize);
+            blockFill(worstBlock->realPtr, processID & 0xFF, worstBlock->realSize);
         }
         
         // Create new hole
@@ -472,6 +551,49 @@ int worstFit(MemoryManager *mm, int processID, int size) {
 }
 
 
+/*
+================================================================================
+HELPERS: Deferred coalescing
+================================================================================
+PURPOSE: Pieces of allocateMemory / deallocateMemory (and the buddy
+         versions) that only run while mm->quick is set
+
+quickMaybePass: Run the batch pass if quickPassDue() says so
+takeQuickBlock: Turn a popped quick-list hole into a process as is
+                (the hole already has exactly the right size: no split)
+*/
+
+static void quickMaybePass(MemoryManager *mm) {
+    if (mm->quick != NULL) {
+        int trigger = quickPassDue(mm->quick);
+        if (trigger != 0) {
+            coalesceDeferred(mm, trigger);
+        }
+    }
+}
+
+static void takeQuickBlock(MemoryManager *mm, MemoryBlock *block, int processID) {
+    block->isHole = 0;
+    block->processID = processID;
+    block->realSize = (size_t)block->size * 1024;
+    if (block->realPtr != NULL) {
+        blockFill(block->realPtr, processID & 0xFF, block->realSize);
+    }
+    mm->numProcesses++;
+    mm->numHoles--;
+    mm->freeMemory -= block->size;
+}
+
+static int fitByAlgorithm(MemoryManager *mm, int processID, int size, AllocationAlgorithm algo) {
+    switch (algo) {
+        case FIRST_FIT: return firstFit(mm, processID, size);
+        case BEST_FIT:  return bestFit(mm, processID, size);
+        case WORST_FIT: return worstFit(mm, processID, size);
+        default:        return -1;
+    }
+}
+
+
 /*
 ================================================================================
 FUNCTION: allocateMemory
@@ -492,43 +614,81 @@ int allocateMemory(MemoryManager *mm, int processID, int size,
     
     // STEP 1: Validate process size
     if (size <= 0) {
-        printf("Error: Invalid process size!\n");
+        LOG_INFO("Error: Invalid process size!\n");
         return -1;
     }
     
     // STEP 2: Check if enough free memory exists
     if (size > mm->freeMemory) {
-        printf("Error: Not enough free memory!\n");
-        printf("Requested: %d KB, Available: %d KB\n", size, mm->freeMemory);
+        LOG_INFO("Error: Not enough free memory!\n"
+                 "Requested: %d KB, Available: %d KB\n", size, mm->freeMemory);
         return -1;
     }
     
     // STEP 3: Call appropriate algorithm based on 'algo' parameter
     int result;
+    FaultProbe probe;
+    faultProbeBegin(mm, &probe);
     
-    // Switch statement - like multiple if-else
-    // Checks the value of 'algo' and runs matching case
-    switch (algo) {
-        case FIRST_FIT:
-            result = firstFit(mm, processID, size);
-            break;  // Exit switch after this case
-            
-        case BEST_FIT:
-            result = bestFit(mm, processID, size);
-            break;
-            
-        case WORST_FIT:
-            result = worstFit(mm, processID, size);
-            break;
-            
-        default:
-            // This shouldn't happen, but just in case
+    // Paged mode: any free frames will do, 'algo' does not apply
+    if (mm->usePagedMode) {
+        int frame = pagedAllocate(mm->paged, processID, size);
+        if (frame == -1) {
             return -1;
+        }
+        mm->numProcesses++;
+        mm->freeMemory = mm->paged->freeFrames * mm->paged->frameSizeKB;
+        mm->totalAllocations++;
+        faultProbeEnd(mm, &probe, &mm->allocFaults);
+        historyRecord(mm, HISTORY_ALLOCATE, processID, size, algo);
+        return mm->osMemory + frame * mm->paged->frameSizeKB;
+    }
+    
+    // Boundary-tag mode: first fit over the tags in the region itself
+    if (mm->useBoundaryTags) {
+        long offset = btAllocate(mm->tags, processID, (size_t)size * 1024);
+        if (offset == -1) {
+            return -1;
+        }
+        mm->numProcesses++;
+        mm->numHoles = mm->tags->numFree;
+        mm->freeMemory = (int)(mm->tags->freeBytes / 1024);
+        mm->totalAllocations++;
+        faultProbeEnd(mm, &probe, &mm->allocFaults);
+        historyRecord(mm, HISTORY_ALLOCATE, processID, size, algo);
+        return mm->osMemory + (int)(offset / 1024);
+    }
+    
+    // Deferred coalescing: a hole of exactly this size on the quick list
+    // is reused as is ('algo' does not apply to a hit)
+    if (mm->quick != NULL) {
+        quickMaybePass(mm);
+        MemoryBlock *block = quickPop(mm->quick, size);
+        if (block != NULL) {
+            takeQuickBlock(mm, block, processID);
+            mm->totalAllocations++;
+            faultProbeEnd(mm, &probe, &mm->allocFaults);
+            historyRecord(mm, HISTORY_ALLOCATE, processID, size, algo);
+            return block->startAddress;
+        }
+    }
+    
+    // Run the chosen placement algorithm (first / best / worst fit)
+    result = fitByAlgorithm(mm, processID, size, algo);
+    
+    // Deferred coalescing under pressure: the unmerged holes may add up
+    // to a hole that fits, so merge them all and try once more
+    if (result == -1 && mm->quick != NULL && mm->quick->pendingFrees > 0) {
+        coalesceDeferred(mm, 1);
+        result = fitByAlgorithm(mm, processID, size, algo);
     }
     
     // STEP 4: If allocation succeeded, update the total counter
+    // and charge the page faults of the memset() fill to allocations
     if (result != -1) {
         mm->totalAllocations++;
+        faultProbeEnd(mm, &probe, &mm->allocFaults);
+        historyRecord(mm, HISTORY_ALLOCATE, processID, size, algo);
     }
     
     // STEP 5: Return result from the algorithm
@@ -551,6 +711,41 @@ ALGORITHM EXPLANATION:
 
 int deallocateMemory(MemoryManager *mm, int processID) {
     
+    // Paged mode: return the frames to the bitmap (nothing to merge)
+    if (mm->usePagedMode) {
+        FaultProbe probe;
+        faultProbeBegin(mm, &probe);
+        if (!pagedDeallocate(mm->paged, processID)) {
+            return 0;
+        }
+        mm->numProcesses--;
+        mm->freeMemory = mm->paged->freeFrames * mm->paged->frameSizeKB;
+        mm->totalDeallocations++;
+        faultProbeEnd(mm, &probe, &mm->deallocFaults);
+        historyRecord(mm, HISTORY_DEALLOCATE, processID, 0, 0);
+        return 1;
+    }
+    
+    // Boundary-tag mode: find the header, then coalesce through the tags
+    if (mm->useBoundaryTags) {
+        FaultProbe probe;
+        faultProbeBegin(mm, &probe);
+        long offset = btFindProcess(mm->tags, processID);
+        if (offset == -1 || !btFree(mm->tags, offset)) {
+            return 0;
+        }
+        mm->numProcesses--;
+        mm->numHoles = mm->tags->numFree;
+        mm->freeMemory = (int)(mm->tags->freeBytes / 1024);
+        mm->totalDeallocations++;
+        faultProbeEnd(mm, &probe, &mm->deallocFaults);
+        historyRecord(mm, HISTORY_DEALLOCATE, processID, 0, 0);
+        return 1;
+    }
+    
+    // Deferred coalescing: maybe run the batch pass first
+    quickMaybePass(mm);
+    
     // STEP 1: Set up pointers to traverse list
     MemoryBlock *current = mm->head;  // Block we're checking
     MemoryBlock *prev = NULL;         // Previous block (needed for merging)
@@ -562,6 +757,8 @@ int deallocateMemory(MemoryManager *mm, int processID) {
         if (!current->isHole && current->processID == processID) {
             
             // FOUND IT! Now deallocate.
+            FaultProbe probe;
+            faultProbeBegin(mm, &probe);
             
             // STEP 3: Convert process to hole
             current->isHole = 1;           // Mark as hole
@@ -569,7 +766,7 @@ int deallocateMemory(MemoryManager *mm, int processID) {
             
             // Clear the REAL memory (zero it out like the OS does)
             if (current->realPtr != NULL) {
-                memset(current->realPtr, 0, current->realSize);
+                blockFill(current->realPtr, 0, current->realSize);
             }
             
             // STEP 4: Update statistics
@@ -578,6 +775,15 @@ int deallocateMemory(MemoryManager *mm, int processID) {
             mm->freeMemory += current->size;  // More free memory
             mm->totalDeallocations++;      // Increment deallocation counter
             
+            // Deferred coalescing: leave the hole unmerged for the quick
+            // lists; the batch pass merges it later
+            if (mm->quick != NULL) {
+                quickPush(mm->quick, current);
+                faultProbeEnd(mm, &probe, &mm->deallocFaults);
+                historyRecord(mm, HISTORY_DEALLOCATE, processID, 0, 0);
+                return 1;
+            }
+            
             // STEP 5: Try to merge with NEXT block (if it's a hole)
             if (current->next != NULL && current->next->isHole) {
                 
@@ -620,6 +826,9 @@ int deallocateMemory(MemoryManager *mm, int processID) {
                 mm->numHoles--;
             }
             
+            faultProbeEnd(mm, &probe, &mm->deallocFaults);
+            historyRecord(mm, HISTORY_DEALLOCATE, processID, 0, 0);
+            
             // SUCCESS!
             return 1;
         }
@@ -685,6 +894,17 @@ float calculateFragmentation(MemoryManager *mm) {
         return 0.0;
     }
     
+    // Paged mode: every free frame is usable, so there is no external
+    // fragmentation (the waste is internal, see paged->internalFragKB)
+    if (mm->usePagedMode) {
+        return 0.0;
+    }
+    
+    // Boundary-tag mode: same formula, measured in bytes over the tags
+    if (mm->useBoundaryTags) {
+        return btFragmentation(mm->tags);
+    }
+    
     // Find the largest hole
     int largestHole = 0;
     MemoryBlock *current = mm->head;
@@ -707,6 +927,35 @@ float calculateFragmentation(MemoryManager *mm) {
 }
 
 
+/*
+================================================================================
+FUNCTION: largestHoleKB
+================================================================================
+PURPOSE: Size of the biggest free block of whichever engine is active
+*/
+
+int largestHoleKB(MemoryManager *mm) {
+    
+    // Paged mode: the longest run of free frames
+    if (mm->usePagedMode) {
+        return pagedLargestFreeRun(mm->paged);
+    }
+    
+    // Boundary tags: the largest free block between tags
+    if (mm->useBoundaryTags) {
+        return (int)(btLargestFree(mm->tags) / 1024);
+    }
+    
+    int largestHole = 0;
+    for (MemoryBlock *current = mm->head; current != NULL; current = current->next) {
+        if (current->isHole && current->size > largestHole) {
+            largestHole = current->size;
+        }
+    }
+    return largestHole;
+}
+
+
 /*
 ================================================================================
 FUNCTION: freeMemoryManager
@@ -728,6 +977,11 @@ void freeMemoryManager(MemoryManager *mm) {
     // Set head to NULL (list is now empty)
     mm->head = NULL;
     
+    // Quick-list entries pointed into the list we just freed
+    if (mm->quick != NULL) {
+        quickClear(mm->quick);
+    }
+    
     // NOTE: We do NOT free backingRegion here because compact()
     // calls freeMemoryManager but needs the backing region to survive.
     // The backing region is freed in resetMemory() and at program exit.
@@ -770,6 +1024,24 @@ Frag = 0% (all free memory in one hole!)
 
 int compact(MemoryManager *mm, char *resultBuffer, int bufferSize) {
     
+    // Paged mode has no external fragmentation, so there is nothing to slide
+    if (mm->usePagedMode) {
+        if (resultBuffer != NULL) {
+            snprintf(resultBuffer, bufferSize,
+                "{\"success\":false,\"message\":\"Paged mode never needs compaction\"}");
+        }
+        return 0;
+    }
+    
+    // Boundary tags: sliding would rewrite every tag; revert first
+    if (mm->useBoundaryTags) {
+        if (resultBuffer != NULL) {
+            snprintf(resultBuffer, bufferSize,
+                "{\"success\":false,\"message\":\"Revert boundary tags before compacting\"}");
+        }
+        return 0;
+    }
+    
     // STEP 1: Count allocated processes
     int processCount = 0;
     MemoryBlock *current = mm->head;
@@ -789,14 +1061,25 @@ int compact(MemoryManager *mm, char *resultBuffer, int bufferSize) {
         return 0;
     }
     
-    // STEP 2: Record metrics BEFORE compaction
+    // STEP 2: Room for every process's ID and size (sized by the count,
+    // not a fixed 100: there can be as many processes as KB of user memory)
+    int *processIDs = (int*)malloc(sizeof(int) * 2 * (processCount + 1));
+    if (processIDs == NULL) {
+        if (resultBuffer != NULL) {
+            snprintf(resultBuffer, bufferSize,
+                "{\"success\":false,\"message\":\"Out of memory\"}");
+        }
+        return 0;
+    }
+    int *processSizes = processIDs + processCount + 1;
+    
+    // Record metrics BEFORE compaction
+    FaultProbe probe;
+    faultProbeBegin(mm, &probe);
     float fragBefore = calculateFragmentation(mm);
     int holesBefore = mm->numHoles;
     
     // STEP 3: Collect all process info (processID and size)
-    // We need arrays to temporarily store process data
-    int processIDs[100];     // Store up to 100 process IDs
-    int processSizes[100];   // Store their sizes
     int processIdx = 0;
     int totalMoved = 0;
     int totalBytesMoved = 0;
@@ -823,6 +1106,7 @@ int compact(MemoryManager *mm, char *resultBuffer, int bufferSize) {
     // STEP 4: Compact REAL memory using memmove
     // This is what a real OS does during compaction!
     // We move the actual bytes in the mmap'd region.
+    // Large moves are split across threads by parallelMove().
     if (mm->backingRegion.basePtr != NULL) {
         size_t destOffset = 0;
         current = mm->head;
@@ -830,10 +1114,10 @@ int compact(MemoryManager *mm, char *resultBuffer, int bufferSize) {
             if (!current->isHole && current->realPtr != NULL) {
                 void *dest = (char *)mm->backingRegion.basePtr + destOffset;
                 if (dest != current->realPtr) {
-                    // memmove handles overlapping regions safely
-                    memmove(dest, current->realPtr, current->realSize);
-                    printf("[COMPACT] Moved P%d real memory: %p -> %p (%zu bytes)\n",
-                           current->processID, current->realPtr, dest, current->realSize);
+                    // Handles overlapping regions safely (like memmove)
+                    parallelMove(dest, current->realPtr, current->realSize);
+                    LOG_DEBUG("[COMPACT] Moved P%d real memory: %p -> %p (%zu bytes)\n",
+                              current->processID, current->realPtr, dest, current->realSize);
                 }
                 destOffset += current->realSize;
             }
@@ -843,7 +1127,7 @@ int compact(MemoryManager *mm, char *resultBuffer, int bufferSize) {
         size_t totalUsedBytes = destOffset;
         size_t remainingBytes = mm->backingRegion.size - totalUsedBytes;
         if (remainingBytes > 0) {
-            memset((char *)mm->backingRegion.basePtr + totalUsedBytes, 0, remainingBytes);
+            blockFill((char *)mm->backingRegion.basePtr + totalUsedBytes, 0, remainingBytes);
         }
     }
     
@@ -902,6 +1186,9 @@ int compact(MemoryManager *mm, char *resultBuffer, int bufferSize) {
     mm->numProcesses = processIdx;
     mm->freeMemory = remainingSpace;
     mm->totalCompactions++;
+    free(processIDs);
+    mm->layoutGeneration++;     // Blocks moved
+    faultProbeEnd(mm, &probe, &mm->compactFaults);
     
     // STEP 8: Record metrics AFTER compaction
     float fragAfter = calculateFragmentation(mm);
@@ -925,9 +1212,10 @@ int compact(MemoryManager *mm, char *resultBuffer, int bufferSize) {
         );
     }
     
-    printf("Compaction complete: Moved %d processes\n", totalMoved);
-    printf("Fragmentation: %.1f%% → %.1f%%\n", fragBefore, fragAfter);
+    LOG_INFO("Compaction complete: Moved %d processes\n"
+             "Fragmentation: %.1f%% → %.1f%%\n", totalMoved, fragBefore, fragAfter);
     
+    historyRecord(mm, HISTORY_COMPACT, 0, 0, 0);
     return 1;
 }
 
@@ -1010,6 +1298,27 @@ int nextPowerOf2(int n) {
 }
 
 
+/*
+================================================================================
+FUNCTION: buddyPoolSize
+================================================================================
+PURPOSE: The largest power of 2 that fits in userMemory
+
+WHY NOT DOUBLE UNTIL WE PASS userMemory?
+Pools go up to 2 TB = 2^31 KB. Doubling an int past 2^30 overflows, and
+the loop never ends. Comparing with userMemory / 2 stops at 2^30 (the
+largest power of 2 an int holds) without ever computing a larger value.
+*/
+
+int buddyPoolSize(int userMemory) {
+    int size = 1;
+    while (size <= userMemory / 2) {
+        size *= 2;
+    }
+    return size;
+}
+
+
 /*
 ================================================================================
 FUNCTION: buddyAllocate
@@ -1044,12 +1353,52 @@ DISADVANTAGE:
 
 int buddyAllocate(MemoryManager *mm, int size, char *resultBuffer, int bufferSize) {
     
+    // Larger than any buddy block: nothing can hold it (and rounding it
+    // up would overflow)
+    if (size > BUDDY_MAX_KB) {
+        if (resultBuffer != NULL) {
+            snprintf(resultBuffer, bufferSize,
+                "{\"success\":false,\"message\":\"No suitable buddy block found\"}");
+        }
+        return -1;
+    }
+    
     // STEP 1: Round up requested size to next power of 2
     int allocSize = nextPowerOf2(size);
     
     // STEP 2: Auto-assign a process ID
     int processID = ++(mm->processCounter);
     
+    // Deferred coalescing: an unmerged buddy of exactly allocSize is
+    // reused without splitting anything
+    if (mm->quick != NULL) {
+        quickMaybePass(mm);
+        MemoryBlock *block = quickPop(mm->quick, allocSize);
+        if (block != NULL) {
+            FaultProbe probe;
+            faultProbeBegin(mm, &probe);
+            takeQuickBlock(mm, block, processID);
+            mm->totalAllocations++;
+            faultProbeEnd(mm, &probe, &mm->allocFaults);
+            if (resultBuffer != NULL) {
+                snprintf(resultBuffer, bufferSize,
+                    "{\"success\":true,"
+                    "\"processId\":\"P%d\","
+                    "\"requestedSize\":%d,"
+                    "\"allocatedSize\":%d,"
+                    "\"wastedSpace\":%d,"
+                    "\"startAddress\":%d,"
+                    "\"quickHit\":true}",
+                    processID, size, allocSize,
+                    allocSize - size,
+                    block->startAddress
+                );
+            }
+            historyRecord(mm, HISTORY_BUDDY_ALLOCATE, processID, size, 0);
+            return block->startAddress;
+        }
+    }
+    
     // STEP 3: Find a free block that is big enough
     MemoryBlock *targetBlock = NULL;
     MemoryBlock *current = mm->head;
@@ -1060,6 +1409,14 @@ int buddyAllocate(MemoryManager *mm, int size, char *resultBuffer, int bufferSiz
             break;  // Use first suitable block (for buddy system)
         }
         current = current->next;
+        
+        // Deferred coalescing under pressure: merge pending buddies and
+        // search once more from the start
+        if (current == NULL && targetBlock == NULL && mm->quick != NULL &&
+            mm->quick->pendingFrees > 0) {
+            coalesceDeferred(mm, 1);
+            current = mm->head;
+        }
     }
     
     // No suitable block found
@@ -1071,6 +1428,9 @@ int buddyAllocate(MemoryManager *mm, int size, char *resultBuffer, int bufferSiz
         return -1;
     }
     
+    FaultProbe probe;
+    faultProbeBegin(mm, &probe);
+    
     // STEP 4: Split the block until it's the right size
     // Each split creates two "buddy" blocks of half the size
     while (targetBlock->size > allocSize) {
@@ -1118,7 +1478,7 @@ int buddyAllocate(MemoryManager *mm, int size, char *resultBuffer, int bufferSiz
     
     // Write pattern byte into REAL memory
     if (targetBlock->realPtr != NULL) {
-        memset(targetBlock->realPtr, processID & 0xFF, targetBlock->realSize);
+        blockFill(targetBlock->realPtr, processID & 0xFF, targetBlock->realSize);
     }
     
     // Update statistics
@@ -1126,6 +1486,7 @@ int buddyAllocate(MemoryManager *mm, int size, char *resultBuffer, int bufferSiz
     mm->numHoles--;
     mm->freeMemory -= targetBlock->size;
     mm->totalAllocations++;
+    faultProbeEnd(mm, &probe, &mm->allocFaults);
     
     // STEP 6: Write result JSON
     if (resultBuffer != NULL) {
@@ -1142,10 +1503,98 @@ int buddyAllocate(MemoryManager *mm, int size, char *resultBuffer, int bufferSiz
         );
     }
     
+    historyRecord(mm, HISTORY_BUDDY_ALLOCATE, processID, size, 0);
     return targetBlock->startAddress;
 }
 
 
+/*
+--------------------------------------------------------------------------------
+HELPER: buddyMergeAll
+--------------------------------------------------------------------------------
+PURPOSE: Merge free buddy pairs until none are left (used by
+         buddyDeallocate and by the deferred-coalescing pass)
+
+RETURNS: Number of merges performed
+*/
+
+static int buddyMergeAll(MemoryManager *mm) {
+    
+    int merges = 0;
+    
+    // We keep trying to merge until no more merging is possible
+    int merged = 1;
+    while (merged) {
+        merged = 0;
+        
+        // Walk through all blocks looking for buddy pairs to merge
+        MemoryBlock *block = mm->head;
+        MemoryBlock *prevBlock = NULL;
+        
+        while (block != NULL) {
+            // Check if this free block has a buddy
+            if (block->isHole && block->buddyID != -1) {
+                
+                // Find the buddy block
+                MemoryBlock *buddy = mm->head;
+                MemoryBlock *prevBuddy = NULL;
+                
+                while (buddy != NULL) {
+                    if (buddy->blockID == block->buddyID) {
+                        break;
+                    }
+                    prevBuddy = buddy;
+                    buddy = buddy->next;
+                }
+                
+                // If buddy found and also free → MERGE
+                if (buddy != NULL && buddy->isHole) {
+                    
+                    // Determine which block comes first in memory
+                    MemoryBlock *first = (block->startAddress < buddy->startAddress) ? block : buddy;
+                    MemoryBlock *second = (first == block) ? buddy : block;
+                    
+                    // Extend first block to cover both
+                    first->endAddress = second->endAddress;
+                    first->size = first->endAddress - first->startAddress + 1;
+                    first->buddyID = -1;  // Reset buddy (will find new buddy later)
+                    
+                    // Merge real memory: first keeps its realPtr, extend realSize
+                    first->realSize = (size_t)first->size * 1024;
+                    
+                    // Remove second block from linked list
+                    MemoryBlock *search = mm->head;
+                    MemoryBlock *searchPrev = NULL;
+                    while (search != NULL) {
+                        if (search == second) {
+                            if (searchPrev != NULL) {
+                                searchPrev->next = search->next;
+                            } else {
+                                mm->head = search->next;
+                            }
+                            free(second);
+                            break;
+                        }
+                        searchPrev = search;
+                        search = search->next;
+                    }
+                    
+                    mm->numHoles--;
+                    merges++;
+                    merged = 1;
+                    break;  // Restart the merge scan
+                }
+            }
+            
+            prevBlock = block;
+            block = block->next;
+        }
+    }
+    
+    return merges;
+}
+
+
 /*
 ================================================================================
 FUNCTION: buddyDeallocate
@@ -1168,6 +1617,9 @@ Merge buddies: [FREE: 256KB]
 
 int buddyDeallocate(MemoryManager *mm, int processID, char *resultBuffer, int bufferSize) {
     
+    // Deferred coalescing: maybe run the batch pass first
+    quickMaybePass(mm);
+    
     // STEP 1: Find the process block
     MemoryBlock *current = mm->head;
     
@@ -1175,6 +1627,8 @@ int buddyDeallocate(MemoryManager *mm, int processID, char *resultBuffer, int bu
         if (!current->isHole && current->processID == processID) {
             
             // FOUND IT!
+            FaultProbe probe;
+            faultProbeBegin(mm, &probe);
             
             // STEP 2: Mark as free
             current->isHole = 1;
@@ -1182,7 +1636,7 @@ int buddyDeallocate(MemoryManager *mm, int processID, char *resultBuffer, int bu
             
             // Clear REAL memory
             if (current->realPtr != NULL) {
-                memset(current->realPtr, 0, current->realSize);
+                blockFill(current->realPtr, 0, current->realSize);
             }
             
             // Update statistics
@@ -1191,75 +1645,16 @@ int buddyDeallocate(MemoryManager *mm, int processID, char *resultBuffer, int bu
             mm->freeMemory += current->size;
             mm->totalDeallocations++;
             
-            // STEP 3: Try to merge with buddy (recursively)
-            // We keep trying to merge until no more merging is possible
-            int merged = 1;
-            while (merged) {
-                merged = 0;
-                
-                // Walk through all blocks looking for buddy pairs to merge
-                MemoryBlock *block = mm->head;
-                MemoryBlock *prevBlock = NULL;
-                
-                while (block != NULL) {
-                    // Check if this free block has a buddy
-                    if (block->isHole && block->buddyID != -1) {
-                        
-                        // Find the buddy block
-                        MemoryBlock *buddy = mm->head;
-                        MemoryBlock *prevBuddy = NULL;
-                        
-                        while (buddy != NULL) {
-                            if (buddy->blockID == block->buddyID) {
-                                break;
-                            }
-                            prevBuddy = buddy;
-                            buddy = buddy->next;
-                        }
-                        
-                        // If buddy found and also free → MERGE
-                        if (buddy != NULL && buddy->isHole) {
-                            
-                            // Determine which block comes first in memory
-                            MemoryBlock *first = (block->startAddress < buddy->startAddress) ? block : buddy;
-                            MemoryBlock *second = (first == block) ? buddy : block;
-                            
-                            // Extend first block to cover both
-                            first->endAddress = second->endAddress;
-                            first->size = first->endAddress - first->startAddress + 1;
-                            first->buddyID = -1;  // Reset buddy (will find new buddy later)
-                            
-                            // Merge real memory: first keeps its realPtr, extend realSize
-                            first->realSize = (size_t)first->size * 1024;
-                            
-                            // Remove second block from linked list
-                            MemoryBlock *search = mm->head;
-                            MemoryBlock *searchPrev = NULL;
-                            while (search != NULL) {
-                                if (search == second) {
-                                    if (searchPrev != NULL) {
-                                        searchPrev->next = search->next;
-                                    } else {
-                                        mm->head = search->next;
-                                    }
-                                    free(second);
-                                    break;
-                                }
-                                searchPrev = search;
-                                search = search->next;
-                            }
-                            
-                            mm->numHoles--;
-                            merged = 1;
-                            break;  // Restart the merge scan
-                        }
-                    }
-                    
-                    prevBlock = block;
-                    block = block->next;
-                }
+            // STEP 3: Try to merge with buddy (recursively), unless
+            // deferred coalescing leaves that to the batch pass
+            if (mm->quick != NULL) {
+                quickPush(mm->quick, current);
+            } else {
+                buddyMergeAll(mm);
             }
             
+            faultProbeEnd(mm, &probe, &mm->deallocFaults);
+            
             // STEP 4: Write result JSON
             if (resultBuffer != NULL) {
                 snprintf(resultBuffer, bufferSize,
@@ -1268,6 +1663,7 @@ int buddyDeallocate(MemoryManager *mm, int processID, char *resultBuffer, int bu
                 );
             }
             
+            historyRecord(mm, HISTORY_BUDDY_DEALLOCATE, processID, 0, 0);
             return 1;
         }
         
@@ -1286,6 +1682,117 @@ int buddyDeallocate(MemoryManager *mm, int processID, char *resultBuffer, int bu
 }
 
 
+/*
+================================================================================
+FUNCTION: coalesceDeferred
+================================================================================
+PURPOSE: The batch pass of deferred-coalescing mode
+
+ALGORITHM:
+- Block list: ONE walk; a hole followed by a hole absorbs it, and keeps
+  absorbing until a process comes next
+- Buddy system: buddyMergeAll() (the same merges buddyDeallocate does)
+- Then the quick lists are emptied: their blocks may have been merged
+
+EXAMPLE (block list):
+Before: [H 8][H 8][P2 16][H 4][H 8][H 32]
+After:  [H 16][P2 16][H 44]          (3 merges in one walk)
+*/
+
+int coalesceDeferred(MemoryManager *mm, int trigger) {
+    
+    int merges = 0;
+    
+    if (mm->useBuddySystem) {
+        merges = buddyMergeAll(mm);
+    } else {
+        MemoryBlock *current = mm->head;
+        while (current != NULL && current->next != NULL) {
+            MemoryBlock *next = current->next;
+            if (current->isHole && next->isHole) {
+                current->endAddress = next->endAddress;
+                current->size = current->endAddress - current->startAddress + 1;
+                current->realSize = (size_t)current->size * 1024;
+                current->next = next->next;
+                free(next);
+                mm->numHoles--;
+                merges++;
+            } else {
+                current = next;
+            }
+        }
+    }
+    
+    if (mm->quick != NULL) {
+        quickClear(mm->quick);
+        mm->quick->passes++;
+        mm->quick->merges += merges;
+        if (trigger == 1) mm->quick->pressurePasses++;
+        if (trigger == 2) mm->quick->timerPasses++;
+    }
+    
+    historyRecord(mm, HISTORY_COALESCE, merges, trigger, 0);
+    return merges;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: saveProcesses
+--------------------------------------------------------------------------------
+PURPOSE: IDs and sizes of every process, in list order, for the
+         conversions that rebuild the heap and allocate them again
+
+One malloc holds both arrays: IDs at [0, n), sizes from [n + 1] on
+(the same layout compact() uses). The caller frees *ids.
+
+RETURNS: Number of processes n, or -1 if out of memory
+*/
+
+static int saveProcesses(MemoryManager *mm, int **ids) {
+    int count = 0;
+    for (MemoryBlock *b = mm->head; b != NULL; b = b->next) {
+        if (!b->isHole) {
+            count++;
+        }
+    }
+    *ids = (int*)malloc(sizeof(int) * 2 * (count + 1));
+    if (*ids == NULL) {
+        return -1;
+    }
+    int *sizes = *ids + count + 1;
+    int i = 0;
+    for (MemoryBlock *b = mm->head; b != NULL; b = b->next) {
+        if (!b->isHole) {
+            (*ids)[i] = b->processID;
+            sizes[i] = b->size;
+            i++;
+        }
+    }
+    return count;
+}
+
+
+/*
+================================================================================
+HELPER: layoutBacking
+================================================================================
+PURPOSE: The backing region of a rebuilt layout (buddy convert / revert)
+
+A metadataOnly manager gets none: its blocks keep realPtr NULL, so the
+re-placed processes are neither mapped nor filled. That keeps a history
+replay of a conversion as cheap as the list work, whatever the pool size.
+*/
+
+static OSRegion layoutBacking(const MemoryManager *mm, size_t bytes) {
+    if (mm->metadataOnly) {
+        OSRegion none = { NULL, 0 };
+        return none;
+    }
+    return os_region_alloc(bytes);
+}
+
+
 /*
 ================================================================================
 FUNCTION: convertToBuddySystem
@@ -1301,37 +1808,40 @@ ALGORITHM:
 
 int convertToBuddySystem(MemoryManager *mm, char *resultBuffer, int bufferSize) {
     
-    // STEP 1: Save current processes
-    int savedIDs[100];
-    int savedSizes[100];
-    int savedCount = 0;
+    if (mm->usePagedMode || mm->useBoundaryTags) {
+        if (resultBuffer != NULL) {
+            snprintf(resultBuffer, bufferSize,
+                "{\"success\":false,\"message\":\"Revert paged mode / boundary tags first\"}");
+        }
+        return 0;
+    }
     
-    MemoryBlock *current = mm->head;
-    while (current != NULL) {
-        if (!current->isHole) {
-            savedIDs[savedCount] = current->processID;
-            savedSizes[savedCount] = current->size;
-            savedCount++;
+    // The re-allocations below are part of this one op
+    historySuspend(mm);
+    
+    // STEP 1: Save current processes
+    int *savedIDs;
+    int savedCount = saveProcesses(mm, &savedIDs);
+    if (savedCount < 0) {
+        historyResume(mm);
+        if (resultBuffer != NULL) {
+            snprintf(resultBuffer, bufferSize,
+                "{\"success\":false,\"message\":\"Out of memory\"}");
         }
-        current = current->next;
+        return 0;
     }
+    int *savedSizes = savedIDs + savedCount + 1;
     
     // STEP 2: Free old memory and backing region
     freeMemoryManager(mm);
     os_region_free(&mm->backingRegion);
+    mm->layoutGeneration++;
     
-    // STEP 3: Round user memory to nearest power of 2
-    int buddySize = 1;
-    while (buddySize < mm->userMemory) {
-        buddySize *= 2;
-    }
-    // Use the largest power of 2 that fits in user memory
-    if (buddySize > mm->userMemory) {
-        buddySize /= 2;
-    }
+    // STEP 3: Use the largest power of 2 that fits in user memory
+    int buddySize = buddyPoolSize(mm->userMemory);
     
     // STEP 4: Allocate new backing region for buddy system
-    mm->backingRegion = os_region_alloc((size_t)buddySize * 1024);
+    mm->backingRegion = layoutBacking(mm, (size_t)buddySize * 1024);
     
     // STEP 5: Initialize buddy system
     mm->useBuddySystem = 1;
@@ -1374,6 +1884,9 @@ int convertToBuddySystem(MemoryManager *mm, char *resultBuffer, int bufferSize)
         );
     }
     
+    free(savedIDs);
+    historyResume(mm);
+    historyRecord(mm, HISTORY_BUDDY_CONVERT, 0, 0, 0);
     return 1;
 }
 
@@ -1393,28 +1906,30 @@ ALGORITHM:
 
 int revertFromBuddySystem(MemoryManager *mm, char *resultBuffer, int bufferSize) {
     
-    // STEP 1: Save current processes
-    int savedIDs[100];
-    int savedSizes[100];
-    int savedCount = 0;
+    // The re-allocations below are part of this one op
+    historySuspend(mm);
     
-    MemoryBlock *current = mm->head;
-    while (current != NULL) {
-        if (!current->isHole) {
-            savedIDs[savedCount] = current->processID;
-            savedSizes[savedCount] = current->size;
-            savedCount++;
+    // STEP 1: Save current processes
+    int *savedIDs;
+    int savedCount = saveProcesses(mm, &savedIDs);
+    if (savedCount < 0) {
+        historyResume(mm);
+        if (resultBuffer != NULL) {
+            snprintf(resultBuffer, bufferSize,
+                "{\"success\":false,\"message\":\"Out of memory\"}");
         }
-        current = current->next;
+        return 0;
     }
+    int *savedSizes = savedIDs + savedCount + 1;
     
     // STEP 2: Free old memory and backing region
     freeMemoryManager(mm);
     os_region_free(&mm->backingRegion);
     mm->useBuddySystem = 0;
+    mm->layoutGeneration++;
     
     // Allocate new backing region (standard size)
-    mm->backingRegion = os_region_alloc((size_t)mm->userMemory * 1024);
+    mm->backingRegion = layoutBacking(mm, (size_t)mm->userMemory * 1024);
     
     // Reinitialize normally
     mm->numProcesses = 0;
@@ -1451,6 +1966,9 @@ int revertFromBuddySystem(MemoryManager *mm, char *resultBuffer, int bufferSize)
         );
     }
     
+    free(savedIDs);
+    historyResume(mm);
+    historyRecord(mm, HISTORY_BUDDY_REVERT, 0, 0, 0);
     return 1;
 }
 
@@ -1468,10 +1986,30 @@ WHAT IT DOES:
 */
 
 void resetMemory(MemoryManager *mm) {
+    resizeMemory(mm, mm->totalMemory, mm->osMemory);
+}
+
+
+/*
+================================================================================
+FUNCTION: resizeMemory
+================================================================================
+PURPOSE: Reset with new total/OS sizes (the backing region is mapped
+         again at the new size, see os_backing_for)
+*/
+
+void resizeMemory(MemoryManager *mm, int totalMem, int osMem) {
     
-    // Save the original sizes
-    int totalMem = mm->totalMemory;
-    int osMem = mm->osMemory;
+    // Drop paged mode (frame bitmap and page tables), boundary tags
+    // (the tags themselves die with the backing region) and slab caches
+    destroyPagedAllocator(mm->paged);
+    mm->paged = NULL;
+    free(mm->tags);
+    mm->tags = NULL;
+    destroyQuickLists(mm->quick);
+    mm->quick = NULL;
+    destroySlabLayer(mm->slabs);
+    mm->slabs = NULL;
     
     // Free the linked list
     freeMemoryManager(mm);
@@ -1479,8 +2017,205 @@ void resetMemory(MemoryManager *mm) {
     // Free the old OS backing region via munmap()
     os_region_free(&mm->backingRegion);
     
-    // Reinitialize from scratch (will allocate new backing region)
+    // Reinitialize from scratch (will allocate new backing region);
+    // the history outlives the reset, which becomes one more op
+    struct History *history = mm->history;
+    struct AdmissionQueue *admission = mm->admission;   // Waiters keep waiting
     initializeMemory(mm, totalMem, osMem);
+    mm->history = history;
+    mm->admission = admission;
+    historyRecord(mm, HISTORY_RESET, totalMem, osMem, 0);
+}
+
+
+/*
+================================================================================
+FUNCTION: checkPoolSizes
+================================================================================
+*/
+
+const char* checkPoolSizes(int totalMem, int osMem) {
+    if (totalMem <= 0) {
+        return "Total size must be a positive number of KB, MB or GB (up to 2 TB)";
+    }
+    if (osMem <= 0) {
+        return "OS reserve must be a positive number of KB, MB or GB";
+    }
+    if (osMem >= totalMem) {
+        return "OS reserve must be smaller than the total size";
+    }
+    return NULL;
+}
+
+
+/*
+================================================================================
+HELPER: scanResidency
+================================================================================
+PURPOSE: Run ONE mincore() over the whole backing region
+
+Returns a malloc'd vector with one byte per backing page (bit 0 = resident)
+and stores the page count in *pagesOut. Returns NULL when there is no
+backing region or the scan failed. The caller frees the vector.
+*/
+
+static unsigned char* scanResidency(MemoryManager *mm, size_t *pagesOut) {
+    *pagesOut = 0;
+    if (mm->backingRegion.basePtr == NULL) {
+        return NULL;
+    }
+    
+    size_t pageSize = os_get_page_size();
+    size_t pages = (mm->backingRegion.size + pageSize - 1) / pageSize;
+    unsigned char *vec = (unsigned char*)malloc(pages);
+    if (vec == NULL) {
+        return NULL;
+    }
+    
+    *pagesOut = os_region_residency(&mm->backingRegion, vec, pages);
+    if (*pagesOut == 0) {
+        free(vec);
+        return NULL;
+    }
+    return vec;
+}
+
+
+/*
+================================================================================
+HELPER: blockResidency
+================================================================================
+PURPOSE: Slice the residency vector for one block
+
+A block covers the byte range [realPtr, realPtr + realSize) of the backing
+region. Every page that range touches counts toward the block, even if the
+block only covers part of it (blocks are KB-aligned, pages may be 16 KB).
+*/
+
+static void blockResidency(MemoryManager *mm, MemoryBlock *block,
+                           const unsigned char *vec, size_t pages,
+                           size_t *blockPages, size_t *residentPages) {
+    *blockPages = 0;
+    *residentPages = 0;
+    if (block->realPtr == NULL || block->realSize == 0) {
+        return;
+    }
+    
+    size_t pageSize = os_get_page_size();
+    size_t offset = (size_t)((char *)block->realPtr - (char *)mm->backingRegion.basePtr);
+    size_t firstPage = offset / pageSize;
+    size_t lastPage = (offset + block->realSize - 1) / pageSize;
+    if (lastPage >= pages) {
+        lastPage = pages - 1;
+    }
+    
+    for (size_t p = firstPage; p <= lastPage; p++) {
+        (*blockPages)++;
+        if (vec[p] & 1) {
+            (*residentPages)++;
+        }
+    }
+}
+
+
+/*
+================================================================================
+HELPER: faultStatsToJSON
+================================================================================
+PURPOSE: Format one OpFaultStats bucket as {"minor":..,"major":..,"ops":..}
+*/
+
+static void faultStatsToJSON(const OpFaultStats *stats, char *buffer, int bufferSize) {
+    snprintf(buffer, bufferSize,
+        "{\"minor\":%ld,\"major\":%ld,\"ops\":%d}",
+        stats->minorFaults, stats->majorFaults, stats->samples);
+}
+
+
+/*
+================================================================================
+FUNCTION: getResidencyJSON
+================================================================================
+PURPOSE: Report which pages of each block are really in RAM, plus fault costs
+
+HOW IT WORKS:
+1. One mincore() call scans the entire backing region
+2. Walk the block list and count resident pages inside each block
+3. Append the per-operation fault counters collected via getrusage()
+
+OUTPUT FORMAT:
+{
+  "pageSize": 16384,
+  "backingPages": 48,
+  "residentPages": 13,
+  "blocks": [
+    {"blockID":1,"processId":"P1","startAddress":256,"pages":7,"residentPages":7},
+    {"blockID":2,"processId":null,"startAddress":356,"pages":42,"residentPages":6}
+  ],
+  "faults": {"allocate":{...},"deallocate":{...},"compact":{...},"lastOp":{...}}
+}
+*/
+
+void getResidencyJSON(MemoryManager *mm, char *buffer, int bufferSize) {
+    
+    size_t pages = 0;
+    unsigned char *vec = scanResidency(mm, &pages);
+    
+    size_t totalResident = 0;
+    for (size_t p = 0; p < pages; p++) {
+        if (vec[p] & 1) {
+            totalResident++;
+        }
+    }
+    
+    int written = snprintf(buffer, bufferSize,
+        "{\"pageSize\":%zu,\"backingPages\":%zu,\"residentPages\":%zu,\"blocks\":[",
+        os_get_page_size(), pages, totalResident);
+    
+    // Per-block slices of the residency vector
+    MemoryBlock *current = mm->head;
+    int first = 1;
+    while (current != NULL && vec != NULL) {
+        size_t blockPages, residentPages;
+        blockResidency(mm, current, vec, pages, &blockPages, &residentPages);
+        
+        char pidStr[16];
+        if (current->isHole) {
+            snprintf(pidStr, sizeof(pidStr), "null");
+        } else {
+            snprintf(pidStr, sizeof(pidStr), "\"P%d\"", current->processID);
+        }
+        
+        char blockJSON[192];
+        snprintf(blockJSON, sizeof(blockJSON),
+            "%s{\"blockID\":%d,\"processId\":%s,\"startAddress\":%d,"
+            "\"pages\":%zu,\"residentPages\":%zu}",
+            first ? "" : ",",
+            current->blockID, pidStr, current->startAddress,
+            blockPages, residentPages);
+        
+        int remaining = bufferSize - written;
+        if (remaining > (int)strlen(blockJSON) + 256) {
+            written += snprintf(buffer + written, remaining, "%s", blockJSON);
+            first = 0;
+        }
+        current = current->next;
+    }
+    free(vec);
+    
+    // Fault counters per kind of operation
+    char allocJSON[96], deallocJSON[96], compactJSON[96], lastJSON[96];
+    faultStatsToJSON(&mm->allocFaults, allocJSON, sizeof(allocJSON));
+    faultStatsToJSON(&mm->deallocFaults, deallocJSON, sizeof(deallocJSON));
+    faultStatsToJSON(&mm->compactFaults, compactJSON, sizeof(compactJSON));
+    faultStatsToJSON(&mm->lastOpFaults, lastJSON, sizeof(lastJSON));
+    
+    if (written < bufferSize) {
+        snprintf(buffer + written, bufferSize - written,
+            "],\"faults\":{\"allocate\":%s,\"deallocate\":%s,"
+            "\"compact\":%s,\"lastOp\":%s}}",
+            allocJSON, deallocJSON, compactJSON, lastJSON);
+    }
 }
 
 
@@ -1516,13 +2251,28 @@ void getStatsJSON(MemoryManager *mm, char *buffer, int bufferSize) {
     int usedMemory = mm->userMemory - mm->freeMemory;
     
     // Find largest hole size
-    int largestHole = 0;
-    MemoryBlock *current = mm->head;
-    while (current != NULL) {
-        if (current->isHole && current->size > largestHole) {
-            largestHole = current->size;
-        }
-        current = current->next;
+    int largestHole = largestHoleKB(mm);
+    
+    // Paged mode: holes are runs of free frames
+    char pagedJSON[160] = "null";
+    if (mm->usePagedMode) {
+        mm->numHoles = pagedFreeRuns(mm->paged);
+        snprintf(pagedJSON, sizeof(pagedJSON),
+            "{\"frameSizeKB\":%d,\"frames\":%d,\"freeFrames\":%d,"
+            "\"internalFragmentationKB\":%lld}",
+            mm->paged->frameSizeKB, mm->paged->numFrames,
+            mm->paged->freeFrames, mm->paged->internalFragKB);
+    }
+    
+    // Boundary-tag mode: holes and metadata come from the tags
+    char tagsJSON[160] = "null";
+    if (mm->useBoundaryTags) {
+        mm->numHoles = mm->tags->numFree;
+        snprintf(tagsJSON, sizeof(tagsJSON),
+            "{\"blocks\":%d,\"freeBlocks\":%d,\"metadataBytes\":%d,"
+            "\"headerReads\":%lld}",
+            mm->tags->numBlocks, mm->tags->numFree,
+            mm->tags->numBlocks * BT_OVERHEAD, mm->tags->headerReads);
     }
     
     // Format backing region address as hex
@@ -1533,6 +2283,57 @@ void getStatsJSON(MemoryManager *mm, char *buffer, int bufferSize) {
         snprintf(backingAddrStr, sizeof(backingAddrStr), "null");
     }
     
+    // Pages of the backing region. Which of them are resident is
+    // GET /api/residency's job: a mincore() over the whole region on
+    // every stats render (every snapshot after every POST) would cost
+    // time in proportion to the pool, not to the blocks
+    size_t pageSize = os_get_page_size();
+    size_t backingPages = (mm->backingRegion.basePtr != NULL)
+        ? (mm->backingRegion.size + pageSize - 1) / pageSize : 0;
+    
+    // Deferred coalescing (quick-list hit rate, batch passes)
+    char quickJSON[512];
+    quickListsToJSON(mm->quick, quickJSON, sizeof(quickJSON));
+    
+    // Parallel compaction copies
+    char copyJSON[256];
+    parallelCopyStatsToJSON(copyJSON, sizeof(copyJSON));
+    
+    // Fill / copy kernels (streaming vs regular stores)
+    char streamJSON[256];
+    streamStatsToJSON(streamJSON, sizeof(streamJSON));
+    
+    // Slab caches (utilization and internal fragmentation)
+    char slabJSON[256];
+    slabSummaryJSON(mm, slabJSON, sizeof(slabJSON));
+    
+    // Admission queue (waiting allocations)
+    char admissionJSON[384];
+    admissionToJSON(mm->admission, admissionJSON, sizeof(admissionJSON));
+    
+    // Latest address-translation run, one entry per page size
+    char translationJSON[1024];
+    int tw = snprintf(translationJSON, sizeof(translationJSON), "[");
+    for (int i = 0; i < mm->numTranslationSummaries; i++) {
+        const TranslationSummary *t = &mm->translation[i];
+        tw += snprintf(translationJSON + tw, sizeof(translationJSON) - tw,
+            "%s{\"pageSizeKB\":%d,\"levels\":%d,\"tlbEntries\":%d,\"tlbWays\":%d,"
+            "\"translations\":%lld,\"tlbMisses\":%lld,\"missRate\":%.6f,"
+            "\"walkAccesses\":%lld,\"translationsPerSecond\":%.0f}",
+            (i == 0) ? "" : ",",
+            t->pageSizeKB, t->levels, t->tlbEntries, t->tlbWays,
+            t->translations, t->tlbMisses,
+            (t->translations > 0) ? (double)t->tlbMisses / (double)t->translations : 0.0,
+            t->walkAccesses, t->translationsPerSecond);
+    }
+    snprintf(translationJSON + tw, sizeof(translationJSON) - tw, "]");
+    
+    char allocJSON[96], deallocJSON[96], compactJSON[96], lastJSON[96];
+    faultStatsToJSON(&mm->allocFaults, allocJSON, sizeof(allocJSON));
+    faultStatsToJSON(&mm->deallocFaults, deallocJSON, sizeof(deallocJSON));
+    faultStatsToJSON(&mm->compactFaults, compactJSON, sizeof(compactJSON));
+    faultStatsToJSON(&mm->lastOpFaults, lastJSON, sizeof(lastJSON));
+    
     // Build the JSON string (with real OS memory info)
     snprintf(buffer, bufferSize,
         "{\"totalMemory\":%d,"
@@ -1548,10 +2349,24 @@ void getStatsJSON(MemoryManager *mm, char *buffer, int bufferSize) {
         "\"totalDeallocations\":%d,"
         "\"totalCompactions\":%d,"
         "\"useBuddySystem\":%s,"
+        "\"usePagedMode\":%s,"
+        "\"paged\":%s,"
+        "\"useBoundaryTags\":%s,"
+        "\"boundaryTags\":%s,"
         "\"backingType\":\"mmap/munmap\","
+        "\"backing\":\"%s\","
         "\"backingRegionBase\":%s,"
         "\"backingRegionSize\":%zu,"
-        "\"systemPageSize\":%zu}",
+        "\"systemPageSize\":%zu,"
+        "\"backingPages\":%zu,"
+        "\"faults\":{\"allocate\":%s,\"deallocate\":%s,"
+        "\"compact\":%s,\"lastOp\":%s},"
+        "\"translation\":%s,"
+        "\"quickLists\":%s,"
+        "\"parallelCopy\":%s,"
+        "\"streamKernels\":%s,"
+        "\"slab\":%s,"
+        "\"admission\":%s}",
         mm->totalMemory,
         mm->osMemory,
         mm->userMemory,
@@ -1565,9 +2380,23 @@ void getStatsJSON(MemoryManager *mm, char *buffer, int bufferSize) {
         mm->totalDeallocations,
         mm->totalCompactions,
         mm->useBuddySystem ? "true" : "false",
+        mm->usePagedMode ? "true" : "false",
+        pagedJSON,
+        mm->useBoundaryTags ? "true" : "false",
+        tagsJSON,
+        mm->backingRegion.basePtr != NULL
+            ? os_backing_name(os_backing_for(mm->backingRegion.size)) : "none",
         backingAddrStr,
         mm->backingRegion.size,
-        os_get_page_size()
+        pageSize,
+        backingPages,
+        allocJSON, deallocJSON, compactJSON, lastJSON,
+        translationJSON,
+        quickJSON,
+        copyJSON,
+        streamJSON,
+        slabJSON,
+        admissionJSON
     );
 }
 
@@ -1589,13 +2418,16 @@ WHAT WE IMPLEMENTED:
 9.  freeMemoryManager() - Clean up memory
 10. compact() - Sliding compaction with JSON result
 11. autoCompact() - Auto-compact based on threshold
-12. nextPowerOf2() - Helper for buddy system
+12. nextPowerOf2() / buddyPoolSize() - Helpers for buddy system
 13. buddyAllocate() - Buddy system allocation with splitting
 14. buddyDeallocate() - Buddy system deallocation with merging
 15. convertToBuddySystem() - Switch to buddy system
 16. revertFromBuddySystem() - Switch back to standard
-17. resetMemory() - Reset to initial state
-18. getStatsJSON() - Memory stats as JSON
+17. coalesceDeferred() - Batch merge pass of deferred-coalescing mode
+18. resetMemory() - Reset to initial state (leaves paged mode too)
+    resizeMemory() / checkPoolSizes() - Reset to new, validated sizes
+19. getResidencyJSON() - Per-block resident pages (mincore) + fault deltas
+20. getStatsJSON() - Memory stats as JSON
 
 THIS IS THE CORE OF YOUR PROJECT!
 All the OS concepts you learned are implemented here.
@@ -28,6 +28,15 @@ DESCRIPTION:
 // ../ means "go up one folder", then into include/
 #include "../include/memory_structures.h"
 
+// Paged mode keeps frames instead of a block list (see blocksToJSON)
+#include "../include/paged_allocator.h"
+
+// Boundary-tag mode keeps its blocks inside the backing region
+#include "../include/boundary_tag.h"
+
+// Error messages go through the leveled logger
+#include "../include/logger.h"
+
 
 /*
 ================================================================================
@@ -69,8 +78,8 @@ MemoryBlock* createBlock(MemoryManager *mm, int isHole, int start, int end, int
     // malloc returns NULL if it couldn't allocate memory
     if (newBlock == NULL) {
         // If malloc failed, print error and return NULL
-        printf("Error: Memory allocation failed!\n");
-        printf("Cannot create new memory block.\n");
+        LOG_ERROR("Error: Memory allocation failed!\n"
+                  "Cannot create new memory block.\n");
         return NULL;  // Return NULL to indicate failure
     }
     
@@ -300,10 +309,21 @@ EXAMPLE OUTPUT:
 ]
 
 NOTE: We also include the OS block at the beginning (address 0 to osMemory-1)
+NOTE: In paged mode there is no block list; the frames are rendered instead
+NOTE: In boundary-tag mode the blocks are read from the tags
 */
 
 void blocksToJSON(MemoryManager *mm, char *buffer, int bufferSize) {
     
+    if (mm->usePagedMode && mm->paged != NULL) {
+        pagedBlocksToJSON(mm->paged, mm->osMemory, buffer, bufferSize);
+        return;
+    }
+    if (mm->useBoundaryTags && mm->tags != NULL) {
+        btBlocksToJSON(mm->tags, mm->osMemory, buffer, bufferSize);
+        return;
+    }
+    
     // STEP 1: Start the JSON array
     // Begin with the OS block (always at address 0)
     int written = snprintf(buffer, bufferSize,
@@ -341,6 +361,37 @@ void blocksToJSON(MemoryManager *mm, char *buffer, int bufferSize) {
 }
 
 
+/*
+================================================================================
+FUNCTION: blocksToArray
+================================================================================
+PURPOSE: Copy every block (the same ones blocksToJSON renders, without the
+         OS block) into an array, for readers that want numbers, not JSON
+
+RETURNS: How many blocks there are; only the first maxBlocks are copied
+*/
+
+int blocksToArray(MemoryManager *mm, MemoryBlock *blocks, int maxBlocks) {
+    
+    if (mm->usePagedMode && mm->paged != NULL) {
+        return pagedBlocksToArray(mm->paged, mm->osMemory, blocks, maxBlocks);
+    }
+    if (mm->useBoundaryTags && mm->tags != NULL) {
+        return btBlocksToArray(mm->tags, mm->osMemory, blocks, maxBlocks);
+    }
+    
+    int count = 0;
+    for (MemoryBlock *current = mm->head; current != NULL; current = current->next) {
+        if (count < maxBlocks) {
+            blocks[count] = *current;
+            blocks[count].next = NULL;
+        }
+        count++;
+    }
+    return count;
+}
+
+
 /*
 ================================================================================
 END OF FILE: memory_structures.c
@@ -351,6 +402,7 @@ WHAT WE IMPLEMENTED:
 2. displayBlock() - Prints block information in formatted way
 3. blockToJSON() - Converts single block to JSON string
 4. blocksToJSON() - Converts all blocks to JSON array string
+5. blocksToArray() - Copies all blocks into an array (shared-memory export)
 
 KEY C CONCEPTS USED:
 - malloc() - Allocate memory dynamically
@@ -0,0 +1,886 @@
+/*
+================================================================================
+FILE: microbench.c
+PURPOSE: Time single engine functions on heaps of chosen shapes
+DESCRIPTION:
+    - A shape is built ONCE into a heap image (an array of blocks plus the
+      manager's counters); every sample that changes the heap starts from
+      a fresh list rebuilt from the image, outside the timed region
+    - Block-list heaps are laid out directly (building them through
+      firstFit would cost O(n²) and could not place the holes exactly);
+      buddy heaps are built by buddyAllocate itself, so the buddy links
+      are the engine's own
+    - One sample = a batch of calls between two clock reads, divided by
+      the batch: calls far shorter than the clock's resolution are still
+      measured, calls that change the heap are limited to what one copy
+      of the heap allows
+================================================================================
+*/
+
+#include <stdio.h>          // printf, fprintf
+#include <stdlib.h>         // malloc, calloc, free, qsort, strtod
+#include <string.h>         // memset, strlen, strncmp, strchr
+#include <time.h>           // clock_gettime, CLOCK_MONOTONIC
+#include "../include/microbench.h"
+#include "../include/memory_manager.h"
+#include "../include/workload.h"        // WorkloadRNG
+
+
+// Most calls one sample times (also the calls one heap copy must absorb)
+#define MICROBENCH_MAX_BATCH 64
+
+// Calls that only read the heap can batch far more
+#define MICROBENCH_MAX_READ_BATCH (1 << 20)
+
+// A sample should take about this long (ns): well above clock resolution
+#define MICROBENCH_SAMPLE_NS 100000.0
+
+// Buddy heaps are built by buddyAllocate, whose first-fit walk makes the
+// build O(n²): larger shapes skip the buddy functions
+#define MICROBENCH_MAX_BUDDY_BLOCKS 20000
+
+// OS part of every scratch heap (KB)
+#define MICROBENCH_OS_KB 1024
+
+// Bytes of blocksToJSON output reserved per block
+#define MICROBENCH_JSON_PER_BLOCK 256
+
+
+static volatile long long sink;     // Keeps results the compiler could drop
+
+
+static long long nowNanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+
+/*
+================================================================================
+STRUCTURE: HeapImage / BenchContext
+================================================================================
+HeapImage:    The blocks of a shape, in list order, and the manager they
+              belong to (head NULL: the list is rebuilt from blocks[])
+BenchContext: What a benchmark's calls need: the live heap, the size to
+              allocate, the processes to free and the output buffers
+*/
+
+typedef struct {
+    MemoryBlock  *blocks;
+    int           count;
+    MemoryManager state;
+} HeapImage;
+
+typedef struct {
+    MemoryManager    mm;
+    const HeapImage *image;
+    int              requestKB;
+    int              nextPid;           // First PID the allocations hand out
+    int             *candidates;        // Processes a deallocation may target
+    int              numCandidates;
+    int              targets[MICROBENCH_MAX_BATCH];
+    char             result[512];       // Result JSON of compact / buddy calls
+    char            *json;              // blocksToJSON / getStatsJSON output
+    int              jsonSize;
+} BenchContext;
+
+
+/*
+================================================================================
+STRUCTURE: BenchCase
+================================================================================
+PURPOSE: One row of the tables
+
+wantPrevHole / wantNextHole pick the processes a deallocation frees by
+their neighbours (-1: either), which is what selects the merge case:
+
+    none: [P][X][P]    next: [P][X][H]    prev: [H][X][P]    both: [H][X][H]
+*/
+
+enum { HEAP_LIST, HEAP_BUDDY };
+
+typedef struct {
+    const char *name;
+    int         heap;           // HEAP_LIST / HEAP_BUDDY
+    int         mutates;        // Fresh heap copy before every sample
+    int         maxBatch;       // 0: as many calls as there are targets
+    int         wantPrevHole;
+    int         wantNextHole;
+    void      (*run)(BenchContext *ctx, int batch);
+} BenchCase;
+
+
+/*
+--------------------------------------------------------------------------------
+The timed loops (one per benchmark; nothing else is inside the clock reads)
+--------------------------------------------------------------------------------
+*/
+
+static void runFirstFit(BenchContext *ctx, int batch) {
+    for (int i = 0; i < batch; i++) {
+        sink += firstFit(&ctx->mm, ctx->nextPid + i, ctx->requestKB);
+    }
+}
+
+static void runBestFit(BenchContext *ctx, int batch) {
+    for (int i = 0; i < batch; i++) {
+        sink += bestFit(&ctx->mm, ctx->nextPid + i, ctx->requestKB);
+    }
+}
+
+static void runWorstFit(BenchContext *ctx, int batch) {
+    for (int i = 0; i < batch; i++) {
+        sink += worstFit(&ctx->mm, ctx->nextPid + i, ctx->requestKB);
+    }
+}
+
+static void runDeallocate(BenchContext *ctx, int batch) {
+    for (int i = 0; i < batch; i++) {
+        sink += deallocateMemory(&ctx->mm, ctx->targets[i]);
+    }
+}
+
+static void runBuddyAllocate(BenchContext *ctx, int batch) {
+    for (int i = 0; i < batch; i++) {
+        sink += buddyAllocate(&ctx->mm, ctx->requestKB, ctx->result, sizeof(ctx->result));
+    }
+}
+
+static void runBuddyDeallocate(BenchContext *ctx, int batch) {
+    for (int i = 0; i < batch; i++) {
+        sink += buddyDeallocate(&ctx->mm, ctx->targets[i], ctx->result, sizeof(ctx->result));
+    }
+}
+
+static void runCompact(BenchContext *ctx, int batch) {
+    (void)batch;        // Always 1: the second call would find nothing to do
+    sink += compact(&ctx->mm, ctx->result, sizeof(ctx->result));
+}
+
+static void runFragmentation(BenchContext *ctx, int batch) {
+    for (int i = 0; i < batch; i++) {
+        sink += (long long)(calculateFragmentation(&ctx->mm) * 100.0f);
+    }
+}
+
+static void runBlocksToJSON(BenchContext *ctx, int batch) {
+    for (int i = 0; i < batch; i++) {
+        blocksToJSON(&ctx->mm, ctx->json, ctx->jsonSize);
+        sink += ctx->json[1];
+    }
+}
+
+static void runStatsJSON(BenchContext *ctx, int batch) {
+    for (int i = 0; i < batch; i++) {
+        getStatsJSON(&ctx->mm, ctx->json, ctx->jsonSize);
+        sink += ctx->json[1];
+    }
+}
+
+
+static const BenchCase benchCases[] = {
+    { "firstFit",               HEAP_LIST,  1, MICROBENCH_MAX_BATCH,      -1, -1, runFirstFit },
+    { "bestFit",                HEAP_LIST,  1, MICROBENCH_MAX_BATCH,      -1, -1, runBestFit },
+    { "worstFit",               HEAP_LIST,  1, MICROBENCH_MAX_BATCH,      -1, -1, runWorstFit },
+    { "deallocateMemory/none",  HEAP_LIST,  1, 0,                          0,  0, runDeallocate },
+    { "deallocateMemory/next",  HEAP_LIST,  1, 0,                          0,  1, runDeallocate },
+    { "deallocateMemory/prev",  HEAP_LIST,  1, 0,                          1,  0, runDeallocate },
+    { "deallocateMemory/both",  HEAP_LIST,  1, 0,                          1,  1, runDeallocate },
+    { "buddyAllocate",          HEAP_BUDDY, 1, MICROBENCH_MAX_BATCH,      -1, -1, runBuddyAllocate },
+    { "buddyDeallocate",        HEAP_BUDDY, 1, 0,                         -1, -1, runBuddyDeallocate },
+    { "compact",                HEAP_LIST,  1, 1,                         -1, -1, runCompact },
+    { "calculateFragmentation", HEAP_LIST,  0, MICROBENCH_MAX_READ_BATCH, -1, -1, runFragmentation },
+    { "blocksToJSON",           HEAP_LIST,  0, MICROBENCH_MAX_READ_BATCH, -1, -1, runBlocksToJSON },
+    { "getStatsJSON",           HEAP_LIST,  0, MICROBENCH_MAX_READ_BATCH, -1, -1, runStatsJSON },
+};
+
+#define NUM_BENCH_CASES ((int)(sizeof(benchCases) / sizeof(benchCases[0])))
+
+
+/*
+================================================================================
+FUNCTION: microbenchDefaults / microbenchParseList
+================================================================================
+*/
+
+void microbenchDefaults(MicrobenchConfig *config) {
+    memset(config, 0, sizeof(*config));
+    config->blockCounts[0] = 100;
+    config->blockCounts[1] = 1000;
+    config->blockCounts[2] = 10000;
+    config->numBlockCounts = 3;
+    config->holeRatios[0] = 0.1;
+    config->holeRatios[1] = 0.3;
+    config->numHoleRatios = 2;
+    config->spreads[0] = 0.0;
+    config->spreads[1] = 0.5;
+    config->numSpreads = 2;
+    config->repetitions = 30;
+    config->warmup = 5;
+    config->seed = 42;
+}
+
+int microbenchParseList(const char *text, double *values, int maxValues) {
+    int count = 0;
+    const char *p = text;
+    while (*p != '\0') {
+        char *end;
+        double value = strtod(p, &end);
+        if (end == p || count == maxValues || (*end != ',' && *end != '\0')) {
+            return -1;
+        }
+        values[count++] = value;
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return count > 0 ? count : -1;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: isSelected
+--------------------------------------------------------------------------------
+PURPOSE: Does 'only' name this benchmark? An entry matches the whole name
+         or the part before a '/' ("deallocateMemory" = all four cases)
+*/
+
+static int isSelected(const char *only, const char *name) {
+    if (only == NULL || only[0] == '\0') {
+        return 1;
+    }
+    const char *entry = only;
+    while (*entry != '\0') {
+        const char *comma = strchr(entry, ',');
+        size_t length = comma != NULL ? (size_t)(comma - entry) : strlen(entry);
+        if (length > 0 && strncmp(name, entry, length) == 0 &&
+            (name[length] == '\0' || name[length] == '/')) {
+            return 1;
+        }
+        if (comma == NULL) {
+            break;
+        }
+        entry = comma + 1;
+    }
+    return 0;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: squareRoot / tCritical
+--------------------------------------------------------------------------------
+squareRoot: Newton's iteration x = (x + v/x) / 2 (the project links no
+            math library); converges quadratically from any x above √v
+tCritical:  Two-sided 95% quantile of Student's t with 'df' degrees of
+            freedom: the confidence interval of a mean of few samples is
+            wider than the normal 1.96 would say
+*/
+
+static double squareRoot(double v) {
+    if (v <= 0.0) {
+        return 0.0;
+    }
+    double x = v > 1.0 ? v : 1.0;
+    for (int i = 0; i < 64; i++) {
+        double next = 0.5 * (x + v / x);
+        if (next >= x) {
+            break;
+        }
+        x = next;
+    }
+    return x;
+}
+
+static double tCritical(int df) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df < 1) {
+        return 0.0;
+    }
+    if (df <= 30) {
+        return table[df - 1];
+    }
+    return df <= 60 ? 2.000 : df <= 120 ? 1.980 : 1.960;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: summarize
+--------------------------------------------------------------------------------
+PURPOSE: min, median, mean ± 95% confidence interval, coefficient of
+         variation (stddev / mean) and max of n samples (sorts them)
+
+The median and min are what to compare when a few samples were hit by
+an interrupt; mean ± CI is what says whether two runs really differ
+(intervals that do not overlap).
+*/
+
+typedef struct {
+    double min;
+    double median;
+    double mean;
+    double ci95;
+    double cv;          // Percent
+    double max;
+} SampleSummary;
+
+static int compareDoubles(const void *a, const void *b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void summarize(double *samples, int n, SampleSummary *s) {
+    qsort(samples, n, sizeof(double), compareDoubles);
+    s->min = samples[0];
+    s->max = samples[n - 1];
+    s->median = (n % 2 == 1) ? samples[n / 2]
+                             : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) {
+        sum += samples[i];
+    }
+    s->mean = sum / n;
+    double squares = 0.0;
+    for (int i = 0; i < n; i++) {
+        squares += (samples[i] - s->mean) * (samples[i] - s->mean);
+    }
+    double stddev = n > 1 ? squareRoot(squares / (n - 1)) : 0.0;
+    s->ci95 = n > 1 ? tCritical(n - 1) * stddev / squareRoot(n) : 0.0;
+    s->cv = s->mean > 0.0 ? 100.0 * stddev / s->mean : 0.0;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: freeImage / captureImage / restoreImage
+--------------------------------------------------------------------------------
+captureImage: Copy a live heap into an image (blocksToArray)
+restoreImage: Replace ctx->mm with a fresh list built from the image;
+              blockIDs and buddyIDs are kept, so buddy links survive
+RETURNS (both): 1, or 0 if out of memory
+*/
+
+static void freeImage(HeapImage *image) {
+    free(image->blocks);
+    image->blocks = NULL;
+    image->count = 0;
+}
+
+static int captureImage(MemoryManager *mm, HeapImage *image) {
+    int count = blocksToArray(mm, NULL, 0);
+    image->blocks = (MemoryBlock*)malloc(sizeof(MemoryBlock) * (count > 0 ? count : 1));
+    if (image->blocks == NULL) {
+        return 0;
+    }
+    image->count = blocksToArray(mm, image->blocks, count);
+    image->state = *mm;
+    image->state.head = NULL;
+    return 1;
+}
+
+static int restoreImage(BenchContext *ctx) {
+    const HeapImage *image = ctx->image;
+    freeMemoryManager(&ctx->mm);
+    ctx->mm = image->state;
+
+    MemoryBlock *tail = NULL;
+    for (int i = 0; i < image->count; i++) {
+        const MemoryBlock *b = &image->blocks[i];
+        MemoryBlock *block = createBlock(NULL, b->isHole, b->startAddress,
+                                         b->endAddress, b->processID);
+        if (block == NULL) {
+            freeMemoryManager(&ctx->mm);
+            return 0;
+        }
+        block->blockID = b->blockID;
+        block->buddyID = b->buddyID;
+        block->realSize = b->realSize;
+        if (tail == NULL) {
+            ctx->mm.head = block;
+        } else {
+            tail->next = block;
+        }
+        tail = block;
+    }
+    ctx->nextPid = image->state.processCounter + 1;
+    return 1;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: blockSize / chance
+--------------------------------------------------------------------------------
+blockSize: A size uniform in [mean - spread * mean, mean + spread * mean]
+chance:    1 with probability p
+*/
+
+static int blockSize(WorkloadRNG *rng, double spread) {
+    int half = (int)(spread * MICROBENCH_MEAN_KB);
+    int size = MICROBENCH_MEAN_KB - half + (int)workloadRange(rng, (uint32_t)(2 * half + 1));
+    return size > 0 ? size : 1;
+}
+
+static int chance(WorkloadRNG *rng, double p) {
+    return (double)(workloadNext(rng) >> 11) < p * (double)(1ULL << 53);
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: buildListImage
+--------------------------------------------------------------------------------
+PURPOSE: Lay out a block-list heap of the shape directly
+
+- A block after a hole is a process (a real heap has no two holes in a
+  row: deallocation merges them); any other block is a hole with
+  probability q = ratio / (1 - ratio), which makes 'ratio' of all
+  blocks holes. Random rather than evenly spaced, so every neighbour
+  pattern - and so every merge case of deallocateMemory - occurs
+  (ratio 0.5 is the exception: holes and processes alternate)
+- The last block is a process, followed by a tail hole big enough for a
+  whole batch of allocations, so no allocation fails because the heap
+  ran out (firstFit may still walk the whole list to get there)
+
+EXAMPLE (8 blocks, ratio 0.25):
+    [P1][H][P2][P3][H][P4][P5][P6] [tail hole]
+*/
+
+static int buildListImage(HeapImage *image, int blocks, double holeRatio,
+                          double spread, WorkloadRNG *rng) {
+    image->blocks = (MemoryBlock*)calloc(blocks + 1, sizeof(MemoryBlock));
+    if (image->blocks == NULL) {
+        return 0;
+    }
+
+    MemoryManager *state = &image->state;
+    memset(state, 0, sizeof(*state));
+    state->osMemory = MICROBENCH_OS_KB;
+
+    double q = holeRatio / (1.0 - holeRatio);
+    int address = MICROBENCH_OS_KB;
+    for (int i = 0; i < blocks; i++) {
+        MemoryBlock *b = &image->blocks[i];
+        b->isHole = chance(rng, q) && i != blocks - 1 &&
+                    (i == 0 || !image->blocks[i - 1].isHole);
+        b->startAddress = address;
+        b->size = blockSize(rng, spread);
+        b->endAddress = address + b->size - 1;
+        b->processID = b->isHole ? -1 : ++state->processCounter;
+        b->blockID = i + 1;
+        b->buddyID = -1;
+        b->realSize = (size_t)b->size * 1024;
+        address += b->size;
+        if (b->isHole) {
+            state->numHoles++;
+            state->freeMemory += b->size;
+        } else {
+            state->numProcesses++;
+        }
+    }
+
+    MemoryBlock *tail = &image->blocks[blocks];
+    int tailKB = MICROBENCH_MAX_BATCH * (MICROBENCH_MEAN_KB * 2);
+    tail->isHole = 1;
+    tail->startAddress = address;
+    tail->size = tailKB;
+    tail->endAddress = address + tailKB - 1;
+    tail->processID = -1;
+    tail->blockID = blocks + 1;
+    tail->buddyID = -1;
+    tail->realSize = (size_t)tailKB * 1024;
+    address += tailKB;
+
+    image->count = blocks + 1;
+    state->numHoles++;
+    state->freeMemory += tailKB;
+    state->totalMemory = address;
+    state->userMemory = address - MICROBENCH_OS_KB;
+    state->nextBlockID = blocks + 2;
+    state->measureFaults = 0;
+    return 1;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: buildBuddyImage
+--------------------------------------------------------------------------------
+PURPOSE: A buddy heap of the shape, built by the engine itself
+
+1. A power-of-2 region twice what the blocks and one batch need
+2. buddyAllocate every block (sizes rounded up to powers of 2)
+3. Turn each process into a hole with probability 'ratio', unless that
+   would make a free buddy pair (buddyDeallocate would have merged it):
+   its buddy must not be a hole, and no hole may name it as its buddy
+   (so a shape can end up with somewhat fewer holes than asked for)
+*/
+
+static int buildBuddyImage(HeapImage *image, int blocks, double holeRatio,
+                           double spread, WorkloadRNG *rng) {
+
+    // STEP 1: Region
+    long long needed = (long long)MICROBENCH_MAX_BATCH * nextPowerOf2(MICROBENCH_MEAN_KB);
+    int *sizes = (int*)malloc(sizeof(int) * blocks);
+    if (sizes == NULL) {
+        return 0;
+    }
+    for (int i = 0; i < blocks; i++) {
+        sizes[i] = blockSize(rng, spread);
+        needed += nextPowerOf2(sizes[i]);
+    }
+    int region = nextPowerOf2((int)(needed * 2));
+
+    MemoryManager mm;
+    memset(&mm, 0, sizeof(mm));
+    mm.osMemory = MICROBENCH_OS_KB;
+    mm.totalMemory = MICROBENCH_OS_KB + region;
+    mm.userMemory = region;
+    mm.nextBlockID = 1;
+    mm.useBuddySystem = 1;
+    mm.measureFaults = 0;
+    mm.head = createBlock(&mm, 1, MICROBENCH_OS_KB, MICROBENCH_OS_KB + region - 1, -1);
+    if (mm.head == NULL) {
+        free(sizes);
+        return 0;
+    }
+    mm.freeMemory = region;
+    mm.numHoles = 1;
+
+    // STEP 2: Allocate
+    for (int i = 0; i < blocks; i++) {
+        buddyAllocate(&mm, sizes[i], NULL, 0);
+    }
+    free(sizes);
+
+    // STEP 3: Holes (blocks by ID; how many holes name each block as buddy)
+    MemoryBlock **byID = (MemoryBlock**)calloc(mm.nextBlockID, sizeof(MemoryBlock*));
+    int *namedByHole = (int*)calloc(mm.nextBlockID, sizeof(int));
+    if (byID == NULL || namedByHole == NULL) {
+        free(byID);
+        free(namedByHole);
+        freeMemoryManager(&mm);
+        return 0;
+    }
+    for (MemoryBlock *b = mm.head; b != NULL; b = b->next) {
+        byID[b->blockID] = b;
+        if (b->isHole && b->buddyID != -1) {
+            namedByHole[b->buddyID]++;
+        }
+    }
+    for (MemoryBlock *b = mm.head; b != NULL; b = b->next) {
+        if (b->isHole || !chance(rng, holeRatio)) {
+            continue;
+        }
+        MemoryBlock *buddy = b->buddyID != -1 ? byID[b->buddyID] : NULL;
+        if ((buddy != NULL && buddy->isHole) || namedByHole[b->blockID] > 0) {
+            continue;
+        }
+        b->isHole = 1;
+        b->processID = -1;
+        mm.numProcesses--;
+        mm.numHoles++;
+        mm.freeMemory += b->size;
+        if (b->buddyID != -1) {
+            namedByHole[b->buddyID]++;
+        }
+    }
+    free(byID);
+    free(namedByHole);
+
+    int ok = captureImage(&mm, image);
+    freeMemoryManager(&mm);
+    return ok;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: findCandidates / pickTargets
+--------------------------------------------------------------------------------
+findCandidates: PIDs of the image's processes whose neighbours match the
+                case, at least 3 blocks apart, so freeing one never
+                changes the neighbours of another
+pickTargets:    'batch' of them, spread evenly over the list (the middle
+                one of each equal share), so a batch walks as far on
+                average as a single call would
+*/
+
+static int findCandidates(BenchContext *ctx, const BenchCase *bc) {
+    const HeapImage *image = ctx->image;
+    ctx->numCandidates = 0;
+    int last = -3;
+    for (int i = 0; i < image->count; i++) {
+        const MemoryBlock *b = &image->blocks[i];
+        if (b->isHole || i - last < 3) {
+            continue;
+        }
+        int prevHole = i > 0 && image->blocks[i - 1].isHole;
+        int nextHole = i + 1 < image->count && image->blocks[i + 1].isHole;
+        if ((bc->wantPrevHole != -1 && prevHole != bc->wantPrevHole) ||
+            (bc->wantNextHole != -1 && nextHole != bc->wantNextHole)) {
+            continue;
+        }
+        ctx->candidates[ctx->numCandidates++] = b->processID;
+        last = i;
+    }
+    return ctx->numCandidates;
+}
+
+static void pickTargets(BenchContext *ctx, int batch) {
+    for (int i = 0; i < batch; i++) {
+        long long index = ((long long)(2 * i + 1) * ctx->numCandidates) / (2 * batch);
+        ctx->targets[i] = ctx->candidates[index];
+    }
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: timeSample
+--------------------------------------------------------------------------------
+PURPOSE: One sample: (fresh heap,) clock, 'batch' calls, clock
+
+RETURNS: Nanoseconds per call, or -1 if the heap could not be restored
+*/
+
+static double timeSample(BenchContext *ctx, const BenchCase *bc, int batch) {
+    if (bc->mutates && !restoreImage(ctx)) {
+        return -1.0;
+    }
+    if (bc->maxBatch == 0) {
+        pickTargets(ctx, batch);
+    }
+    long long start = nowNanoseconds();
+    bc->run(ctx, batch);
+    long long elapsed = nowNanoseconds() - start;
+    return (double)elapsed / batch;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: runCase
+--------------------------------------------------------------------------------
+ALGORITHM:
+1. Pristine heap; deallocations find their targets (none: "n/a" row)
+2. Calibrate: one call alone gives the batch that fills about
+   MICROBENCH_SAMPLE_NS (at most what the case allows)
+3. Warmup samples (caches, branch predictors, malloc's free lists),
+   thrown away
+4. Measured samples, summarized into one row
+*/
+
+static void runCase(BenchContext *ctx, const BenchCase *bc, const MicrobenchConfig *config,
+                    double *samples) {
+
+    // STEP 1: Pristine heap, targets
+    if (!restoreImage(ctx)) {
+        printf("  %-24s out of memory\n", bc->name);
+        return;
+    }
+    int maxBatch = bc->maxBatch;
+    if (maxBatch == 0) {
+        maxBatch = findCandidates(ctx, bc);
+        if (maxBatch == 0) {
+            printf("  %-24s      n/a (no process with these neighbours in this shape)\n",
+                   bc->name);
+            return;
+        }
+        if (maxBatch > MICROBENCH_MAX_BATCH) {
+            maxBatch = MICROBENCH_MAX_BATCH;
+        }
+    }
+
+    // STEP 2: Calibrate
+    double single = timeSample(ctx, bc, 1);
+    int batch = maxBatch;
+    if (single > 0.0 && single * maxBatch > MICROBENCH_SAMPLE_NS) {
+        batch = (int)(MICROBENCH_SAMPLE_NS / single);
+        batch = batch < 1 ? 1 : batch;
+    }
+
+    // STEP 3: Warmup
+    for (int i = 0; i < config->warmup; i++) {
+        timeSample(ctx, bc, batch);
+    }
+
+    // STEP 4: Measure
+    for (int i = 0; i < config->repetitions; i++) {
+        samples[i] = timeSample(ctx, bc, batch);
+        if (samples[i] < 0.0) {
+            printf("  %-24s out of memory\n", bc->name);
+            return;
+        }
+    }
+    SampleSummary s;
+    summarize(samples, config->repetitions, &s);
+    printf("  %-24s %7d %11.1f %11.1f %11.1f ±%9.1f %6.1f%% %11.1f\n",
+           bc->name, batch, s.min, s.median, s.mean, s.ci95, s.cv, s.max);
+}
+
+
+/*
+================================================================================
+FUNCTION: runMicrobenchmarks
+================================================================================
+ALGORITHM:
+1. Validate the configuration; at least one benchmark selected
+2. For every shape: build the images the selected benchmarks need (same
+   seed for every shape, so a shape is the same heap in every run)
+3. One row per benchmark, then free the shape
+*/
+
+int runMicrobenchmarks(const MicrobenchConfig *config) {
+
+    // STEP 1: Validate
+    for (int i = 0; i < config->numBlockCounts; i++) {
+        if (config->blockCounts[i] < 1 || config->blockCounts[i] > MICROBENCH_MAX_BLOCKS) {
+            fprintf(stderr, "Error: block counts must be 1-%d\n", MICROBENCH_MAX_BLOCKS);
+            return 1;
+        }
+    }
+    for (int i = 0; i < config->numHoleRatios; i++) {
+        if (config->holeRatios[i] < 0.0 || config->holeRatios[i] > 0.5) {
+            fprintf(stderr, "Error: hole ratios must be 0-0.5 (holes are never neighbours)\n");
+            return 1;
+        }
+    }
+    for (int i = 0; i < config->numSpreads; i++) {
+        if (config->spreads[i] < 0.0 || config->spreads[i] > 0.95) {
+            fprintf(stderr, "Error: size spreads must be 0-0.95\n");
+            return 1;
+        }
+    }
+    if (config->repetitions < 2 || config->warmup < 0) {
+        fprintf(stderr, "Error: need at least 2 repetitions and no negative warmup\n");
+        return 1;
+    }
+    int wantList = 0, wantBuddy = 0;
+    for (int c = 0; c < NUM_BENCH_CASES; c++) {
+        if (isSelected(config->only, benchCases[c].name)) {
+            wantList |= benchCases[c].heap == HEAP_LIST;
+            wantBuddy |= benchCases[c].heap == HEAP_BUDDY;
+        }
+    }
+    if (!wantList && !wantBuddy) {
+        fprintf(stderr, "Error: no benchmark matches \"%s\"; the benchmarks are:\n", config->only);
+        for (int c = 0; c < NUM_BENCH_CASES; c++) {
+            fprintf(stderr, "  %s\n", benchCases[c].name);
+        }
+        return 1;
+    }
+
+    double *samples = (double*)malloc(sizeof(double) * config->repetitions);
+    if (samples == NULL) {
+        return 1;
+    }
+
+    printf("Microbenchmarks: ns per call, %d samples after %d warmup samples\n"
+           "(batch = calls per sample; ± = 95%% confidence interval of the mean;\n"
+           " cv = standard deviation / mean)\n",
+           config->repetitions, config->warmup);
+
+    // STEP 2: Shapes
+    for (int bi = 0; bi < config->numBlockCounts; bi++)
+    for (int hi = 0; hi < config->numHoleRatios; hi++)
+    for (int si = 0; si < config->numSpreads; si++) {
+        int blocks = config->blockCounts[bi];
+        double holeRatio = config->holeRatios[hi];
+        double spread = config->spreads[si];
+
+        HeapImage listImage, buddyImage;
+        memset(&listImage, 0, sizeof(listImage));
+        memset(&buddyImage, 0, sizeof(buddyImage));
+        WorkloadRNG rng;
+        int buddyHere = wantBuddy && blocks <= MICROBENCH_MAX_BUDDY_BLOCKS;
+        int ok = 1;
+        if (wantList) {
+            workloadSeed(&rng, config->seed);
+            ok = ok && buildListImage(&listImage, blocks, holeRatio, spread, &rng);
+        }
+        if (buddyHere) {
+            workloadSeed(&rng, config->seed);
+            ok = ok && buildBuddyImage(&buddyImage, blocks, holeRatio, spread, &rng);
+        }
+
+        int largest = listImage.count > buddyImage.count ? listImage.count : buddyImage.count;
+        BenchContext ctx;
+        memset(&ctx, 0, sizeof(ctx));
+        ctx.requestKB = MICROBENCH_MEAN_KB;
+        ctx.candidates = (int*)malloc(sizeof(int) * (largest + 1));
+        ctx.jsonSize = (largest + 2 * MICROBENCH_MAX_BATCH + 1) * MICROBENCH_JSON_PER_BLOCK + 65536;
+        ctx.json = (char*)malloc(ctx.jsonSize);
+        if (!ok || ctx.candidates == NULL || ctx.json == NULL) {
+            fprintf(stderr, "Error: out of memory building a %d-block heap\n", blocks);
+            free(ctx.candidates);
+            free(ctx.json);
+            freeImage(&listImage);
+            freeImage(&buddyImage);
+            free(samples);
+            return 1;
+        }
+
+        printf("\nShape: %d blocks, %.0f%% holes, sizes %d KB ± %.0f%%\n",
+               blocks, holeRatio * 100.0, MICROBENCH_MEAN_KB, spread * 100.0);
+        if (wantList) {
+            printf("  list heap:  %d blocks, %d holes (with the tail hole)\n",
+                   listImage.count, listImage.state.numHoles);
+        }
+        if (buddyHere) {
+            printf("  buddy heap: %d blocks, %d holes (%d KB region)\n",
+                   buddyImage.count, buddyImage.state.numHoles, buddyImage.state.userMemory);
+        } else if (wantBuddy) {
+            printf("  buddy heap: skipped (building one is O(n²) above %d blocks)\n",
+                   MICROBENCH_MAX_BUDDY_BLOCKS);
+        }
+        printf("  %-24s %7s %11s %11s %11s %10s %7s %11s\n",
+               "function", "batch", "min", "median", "mean", "± 95%", "cv", "max");
+
+        // STEP 3: Rows
+        for (int c = 0; c < NUM_BENCH_CASES; c++) {
+            const BenchCase *bc = &benchCases[c];
+            if (!isSelected(config->only, bc->name) ||
+                (bc->heap == HEAP_BUDDY && !buddyHere)) {
+                continue;
+            }
+            ctx.image = bc->heap == HEAP_BUDDY ? &buddyImage : &listImage;
+            runCase(&ctx, bc, config, samples);
+            fflush(stdout);
+        }
+
+        freeMemoryManager(&ctx.mm);
+        free(ctx.candidates);
+        free(ctx.json);
+        freeImage(&listImage);
+        freeImage(&buddyImage);
+    }
+
+    free(samples);
+    return 0;
+}
+
+
+/*
+================================================================================
+END OF FILE: microbench.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. benchCases[] - firstFit / bestFit / worstFit, deallocateMemory in its
+   four merge cases, buddyAllocate / buddyDeallocate, compact,
+   calculateFragmentation, blocksToJSON, getStatsJSON
+2. buildListImage() / buildBuddyImage() - Heaps of a shape (block count,
+   hole ratio, size spread), list laid out directly, buddy by the engine
+3. captureImage() / restoreImage() - A fresh heap before every sample
+4. runCase() - Calibrated batch, warmup, repetitions
+5. summarize() - min, median, mean ± 95% CI (Student's t), cv, max
+6. microbenchDefaults() / microbenchParseList() / runMicrobenchmarks()
+================================================================================
+*/
@@ -0,0 +1,70 @@
+/*
+================================================================================
+FILE: operations.c
+PURPOSE: Implement the allocate / deallocate operations of every front end
+================================================================================
+*/
+
+#include <stddef.h>     // NULL
+#include "../include/operations.h"
+#include "../include/memory_manager.h"
+#include "../include/slab_cache.h"
+
+
+/*
+================================================================================
+FUNCTION: opAllocate
+================================================================================
+*/
+
+int opAllocate(MemoryManager *mm, int sizeKB, AllocationAlgorithm algorithm,
+               int *processID) {
+
+    int start = -1;
+    if (sizeKB > 0 && mm->useBuddySystem) {
+        // buddyAllocate() takes the next PID itself
+        start = buddyAllocate(mm, sizeKB, NULL, 0);
+    } else {
+        ++(mm->processCounter);
+        if (sizeKB > 0) {
+            start = allocateMemory(mm, mm->processCounter, sizeKB, algorithm);
+        }
+    }
+    if (processID != NULL) {
+        *processID = mm->processCounter;
+    }
+    return start;
+}
+
+
+/*
+================================================================================
+FUNCTION: opDeallocate
+================================================================================
+*/
+
+int opDeallocate(MemoryManager *mm, int processID) {
+
+    if (processID <= 0) {
+        return 0;
+    }
+    // Slab blocks are released by their cache, never directly
+    if (slabOwnsProcess(mm, processID)) {
+        return -1;
+    }
+    return mm->useBuddySystem
+        ? buddyDeallocate(mm, processID, NULL, 0)
+        : deallocateMemory(mm, processID);
+}
+
+
+/*
+================================================================================
+END OF FILE: operations.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. opAllocate() - Buddy or list allocation, next PID
+2. opDeallocate() - Slab check, buddy or list free
+================================================================================
+*/
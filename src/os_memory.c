@@ -10,14 +10,25 @@ DESCRIPTION:
 ================================================================================
 */
 
+#define _GNU_SOURCE         // RUSAGE_THREAD on Linux (ignored on macOS)
+
 #include <stdio.h>          // printf, snprintf
 #include <string.h>         // memset
+#include <strings.h>        // strcasecmp
+#include <limits.h>         // INT_MAX
 #include <sys/mman.h>       // mmap, munmap, PROT_READ, PROT_WRITE, MAP_PRIVATE, MAP_ANONYMOUS
 #include <unistd.h>         // sysconf, _SC_PAGESIZE
 #include <sys/types.h>      // size_t
 #include <sys/sysctl.h>     // sysctl, HW_MEMSIZE (macOS)
+#include <sys/resource.h>   // getrusage, RUSAGE_SELF
+
+#ifdef __linux__
+#include <linux/perf_event.h>   // perf_event_attr, PERF_COUNT_HW_CACHE_MISSES
+#include <sys/syscall.h>        // SYS_perf_event_open
+#endif
 
 #include "../include/os_memory.h"
+#include "../include/logger.h"
 
 
 /*
@@ -117,7 +128,7 @@ OSRegion os_region_alloc(size_t sizeBytes) {
     region.size = 0;
 
     if (sizeBytes == 0) {
-        printf("[os_memory] Error: Cannot allocate 0 bytes\n");
+        LOG_WARN("[os_memory] Error: Cannot allocate 0 bytes\n");
         return region;
     }
 
@@ -125,6 +136,23 @@ OSRegion os_region_alloc(size_t sizeBytes) {
     size_t pageSize = os_get_page_size();
     size_t alignedSize = ((sizeBytes + pageSize - 1) / pageSize) * pageSize;
 
+    // A pool that could never be filled is not mapped at all
+    OSBackingKind kind = os_backing_for(alignedSize);
+    if (kind == OS_BACKING_NONE) {
+        LOG_WARN("[os_memory] %zu MB is more than half of physical RAM: not mapped\n",
+                 alignedSize / (1024 * 1024));
+        return region;
+    }
+
+    // Large regions: reserve no swap up front (pages still arrive on
+    // first touch, so an untouched GB costs nothing)
+    int flags = MAP_PRIVATE | MAP_ANON;
+#ifdef MAP_NORESERVE
+    if (kind == OS_BACKING_MMAP_LARGE) {
+        flags |= MAP_NORESERVE;
+    }
+#endif
+
     // STEP 2: Call mmap() — the real OS system call!
     //
     // This is where the magic happens:
@@ -135,7 +163,7 @@ OSRegion os_region_alloc(size_t sizeBytes) {
         NULL,                          // Let kernel choose address
         alignedSize,                   // Size (page-aligned)
         PROT_READ | PROT_WRITE,        // Read + Write permissions
-        MAP_PRIVATE | MAP_ANON,        // Private anonymous mapping
+        flags,                         // Private anonymous mapping
         -1,                            // No file descriptor
         0                              // No offset
     );
@@ -146,12 +174,20 @@ OSRegion os_region_alloc(size_t sizeBytes) {
         return region;
     }
 
+#ifdef MADV_HUGEPAGE
+    // Ask for transparent huge pages: one TLB entry per 2 MB instead of
+    // per 4 KB (only a hint; the kernel may ignore it)
+    if (kind == OS_BACKING_MMAP_LARGE) {
+        madvise(ptr, alignedSize, MADV_HUGEPAGE);
+    }
+#endif
+
     // STEP 4: Fill in the region struct
     region.basePtr = ptr;
     region.size = alignedSize;
 
-    printf("[os_memory] mmap() allocated %zu bytes at address %p (requested %zu)\n",
-           alignedSize, ptr, sizeBytes);
+    LOG_INFO("[os_memory] mmap() allocated %zu bytes at address %p (requested %zu)\n",
+             alignedSize, ptr, sizeBytes);
 
     return region;
 }
@@ -189,8 +225,8 @@ void os_region_free(OSRegion *region) {
     int result = munmap(region->basePtr, region->size);
 
     if (result == 0) {
-        printf("[os_memory] munmap() freed %zu bytes at address %p\n",
-               region->size, region->basePtr);
+        LOG_INFO("[os_memory] munmap() freed %zu bytes at address %p\n",
+                 region->size, region->basePtr);
     } else {
         perror("[os_memory] munmap() failed");
     }
@@ -319,7 +355,7 @@ void os_detect_memory_sizes(int *totalMemKB, int *osMemKB) {
             physPages = (long)(totalRAM / (pageSize > 0 ? pageSize : 4096));
         } else {
             // Ultimate fallback: assume 4 GB
-            printf("[os_memory] WARNING: Could not detect system memory, using 4 GB default\n");
+            LOG_WARN("[os_memory] WARNING: Could not detect system memory, using 4 GB default\n");
             *totalMemKB = 1024;
             *osMemKB = 256;
             return;
@@ -330,11 +366,11 @@ void os_detect_memory_sizes(int *totalMemKB, int *osMemKB) {
     size_t totalRAM_bytes = (size_t)physPages * (size_t)pageSize;
     size_t totalRAM_KB = totalRAM_bytes / 1024;
     
-    printf("\n[SYSTEM DETECTION] Using sysconf(_SC_PHYS_PAGES) × sysconf(_SC_PAGE_SIZE)\n");
-    printf("[SYSTEM DETECTION] Physical pages: %ld\n", physPages);
-    printf("[SYSTEM DETECTION] Page size: %ld bytes\n", pageSize);
-    printf("[SYSTEM DETECTION] Total physical RAM: %zu KB (%zu MB)\n", 
-           totalRAM_KB, totalRAM_KB / 1024);
+    LOG_INFO("\n[SYSTEM DETECTION] Using sysconf(_SC_PHYS_PAGES) × sysconf(_SC_PAGE_SIZE)\n"
+             "[SYSTEM DETECTION] Physical pages: %ld\n"
+             "[SYSTEM DETECTION] Page size: %ld bytes\n"
+             "[SYSTEM DETECTION] Total physical RAM: %zu KB (%zu MB)\n",
+             physPages, pageSize, totalRAM_KB, totalRAM_KB / 1024);
     
     // STEP 3: Compute managed pool size
     // Use 1/8192 of physical RAM as the managed pool
@@ -352,11 +388,195 @@ void os_detect_memory_sizes(int *totalMemKB, int *osMemKB) {
     // STEP 4: OS reserved = 25% of pool
     int osReservedKB = poolKB / 4;
     
-    printf("[SYSTEM DETECTION] Managed pool: %d KB (1/%d of physical RAM)\n", 
-           poolKB, (int)(totalRAM_KB / poolKB));
-    printf("[SYSTEM DETECTION] OS reserved: %d KB (25%%)\n", osReservedKB);
-    printf("[SYSTEM DETECTION] User memory: %d KB\n", poolKB - osReservedKB);
+    LOG_INFO("[SYSTEM DETECTION] Managed pool: %d KB (1/%d of physical RAM)\n"
+             "[SYSTEM DETECTION] OS reserved: %d KB (25%%)\n"
+             "[SYSTEM DETECTION] User memory: %d KB\n",
+             poolKB, (int)(totalRAM_KB / poolKB), osReservedKB, poolKB - osReservedKB);
     
     *totalMemKB = poolKB;
     *osMemKB = osReservedKB;
 }
+
+
+/*
+================================================================================
+FUNCTION: os_size_to_kb
+================================================================================
+EXAMPLE:
+    os_size_to_kb(4, "GB")  → 4194304
+    os_size_to_kb(768, NULL) → 768
+*/
+
+int os_size_to_kb(long long value, const char *unit) {
+    long long multiplier;
+    if (unit == NULL || unit[0] == '\0' || strcasecmp(unit, "KB") == 0) {
+        multiplier = 1;
+    } else if (strcasecmp(unit, "MB") == 0) {
+        multiplier = 1024;
+    } else if (strcasecmp(unit, "GB") == 0) {
+        multiplier = 1024 * 1024;
+    } else {
+        return -1;
+    }
+
+    if (value <= 0 || value > INT_MAX / multiplier) {
+        return -1;
+    }
+    return (int)(value * multiplier);
+}
+
+
+/*
+================================================================================
+FUNCTION: os_backing_for / os_backing_name
+================================================================================
+*/
+
+OSBackingKind os_backing_for(size_t sizeBytes) {
+    long physPages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGE_SIZE);
+    size_t totalRAM = (physPages > 0 && pageSize > 0)
+        ? (size_t)physPages * (size_t)pageSize
+        : os_get_total_ram();
+
+    // Unknown RAM size: trust the caller and map
+    if (totalRAM > 0 && sizeBytes > totalRAM / 2) {
+        return OS_BACKING_NONE;
+    }
+    return sizeBytes >= OS_LARGE_REGION_BYTES ? OS_BACKING_MMAP_LARGE : OS_BACKING_MMAP;
+}
+
+const char* os_backing_name(OSBackingKind kind) {
+    switch (kind) {
+        case OS_BACKING_MMAP:       return "mmap";
+        case OS_BACKING_MMAP_LARGE: return "mmap_large";
+        default:                    return "none";
+    }
+}
+
+
+/*
+================================================================================
+FUNCTION: os_region_residency
+================================================================================
+PURPOSE: Find out which pages of a region are actually in physical RAM
+
+DETAILED EXPLANATION:
+
+    mmap() only reserves VIRTUAL address space. A physical frame is
+    attached to a page the first time it is touched (demand paging), and
+    the kernel may later evict it. mincore() reports, for every page of
+    a range, whether it is resident right now.
+
+    We scan the whole backing region with a single mincore() call instead
+    of one call per block: one syscall, one pass over the page tables,
+    and callers slice the resulting vector per block afterwards.
+
+    macOS declares the vector as char*, Linux as unsigned char*; both
+    set bit 0 for a resident page.
+*/
+
+size_t os_region_residency(const OSRegion *region, unsigned char *vec, size_t vecLen) {
+    if (region == NULL || region->basePtr == NULL || vec == NULL) {
+        return 0;
+    }
+
+    size_t pageSize = os_get_page_size();
+    size_t pages = (region->size + pageSize - 1) / pageSize;
+    if (pages > vecLen) {
+        return 0;
+    }
+
+#if defined(__APPLE__)
+    int result = mincore(region->basePtr, region->size, (char *)vec);
+#else
+    int result = mincore(region->basePtr, region->size, vec);
+#endif
+
+    if (result != 0) {
+        perror("[os_memory] mincore() failed");
+        return 0;
+    }
+
+    return pages;
+}
+
+
+/*
+================================================================================
+FUNCTION: os_get_fault_counts
+================================================================================
+PURPOSE: Sample the kernel's page-fault counters
+
+HOW IT WORKS:
+    getrusage() fills a struct rusage; ru_minflt counts faults served
+    from memory (zero-fill, page cache) and ru_majflt counts faults that
+    needed I/O. RUSAGE_THREAD (Linux) keeps other server threads out of
+    the numbers; macOS only offers the process-wide RUSAGE_SELF.
+*/
+
+void os_get_fault_counts(long *minorFaults, long *majorFaults) {
+    struct rusage usage;
+
+#if defined(RUSAGE_THREAD)
+    int result = getrusage(RUSAGE_THREAD, &usage);
+#else
+    int result = getrusage(RUSAGE_SELF, &usage);
+#endif
+
+    if (result != 0) {
+        *minorFaults = 0;
+        *majorFaults = 0;
+        return;
+    }
+
+    *minorFaults = usage.ru_minflt;
+    *majorFaults = usage.ru_majflt;
+}
+
+
+/*
+================================================================================
+FUNCTION: os_cache_counter_open / os_cache_counter_read / os_cache_counter_close
+================================================================================
+PURPOSE: Hardware cache-miss counter for this thread
+
+HOW IT WORKS:
+    glibc has no wrapper for perf_event_open(), so we call it through
+    syscall(). pid = 0, cpu = -1 means "this thread, on any CPU". Kernel
+    and hypervisor events are excluded so only our own loop is counted.
+*/
+
+int os_cache_counter_open(void) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    return (fd < 0) ? -1 : (int)fd;
+#else
+    return -1;
+#endif
+}
+
+long long os_cache_counter_read(int counter) {
+    if (counter < 0) {
+        return -1;
+    }
+    long long value = 0;
+    if (read(counter, &value, sizeof(value)) != (ssize_t)sizeof(value)) {
+        return -1;
+    }
+    return value;
+}
+
+void os_cache_counter_close(int counter) {
+    if (counter >= 0) {
+        close(counter);
+    }
+}
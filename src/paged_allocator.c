@@ -0,0 +1,876 @@
+/*
+================================================================================
+FILE: paged_allocator.c
+PURPOSE: Implement non-contiguous (paged) allocation
+DESCRIPTION:
+    - Free-frame bitmap searched with count-trailing-zeros
+    - Per-process page tables indexed directly by PID
+    - Conversion between contiguous and paged mode
+    - Head-to-head comparison with first/best/worst fit and buddy
+================================================================================
+*/
+
+#include <stdio.h>      // snprintf
+#include <stdlib.h>     // malloc, calloc, realloc, free, qsort
+#include <string.h>     // memset
+#include <time.h>       // clock_gettime, CLOCK_MONOTONIC
+#include "../include/paged_allocator.h"
+#include "../include/memory_manager.h"
+#include "../include/os_memory.h"
+#include "../include/workload.h"
+#include "../include/stream_kernels.h"
+#include "../include/history.h"
+
+
+// Upper bound on the comparison stream (one latency sample per op per engine)
+#define MAX_COMPARE_OPS 200000
+
+
+/*
+================================================================================
+HELPER: frameBytes / framePtr
+================================================================================
+PURPOSE: Real address of frame f (NULL when there is no backing region)
+*/
+
+static size_t frameBytes(const PagedAllocator *pa) {
+    return (size_t)pa->frameSizeKB * 1024;
+}
+
+static char* framePtr(const PagedAllocator *pa, int frame) {
+    if (pa->base == NULL) {
+        return NULL;
+    }
+    return pa->base + (size_t)frame * frameBytes(pa);
+}
+
+
+/*
+================================================================================
+FUNCTION: createPagedAllocator
+================================================================================
+PURPOSE: Build an all-free bitmap for the frames of user memory
+
+The bits past numFrames in the last word stay 0 ("not free"), so the
+search never hands out a frame that does not exist.
+*/
+
+PagedAllocator* createPagedAllocator(int userMemoryKB, int frameSizeKB, void *base) {
+
+    if (frameSizeKB <= 0 || userMemoryKB < frameSizeKB) {
+        return NULL;
+    }
+
+    PagedAllocator *pa = (PagedAllocator*)calloc(1, sizeof(PagedAllocator));
+    if (pa == NULL) {
+        return NULL;
+    }
+
+    pa->frameSizeKB = frameSizeKB;
+    pa->numFrames = userMemoryKB / frameSizeKB;
+    pa->freeFrames = pa->numFrames;
+    pa->numWords = (pa->numFrames + 63) / 64;
+    pa->base = (char*)base;
+
+    pa->freeBitmap = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)pa->numWords);
+    pa->frameOwner = (int*)malloc(sizeof(int) * (size_t)pa->numFrames);
+    if (pa->freeBitmap == NULL || pa->frameOwner == NULL) {
+        destroyPagedAllocator(pa);
+        return NULL;
+    }
+
+    for (int w = 0; w < pa->numWords; w++) {
+        pa->freeBitmap[w] = ~0ULL;
+    }
+    int tailBits = pa->numFrames % 64;
+    if (tailBits != 0) {
+        pa->freeBitmap[pa->numWords - 1] = (1ULL << tailBits) - 1;
+    }
+    for (int f = 0; f < pa->numFrames; f++) {
+        pa->frameOwner[f] = -1;
+    }
+
+    return pa;
+}
+
+
+/*
+================================================================================
+FUNCTION: destroyPagedAllocator
+================================================================================
+*/
+
+void destroyPagedAllocator(PagedAllocator *pa) {
+
+    if (pa == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < pa->processCapacity; i++) {
+        free(pa->processes[i].pageTable);
+    }
+    free(pa->processes);
+    free(pa->freeBitmap);
+    free(pa->frameOwner);
+    free(pa);
+}
+
+
+/*
+================================================================================
+HELPER: ensureProcessSlot
+================================================================================
+PURPOSE: Grow the PID-indexed process table so slot processID exists
+
+Doubles the capacity, so a stream of increasing PIDs costs O(1) amortized.
+*/
+
+static int ensureProcessSlot(PagedAllocator *pa, int processID) {
+
+    if (processID < pa->processCapacity) {
+        return 1;
+    }
+
+    int newCapacity = (pa->processCapacity > 0) ? pa->processCapacity : 64;
+    while (newCapacity <= processID) {
+        newCapacity *= 2;
+    }
+
+    PagedProcess *grown = (PagedProcess*)realloc(pa->processes,
+                                                 sizeof(PagedProcess) * (size_t)newCapacity);
+    if (grown == NULL) {
+        return 0;
+    }
+
+    for (int i = pa->processCapacity; i < newCapacity; i++) {
+        grown[i].processID = -1;
+        grown[i].sizeKB = 0;
+        grown[i].numPages = 0;
+        grown[i].pageTable = NULL;
+    }
+
+    pa->processes = grown;
+    pa->processCapacity = newCapacity;
+    return 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: pagedAllocate
+================================================================================
+PURPOSE: Take the first numPages free frames found from the search cursor
+
+HOW IT WORKS:
+1. numPages = ceil(sizeKB / frameSizeKB); fail early if too few frames
+2. Walk the bitmap one 64-bit word at a time, starting at searchCursor
+3. Inside a word, __builtin_ctzll(bits) is the lowest free frame and
+   bits &= bits - 1 clears it, so each frame costs one instruction pair
+4. Fill each frame with the PID pattern, like the contiguous allocators
+
+The cursor rotates (next-fit over words), so after frees the search does
+not keep rescanning full words at the start of memory.
+*/
+
+int pagedAllocate(PagedAllocator *pa, int processID, int sizeKB) {
+
+    if (pa == NULL || processID < 0 || sizeKB <= 0) {
+        return -1;
+    }
+
+    int numPages = (sizeKB + pa->frameSizeKB - 1) / pa->frameSizeKB;
+    if (numPages > pa->freeFrames) {
+        return -1;
+    }
+
+    if (!ensureProcessSlot(pa, processID)) {
+        return -1;
+    }
+    PagedProcess *proc = &pa->processes[processID];
+    if (proc->processID != -1) {
+        return -1;      // PID already has memory
+    }
+
+    int *pageTable = (int*)malloc(sizeof(int) * (size_t)numPages);
+    if (pageTable == NULL) {
+        return -1;
+    }
+
+    int got = 0;
+    int w = pa->searchCursor;
+    while (got < numPages) {
+        uint64_t bits = pa->freeBitmap[w];
+
+        while (bits != 0 && got < numPages) {
+            int frame = w * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            pa->frameOwner[frame] = processID;
+            pageTable[got++] = frame;
+
+            char *ptr = framePtr(pa, frame);
+            if (ptr != NULL) {
+                blockFill(ptr, processID & 0xFF, frameBytes(pa));
+            }
+        }
+
+        pa->freeBitmap[w] = bits;
+        if (got < numPages) {
+            w = (w + 1 == pa->numWords) ? 0 : w + 1;
+        }
+    }
+    pa->searchCursor = w;
+
+    proc->processID = processID;
+    proc->sizeKB = sizeKB;
+    proc->numPages = numPages;
+    proc->pageTable = pageTable;
+
+    pa->freeFrames -= numPages;
+    pa->internalFragKB += (long long)numPages * pa->frameSizeKB - sizeKB;
+
+    return pageTable[0];
+}
+
+
+/*
+================================================================================
+FUNCTION: pagedDeallocate
+================================================================================
+PURPOSE: Zero the process's frames and set their bits again
+
+No merging step exists: a free frame is usable on its own.
+*/
+
+int pagedDeallocate(PagedAllocator *pa, int processID) {
+
+    if (pa == NULL || processID < 0 || processID >= pa->processCapacity) {
+        return 0;
+    }
+
+    PagedProcess *proc = &pa->processes[processID];
+    if (proc->processID == -1) {
+        return 0;
+    }
+
+    for (int p = 0; p < proc->numPages; p++) {
+        int frame = proc->pageTable[p];
+
+        char *ptr = framePtr(pa, frame);
+        if (ptr != NULL) {
+            blockFill(ptr, 0, frameBytes(pa));
+        }
+
+        pa->frameOwner[frame] = -1;
+        pa->freeBitmap[frame / 64] |= 1ULL << (frame % 64);
+    }
+
+    pa->freeFrames += proc->numPages;
+    pa->internalFragKB -= (long long)proc->numPages * pa->frameSizeKB - proc->sizeKB;
+
+    free(proc->pageTable);
+    proc->pageTable = NULL;
+    proc->processID = -1;
+    proc->sizeKB = 0;
+    proc->numPages = 0;
+
+    return 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: pagedTranslate
+================================================================================
+PURPOSE: Virtual KB → page → frame → physical KB (one table lookup)
+*/
+
+long pagedTranslate(const PagedAllocator *pa, int processID, int virtualKB) {
+
+    if (pa == NULL || processID < 0 || processID >= pa->processCapacity) {
+        return -1;
+    }
+
+    const PagedProcess *proc = &pa->processes[processID];
+    if (proc->processID == -1 || virtualKB < 0 || virtualKB >= proc->sizeKB) {
+        return -1;
+    }
+
+    int page = virtualKB / pa->frameSizeKB;
+    int offset = virtualKB % pa->frameSizeKB;
+    return (long)proc->pageTable[page] * pa->frameSizeKB + offset;
+}
+
+
+/*
+================================================================================
+FUNCTION: pagedFreeRuns / pagedLargestFreeRun
+================================================================================
+PURPOSE: Count runs of consecutive free frames (and the longest one, in KB)
+*/
+
+int pagedFreeRuns(const PagedAllocator *pa) {
+
+    int runs = 0;
+    for (int f = 0; f < pa->numFrames; f++) {
+        if (pa->frameOwner[f] == -1 && (f == 0 || pa->frameOwner[f - 1] != -1)) {
+            runs++;
+        }
+    }
+    return runs;
+}
+
+int pagedLargestFreeRun(const PagedAllocator *pa) {
+
+    int largest = 0;
+    int current = 0;
+    for (int f = 0; f < pa->numFrames; f++) {
+        if (pa->frameOwner[f] == -1) {
+            current++;
+            if (current > largest) {
+                largest = current;
+            }
+        } else {
+            current = 0;
+        }
+    }
+    return largest * pa->frameSizeKB;
+}
+
+
+/*
+================================================================================
+FUNCTION: pagedBlocksToJSON
+================================================================================
+PURPOSE: Same JSON shape as blocksToJSON, one block per run of frames
+
+Each run is turned into a temporary MemoryBlock and serialized with
+blockToJSON(), so the frontend cannot tell the difference.
+*/
+
+// The run of frames starting at *frame as a block; *frame moves past it
+static void nextRun(const PagedAllocator *pa, int osMemory, int *frame, int runID,
+                    MemoryBlock *block) {
+    int runStart = *frame;
+    int owner = pa->frameOwner[runStart];
+    int f = runStart;
+    while (f < pa->numFrames && pa->frameOwner[f] == owner) {
+        f++;
+    }
+    int runFrames = f - runStart;
+    *frame = f;
+
+    block->isHole = (owner == -1);
+    block->startAddress = osMemory + runStart * pa->frameSizeKB;
+    block->size = runFrames * pa->frameSizeKB;
+    block->endAddress = block->startAddress + block->size - 1;
+    block->processID = owner;
+    block->blockID = runID;
+    block->buddyID = -1;
+    block->realPtr = framePtr(pa, runStart);
+    block->realSize = (size_t)runFrames * frameBytes(pa);
+    block->next = NULL;
+}
+
+void pagedBlocksToJSON(const PagedAllocator *pa, int osMemory, char *buffer, int bufferSize) {
+
+    // STEP 1: OS block first (always at address 0)
+    int written = snprintf(buffer, bufferSize,
+        "[{\"id\":0,\"startAddress\":0,\"endAddress\":%d,"
+        "\"size\":%d,\"isHole\":false,\"processId\":\"OS\","
+        "\"blockID\":0,\"buddyID\":-1}",
+        osMemory - 1,
+        osMemory
+    );
+
+    // STEP 2: One block per run of frames with the same owner
+    int runID = 1;
+    int f = 0;
+    while (f < pa->numFrames) {
+        MemoryBlock block;
+        nextRun(pa, osMemory, &f, runID++, &block);
+
+        char blockJSON[512];
+        blockToJSON(&block, blockJSON, sizeof(blockJSON));
+
+        int remaining = bufferSize - written;
+        if (remaining > (int)strlen(blockJSON) + 3) {
+            written += snprintf(buffer + written, remaining, ",%s", blockJSON);
+        }
+    }
+
+    // STEP 3: Close the JSON array
+    if (written < bufferSize - 1) {
+        buffer[written] = ']';
+        buffer[written + 1] = '\0';
+    }
+}
+
+int pagedBlocksToArray(const PagedAllocator *pa, int osMemory,
+                       MemoryBlock *blocks, int maxBlocks) {
+    int count = 0;
+    int f = 0;
+    while (f < pa->numFrames) {
+        MemoryBlock block;
+        nextRun(pa, osMemory, &f, count + 1, &block);
+        if (count < maxBlocks) {
+            blocks[count] = block;
+        }
+        count++;
+    }
+    return count;
+}
+
+
+/*
+================================================================================
+FUNCTION: convertToPagedMode
+================================================================================
+PURPOSE: Switch from contiguous blocks to frames
+
+ALGORITHM:
+1. Save all current processes (IDs and sizes)
+2. Free the block list and zero the backing region
+3. Build the frame bitmap over the same backing region
+4. Re-allocate each saved process (same PID) with paged allocation
+*/
+
+int convertToPagedMode(MemoryManager *mm, int frameSizeKB, char *resultBuffer, int bufferSize) {
+
+    // STEP 1: Validate
+    if (mm->usePagedMode) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Paged mode is already active\"}");
+        return 0;
+    }
+    if (mm->useBuddySystem || mm->useBoundaryTags) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Revert the buddy system / boundary tags first\"}");
+        return 0;
+    }
+    if (frameSizeKB <= 0 || frameSizeKB > mm->userMemory) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Frame size must be 1-%d KB\"}",
+            mm->userMemory);
+        return 0;
+    }
+
+    // STEP 2: Save current processes
+    int savedCount = 0;
+    for (MemoryBlock *b = mm->head; b != NULL; b = b->next) {
+        if (!b->isHole) {
+            savedCount++;
+        }
+    }
+
+    int *savedIDs = (int*)malloc(sizeof(int) * (size_t)(savedCount + 1));
+    int *savedSizes = (int*)malloc(sizeof(int) * (size_t)(savedCount + 1));
+    PagedAllocator *pa = createPagedAllocator(mm->userMemory, frameSizeKB,
+                                              mm->backingRegion.basePtr);
+    if (savedIDs == NULL || savedSizes == NULL || pa == NULL) {
+        free(savedIDs);
+        free(savedSizes);
+        destroyPagedAllocator(pa);
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Out of memory\"}");
+        return 0;
+    }
+
+    int n = 0;
+    for (MemoryBlock *b = mm->head; b != NULL; b = b->next) {
+        if (!b->isHole) {
+            savedIDs[n] = b->processID;
+            savedSizes[n] = b->size;
+            n++;
+        }
+    }
+
+    // STEP 3: Drop the block list, clear the real memory, switch modes
+    freeMemoryManager(mm);
+    if (mm->backingRegion.basePtr != NULL) {
+        blockFill(mm->backingRegion.basePtr, 0, mm->backingRegion.size);
+    }
+
+    mm->usePagedMode = 1;
+    mm->layoutGeneration++;
+    mm->paged = pa;
+    mm->numProcesses = 0;
+    mm->numHoles = 1;
+    mm->freeMemory = pa->numFrames * frameSizeKB;
+
+    // STEP 4: Re-allocate saved processes with their old PIDs
+    int successCount = 0;
+    historySuspend(mm);     // Logged as one conversion op, not per process
+    for (int i = 0; i < savedCount; i++) {
+        if (allocateMemory(mm, savedIDs[i], savedSizes[i], FIRST_FIT) != -1) {
+            successCount++;
+        }
+    }
+    historyResume(mm);
+
+    free(savedIDs);
+    free(savedSizes);
+
+    // STEP 5: Write result JSON
+    snprintf(resultBuffer, bufferSize,
+        "{\"success\":true,"
+        "\"message\":\"Converted to paged allocation. %d/%d processes re-allocated.\","
+        "\"frameSizeKB\":%d,"
+        "\"frames\":%d,"
+        "\"processesConverted\":%d,"
+        "\"totalProcesses\":%d}",
+        successCount, savedCount,
+        frameSizeKB,
+        pa->numFrames,
+        successCount,
+        savedCount
+    );
+
+    historyRecord(mm, HISTORY_PAGED_CONVERT, frameSizeKB, 0, 0);
+    return 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: revertFromPagedMode
+================================================================================
+PURPOSE: Switch back to contiguous blocks
+
+ALGORITHM:
+1. Save all current processes from the page tables (in PID order)
+2. Destroy the frame bitmap and zero the backing region
+3. Recreate the initial hole
+4. Re-allocate each saved process using first fit
+*/
+
+int revertFromPagedMode(MemoryManager *mm, char *resultBuffer, int bufferSize) {
+
+    if (!mm->usePagedMode || mm->paged == NULL) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Paged mode is not active\"}");
+        return 0;
+    }
+
+    PagedAllocator *pa = mm->paged;
+
+    // STEP 1: Save current processes
+    int savedCount = 0;
+    int *savedIDs = (int*)malloc(sizeof(int) * (size_t)(pa->processCapacity + 1));
+    int *savedSizes = (int*)malloc(sizeof(int) * (size_t)(pa->processCapacity + 1));
+    if (savedIDs == NULL || savedSizes == NULL) {
+        free(savedIDs);
+        free(savedSizes);
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Out of memory\"}");
+        return 0;
+    }
+
+    for (int i = 0; i < pa->processCapacity; i++) {
+        if (pa->processes[i].processID != -1) {
+            savedIDs[savedCount] = pa->processes[i].processID;
+            savedSizes[savedCount] = pa->processes[i].sizeKB;
+            savedCount++;
+        }
+    }
+
+    // STEP 2: Leave paged mode
+    destroyPagedAllocator(pa);
+    mm->paged = NULL;
+    mm->usePagedMode = 0;
+    mm->layoutGeneration++;
+    if (mm->backingRegion.basePtr != NULL) {
+        blockFill(mm->backingRegion.basePtr, 0, mm->backingRegion.size);
+    }
+
+    // STEP 3: Reinitialize the standard layout
+    mm->numProcesses = 0;
+    mm->numHoles = 1;
+    mm->freeMemory = mm->userMemory;
+
+    mm->head = createBlock(mm, 1, mm->osMemory, mm->totalMemory - 1, -1);
+    if (mm->backingRegion.basePtr != NULL) {
+        mm->head->realPtr = mm->backingRegion.basePtr;
+        mm->head->realSize = mm->backingRegion.size;
+    }
+
+    // STEP 4: Re-allocate saved processes using first fit
+    int successCount = 0;
+    historySuspend(mm);     // Logged as one conversion op, not per process
+    for (int i = 0; i < savedCount; i++) {
+        if (allocateMemory(mm, savedIDs[i], savedSizes[i], FIRST_FIT) != -1) {
+            successCount++;
+        }
+    }
+    historyResume(mm);
+
+    free(savedIDs);
+    free(savedSizes);
+
+    snprintf(resultBuffer, bufferSize,
+        "{\"success\":true,"
+        "\"message\":\"Reverted to contiguous allocation. %d/%d processes re-allocated.\","
+        "\"processesConverted\":%d,"
+        "\"totalProcesses\":%d}",
+        successCount, savedCount,
+        successCount,
+        savedCount
+    );
+
+    historyRecord(mm, HISTORY_PAGED_REVERT, 0, 0, 0);
+    return 1;
+}
+
+
+/*
+================================================================================
+HELPERS: Latency measurement for comparePlacementModes
+================================================================================
+*/
+
+static long long nowNanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int compareLongLong(const void *a, const void *b) {
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+// Sorts samples in place and writes {"mean":..,"p50":..,"p99":..,"max":..}
+static void latencyToJSON(long long *samples, int count, char *buffer, int bufferSize) {
+
+    if (count == 0) {
+        snprintf(buffer, bufferSize, "{\"mean\":0,\"p50\":0,\"p99\":0,\"max\":0}");
+        return;
+    }
+
+    long long sum = 0;
+    for (int i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    qsort(samples, (size_t)count, sizeof(long long), compareLongLong);
+
+    snprintf(buffer, bufferSize,
+        "{\"mean\":%lld,\"p50\":%lld,\"p99\":%lld,\"max\":%lld}",
+        sum / count,
+        samples[count / 2],
+        samples[(int)((long long)count * 99 / 100)],
+        samples[count - 1]
+    );
+}
+
+
+/*
+================================================================================
+FUNCTION: comparePlacementModes
+================================================================================
+PURPOSE: Replay one operation stream on five engines
+
+ENGINES:
+0 first_fit, 1 best_fit, 2 worst_fit - contiguous list (allocateMemory)
+3 buddy                                 - power-of-2 blocks (buddyAllocate)
+4 paged                                 - frame bitmap (allocateMemory, paged mode)
+
+Every engine goes through its public entry point, so all of them pay the
+same bookkeeping (counters, fault probes, memset of real memory).
+
+METRICS:
+- External fragmentation (calculateFragmentation) sampled after every op
+- Internal fragmentation: rounding waste inside allocations, summed over
+  live allocations (0 for the fits, power-of-2 rounding for buddy,
+  last-frame waste for paged), reported at the end of the stream
+- Allocation and free latency in nanoseconds
+*/
+
+int comparePlacementModes(MemoryManager *mm, int ops, int minSizeKB, int maxSizeKB,
+                          int freePercent, int frameSizeKB, unsigned long long seed,
+                          char *resultBuffer, int bufferSize) {
+
+    static const char *engineNames[5] = {
+        "first_fit", "best_fit", "worst_fit", "buddy", "paged"
+    };
+
+    // STEP 1: Validate parameters
+    if (ops <= 0 || ops > MAX_COMPARE_OPS) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"ops must be 1-%d\"}", MAX_COMPARE_OPS);
+        return 0;
+    }
+    if (minSizeKB <= 0 || maxSizeKB < minSizeKB || maxSizeKB > mm->userMemory) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Need 0 < minSize <= maxSize <= %d\"}",
+            mm->userMemory);
+        return 0;
+    }
+    if (freePercent < 0 || freePercent > 100) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"freePercent must be 0-100\"}");
+        return 0;
+    }
+    if (frameSizeKB <= 0 || frameSizeKB > mm->userMemory) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Frame size must be 1-%d KB\"}",
+            mm->userMemory);
+        return 0;
+    }
+
+    // STEP 2: Generate the shared operation stream
+    WorkloadOp *stream = (WorkloadOp*)malloc(sizeof(WorkloadOp) * (size_t)ops);
+    int *pidOf = (int*)malloc(sizeof(int) * (size_t)ops);
+    int *wasteOf = (int*)malloc(sizeof(int) * (size_t)ops);
+    long long *allocNs = (long long*)malloc(sizeof(long long) * (size_t)ops);
+    long long *freeNs = (long long*)malloc(sizeof(long long) * (size_t)ops);
+    if (stream == NULL || pidOf == NULL || wasteOf == NULL || allocNs == NULL || freeNs == NULL) {
+        free(stream); free(pidOf); free(wasteOf); free(allocNs); free(freeNs);
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Out of memory\"}");
+        return 0;
+    }
+
+    WorkloadRNG rng;
+    workloadSeed(&rng, (uint64_t)seed);
+    int allocations = generateOpStream(&rng, stream, ops, minSizeKB, maxSizeKB, freePercent);
+
+    int written = snprintf(resultBuffer, bufferSize,
+        "{\"success\":true,\"ops\":%d,\"allocations\":%d,"
+        "\"minSizeKB\":%d,\"maxSizeKB\":%d,\"freePercent\":%d,"
+        "\"frameSizeKB\":%d,\"seed\":%llu,\"results\":[",
+        ops, allocations, minSizeKB, maxSizeKB, freePercent, frameSizeKB, seed);
+
+    // STEP 3: Replay the stream on each engine
+    for (int e = 0; e < 5 && written < bufferSize; e++) {
+
+        MemoryManager scratch;
+        initializeMemory(&scratch, mm->totalMemory, mm->osMemory);
+
+        char tempBuf[256];
+        if (e == 3) {
+            convertToBuddySystem(&scratch, NULL, 0);
+        } else if (e == 4) {
+            convertToPagedMode(&scratch, frameSizeKB, tempBuf, sizeof(tempBuf));
+        }
+        int engineMemoryKB = scratch.freeMemory;
+
+        int successes = 0, failures = 0;
+        int allocSamples = 0, freeSamples = 0;
+        double fragSum = 0.0;
+        long long internalKB = 0;
+
+        for (int i = 0; i < ops; i++) {
+            const WorkloadOp *op = &stream[i];
+
+            if (!op->isFree) {
+                pidOf[op->allocIndex] = -1;
+
+                // allocateMemory prints when memory is short; check first
+                if (e != 3 && op->sizeKB > scratch.freeMemory) {
+                    failures++;
+                    fragSum += calculateFragmentation(&scratch);
+                    continue;
+                }
+
+                int pid = op->allocIndex + 1;
+                long long start = nowNanoseconds();
+                int result;
+                if (e == 3) {
+                    result = buddyAllocate(&scratch, op->sizeKB, NULL, 0);
+                    pid = scratch.processCounter;
+                } else {
+                    AllocationAlgorithm algo = (e == 1) ? BEST_FIT
+                                             : (e == 2) ? WORST_FIT : FIRST_FIT;
+                    result = allocateMemory(&scratch, pid, op->sizeKB, algo);
+                }
+                allocNs[allocSamples++] = nowNanoseconds() - start;
+
+                if (result != -1) {
+                    successes++;
+                    pidOf[op->allocIndex] = pid;
+                    if (e == 3) {
+                        wasteOf[op->allocIndex] = nextPowerOf2(op->sizeKB) - op->sizeKB;
+                    } else if (e == 4) {
+                        int pages = (op->sizeKB + frameSizeKB - 1) / frameSizeKB;
+                        wasteOf[op->allocIndex] = pages * frameSizeKB - op->sizeKB;
+                    } else {
+                        wasteOf[op->allocIndex] = 0;
+                    }
+                    internalKB += wasteOf[op->allocIndex];
+                } else {
+                    failures++;
+                }
+            } else if (pidOf[op->allocIndex] != -1) {
+                int pid = pidOf[op->allocIndex];
+                long long start = nowNanoseconds();
+                if (e == 3) {
+                    buddyDeallocate(&scratch, pid, NULL, 0);
+                } else {
+                    deallocateMemory(&scratch, pid);
+                }
+                freeNs[freeSamples++] = nowNanoseconds() - start;
+                internalKB -= wasteOf[op->allocIndex];
+                pidOf[op->allocIndex] = -1;
+            }
+
+            fragSum += calculateFragmentation(&scratch);
+        }
+
+        float finalFrag = calculateFragmentation(&scratch);
+
+        char allocJSON[128], freeJSON[128];
+        latencyToJSON(allocNs, allocSamples, allocJSON, sizeof(allocJSON));
+        latencyToJSON(freeNs, freeSamples, freeJSON, sizeof(freeJSON));
+
+        written += snprintf(resultBuffer + written, bufferSize - written,
+            "%s{\"engine\":\"%s\",\"memoryKB\":%d,"
+            "\"successes\":%d,\"failures\":%d,"
+            "\"avgFragmentation\":%.2f,\"finalFragmentation\":%.2f,"
+            "\"internalFragmentationKB\":%lld,"
+            "\"allocNs\":%s,\"freeNs\":%s}",
+            (e > 0) ? "," : "",
+            engineNames[e], engineMemoryKB,
+            successes, failures,
+            fragSum / ops, finalFrag,
+            internalKB,
+            allocJSON, freeJSON);
+
+        // STEP 4: Tear the scratch memory down
+        if (scratch.usePagedMode) {
+            destroyPagedAllocator(scratch.paged);
+            scratch.paged = NULL;
+        }
+        freeMemoryManager(&scratch);
+        os_region_free(&scratch.backingRegion);
+    }
+
+    if (written < bufferSize) {
+        snprintf(resultBuffer + written, bufferSize - written, "]}");
+    }
+
+    free(stream);
+    free(pidOf);
+    free(wasteOf);
+    free(allocNs);
+    free(freeNs);
+    return 1;
+}
+
+
+/*
+================================================================================
+END OF FILE: paged_allocator.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. createPagedAllocator() / destroyPagedAllocator() - Frame bitmap setup
+2. pagedAllocate() - ctz bitmap search, any free frames will do
+3. pagedDeallocate() - Zero frames and set their bits
+4. pagedTranslate() - Virtual KB → physical KB via the page table
+5. pagedFreeRuns() / pagedLargestFreeRun() - Free-frame scatter stats
+6. pagedBlocksToJSON() / pagedBlocksToArray() - Frames rendered as blocks
+7. convertToPagedMode() / revertFromPagedMode() - Switch modes
+8. comparePlacementModes() - Fits vs buddy vs paging on one stream
+================================================================================
+*/
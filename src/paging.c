@@ -0,0 +1,767 @@
+/*
+================================================================================
+FILE: paging.c
+PURPOSE: Implement the demand-paging simulator
+DESCRIPTION:
+    - Builds per-process page tables and carves frames out of free holes
+    - Six page replacement engines, each a tight loop over the reference
+      string with O(1) (or O(log frames) for OPT) work per reference
+    - Formats results as JSON for the HTTP API
+================================================================================
+*/
+
+#include <stdio.h>      // snprintf
+#include <stdlib.h>     // malloc, calloc, free
+#include <string.h>     // strcmp, memset
+#include <time.h>       // clock_gettime, CLOCK_MONOTONIC
+#include "../include/paging.h"
+#include "../include/workload.h"
+
+
+// Upper bound on the reference string length (4 bytes each, plus 4 more
+// for OPT's next-use array → 160 MB at the limit)
+#define MAX_REFERENCE_LENGTH 20000000
+
+
+/*
+================================================================================
+HELPER: nowSeconds
+================================================================================
+PURPOSE: Monotonic wall clock in seconds (for throughput measurements)
+*/
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+
+/*
+================================================================================
+FUNCTION: pageAlgorithmName / parsePageAlgorithm
+================================================================================
+*/
+
+static const char *PAGE_ALGORITHM_NAMES[NUM_PAGE_ALGORITHMS] = {
+    "fifo", "lru", "clock", "second_chance", "lfu", "opt"
+};
+
+const char* pageAlgorithmName(PageReplacementAlgorithm algo) {
+    if ((int)algo < 0 || (int)algo >= NUM_PAGE_ALGORITHMS) {
+        return "unknown";
+    }
+    return PAGE_ALGORITHM_NAMES[algo];
+}
+
+int parsePageAlgorithm(const char *name) {
+    for (int i = 0; i < NUM_PAGE_ALGORITHMS; i++) {
+        if (strcmp(name, PAGE_ALGORITHM_NAMES[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+/*
+================================================================================
+FUNCTION: buildPagingSpace
+================================================================================
+PURPOSE: Create page tables for all processes and frames from all holes
+
+EXAMPLE (pageSizeKB = 4):
+Memory:  [P1: 10 KB][HOLE: 24 KB][P2: 8 KB][HOLE: 9 KB]
+Pages:   P1 → 3 pages (global 0..2), P2 → 2 pages (global 3..4)
+Frames:  HOLE 24 KB → 6 frames, HOLE 9 KB → 2 frames (1 KB left over)
+*/
+
+int buildPagingSpace(MemoryManager *mm, int pageSizeKB, int maxFrames, PagingSpace *space) {
+
+    memset(space, 0, sizeof(*space));
+    if (pageSizeKB <= 0) {
+        return -1;
+    }
+    space->pageSizeKB = pageSizeKB;
+
+    // STEP 1: Count processes and frames
+    int processes = 0;
+    long long frames = 0;
+    MemoryBlock *current = mm->head;
+    while (current != NULL) {
+        if (current->isHole) {
+            frames += current->size / pageSizeKB;
+        } else {
+            processes++;
+        }
+        current = current->next;
+    }
+    if (maxFrames > 0 && frames > maxFrames) {
+        frames = maxFrames;
+    }
+    if (processes == 0 || frames == 0) {
+        return -1;
+    }
+
+    space->processIDs = (int*)malloc(sizeof(int) * processes);
+    space->pageBase = (int*)malloc(sizeof(int) * processes);
+    space->pageCount = (int*)malloc(sizeof(int) * processes);
+    space->framePtr = (char**)malloc(sizeof(char*) * (size_t)frames);
+    if (!space->processIDs || !space->pageBase || !space->pageCount || !space->framePtr) {
+        freePagingSpace(space);
+        return -1;
+    }
+
+    // STEP 2: Lay out the page tables and carve the frames
+    size_t frameBytes = (size_t)pageSizeKB * 1024;
+    int frame = 0;
+    current = mm->head;
+    while (current != NULL) {
+        if (current->isHole) {
+            int holeFrames = current->size / pageSizeKB;
+            for (int k = 0; k < holeFrames && frame < frames; k++) {
+                space->framePtr[frame++] = (current->realPtr != NULL)
+                    ? (char *)current->realPtr + (size_t)k * frameBytes
+                    : NULL;
+            }
+        } else {
+            int i = space->numProcesses++;
+            space->processIDs[i] = current->processID;
+            space->pageBase[i] = space->totalPages;
+            space->pageCount[i] = (current->size + pageSizeKB - 1) / pageSizeKB;
+            space->totalPages += space->pageCount[i];
+        }
+        current = current->next;
+    }
+    space->numFrames = frame;
+
+    return 0;
+}
+
+
+/*
+================================================================================
+FUNCTION: freePagingSpace
+================================================================================
+*/
+
+void freePagingSpace(PagingSpace *space) {
+    free(space->processIDs);
+    free(space->pageBase);
+    free(space->pageCount);
+    free(space->framePtr);
+    memset(space, 0, sizeof(*space));
+}
+
+
+/*
+================================================================================
+HELPER: Engine state shared by all algorithms
+================================================================================
+PURPOSE: Page table + inverted page table + counters
+
+frameOf[page]  → frame holding the page, or -1 (the page table)
+pageIn[frame]  → page held by the frame, or -1 (the inverted page table)
+
+Loading a page writes its number into the first word of the real frame,
+so every page-in really touches the backing memory like a disk read would.
+*/
+
+typedef struct {
+    const PagingSpace *space;
+    int *frameOf;
+    int *pageIn;
+    int  usedFrames;
+    long long faults;
+    long long evictions;
+} PagingEngine;
+
+static void loadPage(PagingEngine *e, int frame, int page) {
+    int old = e->pageIn[frame];
+    if (old >= 0) {
+        e->frameOf[old] = -1;
+        e->evictions++;
+    }
+    e->pageIn[frame] = page;
+    e->frameOf[page] = frame;
+    char *ptr = e->space->framePtr[frame];
+    if (ptr != NULL) {
+        *(volatile uint32_t *)ptr = (uint32_t)page;
+    }
+}
+
+
+/*
+================================================================================
+ENGINE: FIFO
+================================================================================
+Frames are filled in order 0, 1, 2, ... so once memory is full the oldest
+page is always at the "hand", which just advances round-robin.
+*/
+
+static void runFIFO(PagingEngine *e, const uint32_t *refs, int length) {
+    int frames = e->space->numFrames;
+    int hand = 0;
+    for (int i = 0; i < length; i++) {
+        int page = (int)refs[i];
+        if (e->frameOf[page] >= 0) continue;           // Hit
+        e->faults++;
+        int frame;
+        if (e->usedFrames < frames) {
+            frame = e->usedFrames++;
+        } else {
+            frame = hand;
+            hand = (hand + 1 == frames) ? 0 : hand + 1;
+        }
+        loadPage(e, frame, page);
+    }
+}
+
+
+/*
+================================================================================
+ENGINE: LRU (hash + intrusive doubly linked list)
+================================================================================
+The page table is the hash (page → frame). prev/next arrays thread a list
+through the frames: head = most recently used, tail = victim. A hit
+unlinks the frame and pushes it to the head: O(1), no searching.
+*/
+
+static void runLRU(PagingEngine *e, const uint32_t *refs, int length,
+                   int *prev, int *next) {
+    int frames = e->space->numFrames;
+    int head = -1, tail = -1;
+
+    for (int i = 0; i < length; i++) {
+        int page = (int)refs[i];
+        int frame = e->frameOf[page];
+
+        if (frame >= 0) {
+            // Hit: move to front (skip if already there)
+            if (frame != head) {
+                next[prev[frame]] = next[frame];
+                if (next[frame] >= 0) prev[next[frame]] = prev[frame];
+                else tail = prev[frame];
+                prev[frame] = -1;
+                next[frame] = head;
+                prev[head] = frame;
+                head = frame;
+            }
+            continue;
+        }
+
+        e->faults++;
+        if (e->usedFrames < frames) {
+            frame = e->usedFrames++;
+        } else {
+            // Evict the tail (least recently used)
+            frame = tail;
+            tail = prev[frame];
+            if (tail >= 0) next[tail] = -1;
+            else head = -1;
+        }
+        loadPage(e, frame, page);
+
+        prev[frame] = -1;
+        next[frame] = head;
+        if (head >= 0) prev[head] = frame;
+        head = frame;
+        if (tail < 0) tail = frame;
+    }
+}
+
+
+/*
+================================================================================
+ENGINE: Clock
+================================================================================
+One reference bit per frame. A hit sets the bit. On a fault the hand
+sweeps: a set bit is cleared (the page gets another lap), a clear bit
+marks the victim.
+*/
+
+static void runClock(PagingEngine *e, const uint32_t *refs, int length,
+                     unsigned char *refBit) {
+    int frames = e->space->numFrames;
+    int hand = 0;
+    for (int i = 0; i < length; i++) {
+        int page = (int)refs[i];
+        int frame = e->frameOf[page];
+        if (frame >= 0) {
+            refBit[frame] = 1;
+            continue;
+        }
+        e->faults++;
+        if (e->usedFrames < frames) {
+            frame = e->usedFrames++;
+        } else {
+            while (refBit[hand]) {
+                refBit[hand] = 0;
+                hand = (hand + 1 == frames) ? 0 : hand + 1;
+            }
+            frame = hand;
+            hand = (hand + 1 == frames) ? 0 : hand + 1;
+        }
+        loadPage(e, frame, page);
+        refBit[frame] = 1;
+    }
+}
+
+
+/*
+================================================================================
+ENGINE: Second-Chance
+================================================================================
+The textbook formulation: a real FIFO queue (linked through the frames).
+The victim is taken from the front; if its reference bit is set, the bit
+is cleared and the page moves to the back of the queue instead.
+It evicts the same pages as Clock - Clock is simply the trick that turns
+the queue moves into a pointer increment - so comparing the two shows
+what the list manipulation costs.
+*/
+
+static void runSecondChance(PagingEngine *e, const uint32_t *refs, int length,
+                            unsigned char *refBit, int *next) {
+    int frames = e->space->numFrames;
+    int head = -1, tail = -1;
+    for (int i = 0; i < length; i++) {
+        int page = (int)refs[i];
+        int frame = e->frameOf[page];
+        if (frame >= 0) {
+            refBit[frame] = 1;
+            continue;
+        }
+        e->faults++;
+        if (e->usedFrames < frames) {
+            frame = e->usedFrames++;
+        } else {
+            // Give referenced pages at the front a second chance
+            while (refBit[head]) {
+                refBit[head] = 0;
+                if (head != tail) {
+                    int moved = head;
+                    head = next[moved];
+                    next[moved] = -1;
+                    next[tail] = moved;
+                    tail = moved;
+                }
+            }
+            frame = head;
+            head = next[head];
+            if (head < 0) tail = -1;
+        }
+        loadPage(e, frame, page);
+        refBit[frame] = 1;
+
+        // Enqueue at the back
+        next[frame] = -1;
+        if (tail >= 0) next[tail] = frame;
+        else head = frame;
+        tail = frame;
+    }
+}
+
+
+/*
+================================================================================
+ENGINE: LFU (O(1) frequency buckets)
+================================================================================
+Frames with the same use count share a bucket; buckets form a list in
+increasing count order. A hit moves the frame to the neighbouring bucket
+(count + 1), creating it if needed. The victim is the oldest frame of
+the first (lowest count) bucket. Every step is O(1).
+
+Arrays (indexed by frame):  bucketOf, fprev, fnext
+Arrays (indexed by bucket): bcount, bhead, btail, bprev, bnext
+At most frames + 1 buckets exist at once; unused ones sit on a free list.
+*/
+
+typedef struct {
+    int *bucketOf, *fprev, *fnext;
+    int *bcount, *bhead, *btail, *bprev, *bnext;
+    int  firstBucket;
+    int  freeBucket;
+} LFUState;
+
+static void lfuListRemove(LFUState *s, int frame) {
+    int b = s->bucketOf[frame];
+    if (s->fprev[frame] >= 0) s->fnext[s->fprev[frame]] = s->fnext[frame];
+    else s->bhead[b] = s->fnext[frame];
+    if (s->fnext[frame] >= 0) s->fprev[s->fnext[frame]] = s->fprev[frame];
+    else s->btail[b] = s->fprev[frame];
+}
+
+static void lfuListPushHead(LFUState *s, int b, int frame) {
+    s->bucketOf[frame] = b;
+    s->fprev[frame] = -1;
+    s->fnext[frame] = s->bhead[b];
+    if (s->bhead[b] >= 0) s->fprev[s->bhead[b]] = frame;
+    else s->btail[b] = frame;
+    s->bhead[b] = frame;
+}
+
+static int lfuNewBucketAfter(LFUState *s, int after, int count) {
+    int b = s->freeBucket;
+    s->freeBucket = s->bnext[b];
+    s->bcount[b] = count;
+    s->bhead[b] = s->btail[b] = -1;
+    s->bprev[b] = after;
+    s->bnext[b] = (after >= 0) ? s->bnext[after] : s->firstBucket;
+    if (s->bnext[b] >= 0) s->bprev[s->bnext[b]] = b;
+    if (after >= 0) s->bnext[after] = b;
+    else s->firstBucket = b;
+    return b;
+}
+
+static void lfuDropIfEmpty(LFUState *s, int b) {
+    if (s->bhead[b] >= 0) return;
+    if (s->bprev[b] >= 0) s->bnext[s->bprev[b]] = s->bnext[b];
+    else s->firstBucket = s->bnext[b];
+    if (s->bnext[b] >= 0) s->bprev[s->bnext[b]] = s->bprev[b];
+    s->bnext[b] = s->freeBucket;
+    s->freeBucket = b;
+}
+
+static void runLFU(PagingEngine *e, const uint32_t *refs, int length, LFUState *s) {
+    int frames = e->space->numFrames;
+
+    // Put every bucket on the free list
+    s->firstBucket = -1;
+    for (int b = 0; b <= frames; b++) {
+        s->bnext[b] = (b < frames) ? b + 1 : -1;
+    }
+    s->freeBucket = 0;
+
+    for (int i = 0; i < length; i++) {
+        int page = (int)refs[i];
+        int frame = e->frameOf[page];
+
+        if (frame >= 0) {
+            // Hit: move to the bucket for count + 1
+            int b = s->bucketOf[frame];
+            int target = s->bnext[b];
+            if (target < 0 || s->bcount[target] != s->bcount[b] + 1) {
+                target = lfuNewBucketAfter(s, b, s->bcount[b] + 1);
+            }
+            lfuListRemove(s, frame);
+            lfuListPushHead(s, target, frame);
+            lfuDropIfEmpty(s, b);
+            continue;
+        }
+
+        e->faults++;
+        if (e->usedFrames < frames) {
+            frame = e->usedFrames++;
+        } else {
+            // Victim: oldest frame in the lowest-count bucket
+            int b = s->firstBucket;
+            frame = s->btail[b];
+            lfuListRemove(s, frame);
+            lfuDropIfEmpty(s, b);
+        }
+        loadPage(e, frame, page);
+
+        int first = s->firstBucket;
+        if (first < 0 || s->bcount[first] != 1) {
+            first = lfuNewBucketAfter(s, -1, 1);
+        }
+        lfuListPushHead(s, first, frame);
+    }
+}
+
+
+/*
+================================================================================
+ENGINE: OPT (Belady)
+================================================================================
+STEP 1 (precompute): one backward pass over the string gives nextUse[i],
+the position of the next reference to the same page (length = never).
+STEP 2 (replay): frames live in a max-heap keyed by the next use of the
+page they hold. The heap top is always the optimal victim. Each
+reference updates one key: O(log frames).
+*/
+
+static void heapSiftUp(int *heap, int *pos, const int *key, int i) {
+    int f = heap[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (key[heap[parent]] >= key[f]) break;
+        heap[i] = heap[parent];
+        pos[heap[i]] = i;
+        i = parent;
+    }
+    heap[i] = f;
+    pos[f] = i;
+}
+
+static void heapSiftDown(int *heap, int *pos, const int *key, int n, int i) {
+    int f = heap[i];
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= n) break;
+        if (child + 1 < n && key[heap[child + 1]] > key[heap[child]]) child++;
+        if (key[heap[child]] <= key[f]) break;
+        heap[i] = heap[child];
+        pos[heap[i]] = i;
+        i = child;
+    }
+    heap[i] = f;
+    pos[f] = i;
+}
+
+static void runOPT(PagingEngine *e, const uint32_t *refs, int length,
+                   const int *nextUse, int *heap, int *pos, int *key) {
+    int frames = e->space->numFrames;
+    int heapSize = 0;
+
+    for (int i = 0; i < length; i++) {
+        int page = (int)refs[i];
+        int frame = e->frameOf[page];
+
+        if (frame >= 0) {
+            // Hit: the page's next use moved further away
+            key[frame] = nextUse[i];
+            heapSiftUp(heap, pos, key, pos[frame]);
+            continue;
+        }
+
+        e->faults++;
+        if (e->usedFrames < frames) {
+            frame = e->usedFrames++;
+            key[frame] = nextUse[i];
+            heap[heapSize] = frame;
+            heapSiftUp(heap, pos, key, heapSize++);
+        } else {
+            frame = heap[0];
+            key[frame] = nextUse[i];
+            heapSiftDown(heap, pos, key, heapSize, 0);
+        }
+        loadPage(e, frame, page);
+    }
+}
+
+
+/*
+================================================================================
+FUNCTION: simulatePaging
+================================================================================
+PURPOSE: Allocate the engine's working arrays, run one algorithm, time it
+
+Only the replay loop is timed. OPT's next-use precomputation is part of
+its cost, so it is included in OPT's time as well.
+*/
+
+int simulatePaging(const PagingSpace *space, const uint32_t *refs, int length,
+                   PageReplacementAlgorithm algo, PagingResult *result) {
+
+    memset(result, 0, sizeof(*result));
+    result->algorithm = algo;
+
+    int frames = space->numFrames;
+    PagingEngine e;
+    e.space = space;
+    e.usedFrames = 0;
+    e.faults = 0;
+    e.evictions = 0;
+    e.frameOf = (int*)malloc(sizeof(int) * (size_t)space->totalPages);
+    e.pageIn = (int*)malloc(sizeof(int) * (size_t)frames);
+
+    // Scratch arrays: up to eight frame-sized int arrays (LFU needs them)
+    int *scratch = (int*)malloc(sizeof(int) * 8 * (size_t)(frames + 1));
+    unsigned char *refBit = (unsigned char*)calloc((size_t)frames, 1);
+
+    if (!e.frameOf || !e.pageIn || !scratch || !refBit) {
+        free(e.frameOf); free(e.pageIn); free(scratch); free(refBit);
+        return -1;
+    }
+    memset(e.frameOf, 0xFF, sizeof(int) * (size_t)space->totalPages);   // all -1
+    memset(e.pageIn, 0xFF, sizeof(int) * (size_t)frames);
+
+    int *a0 = scratch;
+    int *a1 = a0 + frames + 1;
+    int *a2 = a1 + frames + 1;
+
+    double start = nowSeconds();
+
+    switch (algo) {
+        case PAGE_FIFO:
+            runFIFO(&e, refs, length);
+            break;
+        case PAGE_LRU:
+            runLRU(&e, refs, length, a0, a1);
+            break;
+        case PAGE_CLOCK:
+            runClock(&e, refs, length, refBit);
+            break;
+        case PAGE_SECOND_CHANCE:
+            runSecondChance(&e, refs, length, refBit, a0);
+            break;
+        case PAGE_LFU: {
+            LFUState s;
+            s.bucketOf = a0;
+            s.fprev = a1;
+            s.fnext = a2;
+            s.bcount = a2 + frames + 1;
+            s.bhead = s.bcount + frames + 1;
+            s.btail = s.bhead + frames + 1;
+            s.bprev = s.btail + frames + 1;
+            s.bnext = s.bprev + frames + 1;
+            runLFU(&e, refs, length, &s);
+            break;
+        }
+        case PAGE_OPT: {
+            int *nextUse = (int*)malloc(sizeof(int) * (size_t)length);
+            int *lastSeen = (int*)malloc(sizeof(int) * (size_t)space->totalPages);
+            if (nextUse == NULL || lastSeen == NULL) {
+                free(nextUse); free(lastSeen);
+                free(e.frameOf); free(e.pageIn); free(scratch); free(refBit);
+                return -1;
+            }
+            for (int p = 0; p < space->totalPages; p++) {
+                lastSeen[p] = length;           // "never used again"
+            }
+            for (int i = length - 1; i >= 0; i--) {
+                nextUse[i] = lastSeen[refs[i]];
+                lastSeen[refs[i]] = i;
+            }
+            runOPT(&e, refs, length, nextUse, a0, a1, a2);
+            free(nextUse);
+            free(lastSeen);
+            break;
+        }
+    }
+
+    double elapsed = nowSeconds() - start;
+
+    // Leave the holes zeroed, as deallocateMemory() would
+    for (int f = 0; f < e.usedFrames; f++) {
+        if (space->framePtr[f] != NULL) {
+            *(volatile uint32_t *)space->framePtr[f] = 0;
+        }
+    }
+
+    result->references = length;
+    result->faults = e.faults;
+    result->evictions = e.evictions;
+    result->elapsedSeconds = elapsed;
+    result->refsPerSecond = (elapsed > 0) ? (double)length / elapsed : 0.0;
+    result->faultRate = (length > 0) ? (double)e.faults / (double)length : 0.0;
+
+    free(e.frameOf);
+    free(e.pageIn);
+    free(scratch);
+    free(refBit);
+    return 0;
+}
+
+
+/*
+================================================================================
+FUNCTION: runPagingSimulation
+================================================================================
+PURPOSE: The API entry point - set up, generate, run one or all, report
+
+ALGORITHM:
+1. Validate parameters and apply defaults
+2. Build the paging space from the current memory layout
+3. Generate ONE reference string (so "all" compares like with like)
+4. Replay it with the requested algorithm(s)
+5. Write the results as JSON
+*/
+
+int runPagingSimulation(MemoryManager *mm, const PagingConfig *config,
+                        const char *algorithm, char *resultBuffer, int bufferSize) {
+
+    // STEP 1: Parameters
+    int pageSizeKB = (config->pageSizeKB > 0) ? config->pageSizeKB : 4;
+    int length = (config->length > 0) ? config->length : 1000000;
+    int locality = config->localityPercent;
+    if (locality < 0 || locality > 100) locality = 90;
+
+    int runAll = (strcmp(algorithm, "all") == 0);
+    int single = parsePageAlgorithm(algorithm);
+    if (!runAll && single < 0) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Unknown algorithm '%s' "
+            "(fifo, lru, clock, second_chance, lfu, opt, all)\"}", algorithm);
+        return 0;
+    }
+    if (length > MAX_REFERENCE_LENGTH) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"length must be at most %d\"}",
+            MAX_REFERENCE_LENGTH);
+        return 0;
+    }
+
+    // STEP 2: Pages and frames
+    PagingSpace space;
+    if (buildPagingSpace(mm, pageSizeKB, config->frames, &space) != 0) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Need at least one process and one "
+            "free %d KB frame to simulate paging\"}", pageSizeKB);
+        return 0;
+    }
+
+    // STEP 3: Reference string
+    uint32_t *refs = (uint32_t*)malloc(sizeof(uint32_t) * (size_t)length);
+    if (refs == NULL) {
+        freePagingSpace(&space);
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Out of memory for reference string\"}");
+        return 0;
+    }
+    WorkloadRNG rng;
+    workloadSeed(&rng, config->seed);
+    generateReferenceString(&rng, space.pageBase, space.pageCount, space.numProcesses,
+                            refs, length, locality);
+
+    // STEP 4 + 5: Run and report
+    int written = snprintf(resultBuffer, bufferSize,
+        "{\"success\":true,\"pageSizeKB\":%d,\"frames\":%d,\"virtualPages\":%d,"
+        "\"processes\":%d,\"references\":%d,\"localityPercent\":%d,\"seed\":%llu,"
+        "\"results\":[",
+        pageSizeKB, space.numFrames, space.totalPages, space.numProcesses,
+        length, locality, config->seed);
+
+    int first = runAll ? 0 : single;
+    int last = runAll ? NUM_PAGE_ALGORITHMS - 1 : single;
+    for (int a = first; a <= last && written < bufferSize; a++) {
+        PagingResult r;
+        if (simulatePaging(&space, refs, length, (PageReplacementAlgorithm)a, &r) != 0) {
+            continue;
+        }
+        written += snprintf(resultBuffer + written, bufferSize - written,
+            "%s{\"algorithm\":\"%s\",\"faults\":%lld,\"evictions\":%lld,"
+            "\"faultRate\":%.6f,\"elapsedMs\":%.3f,\"refsPerSecond\":%.0f}",
+            (a == first) ? "" : ",",
+            pageAlgorithmName(r.algorithm), r.faults, r.evictions,
+            r.faultRate, r.elapsedSeconds * 1000.0, r.refsPerSecond);
+    }
+    if (written < bufferSize) {
+        snprintf(resultBuffer + written, bufferSize - written, "]}");
+    }
+
+    free(refs);
+    freePagingSpace(&space);
+    return 1;
+}
+
+
+/*
+================================================================================
+END OF FILE: paging.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. pageAlgorithmName() / parsePageAlgorithm() - Enum <-> API name
+2. buildPagingSpace() - Page tables for processes, frames from holes
+3. freePagingSpace() - Cleanup
+4. simulatePaging() - Replay with FIFO, LRU, Clock, Second-Chance, LFU, OPT
+5. runPagingSimulation() - API entry point with JSON output
+
+COMPLEXITY PER REFERENCE:
+FIFO, Clock, Second-Chance: O(1) amortized
+LRU, LFU: O(1) (intrusive lists threaded through frame arrays)
+OPT: O(log frames) (max-heap on next use) + one O(n) precompute pass
+================================================================================
+*/
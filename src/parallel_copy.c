@@ -0,0 +1,379 @@
+/*
+================================================================================
+FILE: parallel_copy.c
+PURPOSE: Implement the parallel memmove used by compaction
+DESCRIPTION:
+    - A lazily started pool of worker threads (pthreads)
+    - Chunked copies of non-overlapping ranges
+    - Ordered rounds for overlapping slides
+    - Serial vs parallel compaction benchmark
+================================================================================
+*/
+
+#include <stdio.h>      // snprintf
+#include <string.h>     // memcpy, memmove
+#include <time.h>       // clock_gettime, CLOCK_MONOTONIC
+#include <unistd.h>     // sysconf
+#include <pthread.h>    // pthread_create, mutexes, condition variables
+#include "../include/parallel_copy.h"
+#include "../include/memory_manager.h"
+#include "../include/os_memory.h"
+#include "../include/stream_kernels.h"
+
+
+// Chunks smaller than this are not worth handing to another thread
+#define MIN_CHUNK_BYTES (64 * 1024)
+
+// Rounds of an overlapping slide smaller than this run as one memmove
+#define MIN_ROUND_BYTES (256 * 1024)
+
+// Smallest block of the benchmark heap (heapMB * 1024 / processes)
+#define BENCH_MIN_BLOCK_KB 64
+
+
+/*
+================================================================================
+STATE: Configuration, counters and the worker pool
+================================================================================
+
+HOW A JOB RUNS:
+1. The caller fills tasks[0 .. numTasks-1] and bumps jobID
+2. Worker i (1 .. numTasks-1) wakes up, copies tasks[i]
+3. The caller copies tasks[0] itself, then waits until remaining = 0
+
+Workers are started on first use and live until the program exits.
+*/
+
+typedef struct {
+    char       *dest;
+    const char *src;
+    size_t      n;
+} CopyTask;
+
+typedef struct {
+    int      index;             // Which task slot this worker serves
+    unsigned startJob;          // jobID when the worker was created
+} WorkerArg;
+
+static ParallelCopyStats stats = { 0, 4u * 1024 * 1024, 0, 0, 0, 0 };
+
+static pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  workReady = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  workDone = PTHREAD_COND_INITIALIZER;
+static CopyTask  tasks[PARALLEL_COPY_MAX_THREADS];
+static WorkerArg workerArgs[PARALLEL_COPY_MAX_THREADS];
+static int       numTasks = 0;
+static int       remaining = 0;
+static unsigned  jobID = 0;
+static int       poolSize = 0;  // Worker threads started (caller not counted)
+
+
+static void* copyWorker(void *arg) {
+
+    const WorkerArg *me = (const WorkerArg*)arg;
+    unsigned seen = me->startJob;
+
+    pthread_mutex_lock(&poolLock);
+    while (1) {
+        while (jobID == seen) {
+            pthread_cond_wait(&workReady, &poolLock);
+        }
+        seen = jobID;
+
+        if (me->index < numTasks) {
+            CopyTask task = tasks[me->index];
+            pthread_mutex_unlock(&poolLock);
+            blockCopy(task.dest, task.src, task.n);
+            pthread_mutex_lock(&poolLock);
+            if (--remaining == 0) {
+                pthread_cond_signal(&workDone);
+            }
+        }
+    }
+    return NULL;
+}
+
+static int defaultThreads(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) cpus = 1;
+    if (cpus > 8) cpus = 8;
+    return (int)cpus;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: splitCopy
+--------------------------------------------------------------------------------
+PURPOSE: Copy n bytes between NON-overlapping ranges with up to
+         stats.threads threads; returns once every chunk is done
+*/
+
+static void splitCopy(char *dest, const char *src, size_t n) {
+
+    int threads = stats.threads;
+    if ((size_t)threads > n / MIN_CHUNK_BYTES) {
+        threads = (int)(n / MIN_CHUNK_BYTES);
+    }
+    if (threads <= 1) {
+        blockCopy(dest, src, n);
+        return;
+    }
+
+    // Pick the copy kernel here, before the workers race to do it
+    streamKernelName();
+
+    pthread_mutex_lock(&poolLock);
+
+    // STEP 1: Start missing workers (they must not miss this job)
+    while (poolSize < threads - 1) {
+        pthread_t thread;
+        WorkerArg *arg = &workerArgs[poolSize + 1];
+        arg->index = poolSize + 1;
+        arg->startJob = jobID;
+        if (pthread_create(&thread, NULL, copyWorker, arg) != 0) {
+            break;
+        }
+        pthread_detach(thread);
+        poolSize++;
+    }
+    if (threads > poolSize + 1) {
+        threads = poolSize + 1;
+    }
+
+    // STEP 2: Cut the range into 64-byte aligned chunks
+    size_t chunk = (n / (size_t)threads) & ~(size_t)63;
+    for (int i = 0; i < threads; i++) {
+        size_t offset = (size_t)i * chunk;
+        tasks[i].dest = dest + offset;
+        tasks[i].src = src + offset;
+        tasks[i].n = (i == threads - 1) ? n - offset : chunk;
+    }
+    numTasks = threads;
+    remaining = threads - 1;
+    jobID++;
+    pthread_cond_broadcast(&workReady);
+    pthread_mutex_unlock(&poolLock);
+
+    // STEP 3: The caller copies chunk 0, then waits for the others
+    blockCopy(tasks[0].dest, tasks[0].src, tasks[0].n);
+
+    pthread_mutex_lock(&poolLock);
+    while (remaining > 0) {
+        pthread_cond_wait(&workDone, &poolLock);
+    }
+    pthread_mutex_unlock(&poolLock);
+}
+
+
+/*
+================================================================================
+FUNCTION: parallelMove
+================================================================================
+*/
+
+void parallelMove(void *dest, const void *src, size_t n) {
+
+    if (stats.threads == 0) {
+        stats.threads = defaultThreads();
+    }
+
+    char *d = (char*)dest;
+    const char *s = (const char*)src;
+    size_t distance = (d < s) ? (size_t)(s - d) : (size_t)(d - s);
+
+    // STEP 1: Small, serial-only, or too-short rounds → one thread
+    // (blockCopy when the ranges do not overlap, memmove when they do)
+    if (n < stats.thresholdBytes || stats.threads <= 1 || distance == 0 ||
+        (distance < n && distance < MIN_ROUND_BYTES)) {
+        if (distance >= n) {
+            blockCopy(dest, src, n);
+        } else {
+            memmove(dest, src, n);
+        }
+        stats.serialMoves++;
+        return;
+    }
+
+    stats.parallelMoves++;
+    stats.parallelBytes += (long long)n;
+
+    // STEP 2: No overlap → one parallel copy
+    if (distance >= n) {
+        splitCopy(d, s, n);
+        stats.rounds++;
+        return;
+    }
+
+    // STEP 3: Overlap → rounds of at most 'distance' bytes, starting at
+    // the end the data moves towards
+    if (d < s) {
+        for (size_t offset = 0; offset < n; offset += distance) {
+            size_t len = (n - offset < distance) ? n - offset : distance;
+            splitCopy(d + offset, s + offset, len);
+            stats.rounds++;
+        }
+    } else {
+        for (size_t end = n; end > 0; ) {
+            size_t len = (end < distance) ? end : distance;
+            end -= len;
+            splitCopy(d + end, s + end, len);
+            stats.rounds++;
+        }
+    }
+}
+
+
+/*
+================================================================================
+FUNCTION: setParallelCopyConfig / getParallelCopyStats / parallelCopyStatsToJSON
+================================================================================
+*/
+
+int setParallelCopyConfig(int threads, size_t thresholdBytes) {
+    if (threads < 0 || threads > PARALLEL_COPY_MAX_THREADS) {
+        return 0;
+    }
+    if (threads > 0) {
+        stats.threads = threads;
+    }
+    if (thresholdBytes > 0) {
+        stats.thresholdBytes = thresholdBytes;
+    }
+    return 1;
+}
+
+ParallelCopyStats getParallelCopyStats(void) {
+    if (stats.threads == 0) {
+        stats.threads = defaultThreads();
+    }
+    return stats;
+}
+
+void parallelCopyStatsToJSON(char *buffer, int bufferSize) {
+    ParallelCopyStats s = getParallelCopyStats();
+    snprintf(buffer, bufferSize,
+        "{\"threads\":%d,\"thresholdBytes\":%zu,\"cpus\":%ld,"
+        "\"parallelMoves\":%lld,\"serialMoves\":%lld,"
+        "\"parallelBytes\":%lld,\"rounds\":%lld}",
+        s.threads, s.thresholdBytes, sysconf(_SC_NPROCESSORS_ONLN),
+        s.parallelMoves, s.serialMoves, s.parallelBytes, s.rounds);
+}
+
+
+/*
+================================================================================
+FUNCTION: benchmarkCompaction
+================================================================================
+*/
+
+static long long nowNanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Fill the scratch heap and punch a hole before every kept block
+static long long buildFragmentedHeap(MemoryManager *mm, int processes, int blockKB) {
+    long long bytesToMove = 0;
+    for (int i = 0; i < processes; i++) {
+        allocateMemory(mm, i + 1, blockKB, FIRST_FIT);
+    }
+    for (int i = 0; i < processes; i += 2) {
+        deallocateMemory(mm, i + 1);
+    }
+    for (int i = 1; i < processes; i += 2) {
+        bytesToMove += (long long)blockKB * 1024;
+    }
+    return bytesToMove;
+}
+
+// Free every process again (the holes merge back into one)
+static void emptyHeap(MemoryManager *mm, int processes) {
+    for (int i = 1; i < processes; i += 2) {
+        deallocateMemory(mm, i + 1);
+    }
+}
+
+int benchmarkCompaction(int heapMB, int processes, int runs,
+                        char *resultBuffer, int bufferSize) {
+
+    // STEP 1: Validate (the heap bounds the process count: every block
+    // is at least BENCH_MIN_BLOCK_KB, so the time is copying, not list work)
+    int maxProcesses = (heapMB >= 16 && heapMB <= 1024) ?
+                       heapMB * 1024 / BENCH_MIN_BLOCK_KB : 0;
+    if (maxProcesses == 0 || processes < 2 || processes > maxProcesses ||
+        runs < 1 || runs > 10) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Need heapMB 16-1024, processes 2-%d "
+            "(blocks of at least %d KB), runs 1-10\"}",
+            maxProcesses > 0 ? maxProcesses : 1024 * 1024 / BENCH_MIN_BLOCK_KB,
+            BENCH_MIN_BLOCK_KB);
+        return 0;
+    }
+
+    // STEP 2: A scratch manager the size of the requested heap
+    int osKB = 64;
+    int blockKB = heapMB * 1024 / processes;
+    MemoryManager scratch;
+    initializeMemory(&scratch, heapMB * 1024 + osKB, osKB);
+    scratch.measureFaults = 0;
+    if (scratch.backingRegion.basePtr == NULL) {
+        freeMemoryManager(&scratch);
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Could not map a %d MB heap\"}", heapMB);
+        return 0;
+    }
+
+    // STEP 3: Best of 'runs' for each mode
+    ParallelCopyStats saved = getParallelCopyStats();
+    long long bestSerial = -1, bestParallel = -1, bytesMoved = 0;
+
+    for (int run = 0; run < runs; run++) {
+        for (int mode = 0; mode < 2; mode++) {
+            bytesMoved = buildFragmentedHeap(&scratch, processes, blockKB);
+            setParallelCopyConfig(mode == 0 ? 1 : saved.threads, 0);
+
+            long long start = nowNanoseconds();
+            compact(&scratch, NULL, 0);
+            long long elapsed = nowNanoseconds() - start;
+
+            long long *best = (mode == 0) ? &bestSerial : &bestParallel;
+            if (*best < 0 || elapsed < *best) *best = elapsed;
+            emptyHeap(&scratch, processes);
+        }
+    }
+    setParallelCopyConfig(saved.threads, 0);
+
+    freeMemoryManager(&scratch);
+    os_region_free(&scratch.backingRegion);
+
+    // STEP 4: Report
+    snprintf(resultBuffer, bufferSize,
+        "{\"success\":true,\"heapMB\":%d,\"processes\":%d,\"blockKB\":%d,\"runs\":%d,"
+        "\"bytesMoved\":%lld,\"threads\":%d,\"thresholdBytes\":%zu,\"cpus\":%ld,"
+        "\"serialMs\":%.3f,\"parallelMs\":%.3f,\"speedup\":%.2f,"
+        "\"serialGBps\":%.2f,\"parallelGBps\":%.2f}",
+        heapMB, processes, blockKB, runs,
+        bytesMoved, saved.threads, saved.thresholdBytes, sysconf(_SC_NPROCESSORS_ONLN),
+        bestSerial / 1e6, bestParallel / 1e6,
+        (bestParallel > 0) ? (double)bestSerial / (double)bestParallel : 0.0,
+        (bestSerial > 0) ? (double)bytesMoved / (double)bestSerial : 0.0,
+        (bestParallel > 0) ? (double)bytesMoved / (double)bestParallel : 0.0);
+
+    return 1;
+}
+
+
+/*
+================================================================================
+END OF FILE: parallel_copy.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. copyWorker() / splitCopy() - Lazily started pool, chunked memcpy
+2. parallelMove() - memmove with parallel chunks and ordered rounds
+3. setParallelCopyConfig() / getParallelCopyStats() - Threads, threshold
+4. benchmarkCompaction() - Serial vs parallel compact() on a big heap
+================================================================================
+*/
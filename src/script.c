@@ -0,0 +1,240 @@
+/*
+================================================================================
+FILE: script.c
+PURPOSE: Implement the headless command interpreter
+DESCRIPTION:
+    - Read a line, split it into words, dispatch on the first word
+    - Every command calls the same engine function the menu and the
+      server call; only the printing differs (one short line, no map)
+================================================================================
+*/
+
+#include <stdio.h>      // FILE, fgets, fprintf
+#include <stdlib.h>     // malloc, free, strtol
+#include <string.h>     // strcmp, strtok
+#include <time.h>       // clock_gettime, CLOCK_MONOTONIC
+#include "../include/script.h"
+#include "../include/memory_manager.h"
+#include "../include/operations.h"
+
+
+// Longest command line; the JSON commands need one large output buffer
+#define SCRIPT_LINE_SIZE 256
+#define SCRIPT_JSON_SIZE (1024 * 1024)
+
+// Words per line (the longest command, alloc, has three)
+#define SCRIPT_MAX_WORDS 4
+
+
+static long long nowNanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: parseNumber
+--------------------------------------------------------------------------------
+PURPOSE: A positive integer, optionally written as a process name ("P3")
+
+RETURNS: The number, or -1 if the word is not one
+*/
+
+static int parseNumber(const char *word) {
+    if (word[0] == 'P' || word[0] == 'p') {
+        word++;
+    }
+    char *end;
+    long value = strtol(word, &end, 10);
+    if (end == word || *end != '\0' || value <= 0 || value > 0x7fffffff) {
+        return -1;
+    }
+    return (int)value;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: runCommand
+--------------------------------------------------------------------------------
+PURPOSE: Execute one split line
+
+RETURNS: 1 if the command ran (whatever its result), 0 if it was invalid
+         (the reason is left in 'error')
+*/
+
+static int runCommand(MemoryManager *mm, char **words, int count, FILE *out,
+                      char *json, const char **error) {
+
+    const char *command = words[0];
+
+    // ========== alloc <KB> [first|best|worst] ==========
+    if (strcmp(command, "alloc") == 0) {
+        int size = count >= 2 ? parseNumber(words[1]) : -1;
+        if (size <= 0 || count > 3) {
+            *error = "usage: alloc <KB> [first|best|worst]";
+            return 0;
+        }
+
+        AllocationAlgorithm algo = FIRST_FIT;
+        if (count == 3) {
+            if (strcmp(words[2], "best") == 0) {
+                algo = BEST_FIT;
+            } else if (strcmp(words[2], "worst") == 0) {
+                algo = WORST_FIT;
+            } else if (strcmp(words[2], "first") != 0) {
+                *error = "algorithm must be first, best or worst";
+                return 0;
+            }
+        }
+
+        int processID;
+        int start = opAllocate(mm, size, algo, &processID);
+
+        if (start >= 0) {
+            fprintf(out, "P%d %d\n", processID, start);
+        } else {
+            fprintf(out, "fail %d\n", size);
+        }
+        return 1;
+    }
+
+    // ========== free <pid> ==========
+    if (strcmp(command, "free") == 0) {
+        int processID = count == 2 ? parseNumber(words[1]) : -1;
+        if (processID <= 0) {
+            *error = "usage: free <pid>";
+            return 0;
+        }
+
+        int freed = opDeallocate(mm, processID);
+        fprintf(out, "%s P%d\n", freed > 0 ? "ok" : "fail", processID);
+        return 1;
+    }
+
+    // ========== compact ==========
+    if (strcmp(command, "compact") == 0 && count == 1) {
+        fprintf(out, "%s\n", compact(mm, json, SCRIPT_JSON_SIZE) ? "ok" : "fail");
+        return 1;
+    }
+
+    // ========== buddy on|off ==========
+    if (strcmp(command, "buddy") == 0) {
+        int done;
+        if (count == 2 && strcmp(words[1], "on") == 0) {
+            done = convertToBuddySystem(mm, json, SCRIPT_JSON_SIZE);
+        } else if (count == 2 && strcmp(words[1], "off") == 0) {
+            done = revertFromBuddySystem(mm, json, SCRIPT_JSON_SIZE);
+        } else {
+            *error = "usage: buddy on|off";
+            return 0;
+        }
+        fprintf(out, "%s\n", done ? "ok" : "fail");
+        return 1;
+    }
+
+    // ========== reset ==========
+    if (strcmp(command, "reset") == 0 && count == 1) {
+        resetMemory(mm);
+        fprintf(out, "ok\n");
+        return 1;
+    }
+
+    // ========== stats / snapshot ==========
+    if (strcmp(command, "stats") == 0 && count == 1) {
+        getStatsJSON(mm, json, SCRIPT_JSON_SIZE);
+        fprintf(out, "%s\n", json);
+        return 1;
+    }
+    if (strcmp(command, "snapshot") == 0 && count == 1) {
+        blocksToJSON(mm, json, SCRIPT_JSON_SIZE);
+        fprintf(out, "%s\n", json);
+        return 1;
+    }
+
+    *error = "unknown command or wrong number of arguments";
+    return 0;
+}
+
+
+/*
+================================================================================
+FUNCTION: runScript
+================================================================================
+ALGORITHM:
+1. For each line: cut the comment, split on whitespace, skip if empty
+2. Run the command; report invalid lines on stderr
+3. Print the summary on stderr
+*/
+
+int runScript(MemoryManager *mm, FILE *in, FILE *out) {
+
+    char *json = (char*)malloc(SCRIPT_JSON_SIZE);
+    if (json == NULL) {
+        fprintf(stderr, "script: out of memory\n");
+        return 1;
+    }
+
+    char line[SCRIPT_LINE_SIZE];
+    int lineNumber = 0;
+    int errors = 0;
+    long long commands = 0;
+    long long start = nowNanoseconds();
+
+    while (fgets(line, sizeof(line), in) != NULL) {
+        lineNumber++;
+
+        // STEP 1: Strip the comment and split
+        char *hash = strchr(line, '#');
+        if (hash != NULL) {
+            *hash = '\0';
+        }
+        char *words[SCRIPT_MAX_WORDS + 1];
+        int count = 0;
+        for (char *word = strtok(line, " \t\r\n"); word != NULL; word = strtok(NULL, " \t\r\n")) {
+            if (count <= SCRIPT_MAX_WORDS) {
+                words[count] = word;
+            }
+            count++;
+        }
+        if (count == 0) {
+            continue;
+        }
+
+        // STEP 2: Run it
+        const char *error = NULL;
+        if (count > SCRIPT_MAX_WORDS) {
+            error = "too many arguments";
+        } else if (runCommand(mm, words, count, out, json, &error)) {
+            commands++;
+            continue;
+        }
+        fprintf(stderr, "script: line %d: %s\n", lineNumber, error);
+        errors++;
+    }
+
+    // STEP 3: Summary (stderr, so stdout stays machine-readable)
+    fflush(out);
+    double seconds = (nowNanoseconds() - start) / 1e9;
+    fprintf(stderr, "script: %lld commands, %d errors, %.3f ms (%.0f commands/s)\n",
+            commands, errors, seconds * 1e3,
+            seconds > 0 ? commands / seconds : 0.0);
+
+    free(json);
+    return errors;
+}
+
+
+/*
+================================================================================
+END OF FILE: script.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. parseNumber() - Sizes and PIDs ("3" or "P3")
+2. runCommand() - alloc, free, compact, buddy, reset, stats, snapshot
+3. runScript() - Line loop, error reporting, timing summary
+================================================================================
+*/
@@ -0,0 +1,237 @@
+/*
+================================================================================
+FILE: shm_export.c
+PURPOSE: Write the block table and counters into the shared region (seqlock)
+================================================================================
+*/
+
+#include <stdio.h>          // snprintf, fprintf, perror
+#include <stdlib.h>         // malloc
+#include <string.h>         // memset
+#include <unistd.h>         // ftruncate, close, getpid
+#include <fcntl.h>          // O_CREAT, O_EXCL, O_RDWR
+#include <time.h>           // clock_gettime
+#include <sys/mman.h>       // shm_open, shm_unlink, mmap
+#include <sys/stat.h>       // fchmod
+#include "../include/shm_export.h"
+#include "../include/memory_manager.h"
+#include "../include/paged_allocator.h"     // pagedFreeRuns
+#include "../include/boundary_tag.h"        // BoundaryTagHeap.numFree
+
+
+static ShmExportRegion *region = NULL;
+static MemoryBlock *scratch = NULL;     // Blocks collected before the copy
+static char regionName[64];
+
+
+// One block as an exported row
+static void toRow(const MemoryBlock *block, ShmExportBlock *row) {
+    row->startAddress = block->startAddress;
+    row->size = block->size;
+    row->processId = block->isHole ? -1 : block->processID;
+    row->isHole = block->isHole;
+    row->blockId = block->blockID;
+    row->buddyId = block->buddyID;
+}
+
+
+/*
+================================================================================
+FUNCTION: shmExportStart
+================================================================================
+*/
+
+int shmExportStart(const char *name) {
+
+    size_t size = SHM_EXPORT_REGION_SIZE(SHM_EXPORT_MAX_BLOCKS);
+
+    // A region a previous server left keeps living for readers that have
+    // it mapped; new readers get the new one
+    shm_unlink(name);
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        perror("Error: Could not create the shared-memory export");
+        return -1;
+    }
+    fchmod(fd, 0644);      // Not narrowed by the umask: any local reader
+    void *mapped = MAP_FAILED;
+    if (ftruncate(fd, size) == 0) {
+        mapped = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    scratch = (MemoryBlock*)malloc(SHM_EXPORT_MAX_BLOCKS * sizeof(MemoryBlock));
+    if (mapped == MAP_FAILED || scratch == NULL) {
+        fprintf(stderr, "Error: Could not map the shared-memory export %s\n", name);
+        shm_unlink(name);
+        return -1;
+    }
+
+    region = (ShmExportRegion*)mapped;
+    memset(region, 0, sizeof(ShmExportRegion));
+    region->magic = SHM_EXPORT_MAGIC;
+    region->layout = SHM_EXPORT_LAYOUT;
+    region->blockCapacity = SHM_EXPORT_MAX_BLOCKS;
+    region->writerPid = (int32_t)getpid();
+    snprintf(regionName, sizeof(regionName), "%s", name);
+    return 0;
+}
+
+
+/*
+================================================================================
+FUNCTION: shmExportPublish
+================================================================================
+ALGORITHM:
+1. Collect the blocks and the counters outside the seqlock
+2. sequence → odd, then (release fence) write the rows and counters
+3. sequence → even (release store): a reader that saw this value on
+   both sides of its copy got exactly this publication
+*/
+
+void shmExportPublish(MemoryManager *mm) {
+
+    if (region == NULL) {
+        return;
+    }
+
+    // STEP 1: Collect
+    int total = blocksToArray(mm, scratch, SHM_EXPORT_MAX_BLOCKS);
+    int count = total < SHM_EXPORT_MAX_BLOCKS ? total : SHM_EXPORT_MAX_BLOCKS;
+
+    ShmExportCounters counters;
+    shmExportCounters(mm, &counters);
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    // STEP 2: Enter (odd)
+    uint32_t sequence = region->sequence;
+    __atomic_store_n(&region->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    for (int i = 0; i < count; i++) {
+        toRow(&scratch[i], &region->blocks[i]);
+    }
+    region->counters = counters;
+    region->numBlocks = count;
+    region->totalBlocks = total;
+    region->publishedNs = now.tv_sec * 1000000000LL + now.tv_nsec;
+    __atomic_store_n(&region->version, region->version + 1, __ATOMIC_RELAXED);
+
+    // STEP 3: Leave (even)
+    __atomic_store_n(&region->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+
+/*
+================================================================================
+FUNCTION: shmExportCounters
+================================================================================
+PURPOSE: The counters of GET /api/stats (holes counted the way each mode
+         counts them: free runs of frames, free tags, or holes)
+*/
+
+void shmExportCounters(MemoryManager *mm, ShmExportCounters *counters) {
+
+    memset(counters, 0, sizeof(*counters));
+    counters->totalMemory = mm->totalMemory;
+    counters->osMemory = mm->osMemory;
+    counters->userMemory = mm->userMemory;
+    counters->freeMemory = mm->freeMemory;
+    counters->numProcesses = mm->numProcesses;
+    counters->numHoles = mm->usePagedMode ? pagedFreeRuns(mm->paged) :
+                         mm->useBoundaryTags ? mm->tags->numFree : mm->numHoles;
+    counters->largestHole = largestHoleKB(mm);
+    counters->mode = mm->usePagedMode ? SHM_MODE_PAGED :
+                     mm->useBoundaryTags ? SHM_MODE_TAGS :
+                     mm->useBuddySystem ? SHM_MODE_BUDDY : SHM_MODE_LIST;
+    counters->fragmentation = calculateFragmentation(mm);
+    counters->processCounter = mm->processCounter;
+    counters->totalAllocations = mm->totalAllocations;
+    counters->totalDeallocations = mm->totalDeallocations;
+    counters->totalCompactions = mm->totalCompactions;
+    counters->layoutGeneration = mm->layoutGeneration;
+}
+
+
+/*
+================================================================================
+FUNCTION: shmExportRange
+================================================================================
+ALGORITHM:
+1. The block list is walked in place; paged and boundary-tag heaps are
+   collected into the scratch array first (what the export does too)
+2. Rows for blocks that end after 'from' and start before 'to', until
+   maxRows; the first block left out gives *next
+*/
+
+int shmExportRange(MemoryManager *mm, int from, int to,
+                   ShmExportBlock *rows, int maxRows, int *next) {
+
+    *next = -1;
+    int count = 0;
+
+    // STEP 1: Block list
+    if (!mm->usePagedMode && !mm->useBoundaryTags) {
+        for (MemoryBlock *b = mm->head; b != NULL && b->startAddress < to; b = b->next) {
+            if (b->startAddress + b->size <= from) {
+                continue;
+            }
+            if (count == maxRows) {
+                *next = b->startAddress;
+                break;
+            }
+            toRow(b, &rows[count++]);
+        }
+        return count;
+    }
+
+    // STEP 2: Paged / boundary tags
+    if (scratch == NULL) {
+        scratch = (MemoryBlock*)malloc(SHM_EXPORT_MAX_BLOCKS * sizeof(MemoryBlock));
+        if (scratch == NULL) {
+            return 0;
+        }
+    }
+    int total = blocksToArray(mm, scratch, SHM_EXPORT_MAX_BLOCKS);
+    if (total > SHM_EXPORT_MAX_BLOCKS) {
+        total = SHM_EXPORT_MAX_BLOCKS;
+    }
+    for (int i = 0; i < total && scratch[i].startAddress < to; i++) {
+        if (scratch[i].startAddress + scratch[i].size <= from) {
+            continue;
+        }
+        if (count == maxRows) {
+            *next = scratch[i].startAddress;
+            break;
+        }
+        toRow(&scratch[i], &rows[count++]);
+    }
+    return count;
+}
+
+
+/*
+================================================================================
+FUNCTION: shmExportName
+================================================================================
+*/
+
+const char* shmExportName(void) {
+    return region != NULL ? regionName : NULL;
+}
+
+
+/*
+================================================================================
+END OF FILE: shm_export.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. shmExportStart() - shm_open region, world-readable, fixed capacity
+2. shmExportPublish() - Collect, then copy inside the seqlock
+3. shmExportCounters() / shmExportRange() - Counters and rows on request
+   (also the binary protocol's STATS and BLOCK_RANGE answers)
+4. shmExportName() - Whether (and where) we export
+================================================================================
+*/
@@ -0,0 +1,137 @@
+/*
+================================================================================
+FILE: shm_reader.c
+PURPOSE: Map the shared-memory export and copy consistent publications
+================================================================================
+*/
+
+#include <string.h>         // memcpy
+#include <unistd.h>         // close
+#include <fcntl.h>          // O_RDONLY
+#include <sys/mman.h>       // shm_open, mmap, munmap
+#include <sys/stat.h>       // fstat
+#include "../include/shm_reader.h"
+
+
+// Copies attempted before shmReaderRead() gives up on a stuck writer
+#define SHM_READ_ATTEMPTS 1000000
+
+
+/*
+================================================================================
+FUNCTION: shmReaderOpen / shmReaderClose
+================================================================================
+*/
+
+int shmReaderOpen(ShmReader *reader, const char *name) {
+
+    reader->region = NULL;
+    reader->size = 0;
+
+    int fd = shm_open(name != NULL ? name : SHM_EXPORT_DEFAULT_NAME, O_RDONLY, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat info;
+    void *mapped = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(ShmExportRegion)) {
+        mapped = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        return -1;
+    }
+
+    const ShmExportRegion *region = (const ShmExportRegion*)mapped;
+    if (region->magic != SHM_EXPORT_MAGIC || region->layout != SHM_EXPORT_LAYOUT ||
+        SHM_EXPORT_REGION_SIZE(region->blockCapacity) > (size_t)info.st_size) {
+        munmap(mapped, info.st_size);
+        return -1;
+    }
+    reader->region = region;
+    reader->size = info.st_size;
+    return 0;
+}
+
+void shmReaderClose(ShmReader *reader) {
+    if (reader->region != NULL) {
+        munmap((void*)reader->region, reader->size);
+        reader->region = NULL;
+    }
+}
+
+
+/*
+================================================================================
+FUNCTION: shmReaderVersion
+================================================================================
+*/
+
+uint64_t shmReaderVersion(const ShmReader *reader) {
+    return __atomic_load_n(&reader->region->version, __ATOMIC_ACQUIRE);
+}
+
+
+/*
+================================================================================
+FUNCTION: shmReaderRead
+================================================================================
+ALGORITHM (the reader half of the seqlock):
+1. s1 = sequence (acquire); odd → the writer is inside, try again
+2. Copy (the row count is clamped: mid-write it can be anything)
+3. Acquire fence, s2 = sequence; s1 == s2 → nobody wrote meanwhile
+*/
+
+int shmReaderRead(const ShmReader *reader, ShmExportCounters *counters,
+                  ShmExportBlock *blocks, int maxBlocks, uint64_t *version) {
+
+    const ShmExportRegion *region = reader->region;
+
+    for (int attempt = 0; attempt < SHM_READ_ATTEMPTS; attempt++) {
+        // STEP 1: Wait for an even sequence
+        uint32_t before = __atomic_load_n(&region->sequence, __ATOMIC_ACQUIRE);
+        if (before & 1) {
+            continue;
+        }
+
+        // STEP 2: Copy
+        int rows = region->numBlocks;
+        if (rows < 0) {
+            rows = 0;
+        }
+        if (rows > maxBlocks) {
+            rows = maxBlocks;
+        }
+        if (rows > (int)region->blockCapacity) {
+            rows = (int)region->blockCapacity;
+        }
+        memcpy(counters, &region->counters, sizeof(*counters));
+        if (rows > 0) {
+            memcpy(blocks, region->blocks, rows * sizeof(ShmExportBlock));
+        }
+        uint64_t copied = region->version;
+
+        // STEP 3: Nobody wrote while we copied?
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&region->sequence, __ATOMIC_RELAXED) == before) {
+            if (version != NULL) {
+                *version = copied;
+            }
+            return rows;
+        }
+    }
+    return -1;
+}
+
+
+/*
+================================================================================
+END OF FILE: shm_reader.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. shmReaderOpen() / shmReaderClose() - Read-only mapping, layout check
+2. shmReaderVersion() - One load to see whether anything changed
+3. shmReaderRead() - Seqlock copy with a bounded number of retries
+================================================================================
+*/
@@ -0,0 +1,375 @@
+/*
+================================================================================
+FILE: simulation.c
+PURPOSE: Implement the discrete-event simulation engine
+DESCRIPTION:
+    - Event calendar: binary min-heap on (time, seq)
+    - Only ONE future arrival is on the calendar at a time; handling it
+      schedules the next, so the heap holds live processes + 1 entries
+    - Arrival: allocate (or reject if no hole fits), schedule departure
+    - Departure: deallocate
+================================================================================
+*/
+
+#include <stdio.h>      // snprintf, printf
+#include <stdlib.h>     // malloc, realloc, calloc, free
+#include <string.h>     // memset, memcpy
+#include <stdint.h>     // uint64_t
+#include <time.h>       // clock_gettime, CLOCK_MONOTONIC
+#include "../include/simulation.h"
+
+
+static long long nowNanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: exponential
+--------------------------------------------------------------------------------
+PURPOSE: Exponentially distributed sample with the given mean:
+         -mean * ln(u), u uniform in (0, 1]
+
+The project links no math library, so ln() is computed here:
+u = 2^e * m with m in [1, 2), ln(u) = e * ln 2 + ln(m), and
+ln(m) = 2 * atanh(t) with t = (m - 1) / (m + 1) <= 1/3 (5 series terms,
+error below 1e-6).
+*/
+
+static double exponential(WorkloadRNG *rng, double mean) {
+
+    double u = ((workloadNext(rng) >> 11) + 1) * (1.0 / 9007199254740992.0);
+
+    union { double d; uint64_t bits; } v;
+    v.d = u;
+    int e = (int)((v.bits >> 52) & 0x7FF) - 1023;
+    v.bits = (v.bits & 0x000FFFFFFFFFFFFFULL) | 0x3FF0000000000000ULL;   // m in [1, 2)
+
+    double t = (v.d - 1.0) / (v.d + 1.0);
+    double t2 = t * t;
+    double lnM = 2.0 * t * (1.0 + t2 * (1.0 / 3 + t2 * (1.0 / 5 + t2 * (1.0 / 7 + t2 / 9))));
+    double lnU = e * 0.69314718055994531 + lnM;
+
+    return -mean * lnU;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPERS: eventBefore / heapPush / heapPop
+--------------------------------------------------------------------------------
+*/
+
+static int eventBefore(const SimEvent *a, const SimEvent *b) {
+    return a->timeMs < b->timeMs || (a->timeMs == b->timeMs && a->seq < b->seq);
+}
+
+static int heapPush(Simulation *sim, double timeMs, int type, int processID) {
+
+    if (sim->heapSize == sim->heapCapacity) {
+        int capacity = sim->heapCapacity * 2;
+        SimEvent *grown = (SimEvent*)realloc(sim->heap, sizeof(SimEvent) * (size_t)capacity);
+        if (grown == NULL) {
+            return 0;
+        }
+        sim->heap = grown;
+        sim->heapCapacity = capacity;
+    }
+
+    SimEvent event = { timeMs, sim->nextSeq++, type, processID };
+
+    // Sift up: move parents down until the new event's place is found
+    int i = sim->heapSize++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!eventBefore(&event, &sim->heap[parent])) {
+            break;
+        }
+        sim->heap[i] = sim->heap[parent];
+        i = parent;
+    }
+    sim->heap[i] = event;
+    return 1;
+}
+
+static SimEvent heapPop(Simulation *sim) {
+
+    SimEvent top = sim->heap[0];
+    SimEvent last = sim->heap[--sim->heapSize];
+
+    // Sift down: move the earlier child up until last fits
+    int i = 0;
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= sim->heapSize) {
+            break;
+        }
+        if (child + 1 < sim->heapSize && eventBefore(&sim->heap[child + 1], &sim->heap[child])) {
+            child++;
+        }
+        if (!eventBefore(&sim->heap[child], &last)) {
+            break;
+        }
+        sim->heap[i] = sim->heap[child];
+        i = child;
+    }
+    if (sim->heapSize > 0) {
+        sim->heap[i] = last;
+    }
+    return top;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: initSimulatedManager
+--------------------------------------------------------------------------------
+PURPOSE: A manager like initializeMemory() builds, but with no backing
+         region (realPtr NULL: allocations fill no real bytes) and no
+         console output. Buddy mode uses the largest power of 2 that fits,
+         exactly like convertToBuddySystem().
+*/
+
+static int initSimulatedManager(MemoryManager *mm, int totalKB, int osKB, int useBuddy) {
+
+    memset(mm, 0, sizeof(*mm));
+    mm->totalMemory = totalKB;
+    mm->osMemory = osKB;
+    mm->userMemory = totalKB - osKB;
+    mm->nextBlockID = 1;
+    mm->measureFaults = 0;
+
+    int size = mm->userMemory;
+    if (useBuddy) {
+        size = buddyPoolSize(mm->userMemory);
+        mm->useBuddySystem = 1;
+    }
+
+    mm->head = createBlock(mm, 1, osKB, osKB + size - 1, -1);
+    if (mm->head == NULL) {
+        return 0;
+    }
+    mm->freeMemory = size;
+    mm->numHoles = 1;
+    return size;
+}
+
+
+/*
+================================================================================
+FUNCTION: simulationCreate / simulationDestroy
+================================================================================
+*/
+
+Simulation* simulationCreate(const SimulationConfig *config) {
+
+    // STEP 1: Validate
+    if (config->totalKB <= config->osKB || config->osKB < 0 ||
+        config->minSizeKB < 1 || config->maxSizeKB < config->minSizeKB ||
+        config->meanInterarrivalMs <= 0 || config->meanLifetimeMs <= 0 ||
+        config->maxEvents < 1) {
+        return NULL;
+    }
+
+    Simulation *sim = (Simulation*)calloc(1, sizeof(Simulation));
+    if (sim == NULL) {
+        return NULL;
+    }
+    sim->config = *config;
+    workloadSeed(&sim->rng, config->seed);
+
+    // STEP 2: Scratch manager and calendar
+    sim->capacityKB = initSimulatedManager(&sim->mm, config->totalKB, config->osKB,
+                                           config->useBuddy);
+    sim->heapCapacity = 256;
+    sim->heap = (SimEvent*)malloc(sizeof(SimEvent) * (size_t)sim->heapCapacity);
+    if (sim->capacityKB == 0 || sim->heap == NULL) {
+        simulationDestroy(sim);
+        return NULL;
+    }
+
+    // STEP 3: The first arrival
+    heapPush(sim, exponential(&sim->rng, config->meanInterarrivalMs), SIM_ARRIVAL, 0);
+    return sim;
+}
+
+void simulationDestroy(Simulation *sim) {
+    if (sim == NULL) {
+        return;
+    }
+    freeMemoryManager(&sim->mm);
+    free(sim->heap);
+    free(sim);
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPERS: handleArrival / handleDeparture
+--------------------------------------------------------------------------------
+*/
+
+static void handleArrival(Simulation *sim) {
+
+    const SimulationConfig *c = &sim->config;
+    MemoryManager *mm = &sim->mm;
+
+    // The next arrival keeps the stream going
+    heapPush(sim, sim->nowMs + exponential(&sim->rng, c->meanInterarrivalMs), SIM_ARRIVAL, 0);
+
+    int size = c->minSizeKB + (int)workloadRange(&sim->rng, (uint32_t)(c->maxSizeKB - c->minSizeKB + 1));
+    int processID = ++sim->nextProcessID;
+    sim->arrivals++;
+
+    // allocateMemory() prints when the total is short; count that as a
+    // rejection without calling it
+    int start = -1;
+    if (size <= mm->freeMemory) {
+        if (c->useBuddy) {
+            mm->processCounter = processID - 1;     // buddyAllocate picks ++processCounter
+            start = buddyAllocate(mm, size, NULL, 0);
+        } else {
+            start = allocateMemory(mm, processID, size, c->algorithm);
+        }
+    }
+    if (start < 0) {
+        sim->rejected++;
+        return;
+    }
+
+    sim->live++;
+    if (sim->live > sim->peakLive) {
+        sim->peakLive = sim->live;
+    }
+    heapPush(sim, sim->nowMs + exponential(&sim->rng, c->meanLifetimeMs), SIM_DEPARTURE, processID);
+}
+
+static void handleDeparture(Simulation *sim, int processID) {
+    if (sim->config.useBuddy) {
+        buddyDeallocate(&sim->mm, processID, NULL, 0);
+    } else {
+        deallocateMemory(&sim->mm, processID);
+    }
+    sim->live--;
+    sim->departures++;
+}
+
+
+/*
+================================================================================
+FUNCTION: simulationRun
+================================================================================
+ALGORITHM (the classic event loop):
+1. Pop the earliest event
+2. Charge the time since the last event at the current memory usage
+3. Advance the clock to the event
+4. Handle it (which may schedule more events)
+*/
+
+long long simulationRun(Simulation *sim, long long events) {
+
+    long long start = nowNanoseconds();
+    long long remaining = sim->config.maxEvents - sim->events;
+    if (events > remaining) {
+        events = remaining;
+    }
+
+    long long done = 0;
+    while (done < events && sim->heapSize > 0) {
+
+        // STEP 1: Earliest event
+        SimEvent event = heapPop(sim);
+
+        // STEP 2 + 3: Time-weighted usage, then move the clock
+        int usedKB = sim->capacityKB - sim->mm.freeMemory;
+        sim->usedKBms += usedKB * (event.timeMs - sim->nowMs);
+        sim->nowMs = event.timeMs;
+
+        // STEP 4: Handle
+        if (event.type == SIM_ARRIVAL) {
+            handleArrival(sim);
+        } else {
+            handleDeparture(sim, event.processID);
+        }
+        done++;
+    }
+    sim->events += done;
+    sim->wallNs += nowNanoseconds() - start;
+
+    // Progress row for this step
+    if (done > 0 && sim->numProgress < SIM_MAX_PROGRESS) {
+        SimulationProgress *p = &sim->progress[sim->numProgress++];
+        p->timeMs = sim->nowMs;
+        p->events = sim->events;
+        p->live = sim->live;
+        p->fragmentation = calculateFragmentation(&sim->mm);
+        p->utilization = sim->nowMs > 0
+            ? (float)(100.0 * sim->usedKBms / (sim->capacityKB * sim->nowMs)) : 0.0f;
+        p->rejected = sim->rejected;
+    }
+    return done;
+}
+
+
+/*
+================================================================================
+FUNCTION: simulationToJSON
+================================================================================
+*/
+
+void simulationToJSON(const Simulation *sim, char *buffer, int bufferSize) {
+
+    const SimulationConfig *c = &sim->config;
+    static const char *algorithmNames[] = { "first_fit", "best_fit", "worst_fit" };
+
+    int w = snprintf(buffer, bufferSize,
+        "{\"success\":true,"
+        "\"config\":{\"algorithm\":\"%s\",\"totalKB\":%d,\"osKB\":%d,"
+        "\"minSizeKB\":%d,\"maxSizeKB\":%d,\"interarrivalMs\":%.3f,"
+        "\"lifetimeMs\":%.3f,\"events\":%lld,\"seed\":%llu},"
+        "\"progress\":[",
+        c->useBuddy ? "buddy" : algorithmNames[c->algorithm],
+        c->totalKB, c->osKB, c->minSizeKB, c->maxSizeKB,
+        c->meanInterarrivalMs, c->meanLifetimeMs, c->maxEvents, c->seed);
+
+    for (int i = 0; i < sim->numProgress && w < bufferSize - 600; i++) {
+        const SimulationProgress *p = &sim->progress[i];
+        w += snprintf(buffer + w, bufferSize - w,
+            "%s{\"timeMs\":%.1f,\"events\":%lld,\"live\":%d,"
+            "\"fragmentation\":%.2f,\"utilization\":%.2f,\"rejected\":%lld}",
+            i == 0 ? "" : ",",
+            p->timeMs, p->events, p->live, p->fragmentation, p->utilization, p->rejected);
+    }
+
+    double wallSeconds = sim->wallNs / 1e9;
+    snprintf(buffer + w, bufferSize - w,
+        "],\"result\":{\"events\":%lld,\"arrivals\":%lld,\"departures\":%lld,"
+        "\"rejected\":%lld,\"rejectionRate\":%.4f,\"live\":%d,\"peakLive\":%d,"
+        "\"virtualTimeMs\":%.1f,\"meanUtilization\":%.2f,"
+        "\"wallMs\":%.2f,\"eventsPerSecond\":%.0f}}",
+        sim->events, sim->arrivals, sim->departures,
+        sim->rejected, sim->arrivals > 0 ? (double)sim->rejected / sim->arrivals : 0.0,
+        sim->live, sim->peakLive,
+        sim->nowMs,
+        sim->nowMs > 0 ? 100.0 * sim->usedKBms / (sim->capacityKB * sim->nowMs) : 0.0,
+        wallSeconds * 1000.0,
+        wallSeconds > 0 ? sim->events / wallSeconds : 0.0);
+}
+
+
+/*
+================================================================================
+END OF FILE: simulation.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. exponential() - Exponential samples without libm
+2. heapPush() / heapPop() - The event calendar
+3. simulationCreate() / simulationDestroy() - Scratch manager, first arrival
+4. simulationRun() - The event loop, one progress row per call
+5. simulationToJSON() - Config, progress and totals
+================================================================================
+*/
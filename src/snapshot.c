@@ -0,0 +1,136 @@
+/*
+================================================================================
+FILE: snapshot.c
+PURPOSE: Implement copy-on-write snapshot publication
+DESCRIPTION:
+    - Render blocks + stats into a fresh snapshot
+    - Swap the published pointer under a lock held for two instructions
+    - Reference counting keeps old versions alive for their readers
+================================================================================
+*/
+
+#include <stdio.h>      // snprintf
+#include <stdlib.h>     // malloc, free
+#include <string.h>     // strlen
+#include <time.h>       // clock_gettime, CLOCK_MONOTONIC
+#include <pthread.h>    // pthread_mutex_t
+#include "../include/snapshot.h"
+#include "../include/memory_manager.h"
+
+
+/*
+================================================================================
+STATE: The published snapshot
+================================================================================
+
+EXAMPLE (a reader overlaps a compaction):
+reader:  acquire v7 (refs 1 → 2) ......... send v7 ......... release (1 → 0: freed)
+writer:       compact ... render v8 ... swap to v8, release v7 (2 → 1)
+*/
+
+static pthread_mutex_t publishLock = PTHREAD_MUTEX_INITIALIZER;
+static Snapshot          *current = NULL;
+static unsigned long long nextVersion = 1;
+static long long          liveVersions = 0;   // Published or still being read
+
+
+static long long nowNanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+
+/*
+================================================================================
+FUNCTION: snapshotPublish
+================================================================================
+*/
+
+void snapshotPublish(MemoryManager *mm) {
+
+    long long start = nowNanoseconds();
+
+    // STEP 1: Render off to the side (readers still see the old version)
+    Snapshot *fresh = (Snapshot*)malloc(sizeof(Snapshot));
+    char *blocks = (char*)malloc(SNAPSHOT_JSON_SIZE);
+    char *stats = (char*)malloc(SNAPSHOT_JSON_SIZE);
+    if (fresh == NULL || blocks == NULL || stats == NULL) {
+        free(fresh);
+        free(blocks);
+        free(stats);
+        return;     // Readers keep the previous version
+    }
+
+    blocksToJSON(mm, blocks, SNAPSHOT_JSON_SIZE);
+    getStatsJSON(mm, stats, SNAPSHOT_JSON_SIZE);
+
+    fresh->refs = 1;                    // The publication's reference
+    fresh->version = nextVersion++;
+    fresh->blocksJSON = blocks;
+    fresh->statsJSON = stats;
+
+    // STEP 2: Tag the stats with the version ("...}" → "...,"snapshot":{...}}")
+    size_t len = strlen(stats);
+    if (len > 0 && stats[len - 1] == '}') {
+        snprintf(stats + len - 1, SNAPSHOT_JSON_SIZE - (len - 1),
+            ",\"snapshot\":{\"version\":%llu,\"liveVersions\":%lld,\"renderUs\":%.1f}}",
+            fresh->version,
+            __atomic_load_n(&liveVersions, __ATOMIC_RELAXED) + 1,
+            (nowNanoseconds() - start) / 1000.0);
+    }
+
+    // STEP 3: Publish with one pointer swap
+    __atomic_add_fetch(&liveVersions, 1, __ATOMIC_RELAXED);
+    pthread_mutex_lock(&publishLock);
+    Snapshot *old = current;
+    current = fresh;
+    pthread_mutex_unlock(&publishLock);
+
+    // STEP 4: Drop the old publication reference (readers may keep it alive)
+    if (old != NULL) {
+        snapshotRelease(old);
+    }
+}
+
+
+/*
+================================================================================
+FUNCTION: snapshotAcquire / snapshotRelease
+================================================================================
+*/
+
+Snapshot* snapshotAcquire(void) {
+    pthread_mutex_lock(&publishLock);
+    Snapshot *snapshot = current;
+    if (snapshot != NULL) {
+        __atomic_add_fetch(&snapshot->refs, 1, __ATOMIC_ACQ_REL);
+    }
+    pthread_mutex_unlock(&publishLock);
+    return snapshot;
+}
+
+void snapshotRelease(Snapshot *snapshot) {
+    if (snapshot == NULL) {
+        return;
+    }
+    if (__atomic_sub_fetch(&snapshot->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+        free(snapshot->blocksJSON);
+        free(snapshot->statsJSON);
+        free(snapshot);
+        __atomic_sub_fetch(&liveVersions, 1, __ATOMIC_RELAXED);
+    }
+}
+
+
+/*
+================================================================================
+END OF FILE: snapshot.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. snapshotPublish() - Render blocks + stats, then swap one pointer
+2. snapshotAcquire() - Reference to the newest version, never waits on a writer
+3. snapshotRelease() - Last reference frees the version
+================================================================================
+*/
@@ -0,0 +1,276 @@
+/*
+================================================================================
+FILE: static_files.c
+PURPOSE: Index the UI build directory and look files up by URL path
+DESCRIPTION:
+    - One recursive walk at startup; each file is opened once and its
+      descriptor kept, so a request does no open()/stat() at all
+    - The index is sorted by path and never changes afterwards, so
+      lookups from any number of connection threads need no lock
+    - Serving (headers, 304, sendfile) is in http_server.c, which owns
+      the connection
+================================================================================
+*/
+
+#include <stdio.h>      // snprintf
+#include <stdlib.h>     // realloc, qsort, bsearch
+#include <string.h>     // strcmp, strrchr, strncpy, memcpy
+#include <dirent.h>     // opendir, readdir
+#include <fcntl.h>      // open, O_RDONLY
+#include <unistd.h>     // close
+#include <sys/stat.h>   // fstat, S_ISREG, S_ISDIR
+#include "../include/static_files.h"
+
+
+static StaticFile *files = NULL;
+static int numFiles = 0;
+static int capacity = 0;
+static char rootDir[STATIC_MAX_PATH] = "";
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: contentTypeFor
+--------------------------------------------------------------------------------
+PURPOSE: MIME type from the file extension (what a Vite build contains)
+*/
+
+static const struct {
+    const char *extension;
+    const char *type;
+} contentTypes[] = {
+    { ".html",  "text/html; charset=utf-8" },
+    { ".js",    "text/javascript; charset=utf-8" },
+    { ".mjs",   "text/javascript; charset=utf-8" },
+    { ".css",   "text/css; charset=utf-8" },
+    { ".json",  "application/json" },
+    { ".map",   "application/json" },
+    { ".svg",   "image/svg+xml" },
+    { ".png",   "image/png" },
+    { ".jpg",   "image/jpeg" },
+    { ".jpeg",  "image/jpeg" },
+    { ".gif",   "image/gif" },
+    { ".webp",  "image/webp" },
+    { ".ico",   "image/x-icon" },
+    { ".woff",  "font/woff" },
+    { ".woff2", "font/woff2" },
+    { ".ttf",   "font/ttf" },
+    { ".txt",   "text/plain; charset=utf-8" },
+    { ".wasm",  "application/wasm" }
+};
+
+static const char* contentTypeFor(const char *path) {
+    const char *dot = strrchr(path, '.');
+    if (dot != NULL && strchr(dot, '/') == NULL) {
+        for (size_t i = 0; i < sizeof(contentTypes) / sizeof(contentTypes[0]); i++) {
+            if (strcmp(dot, contentTypes[i].extension) == 0) {
+                return contentTypes[i].type;
+            }
+        }
+    }
+    return "application/octet-stream";
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: addFile
+--------------------------------------------------------------------------------
+PURPOSE: Index one file: open it, and its .gz variant if that is smaller
+*/
+
+static void addFile(const char *fullPath, const char *urlPath) {
+
+    size_t pathLength = strlen(urlPath);
+    if (numFiles >= STATIC_MAX_FILES || pathLength >= STATIC_MAX_PATH) {
+        return;
+    }
+    int fd = open(fullPath, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return;
+    }
+
+    if (numFiles == capacity) {
+        int grown = capacity == 0 ? 64 : capacity * 2;
+        StaticFile *more = (StaticFile*)realloc(files, grown * sizeof(StaticFile));
+        if (more == NULL) {
+            close(fd);
+            return;
+        }
+        files = more;
+        capacity = grown;
+    }
+
+    StaticFile *file = &files[numFiles++];
+    memcpy(file->path, urlPath, pathLength + 1);      // Length checked above
+    file->fd = fd;
+    file->size = info.st_size;
+    file->contentType = contentTypeFor(urlPath);
+    file->immutable = strncmp(urlPath, "/assets/", 8) == 0;
+    snprintf(file->etag, sizeof(file->etag), "\"%llx-%llx\"",
+             (unsigned long long)info.st_size, (unsigned long long)info.st_mtime);
+
+    // Precompressed variant (only worth it when it is smaller)
+    char gzipPath[STATIC_MAX_PATH * 2 + 4];
+    snprintf(gzipPath, sizeof(gzipPath), "%s.gz", fullPath);
+    file->gzipFd = -1;
+    file->gzipSize = 0;
+    int gzipFd = open(gzipPath, O_RDONLY);
+    struct stat gzipInfo;
+    if (gzipFd >= 0 && fstat(gzipFd, &gzipInfo) == 0 && S_ISREG(gzipInfo.st_mode) &&
+        gzipInfo.st_size < info.st_size) {
+        file->gzipFd = gzipFd;
+        file->gzipSize = gzipInfo.st_size;
+    } else if (gzipFd >= 0) {
+        close(gzipFd);
+    }
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: walk
+--------------------------------------------------------------------------------
+PURPOSE: Add every file below 'dir' ('urlPrefix' is its URL path)
+*/
+
+static void walk(const char *dir, const char *urlPrefix, int depth) {
+
+    DIR *handle = opendir(dir);
+    if (handle == NULL || depth > 16) {
+        if (handle != NULL) {
+            closedir(handle);
+        }
+        return;
+    }
+
+    struct dirent *entry;
+    while ((entry = readdir(handle)) != NULL) {
+        const char *name = entry->d_name;
+        size_t length = strlen(name);
+        if (name[0] == '.' || (length > 3 && strcmp(name + length - 3, ".gz") == 0)) {
+            continue;       // Hidden, ".", ".." and the variants themselves
+        }
+
+        char fullPath[STATIC_MAX_PATH * 2];
+        char urlPath[STATIC_MAX_PATH * 2];
+        snprintf(fullPath, sizeof(fullPath), "%s/%s", dir, name);
+        snprintf(urlPath, sizeof(urlPath), "%s/%s", urlPrefix, name);
+
+        struct stat info;
+        if (stat(fullPath, &info) != 0) {
+            continue;
+        }
+        if (S_ISDIR(info.st_mode)) {
+            walk(fullPath, urlPath, depth + 1);
+        } else if (S_ISREG(info.st_mode)) {
+            addFile(fullPath, urlPath);
+        }
+    }
+    closedir(handle);
+}
+
+static int comparePaths(const void *a, const void *b) {
+    return strcmp(((const StaticFile*)a)->path, ((const StaticFile*)b)->path);
+}
+
+
+/*
+================================================================================
+FUNCTION: staticFilesLoad
+================================================================================
+*/
+
+int staticFilesLoad(const char *root) {
+
+    DIR *check = opendir(root);
+    if (check == NULL) {
+        return -1;
+    }
+    closedir(check);
+
+    snprintf(rootDir, sizeof(rootDir), "%s", root);
+    walk(root, "", 0);
+    qsort(files, numFiles, sizeof(StaticFile), comparePaths);
+    return numFiles;
+}
+
+
+/*
+================================================================================
+FUNCTION: staticFileFind
+================================================================================
+ALGORITHM:
+1. Cut the query string; "/" means /index.html
+2. Binary search in the sorted index
+3. Not a file and no extension: the UI's own route → /index.html
+*/
+
+const StaticFile* staticFileFind(const char *path) {
+
+    if (numFiles == 0) {
+        return NULL;
+    }
+
+    // STEP 1: Path without "?..."
+    StaticFile key;
+    size_t length = strcspn(path, "?#");
+    if (length >= sizeof(key.path)) {
+        return NULL;
+    }
+    memcpy(key.path, path, length);
+    key.path[length] = '\0';
+    if (strcmp(key.path, "/") == 0) {
+        strcpy(key.path, "/index.html");
+    }
+
+    // STEP 2: Exact match
+    const StaticFile *file = (const StaticFile*)bsearch(&key, files, numFiles,
+                                                        sizeof(StaticFile), comparePaths);
+    if (file != NULL) {
+        return file;
+    }
+
+    // STEP 3: Client-side route
+    const char *last = strrchr(key.path, '/');
+    if (last != NULL && strchr(last, '.') == NULL) {
+        strcpy(key.path, "/index.html");
+        return (const StaticFile*)bsearch(&key, files, numFiles,
+                                          sizeof(StaticFile), comparePaths);
+    }
+    return NULL;
+}
+
+
+/*
+================================================================================
+FUNCTION: staticFileCount / staticFilesRoot
+================================================================================
+*/
+
+int staticFileCount(void) {
+    return numFiles;
+}
+
+const char* staticFilesRoot(void) {
+    return rootDir;
+}
+
+
+/*
+================================================================================
+END OF FILE: static_files.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. contentTypeFor() - MIME types of a Vite build
+2. addFile() - Open once, ETag from size + mtime, smaller .gz variant
+3. walk() - Recursive directory walk (hidden files skipped)
+4. staticFilesLoad() - Build and sort the index
+5. staticFileFind() - Binary search, "/" and client-side routes → index.html
+================================================================================
+*/
@@ -0,0 +1,320 @@
+/*
+================================================================================
+FILE: stats_history.c
+PURPOSE: Implement the multi-resolution stats rings
+DESCRIPTION:
+    - Every sample goes into the raw ring and into the open 1-second
+      accumulator
+    - When a sample lands in a new second, the old second becomes one
+      bucket of the 1-second ring and feeds the open 1-minute accumulator
+    - Minutes close the same way into the 1-minute ring
+================================================================================
+*/
+
+#include <stdio.h>      // snprintf
+#include <string.h>     // strcmp, memset
+#include <time.h>       // clock_gettime, CLOCK_REALTIME
+#include <pthread.h>    // pthread_mutex_t
+#include "../include/stats_history.h"
+#include "../include/memory_manager.h"
+#include "../include/paged_allocator.h"
+#include "../include/boundary_tag.h"
+
+
+/*
+================================================================================
+STATE: Rings and accumulators
+================================================================================
+*/
+
+typedef struct {
+    StatsPoint *points;
+    int         capacity;
+    int         next;       // Where the next point goes
+    int         count;
+} StatsRing;
+
+typedef struct {
+    long long startMs;      // Bucket start (aligned to the resolution)
+    double    freeKB, holes, largestHoleKB, fragmentation;   // Sums
+    float     fragmentationMax;
+    long long ops;
+    int       samples;
+} StatsAccumulator;
+
+static StatsPoint rawPoints[STATS_RAW_SAMPLES];
+static StatsPoint secondPoints[STATS_SECOND_BUCKETS];
+static StatsPoint minutePoints[STATS_MINUTE_BUCKETS];
+
+static StatsRing rawRing    = { rawPoints,    STATS_RAW_SAMPLES,    0, 0 };
+static StatsRing secondRing = { secondPoints, STATS_SECOND_BUCKETS, 0, 0 };
+static StatsRing minuteRing = { minutePoints, STATS_MINUTE_BUCKETS, 0, 0 };
+
+static StatsAccumulator openSecond;
+static StatsAccumulator openMinute;
+static float            lastSecondOps = 0;  // ops/s of the last closed second
+
+static pthread_mutex_t statsLock = PTHREAD_MUTEX_INITIALIZER;
+
+
+static long long nowMilliseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (long long)ts.tv_sec * 1000LL + ts.tv_nsec / 1000000;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPERS: ringPush / ringAt / accumulate / closeBucket
+--------------------------------------------------------------------------------
+*/
+
+static void ringPush(StatsRing *ring, const StatsPoint *point) {
+    ring->points[ring->next] = *point;
+    ring->next = (ring->next + 1) % ring->capacity;
+    if (ring->count < ring->capacity) {
+        ring->count++;
+    }
+}
+
+// i = 0 is the oldest point still in the ring
+static const StatsPoint* ringAt(const StatsRing *ring, int i) {
+    int oldest = (ring->next - ring->count + ring->capacity) % ring->capacity;
+    return &ring->points[(oldest + i) % ring->capacity];
+}
+
+// Add a point (a raw sample or a closed bucket) with its sample weight
+static void accumulate(StatsAccumulator *acc, const StatsPoint *point,
+                       long long bucketStartMs, long long ops) {
+    if (acc->samples == 0) {
+        acc->startMs = bucketStartMs;
+    }
+    acc->freeKB += (double)point->freeKB * point->samples;
+    acc->holes += (double)point->holes * point->samples;
+    acc->largestHoleKB += (double)point->largestHoleKB * point->samples;
+    acc->fragmentation += (double)point->fragmentation * point->samples;
+    if (point->fragmentationMax > acc->fragmentationMax) {
+        acc->fragmentationMax = point->fragmentationMax;
+    }
+    acc->ops += ops;
+    acc->samples += point->samples;
+}
+
+// Means of the accumulator as one point; resets it
+static StatsPoint closeBucket(StatsAccumulator *acc, float seconds) {
+    StatsPoint point;
+    point.timeMs = acc->startMs;
+    point.freeKB = (float)(acc->freeKB / acc->samples);
+    point.holes = (float)(acc->holes / acc->samples);
+    point.largestHoleKB = (float)(acc->largestHoleKB / acc->samples);
+    point.fragmentation = (float)(acc->fragmentation / acc->samples);
+    point.fragmentationMax = acc->fragmentationMax;
+    point.opsPerSec = acc->ops / seconds;
+    point.samples = acc->samples;
+    memset(acc, 0, sizeof(*acc));
+    return point;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: measure
+--------------------------------------------------------------------------------
+PURPOSE: Free memory, holes and largest hole of whichever engine is
+         active (the same numbers getStatsJSON reports)
+*/
+
+static void measure(MemoryManager *mm, StatsPoint *point) {
+
+    int holes = mm->numHoles;
+    int largest = 0;
+
+    if (mm->usePagedMode) {
+        largest = pagedLargestFreeRun(mm->paged);
+        holes = pagedFreeRuns(mm->paged);
+    } else if (mm->useBoundaryTags) {
+        largest = (int)(btLargestFree(mm->tags) / 1024);
+        holes = mm->tags->numFree;
+    } else {
+        for (MemoryBlock *b = mm->head; b != NULL; b = b->next) {
+            if (b->isHole && b->size > largest) {
+                largest = b->size;
+            }
+        }
+    }
+
+    point->freeKB = (float)mm->freeMemory;
+    point->holes = (float)holes;
+    point->largestHoleKB = (float)largest;
+    point->fragmentation = calculateFragmentation(mm);
+    point->fragmentationMax = point->fragmentation;
+    point->samples = 1;
+}
+
+
+/*
+================================================================================
+FUNCTION: statsHistorySample
+================================================================================
+ALGORITHM:
+1. Measure
+2. A new second? Close the open one into the 1s ring; a new minute?
+   close the open minute into the 1m ring first
+3. Push the raw sample, add it to the open second
+*/
+
+void statsHistorySample(MemoryManager *mm, int mutation) {
+
+    // STEP 1: Measure (outside the stats lock; mm is held still by the caller)
+    StatsPoint point;
+    measure(mm, &point);
+    point.timeMs = nowMilliseconds();
+
+    pthread_mutex_lock(&statsLock);
+
+    // STEP 2: Roll up finished buckets
+    long long secondStart = point.timeMs - point.timeMs % 1000;
+    if (openSecond.samples > 0 && openSecond.startMs != secondStart) {
+        long long ops = openSecond.ops;
+        StatsPoint second = closeBucket(&openSecond, 1.0f);
+        ringPush(&secondRing, &second);
+        lastSecondOps = second.opsPerSec;
+
+        long long minuteStart = second.timeMs - second.timeMs % 60000;
+        if (openMinute.samples > 0 && openMinute.startMs != minuteStart) {
+            StatsPoint minute = closeBucket(&openMinute, 60.0f);
+            ringPush(&minuteRing, &minute);
+        }
+        accumulate(&openMinute, &second, minuteStart, ops);
+    }
+
+    // STEP 3: Raw sample
+    point.opsPerSec = lastSecondOps;
+    ringPush(&rawRing, &point);
+    accumulate(&openSecond, &point, secondStart, mutation);
+
+    pthread_mutex_unlock(&statsLock);
+}
+
+
+// Where the text ends after a snprintf that wanted 'written' more
+// characters: never past bufferSize, even when it was cut short
+static int advance(int w, int written, int bufferSize) {
+    return (written < 0 || written >= bufferSize - w) ? bufferSize : w + written;
+}
+
+
+/*
+--------------------------------------------------------------------------------
+HELPER: writeColumn
+--------------------------------------------------------------------------------
+PURPOSE: One "name":[v1,v2,...] array over points first..count-1 of ring
+*/
+
+static int writeColumn(char *buffer, int bufferSize, int w, const char *name,
+                       const StatsRing *ring, int first, int count, int field) {
+    if (w >= bufferSize) {
+        return bufferSize;      // Full already: bufferSize - w would wrap
+    }
+    w = advance(w, snprintf(buffer + w, bufferSize - w, ",\"%s\":[", name), bufferSize);
+    for (int i = first; i < count && w < bufferSize; i++) {
+        const StatsPoint *p = ringAt(ring, i);
+        const char *comma = i == first ? "" : ",";
+        char *out = buffer + w;
+        int room = bufferSize - w;
+        int n = 0;
+        switch (field) {
+            case 0: n = snprintf(out, room, "%s%lld", comma, p->timeMs); break;
+            case 1: n = snprintf(out, room, "%s%.1f", comma, p->freeKB); break;
+            case 2: n = snprintf(out, room, "%s%.1f", comma, p->holes); break;
+            case 3: n = snprintf(out, room, "%s%.1f", comma, p->largestHoleKB); break;
+            case 4: n = snprintf(out, room, "%s%.2f", comma, p->fragmentation); break;
+            case 5: n = snprintf(out, room, "%s%.2f", comma, p->fragmentationMax); break;
+            case 6: n = snprintf(out, room, "%s%.1f", comma, p->opsPerSec); break;
+        }
+        w = advance(w, n, bufferSize);
+    }
+    if (w < bufferSize) {
+        w = advance(w, snprintf(buffer + w, bufferSize - w, "]"), bufferSize);
+    }
+    return w;
+}
+
+
+/*
+================================================================================
+FUNCTION: statsHistoryToJSON
+================================================================================
+*/
+
+int statsHistoryToJSON(int rangeSeconds, const char *resolution,
+                       char *buffer, int bufferSize) {
+
+    // STEP 1: Pick the resolution
+    const StatsRing *ring = &minuteRing;
+    const char *name = "1m";
+    if (resolution != NULL && strcmp(resolution, "raw") == 0) {
+        ring = &rawRing;
+        name = "raw";
+    } else if (resolution != NULL && strcmp(resolution, "1s") == 0) {
+        ring = &secondRing;
+        name = "1s";
+    } else if (resolution == NULL || resolution[0] == '\0' || strcmp(resolution, "1m") != 0) {
+        if (rangeSeconds <= 60) {
+            ring = &rawRing;
+            name = "raw";
+        } else if (rangeSeconds <= STATS_SECOND_BUCKETS) {
+            ring = &secondRing;
+            name = "1s";
+        }
+    }
+
+    pthread_mutex_lock(&statsLock);
+
+    // STEP 2: Points inside the range (the rings are in time order)
+    long long since = nowMilliseconds() - (long long)rangeSeconds * 1000;
+    int first = 0;
+    while (first < ring->count && ringAt(ring, first)->timeMs < since) {
+        first++;
+    }
+
+    // STEP 3: Keep the newest points that fit (about 100 characters each)
+    int fit = (bufferSize - 400) / 100;
+    if (fit < 0) {
+        fit = 0;
+    }
+    if (ring->count - first > fit) {
+        first = ring->count - fit;
+    }
+
+    // STEP 4: One array per column
+    int w = advance(0, snprintf(buffer, bufferSize,
+        "{\"range\":%d,\"resolution\":\"%s\",\"points\":%d",
+        rangeSeconds, name, ring->count - first), bufferSize);
+    w = writeColumn(buffer, bufferSize, w, "t", ring, first, ring->count, 0);
+    w = writeColumn(buffer, bufferSize, w, "freeKB", ring, first, ring->count, 1);
+    w = writeColumn(buffer, bufferSize, w, "holes", ring, first, ring->count, 2);
+    w = writeColumn(buffer, bufferSize, w, "largestHoleKB", ring, first, ring->count, 3);
+    w = writeColumn(buffer, bufferSize, w, "fragmentation", ring, first, ring->count, 4);
+    w = writeColumn(buffer, bufferSize, w, "fragmentationMax", ring, first, ring->count, 5);
+    w = writeColumn(buffer, bufferSize, w, "opsPerSec", ring, first, ring->count, 6);
+    if (w < bufferSize) {
+        w = advance(w, snprintf(buffer + w, bufferSize - w, "}"), bufferSize);
+    }
+
+    pthread_mutex_unlock(&statsLock);
+    return w < bufferSize ? w : bufferSize - 1;
+}
+
+
+/*
+================================================================================
+END OF FILE: stats_history.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. statsHistorySample() - Raw sample plus 1s / 1m roll-ups
+2. statsHistoryToJSON() - Columns of one resolution over a time range
+================================================================================
+*/
@@ -0,0 +1,640 @@
+/*
+================================================================================
+FILE: translation.c
+PURPOSE: Implement the address translation simulator
+DESCRIPTION:
+    - Radix page tables stored as a pool of 512-entry nodes
+    - Set-associative TLB in struct-of-arrays layout
+    - Batched translation loop: compute keys and prefetch TLB sets for a
+      batch, then probe, walk on misses and fill
+    - Formats results as JSON for the HTTP API
+================================================================================
+*/
+
+#include <stdio.h>      // snprintf
+#include <stdlib.h>     // malloc, calloc, realloc, free
+#include <string.h>     // strcmp, memset
+#include <time.h>       // clock_gettime, CLOCK_MONOTONIC
+#include "../include/translation.h"
+#include "../include/paged_allocator.h"
+#include "../include/workload.h"
+
+
+// Upper bound on the stream length (8 bytes per reference → 160 MB)
+#define MAX_TRANSLATION_LENGTH 20000000
+
+// Upper bound on one process's virtual space (1 GB)
+#define MAX_VIRTUAL_KB 1048576
+
+// Entries per page-table node (9 index bits per level, as on x86-64)
+#define PT_ENTRIES    512
+#define PT_INDEX_BITS 9
+
+// A reference packs the address space (ASID) above the virtual address
+#define ASID_SHIFT 48
+#define VA_MASK    ((1ULL << ASID_SHIFT) - 1)
+
+// References translated per batch (keys computed and sets prefetched first)
+#define TRANSLATE_BATCH 64
+
+
+/*
+================================================================================
+HELPER: nowSeconds
+================================================================================
+*/
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int isPowerOf2(long long n) {
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+
+/*
+================================================================================
+FUNCTION: tlbPolicyName / parseTLBPolicy
+================================================================================
+*/
+
+static const char *TLB_POLICY_NAMES[2] = { "lru", "random" };
+
+const char* tlbPolicyName(TLBReplacementPolicy policy) {
+    if ((int)policy < 0 || (int)policy > 1) {
+        return "unknown";
+    }
+    return TLB_POLICY_NAMES[policy];
+}
+
+int parseTLBPolicy(const char *name) {
+    for (int i = 0; i < 2; i++) {
+        if (strcmp(name, TLB_POLICY_NAMES[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+/*
+================================================================================
+STRUCTURE: AddressSpaces (internal)
+================================================================================
+PURPOSE: The processes that take part and where their memory really is
+*/
+
+typedef struct {
+    int  numProcesses;
+    int *processIDs;        // PID of address space i (i is the ASID)
+    int *blockStartKB;      // Contiguous mode: physical start of the block
+    int *sizeKB;            // Block size (physical memory behind the space)
+    int *virtualKB;         // Virtual space size
+    int *pageBase;          // First global 4 KB page of space i (for the stream)
+    int *pageCount;         // 4 KB pages in space i
+} AddressSpaces;
+
+static void freeAddressSpaces(AddressSpaces *as) {
+    free(as->processIDs);
+    free(as->blockStartKB);
+    free(as->sizeKB);
+    free(as->virtualKB);
+    free(as->pageBase);
+    free(as->pageCount);
+    memset(as, 0, sizeof(*as));
+}
+
+// Returns 0 on success, -1 if there are no processes or memory ran out
+static int buildAddressSpaces(MemoryManager *mm, int virtualKB, AddressSpaces *as) {
+
+    memset(as, 0, sizeof(*as));
+
+    // STEP 1: Count processes (block list, or page tables in paged mode)
+    int count = 0;
+    if (mm->usePagedMode) {
+        for (int i = 0; i < mm->paged->processCapacity; i++) {
+            if (mm->paged->processes[i].processID != -1) count++;
+        }
+    } else {
+        for (MemoryBlock *b = mm->head; b != NULL; b = b->next) {
+            if (!b->isHole) count++;
+        }
+    }
+    if (count == 0) {
+        return -1;
+    }
+
+    as->processIDs = (int*)malloc(sizeof(int) * count);
+    as->blockStartKB = (int*)malloc(sizeof(int) * count);
+    as->sizeKB = (int*)malloc(sizeof(int) * count);
+    as->virtualKB = (int*)malloc(sizeof(int) * count);
+    as->pageBase = (int*)malloc(sizeof(int) * count);
+    as->pageCount = (int*)malloc(sizeof(int) * count);
+    if (!as->processIDs || !as->blockStartKB || !as->sizeKB ||
+        !as->virtualKB || !as->pageBase || !as->pageCount) {
+        freeAddressSpaces(as);
+        return -1;
+    }
+
+    // STEP 2: Record each process
+    if (mm->usePagedMode) {
+        for (int i = 0; i < mm->paged->processCapacity; i++) {
+            const PagedProcess *p = &mm->paged->processes[i];
+            if (p->processID != -1) {
+                int k = as->numProcesses++;
+                as->processIDs[k] = p->processID;
+                as->blockStartKB[k] = -1;
+                as->sizeKB[k] = p->sizeKB;
+            }
+        }
+    } else {
+        for (MemoryBlock *b = mm->head; b != NULL; b = b->next) {
+            if (!b->isHole) {
+                int k = as->numProcesses++;
+                as->processIDs[k] = b->processID;
+                as->blockStartKB[k] = b->startAddress;
+                as->sizeKB[k] = b->size;
+            }
+        }
+    }
+
+    // STEP 3: Virtual spaces, laid out side by side in 4 KB units
+    int total = 0;
+    for (int k = 0; k < as->numProcesses; k++) {
+        as->virtualKB[k] = (virtualKB > 0) ? virtualKB : as->sizeKB[k];
+        as->pageBase[k] = total;
+        as->pageCount[k] = (as->virtualKB[k] + 3) / 4;
+        total += as->pageCount[k];
+    }
+
+    return 0;
+}
+
+// Physical KB address behind offset KB of address space k
+static long physicalKB(MemoryManager *mm, const AddressSpaces *as, int k, long offsetKB) {
+    long inBlock = offsetKB % as->sizeKB[k];
+    if (as->blockStartKB[k] < 0) {
+        return mm->osMemory + pagedTranslate(mm->paged, as->processIDs[k], (int)inBlock);
+    }
+    return as->blockStartKB[k] + inBlock;
+}
+
+
+/*
+================================================================================
+STRUCTURE: PageTables (internal)
+================================================================================
+PURPOSE: Radix page tables of all address spaces in one node pool
+
+ENTRY ENCODING:
+0 = not present. In an upper level, entry = child node index + 1.
+In the last level, entry = physical frame number + 1.
+Nodes are referenced by index, so growing the pool with realloc() is safe.
+*/
+
+typedef struct {
+    uint64_t *pool;         // nodes * PT_ENTRIES entries
+    int       nodes;
+    int       capacity;
+    int      *root;         // Root node of each address space
+    int       levels;
+    int       pageShift;    // log2(page size in bytes)
+} PageTables;
+
+static int allocNode(PageTables *pt) {
+    if (pt->nodes == pt->capacity) {
+        int newCapacity = (pt->capacity > 0) ? pt->capacity * 2 : 16;
+        uint64_t *grown = (uint64_t*)realloc(pt->pool,
+            sizeof(uint64_t) * PT_ENTRIES * (size_t)newCapacity);
+        if (grown == NULL) {
+            return -1;
+        }
+        pt->pool = grown;
+        pt->capacity = newCapacity;
+    }
+    memset(pt->pool + (size_t)pt->nodes * PT_ENTRIES, 0, sizeof(uint64_t) * PT_ENTRIES);
+    return pt->nodes++;
+}
+
+static void freePageTables(PageTables *pt) {
+    free(pt->pool);
+    free(pt->root);
+    memset(pt, 0, sizeof(*pt));
+}
+
+// Map virtual page vpn of the table rooted at node 'root' to frame pfn
+static int mapPage(PageTables *pt, int root, uint64_t vpn, uint64_t pfn) {
+    int node = root;
+    for (int level = pt->levels - 1; level > 0; level--) {
+        size_t slot = (size_t)node * PT_ENTRIES
+                    + ((vpn >> (PT_INDEX_BITS * level)) & (PT_ENTRIES - 1));
+        if (pt->pool[slot] == 0) {
+            int child = allocNode(pt);
+            if (child < 0) {
+                return -1;
+            }
+            pt->pool[slot] = (uint64_t)child + 1;
+        }
+        node = (int)(pt->pool[slot] - 1);
+    }
+    pt->pool[(size_t)node * PT_ENTRIES + (vpn & (PT_ENTRIES - 1))] = pfn + 1;
+    return 0;
+}
+
+// Build the page tables of all spaces for one page size
+static int buildPageTables(MemoryManager *mm, const AddressSpaces *as,
+                           int pageSizeKB, int levels, PageTables *pt) {
+
+    memset(pt, 0, sizeof(*pt));
+    pt->levels = levels;
+    pt->pageShift = __builtin_ctzll((unsigned long long)pageSizeKB * 1024);
+    pt->root = (int*)malloc(sizeof(int) * as->numProcesses);
+    if (pt->root == NULL) {
+        return -1;
+    }
+
+    for (int k = 0; k < as->numProcesses; k++) {
+        pt->root[k] = allocNode(pt);
+        if (pt->root[k] < 0) {
+            freePageTables(pt);
+            return -1;
+        }
+
+        long pages = ((long)as->virtualKB[k] + pageSizeKB - 1) / pageSizeKB;
+        for (long p = 0; p < pages; p++) {
+            long offsetKB = (long)((long long)p * pageSizeKB % as->sizeKB[k]);
+            uint64_t physBytes = (uint64_t)physicalKB(mm, as, k, offsetKB) * 1024;
+            if (mapPage(pt, pt->root[k], (uint64_t)p, physBytes >> pt->pageShift) != 0) {
+                freePageTables(pt);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+// Page walk: one memory access per level, returns the frame number
+static inline uint64_t walkPageTables(const PageTables *pt, int asid, uint64_t vpn) {
+    const uint64_t *pool = pt->pool;
+    uint64_t node = (uint64_t)pt->root[asid];
+    for (int level = pt->levels - 1; level > 0; level--) {
+        node = pool[node * PT_ENTRIES + ((vpn >> (PT_INDEX_BITS * level)) & (PT_ENTRIES - 1))] - 1;
+    }
+    return pool[node * PT_ENTRIES + (vpn & (PT_ENTRIES - 1))] - 1;
+}
+
+
+/*
+================================================================================
+HELPER: translateStream
+================================================================================
+PURPOSE: Translate every reference through the TLB and the page tables
+
+TLB LAYOUT:
+Struct of arrays, the ways of one set next to each other. A tag is
+((ASID << 40) | vpn) + 1, so 0 means "empty way". The set index is the
+low bits of the vpn, as in real TLBs.
+
+BATCHING:
+For each batch of TRANSLATE_BATCH references, a first loop extracts the
+tag and set of every reference and prefetches the set's tags. This loop
+has no dependencies, so the compiler vectorizes it and the prefetches
+overlap. The second loop probes the ways in order (later references
+must see the fills of earlier misses) and walks on a miss.
+*/
+
+static int translateStream(const PageTables *pt, const uint64_t *refs, int length,
+                           const TranslationConfig *config, TranslationResult *result) {
+
+    int ways = config->tlbWays;
+    int sets = config->tlbEntries / ways;
+    uint64_t setMask = (uint64_t)sets - 1;
+    int shift = pt->pageShift;
+    uint64_t offsetMask = (1ULL << shift) - 1;
+
+    uint64_t *tag = (uint64_t*)calloc((size_t)config->tlbEntries, sizeof(uint64_t));
+    uint64_t *frame = (uint64_t*)calloc((size_t)config->tlbEntries, sizeof(uint64_t));
+    uint32_t *stamp = (uint32_t*)calloc((size_t)config->tlbEntries, sizeof(uint32_t));
+    if (tag == NULL || frame == NULL || stamp == NULL) {
+        free(tag); free(frame); free(stamp);
+        return -1;
+    }
+
+    WorkloadRNG rng;
+    workloadSeed(&rng, config->seed ^ 0x7AB1E5EEDULL);
+
+    uint64_t keys[TRANSLATE_BATCH];
+    uint32_t setOf[TRANSLATE_BATCH];
+    long long misses = 0;
+    uint32_t tick = 0;
+    uint64_t checksum = 0;
+
+    double start = nowSeconds();
+
+    for (int base = 0; base < length; base += TRANSLATE_BATCH) {
+        int n = (length - base < TRANSLATE_BATCH) ? length - base : TRANSLATE_BATCH;
+        const uint64_t *batch = refs + base;
+
+        // PHASE 1: Tags and sets (independent, vectorizable)
+        for (int j = 0; j < n; j++) {
+            uint64_t r = batch[j];
+            uint64_t vpn = (r & VA_MASK) >> shift;
+            keys[j] = (((r >> ASID_SHIFT) << 40) | vpn) + 1;
+            setOf[j] = (uint32_t)(vpn & setMask);
+        }
+        for (int j = 0; j < n; j++) {
+            __builtin_prefetch(&tag[(size_t)setOf[j] * ways]);
+        }
+
+        // PHASE 2: Probe in order, walk and fill on a miss
+        for (int j = 0; j < n; j++) {
+            size_t first = (size_t)setOf[j] * ways;
+            uint64_t key = keys[j];
+            tick++;
+
+            int hit = -1;
+            for (int w = 0; w < ways; w++) {
+                if (tag[first + w] == key) {
+                    hit = w;
+                    break;
+                }
+            }
+
+            uint64_t pfn;
+            if (hit >= 0) {
+                pfn = frame[first + hit];
+                stamp[first + hit] = tick;
+            } else {
+                misses++;
+                uint64_t r = batch[j];
+                pfn = walkPageTables(pt, (int)(r >> ASID_SHIFT), (r & VA_MASK) >> shift);
+
+                // Victim: an empty way, else by policy
+                int victim = -1;
+                for (int w = 0; w < ways; w++) {
+                    if (tag[first + w] == 0) {
+                        victim = w;
+                        break;
+                    }
+                }
+                if (victim < 0) {
+                    if (config->policy == TLB_RANDOM) {
+                        victim = (int)workloadRange(&rng, (uint32_t)ways);
+                    } else {
+                        victim = 0;
+                        for (int w = 1; w < ways; w++) {
+                            if (stamp[first + w] < stamp[first + victim]) {
+                                victim = w;
+                            }
+                        }
+                    }
+                }
+                tag[first + victim] = key;
+                frame[first + victim] = pfn;
+                stamp[first + victim] = tick;
+            }
+
+            checksum ^= (pfn << shift) | (batch[j] & offsetMask);
+        }
+    }
+
+    double elapsed = nowSeconds() - start;
+
+    result->translations = length;
+    result->tlbMisses = misses;
+    result->walkAccesses = misses * pt->levels;
+    result->pageTableNodes = pt->nodes;
+    result->missRate = (length > 0) ? (double)misses / (double)length : 0.0;
+    result->elapsedSeconds = elapsed;
+    result->translationsPerSecond = (elapsed > 0) ? (double)length / elapsed : 0.0;
+    result->checksum = checksum;
+
+    free(tag);
+    free(frame);
+    free(stamp);
+    return 0;
+}
+
+
+/*
+================================================================================
+HELPER: generateAddressStream
+================================================================================
+PURPOSE: Turn a 4 KB page reference string into ASID-tagged byte addresses
+
+The page string comes from generateReferenceString (working-set locality).
+Each reference gets a random 8-byte-aligned offset inside its 4 KB page,
+so the same stream can be translated with any page size.
+*/
+
+static uint64_t* generateAddressStream(const AddressSpaces *as, int length,
+                                       int locality, unsigned long long seed) {
+
+    uint32_t *pages = (uint32_t*)malloc(sizeof(uint32_t) * (size_t)length);
+    uint64_t *refs = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)length);
+    if (pages == NULL || refs == NULL) {
+        free(pages);
+        free(refs);
+        return NULL;
+    }
+
+    WorkloadRNG rng;
+    workloadSeed(&rng, seed);
+    generateReferenceString(&rng, as->pageBase, as->pageCount, as->numProcesses,
+                            pages, length, locality);
+
+    for (int i = 0; i < length; i++) {
+        // Binary search for the address space that owns this global page
+        int lo = 0, hi = as->numProcesses - 1;
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (as->pageBase[mid] <= (int)pages[i]) lo = mid; else hi = mid - 1;
+        }
+
+        uint64_t va = (uint64_t)(pages[i] - (uint32_t)as->pageBase[lo]) * 4096
+                    + (workloadNext(&rng) & 4095 & ~7ULL);
+        uint64_t limit = (uint64_t)as->virtualKB[lo] * 1024;
+        if (va >= limit) {
+            va = limit - 8;
+        }
+        refs[i] = ((uint64_t)lo << ASID_SHIFT) | va;
+    }
+
+    free(pages);
+    return refs;
+}
+
+
+/*
+================================================================================
+FUNCTION: runTranslationSimulation
+================================================================================
+PURPOSE: The API entry point - validate, build, generate, translate, report
+
+ALGORITHM:
+1. Validate parameters
+2. Build the address spaces from the current processes
+3. Generate ONE address stream
+4. For each page size: build page tables, translate through a cold TLB
+5. Write JSON and keep the summaries for /api/stats
+*/
+
+int runTranslationSimulation(MemoryManager *mm, const TranslationConfig *config,
+                             const int *pageSizesKB, int numPageSizes,
+                             char *resultBuffer, int bufferSize) {
+
+    // STEP 1: Parameters
+    if (numPageSizes <= 0 || numPageSizes > MAX_TRANSLATION_SUMMARIES) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Between 1 and %d page sizes per run\"}",
+            MAX_TRANSLATION_SUMMARIES);
+        return 0;
+    }
+    for (int s = 0; s < numPageSizes; s++) {
+        if (pageSizesKB[s] < 4 || pageSizesKB[s] > MAX_VIRTUAL_KB || !isPowerOf2(pageSizesKB[s])) {
+            snprintf(resultBuffer, bufferSize,
+                "{\"success\":false,\"message\":\"pageSize must be a power of 2 "
+                "from 4 to %d KB\"}", MAX_VIRTUAL_KB);
+            return 0;
+        }
+    }
+    if (config->levels < 2 || config->levels > 4) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"levels must be 2, 3 or 4\"}");
+        return 0;
+    }
+    if (!isPowerOf2(config->tlbEntries) || config->tlbEntries > 65536 ||
+        !isPowerOf2(config->tlbWays) || config->tlbWays > config->tlbEntries) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"entries and ways must be powers of 2 "
+            "with ways <= entries <= 65536\"}");
+        return 0;
+    }
+    if (config->virtualKB < 0 || config->virtualKB > MAX_VIRTUAL_KB) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"virtualSize must be 0-%d KB\"}",
+            MAX_VIRTUAL_KB);
+        return 0;
+    }
+    if (config->length <= 0 || config->length > MAX_TRANSLATION_LENGTH) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"length must be 1-%d\"}",
+            MAX_TRANSLATION_LENGTH);
+        return 0;
+    }
+    int locality = config->localityPercent;
+    if (locality < 0 || locality > 100) locality = 90;
+
+    // STEP 2: Address spaces
+    AddressSpaces as;
+    if (buildAddressSpaces(mm, config->virtualKB, &as) != 0) {
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Need at least one process to translate\"}");
+        return 0;
+    }
+
+    // The page tables must cover the largest space
+    int largestKB = 0;
+    for (int k = 0; k < as.numProcesses; k++) {
+        if (as.virtualKB[k] > largestKB) largestKB = as.virtualKB[k];
+    }
+    for (int s = 0; s < numPageSizes; s++) {
+        int bits = config->levels * PT_INDEX_BITS
+                 + __builtin_ctzll((unsigned long long)pageSizesKB[s] * 1024);
+        if (bits < 63 && (unsigned long long)largestKB * 1024 > (1ULL << bits)) {
+            freeAddressSpaces(&as);
+            snprintf(resultBuffer, bufferSize,
+                "{\"success\":false,\"message\":\"%d levels of %d KB pages cover "
+                "only %llu KB; use more levels or bigger pages\"}",
+                config->levels, pageSizesKB[s], (1ULL << bits) / 1024);
+            return 0;
+        }
+    }
+
+    // STEP 3: Address stream
+    uint64_t *refs = generateAddressStream(&as, config->length, locality, config->seed);
+    if (refs == NULL) {
+        freeAddressSpaces(&as);
+        snprintf(resultBuffer, bufferSize,
+            "{\"success\":false,\"message\":\"Out of memory for reference stream\"}");
+        return 0;
+    }
+
+    // STEP 4 + 5: Translate with each page size and report
+    int written = snprintf(resultBuffer, bufferSize,
+        "{\"success\":true,\"processes\":%d,\"virtualKB\":%d,\"translations\":%d,"
+        "\"localityPercent\":%d,\"seed\":%llu,\"results\":[",
+        as.numProcesses, config->virtualKB, config->length, locality, config->seed);
+
+    mm->numTranslationSummaries = 0;
+    for (int s = 0; s < numPageSizes && written < bufferSize; s++) {
+        PageTables pt;
+        TranslationResult r;
+        memset(&r, 0, sizeof(r));
+        if (buildPageTables(mm, &as, pageSizesKB[s], config->levels, &pt) != 0) {
+            continue;
+        }
+        int failed = translateStream(&pt, refs, config->length, config, &r);
+        freePageTables(&pt);
+        if (failed) {
+            continue;
+        }
+
+        r.pageSizeKB = pageSizesKB[s];
+        r.levels = config->levels;
+        r.tlbEntries = config->tlbEntries;
+        r.tlbWays = config->tlbWays;
+        r.policy = config->policy;
+
+        TranslationSummary *sum = &mm->translation[mm->numTranslationSummaries++];
+        sum->pageSizeKB = r.pageSizeKB;
+        sum->levels = r.levels;
+        sum->tlbEntries = r.tlbEntries;
+        sum->tlbWays = r.tlbWays;
+        sum->translations = r.translations;
+        sum->tlbMisses = r.tlbMisses;
+        sum->walkAccesses = r.walkAccesses;
+        sum->translationsPerSecond = r.translationsPerSecond;
+
+        written += snprintf(resultBuffer + written, bufferSize - written,
+            "%s{\"pageSizeKB\":%d,\"levels\":%d,\"tlbEntries\":%d,\"tlbWays\":%d,"
+            "\"policy\":\"%s\",\"tlbMisses\":%lld,\"missRate\":%.6f,"
+            "\"walkAccesses\":%lld,\"pageTableNodes\":%lld,\"elapsedMs\":%.3f,"
+            "\"translationsPerSecond\":%.0f,\"checksum\":\"0x%llx\"}",
+            (s == 0) ? "" : ",",
+            r.pageSizeKB, r.levels, r.tlbEntries, r.tlbWays,
+            tlbPolicyName(r.policy), r.tlbMisses, r.missRate,
+            r.walkAccesses, r.pageTableNodes, r.elapsedSeconds * 1000.0,
+            r.translationsPerSecond, (unsigned long long)r.checksum);
+    }
+    if (written < bufferSize) {
+        snprintf(resultBuffer + written, bufferSize - written, "]}");
+    }
+
+    free(refs);
+    freeAddressSpaces(&as);
+    return 1;
+}
+
+
+/*
+================================================================================
+END OF FILE: translation.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. tlbPolicyName() / parseTLBPolicy() - Enum <-> API name
+2. buildAddressSpaces() - Virtual spaces on top of the allocated blocks
+3. buildPageTables() / walkPageTables() - 2/3/4-level radix page tables
+4. translateStream() - Batched set-associative TLB with LRU/random
+5. generateAddressStream() - Byte addresses with working-set locality
+6. runTranslationSimulation() - API entry point with JSON output
+
+COST PER TRANSLATION:
+TLB hit: one set probe (ways compares)
+TLB miss: one set probe + 'levels' dependent loads + one fill
+================================================================================
+*/
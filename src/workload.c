@@ -0,0 +1,191 @@
+/*
+================================================================================
+FILE: workload.c
+PURPOSE: Implement the synthetic workload generators
+DESCRIPTION:
+    - xorshift64* pseudo-random numbers (seedable, portable, fast)
+    - Reference strings with working-set locality for paging experiments
+    - Allocate/free operation streams shared by allocator comparisons
+================================================================================
+*/
+
+#include <stddef.h>
+#include <stdlib.h>     // malloc, free
+#include "../include/workload.h"
+
+
+/*
+================================================================================
+FUNCTION: workloadSeed
+================================================================================
+PURPOSE: Initialize the generator
+
+HOW IT WORKS:
+xorshift gets stuck forever at state 0, so we scramble the seed with the
+splitmix64 finalizer first. Seeds 0, 1, 2... then give unrelated streams.
+*/
+
+void workloadSeed(WorkloadRNG *rng, uint64_t seed) {
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    rng->state = (z != 0) ? z : 0x2545F4914F6CDD1DULL;
+}
+
+
+/*
+================================================================================
+FUNCTION: workloadNext
+================================================================================
+PURPOSE: Advance the generator (xorshift64* by Vigna)
+*/
+
+uint64_t workloadNext(WorkloadRNG *rng) {
+    uint64_t x = rng->state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    rng->state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+
+/*
+================================================================================
+FUNCTION: workloadRange
+================================================================================
+PURPOSE: Map a random number onto [0, n)
+
+HOW IT WORKS:
+Multiply the top 32 bits by n and keep the high half (Lemire's trick).
+No division, and the bias is negligible for the sizes we use.
+*/
+
+uint32_t workloadRange(WorkloadRNG *rng, uint32_t n) {
+    uint64_t r = workloadNext(rng) >> 32;
+    return (uint32_t)((r * (uint64_t)n) >> 32);
+}
+
+
+/*
+================================================================================
+FUNCTION: generateReferenceString
+================================================================================
+PURPOSE: Build a reference string with working-set locality
+
+TUNING CONSTANTS:
+- 1 in 256 references switches to another process (a "context switch")
+- The working set is 1/8 of the process's pages (at least 1 page)
+- 1 in 64 references slides the working set forward by one page
+
+EXAMPLE (one process with 32 pages, locality 90%):
+Window = 4 pages starting at page 10
+→ 90% of references hit pages 10..13, the rest hit any of 0..31
+→ every ~64 references the window moves to 11..14
+*/
+
+void generateReferenceString(WorkloadRNG *rng,
+                             const int *pageBase, const int *pageCount,
+                             int numProcesses,
+                             uint32_t *refs, int length,
+                             int localityPercent) {
+
+    if (numProcesses <= 0 || length <= 0) {
+        return;
+    }
+
+    // Locality as a 16-bit threshold so the hot loop only compares integers
+    uint32_t localityThreshold = (uint32_t)localityPercent * 65536u / 100u;
+
+    int proc = 0;
+    int windowStart = 0;
+
+    for (int i = 0; i < length; i++) {
+        uint64_t r = workloadNext(rng);
+
+        // STEP 1: Occasionally switch to a different process
+        if ((r & 0xFF) == 0) {
+            proc = (int)workloadRange(rng, (uint32_t)numProcesses);
+            windowStart = (int)workloadRange(rng, (uint32_t)pageCount[proc]);
+        }
+
+        int pages = pageCount[proc];
+        int window = pages / 8;
+        if (window < 1) window = 1;
+
+        // STEP 2: Occasionally slide the working set forward
+        if (((r >> 8) & 0x3F) == 0) {
+            windowStart = (windowStart + 1) % pages;
+        }
+
+        // STEP 3: Pick the page (inside the window or anywhere)
+        int page;
+        if (((r >> 16) & 0xFFFF) < localityThreshold) {
+            page = (windowStart + (int)(((r >> 32) % (uint64_t)window))) % pages;
+        } else {
+            page = (int)workloadRange(rng, (uint32_t)pages);
+        }
+
+        refs[i] = (uint32_t)(pageBase[proc] + page);
+    }
+}
+
+
+/*
+================================================================================
+FUNCTION: generateOpStream
+================================================================================
+PURPOSE: Build a reproducible allocate/free stream
+
+The live set is kept in a scratch array; freeing swaps the chosen entry
+with the last one, so every step is O(1).
+*/
+
+int generateOpStream(WorkloadRNG *rng, WorkloadOp *ops, int count,
+                     int minSizeKB, int maxSizeKB, int freePercent) {
+
+    if (minSizeKB < 1) minSizeKB = 1;
+    if (maxSizeKB < minSizeKB) maxSizeKB = minSizeKB;
+
+    int *live = (int*)malloc(sizeof(int) * (size_t)(count > 0 ? count : 1));
+    if (live == NULL) {
+        return 0;
+    }
+    int liveCount = 0;
+    int allocations = 0;
+    uint32_t span = (uint32_t)(maxSizeKB - minSizeKB + 1);
+
+    for (int i = 0; i < count; i++) {
+        if (liveCount > 0 && (int)workloadRange(rng, 100) < freePercent) {
+            uint32_t pick = workloadRange(rng, (uint32_t)liveCount);
+            ops[i].isFree = 1;
+            ops[i].sizeKB = 0;
+            ops[i].allocIndex = live[pick];
+            live[pick] = live[--liveCount];
+        } else {
+            ops[i].isFree = 0;
+            ops[i].sizeKB = minSizeKB + (int)workloadRange(rng, span);
+            ops[i].allocIndex = allocations;
+            live[liveCount++] = allocations++;
+        }
+    }
+
+    free(live);
+    return allocations;
+}
+
+
+/*
+================================================================================
+END OF FILE: workload.c
+================================================================================
+
+WHAT WE IMPLEMENTED:
+1. workloadSeed() - splitmix64-scrambled seeding
+2. workloadNext() - xorshift64* generator
+3. workloadRange() - Uniform integer in [0, n) without division
+4. generateReferenceString() - Working-set reference strings for paging
+5. generateOpStream() - Allocate/free streams for allocator comparisons
+================================================================================
+*/
@@ -0,0 +1,32 @@
+#!/bin/sh
+# ==============================================================================
+# FILE: run_scripts.sh
+# PURPOSE: Run every tests/scripts/*.txt and compare stdout with its .expected
+#
+# USAGE: tests/run_scripts.sh [path/to/memory_visualizer]
+#        (default: build/memory_visualizer)
+#
+# Each script names the pool it needs on an "# ARGS:" line in its header
+# (e.g. "# ARGS: --total 4096 --os-reserve 1024"); the expected output
+# only holds for that pool. Exit status 1 if any script differs.
+# ==============================================================================
+
+BINARY=${1:-build/memory_visualizer}
+DIR=$(dirname "$0")/scripts
+FAILED=0
+
+for SCRIPT in "$DIR"/*.txt; do
+    NAME=$(basename "$SCRIPT" .txt)
+    ARGS=$(sed -n 's/^# ARGS: *//p' "$SCRIPT" | head -n 1)
+
+    # shellcheck disable=SC2086  (ARGS is a list of options)
+    if "$BINARY" $ARGS --script "$SCRIPT" 2>/dev/null |
+            cmp -s - "$DIR/$NAME.expected"; then
+        echo "PASS  $NAME"
+    else
+        echo "FAIL  $NAME  ($BINARY $ARGS --script $SCRIPT)"
+        FAILED=1
+    fi
+done
+
+exit $FAILED